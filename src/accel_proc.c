@@ -2,6 +2,7 @@
 
 #include "edgeai_config.h"
 #include "edgeai_util.h"
+#include "ram_place.h"
 
 void accel_proc_init(accel_proc_t *s)
 {
@@ -12,6 +13,7 @@ void accel_proc_init(accel_proc_t *s)
     s->bang_prev = false;
 }
 
+EDGEAI_RAMFUNC
 void accel_proc_apply_axis_map(int32_t *ax, int32_t *ay)
 {
     if (!ax || !ay) return;
@@ -26,9 +28,14 @@ void accel_proc_apply_axis_map(int32_t *ax, int32_t *ay)
 #endif
 }
 
-void accel_proc_update(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out)
+/* Shared filter front end: updates the LP state, fills every output but the soft response and returns the
+ * deadzoned LP tilt (raw counts).
+ */
+EDGEAI_RAMFUNC
+static bool accel_proc_filter(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out,
+                              int32_t *ax_dz_out, int32_t *ay_dz_out)
 {
-    if (!s || !out) return;
+    if (!s || !out) return false;
 
     int32_t ax = raw_x;
     int32_t ay = raw_y;
@@ -81,6 +88,35 @@ void accel_proc_update(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t ra
     if (edgeai_abs_i32(ay_dz) <= deadzone) ay_dz = 0;
     else ay_dz -= (ay_dz > 0) ? deadzone : -deadzone;
 
+    out->ax_lp = s->ax_lp;
+    out->ay_lp = s->ay_lp;
+    out->az_lp = s->az_lp;
+    out->ax_hp = ax_hp;
+    out->ay_hp = ay_hp;
+    out->az_hp = az_hp;
+    out->bang_score = bang_score;
+    out->bang_pulse = bang_pulse;
+    *ax_dz_out = ax_dz;
+    *ay_dz_out = ay_dz;
+    return true;
+}
+
+EDGEAI_RAMFUNC
+void accel_proc_update(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out)
+{
+#if EDGEAI_ACCEL_FLOAT
+    accel_proc_update_float(s, raw_x, raw_y, raw_z, out);
+#else
+    accel_proc_update_fixed(s, raw_x, raw_y, raw_z, out);
+#endif
+}
+
+EDGEAI_RAMFUNC_UNLESS(EDGEAI_ACCEL_FLOAT)
+void accel_proc_update_fixed(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out)
+{
+    int32_t ax_dz, ay_dz;
+    if (!accel_proc_filter(s, raw_x, raw_y, raw_z, out, &ax_dz, &ay_dz)) return;
+
     /* Normalize to Q15 ~= [-1,1] at 1g. */
     int32_t ax_n_q15 = (int32_t)(((int64_t)ax_dz << 15) / (int64_t)EDGEAI_ACCEL_MAP_DENOM);
     int32_t ay_n_q15 = (int32_t)(((int64_t)ay_dz << 15) / (int64_t)EDGEAI_ACCEL_MAP_DENOM);
@@ -100,14 +136,28 @@ void accel_proc_update(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t ra
     int32_t ay_soft_q15 = (int32_t)(((int64_t)ay_n_q15 * alpha_q15 +
                                      (int64_t)ay_cu_q15 * ((1 << 15) - alpha_q15)) >> 15);
 
-    out->ax_lp = s->ax_lp;
-    out->ay_lp = s->ay_lp;
-    out->az_lp = s->az_lp;
-    out->ax_hp = ax_hp;
-    out->ay_hp = ay_hp;
-    out->az_hp = az_hp;
-    out->bang_score = bang_score;
     out->ax_soft_q15 = ax_soft_q15;
     out->ay_soft_q15 = ay_soft_q15;
-    out->bang_pulse = bang_pulse;
+}
+
+/* The fixed curve in float: x in [-1, 1] at 1g, 35% linear + 65% cubic, back to Q15. */
+EDGEAI_RAMFUNC_IF(EDGEAI_ACCEL_FLOAT)
+static int32_t accel_soft_float(int32_t dz)
+{
+    const float alpha = 11469.0f / 32768.0f;
+    const float x_max = 32767.0f / 32768.0f;
+    float x = (float)dz * (1.0f / (float)EDGEAI_ACCEL_MAP_DENOM);
+    if (x > x_max) x = x_max;
+    if (x < -x_max) x = -x_max;
+    float soft = x * (alpha + (1.0f - alpha) * x * x);
+    return (int32_t)(soft * 32768.0f);
+}
+
+EDGEAI_RAMFUNC_IF(EDGEAI_ACCEL_FLOAT)
+void accel_proc_update_float(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out)
+{
+    int32_t ax_dz, ay_dz;
+    if (!accel_proc_filter(s, raw_x, raw_y, raw_z, out, &ax_dz, &ay_dz)) return;
+    out->ax_soft_q15 = accel_soft_float(ax_dz);
+    out->ay_soft_q15 = accel_soft_float(ay_dz);
 }
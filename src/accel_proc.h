@@ -40,7 +40,19 @@ void accel_proc_init(accel_proc_t *s);
 
 void accel_proc_apply_axis_map(int32_t *ax, int32_t *ay);
 
+/* Arithmetic of the soft-response curve: 0 Q15 integer, 1 single-precision float on the FPU. The filter
+ * state and outputs are integers either way.
+ */
+#ifndef EDGEAI_ACCEL_FLOAT
+#define EDGEAI_ACCEL_FLOAT 0
+#endif
+
 /* Converts raw 12-bit accel sample into a smoothed, deadzoned, soft-response vector.
  * Output is in Q15, approximately normalized to [-1, 1] around 1g.
  */
 void accel_proc_update(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out);
+/* Both variants are always built (tools/fpu_ab_bench.c compares them); accel_proc_update is the one
+ * EDGEAI_ACCEL_FLOAT selects.
+ */
+void accel_proc_update_fixed(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out);
+void accel_proc_update_float(accel_proc_t *s, int32_t raw_x, int32_t raw_y, int32_t raw_z, accel_proc_out_t *out);
@@ -0,0 +1,194 @@
+#include "ball_grid.h"
+
+#include <string.h>
+
+#include "edgeai_config.h"
+#include "edgeai_math.h"
+#include "edgeai_util.h"
+
+/* Circle masks: row half-widths per radius (dx^2 + dy^2 <= r^2 + r, a disc of radius ~r + 1/2) and the
+ * cell count of each disc.
+ */
+static uint8_t s_half[EDGEAI_BALL_GRID_R_MAX + 1][EDGEAI_BALL_GRID_R_MAX + 1];
+static uint16_t s_area[EDGEAI_BALL_GRID_R_MAX + 1];
+static bool s_masks_built;
+
+static void ball_grid_build_masks(void)
+{
+    for (int32_t r = 0; r <= EDGEAI_BALL_GRID_R_MAX; r++)
+    {
+        uint32_t area = 0;
+        for (int32_t dy = 0; dy <= r; dy++)
+        {
+            int32_t hw = 0;
+            while (hw < r && (hw + 1) * (hw + 1) + dy * dy <= r * r + r) hw++;
+            s_half[r][dy] = (uint8_t)hw;
+            area += (uint32_t)(2 * hw + 1) * ((dy == 0) ? 1u : 2u);
+        }
+        s_area[r] = (uint16_t)area;
+    }
+    s_masks_built = true;
+}
+
+static inline void ball_grid_wake(sand_grid_t *g, int32_t x, int32_t y)
+{
+    uint32_t p = sand_sim_patch_of(x, y);
+    g->active[p] = 1u; /* scanned by this frame's grid step */
+    g->changed[p] = 1u;
+}
+
+/* Moves the cell at (x, y), offset (dx, dy) from the center, out along (sx, sy): past the rim of the
+ * footprint, then into the first empty cell within EDGEAI_BALL_GRID_PUSH_REACH. Metal or the grid edge
+ * stops it.
+ */
+static bool ball_grid_push(sand_grid_t *g, int32_t x, int32_t y, int32_t dx, int32_t dy, int32_t sx, int32_t sy,
+                           int32_t r)
+{
+    int32_t k = 1;
+    for (;; k++)
+    {
+        int32_t ey = edgeai_abs_i32(dy + sy * k);
+        if (ey > r || edgeai_abs_i32(dx + sx * k) > (int32_t)s_half[r][ey]) break;
+    }
+    for (int32_t n = 0; n < EDGEAI_BALL_GRID_PUSH_REACH; n++, k++)
+    {
+        int32_t nx = x + sx * k;
+        int32_t ny = y + sy * k;
+        if (nx < 0 || ny < 0 || nx >= EDGEAI_SAND_W || ny >= EDGEAI_SAND_H) return false;
+        uint8_t m = g->cell[ny][nx];
+        if (m == (uint8_t)kEdgeAiMatMetal) return false;
+        if (m != (uint8_t)kEdgeAiMatEmpty) continue;
+        g->cell[ny][nx] = g->cell[y][x];
+        g->cell[y][x] = (uint8_t)kEdgeAiMatEmpty;
+        ball_grid_wake(g, x, y);
+        ball_grid_wake(g, nx, ny);
+        return true;
+    }
+    return false;
+}
+
+/* Rewrites the footprint cells holding `from` to `to` (Ball to Empty clears it, Empty to Ball writes it). */
+static void ball_grid_fill(sand_grid_t *g, int32_t cx, int32_t cy, int32_t r, uint8_t from, uint8_t to)
+{
+    for (int32_t dy = -r; dy <= r; dy++)
+    {
+        int32_t y = cy + dy;
+        if (y < 0 || y >= EDGEAI_SAND_H) continue;
+        int32_t hw = (int32_t)s_half[r][edgeai_abs_i32(dy)];
+        int32_t x0 = (cx - hw < 0) ? 0 : cx - hw;
+        int32_t x1 = (cx + hw >= EDGEAI_SAND_W) ? EDGEAI_SAND_W - 1 : cx + hw;
+        for (int32_t x = x0; x <= x1; x++)
+        {
+            if (g->cell[y][x] == from) g->cell[y][x] = to;
+        }
+        if (x0 > x1) continue;
+        for (int32_t x = x0; x <= x1; x += EDGEAI_SAND_PATCH) ball_grid_wake(g, x, y);
+        ball_grid_wake(g, x1, y);
+    }
+}
+
+void edgeai_ball_grid_init(edgeai_ball_grid_t *c)
+{
+    if (!s_masks_built) ball_grid_build_masks();
+    if (c) memset(c, 0, sizeof(*c));
+}
+
+bool edgeai_ball_grid_step(edgeai_ball_grid_t *c, sand_grid_t *g, const ball_state_t *ball, int32_t *dvx_q16,
+                           int32_t *dvy_q16)
+{
+    if (!c || !g || !ball || !dvx_q16 || !dvy_q16) return false;
+    *dvx_q16 = 0;
+    *dvy_q16 = 0;
+    c->steps++;
+    c->cells = 0;
+    c->occupied = 0;
+    c->moved = 0;
+    c->blocked = 0;
+    if (!s_masks_built) ball_grid_build_masks();
+    if (c->r > 0) ball_grid_fill(g, c->cx, c->cy, c->r, (uint8_t)kEdgeAiMatBall, (uint8_t)kEdgeAiMatEmpty);
+    c->r = 0;
+    if (ball->lift_q16 > (EDGEAI_BALL_GRID_LIFT_PX << 16)) return false;
+
+    int32_t bx_px = edgeai_clamp_i32(ball->x_q16 >> 16, 0, EDGEAI_LCD_W - 1);
+    int32_t by_px = edgeai_clamp_i32(ball->y_q16 >> 16, 0, EDGEAI_LCD_H - 1);
+    int32_t r = (edgeai_ball_r_for_y(by_px) + EDGEAI_SAND_CELL_PX / 2) / EDGEAI_SAND_CELL_PX;
+    r = edgeai_clamp_i32(r, 1, EDGEAI_BALL_GRID_R_MAX);
+    int32_t cx = bx_px / EDGEAI_SAND_CELL_PX;
+    int32_t cy = by_px / EDGEAI_SAND_CELL_PX;
+
+    /* Push direction: 8-way velocity, same sectors as sand_sim_gravity_from_tilt. */
+    int32_t sx = 0, sy = 0;
+    int32_t avx = edgeai_abs_i32(ball->vx_q16);
+    int32_t avy = edgeai_abs_i32(ball->vy_q16);
+    if ((int64_t)avx + avy >= ((int64_t)EDGEAI_BALL_GRID_PUSH_MIN_PX_S << 16))
+    {
+        if (5 * (int64_t)avx >= 2 * (int64_t)avy) sx = (ball->vx_q16 > 0) ? 1 : -1;
+        if (5 * (int64_t)avy >= 2 * (int64_t)avx) sy = (ball->vy_q16 > 0) ? 1 : -1;
+    }
+
+    /* Front rows and columns first, so the leading cells clear the way for the ones behind. */
+    int32_t weight = 0;
+    int32_t sum_x = 0, sum_y = 0;
+    for (int32_t i = 0; i <= 2 * r; i++)
+    {
+        int32_t dy = (sy > 0) ? (r - i) : (i - r);
+        int32_t y = cy + dy;
+        if (y < 0 || y >= EDGEAI_SAND_H) continue;
+        int32_t hw = (int32_t)s_half[r][edgeai_abs_i32(dy)];
+        for (int32_t j = 0; j <= 2 * hw; j++)
+        {
+            int32_t dx = (sx > 0) ? (hw - j) : (j - hw);
+            int32_t x = cx + dx;
+            if (x < 0 || x >= EDGEAI_SAND_W) continue;
+            c->cells++;
+            uint8_t m = g->cell[y][x];
+            if (m == (uint8_t)kEdgeAiMatEmpty) continue;
+            c->occupied++;
+            if (m == (uint8_t)kEdgeAiMatSand) weight += 2;
+            if (m == (uint8_t)kEdgeAiMatWater) weight += 1;
+            /* Ahead of the ball first (loose grains are plowed), else into its wake (packed grains flow
+             * around it into the cells it just left).
+             */
+            if (m != (uint8_t)kEdgeAiMatMetal && (sx | sy) != 0 &&
+                (ball_grid_push(g, x, y, dx, dy, sx, sy, r) || ball_grid_push(g, x, y, dx, dy, -sx, -sy, r)))
+            {
+                c->moved++;
+                continue;
+            }
+            c->blocked++;
+            sum_x += dx;
+            sum_y += dy;
+        }
+    }
+    ball_grid_fill(g, cx, cy, r, (uint8_t)kEdgeAiMatEmpty, (uint8_t)kEdgeAiMatBall);
+    c->cx = cx;
+    c->cy = cy;
+    c->r = r;
+    if (c->occupied == 0u) return false;
+
+    /* Drag: the ball shares its momentum with the grains it met (an inelastic hit, water at half mass). */
+    int64_t drag_q16 = ((int64_t)weight << 16) / (2 * EDGEAI_BALL_GRID_MASS + weight);
+    int64_t dvx = -(((int64_t)ball->vx_q16 * drag_q16) >> 16);
+    int64_t dvy = -(((int64_t)ball->vy_q16 * drag_q16) >> 16);
+
+    /* Collision: cells that could not be displaced are rigid; their centroid is the contact normal. An arc of
+     * r blocked cells is a full wall, bouncing the normal velocity with the screen edges' 3/4 restitution;
+     * a stray grain only takes its share.
+     */
+    uint32_t len = edgeai_isqrt_u32((uint32_t)(sum_x * sum_x + sum_y * sum_y));
+    if (len > 0u)
+    {
+        int64_t vn_q16 = ((int64_t)ball->vx_q16 * sum_x + (int64_t)ball->vy_q16 * sum_y) / (int64_t)len;
+        if (vn_q16 > 0)
+        {
+            int64_t f_q16 = ((int64_t)c->blocked << 16) / r;
+            if (f_q16 > 65536) f_q16 = 65536;
+            int64_t j_q16 = (((vn_q16 * 7) / 4) * f_q16) >> 16;
+            dvx -= (j_q16 * sum_x) / (int64_t)len;
+            dvy -= (j_q16 * sum_y) / (int64_t)len;
+        }
+    }
+    *dvx_q16 = (int32_t)dvx;
+    *dvy_q16 = (int32_t)dvy;
+    return true;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sand_sim.h"
+#include "sim_world.h"
+
+/* Ball-to-grid coupling (docs/SIM_ARCHITECTURE.md, ball phase 2).
+ * Once per grid step, before the sand and water steps, the ball's footprint is rasterized into the material
+ * grid as kEdgeAiMatBall from a precomputed circle mask for its radius in cells (row half-widths, so only
+ * the cells under the ball are touched); the rules treat those cells as solid, so grains pile against the
+ * ball instead of filling it. Last step's footprint is cleared first. Grains and water in the new footprint
+ * are pushed along the ball's 8-way quantized velocity to the first empty cell past the front rim, or else
+ * past the rear rim into the cells it just left, front cells first; a cell with nowhere to go (metal, the
+ * grid edge, a slow ball) is blocked and stays. The occupancy gives the ball a velocity impulse: drag from
+ * the mass of the cells it met, and a rigid bounce off the centroid of the blocked cells when it moves into
+ * them.
+ *
+ * The impulse is returned rather than applied, so the caller can feed it through sim_input_t (the bang
+ * fields) and recordings still replay bit for bit.
+ */
+
+#ifndef EDGEAI_BALL_GRID_ENABLE
+#define EDGEAI_BALL_GRID_ENABLE 1
+#endif
+
+/* Ball mass in sand cells: each grid step the ball shares its momentum with the grains it displaced. */
+#ifndef EDGEAI_BALL_GRID_MASS
+#define EDGEAI_BALL_GRID_MASS 128
+#endif
+
+/* Slowest ball (px/s) that pushes grains aside. */
+#ifndef EDGEAI_BALL_GRID_PUSH_MIN_PX_S
+#define EDGEAI_BALL_GRID_PUSH_MIN_PX_S 24
+#endif
+
+/* Cells past the rim a displaced grain may land (a bulldozed pile). */
+#ifndef EDGEAI_BALL_GRID_PUSH_REACH
+#define EDGEAI_BALL_GRID_PUSH_REACH 3
+#endif
+
+/* Lift (px) above which the ball is off the board and leaves the grid alone. */
+#ifndef EDGEAI_BALL_GRID_LIFT_PX
+#define EDGEAI_BALL_GRID_LIFT_PX 6
+#endif
+
+/* Largest footprint radius in cells. */
+#define EDGEAI_BALL_GRID_R_MAX ((EDGEAI_BALL_R_MAX + EDGEAI_SAND_CELL_PX - 1) / EDGEAI_SAND_CELL_PX)
+
+typedef struct
+{
+    int32_t cx; /* footprint written by the last step (cells); r 0: none */
+    int32_t cy;
+    int32_t r;
+    uint32_t steps;
+    /* Last step. */
+    uint32_t cells;    /* footprint cells touched */
+    uint32_t occupied; /* of those, not empty */
+    uint32_t moved;    /* grains displaced */
+    uint32_t blocked;  /* grains and metal that stayed under the ball */
+} edgeai_ball_grid_t;
+
+/* Clears the counters and builds the circle masks (shared, built once). */
+void edgeai_ball_grid_init(edgeai_ball_grid_t *c);
+
+/* Couples `ball` (LCD pixels, Q16) with `g`: moves its footprint, displaces cells under it, wakes the
+ * patches it changed, and writes the velocity impulse for the ball's next sim step to *dvx_q16 / *dvy_q16
+ * (zero when the ball is airborne, which lifts the footprint off the grid, or over empty cells). Returns
+ * true when the footprint held anything.
+ */
+bool edgeai_ball_grid_step(edgeai_ball_grid_t *c, sand_grid_t *g, const ball_state_t *ball, int32_t *dvx_q16,
+                           int32_t *dvy_q16);
@@ -2413,7 +2413,12 @@ static const uint8_t g_dune_hmap[38400] = {
     160, 156, 152, 147, 142, 138, 133, 128, 123, 118, 116, 111, 104, 101, 96, 91,
 };
 
-static const uint16_t g_dune_tex[38400] = {
+/* Placement of the texture, set by the includer (sw_render.c, see ram_place.h). */
+#ifndef DUNE_TEX_ATTR
+#define DUNE_TEX_ATTR
+#endif
+
+static const uint16_t g_dune_tex[38400] DUNE_TEX_ATTR = {
     0xE699u, 0xE699u, 0xE679u, 0xE699u, 0xE699u, 0xE699u, 0xE699u, 0xE699u, 0xE679u, 0xE679u, 0xE679u, 0xE679u,
     0xE679u, 0xE679u, 0xE679u, 0xE679u, 0xE679u, 0xE699u, 0xE679u, 0xE679u, 0xDE79u, 0xDE79u, 0xE679u, 0xE679u,
     0xE679u, 0xE679u, 0xE679u, 0xDE79u, 0xE679u, 0xE679u, 0xE679u, 0xE699u, 0xE679u, 0xDE79u, 0xDE79u, 0xDE79u,
@@ -0,0 +1,268 @@
+#include "dune_live.h"
+
+#include <string.h>
+
+#include "edgeai_util.h"
+
+#define DUNE_W ((int32_t)EDGEAI_TERRAIN_W)
+#define DUNE_H ((int32_t)EDGEAI_TERRAIN_H)
+
+/* Python floor division for the height tint (c - 128 may be negative). */
+static inline int32_t dune_floor_div(int32_t a, int32_t b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static inline uint16_t dune_rgb565(int32_t r, int32_t g, int32_t b)
+{
+    r = edgeai_clamp_i32(r, 0, 255);
+    g = edgeai_clamp_i32(g, 0, 255);
+    b = edgeai_clamp_i32(b, 0, 255);
+    return (uint16_t)(((uint32_t)(r >> 3) << 11) | ((uint32_t)(g >> 2) << 5) | (uint32_t)(b >> 3));
+}
+
+void edgeai_dune_shade_rect(const uint8_t *hmap, uint16_t *tex, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    if (!hmap || !tex) return;
+    x0 = edgeai_clamp_i32(x0, 0, DUNE_W);
+    x1 = edgeai_clamp_i32(x1, 0, DUNE_W);
+    y0 = edgeai_clamp_i32(y0, 0, DUNE_H);
+    y1 = edgeai_clamp_i32(y1, 0, DUNE_H);
+
+    /* Light (-24, -40, 96) against the normal (-hx, -hy, 96): dot = 24 hx + 40 hy + 96 * 96. */
+    for (int32_t y = y0; y < y1; y++)
+    {
+        const uint8_t *up = hmap + ((y > 0) ? y - 1 : y) * DUNE_W;
+        const uint8_t *dn = hmap + ((y < DUNE_H - 1) ? y + 1 : y) * DUNE_W;
+        const uint8_t *row = hmap + y * DUNE_W;
+        uint16_t *out = tex + y * DUNE_W;
+        int32_t haze = (y < 80) ? 80 - y : 0;
+        for (int32_t x = x0; x < x1; x++)
+        {
+            int32_t c = row[x];
+            int32_t hx = (int32_t)row[(x < DUNE_W - 1) ? x + 1 : x] - (int32_t)row[(x > 0) ? x - 1 : x];
+            int32_t hy = (int32_t)dn[x] - (int32_t)up[x];
+            int32_t dot = 24 * hx + 40 * hy + 96 * 96;
+            int32_t li = (dot < 0) ? 0 : dot >> 6;
+            if (li > 255) li = 255;
+
+            int32_t base_r = 210 + dune_floor_div(c - 128, 10);
+            int32_t base_g = 190 + dune_floor_div(c - 128, 14);
+            int32_t base_b = 150 + dune_floor_div(c - 128, 18);
+            int32_t r = (base_r * (60 + li)) / 255 + (haze * 2) / 3;
+            int32_t g = (base_g * (60 + li)) / 255 + (haze * 2) / 3;
+            int32_t b = (base_b * (60 + li)) / 255 + haze;
+            out[x] = dune_rgb565(r, g, b);
+        }
+    }
+}
+
+/* Tilt-lit kernel: normals from the terrain gradient, base colors from the palette. */
+static void dune_shade_dynamic(edgeai_dune_live_t *d, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    const int32_t kx = -2 * d->light[0];
+    const int32_t ky = -2 * d->light[1];
+    const int32_t kz = EDGEAI_DUNE_LIGHT_Z * d->light[2];
+    for (int32_t y = y0; y < y1; y++)
+    {
+        const uint8_t *row = d->hmap + y * DUNE_W;
+        const uint16_t *grad = d->terrain->grad + y * DUNE_W;
+        uint16_t *out = d->tex + y * DUNE_W;
+        int32_t haze = (y < 80) ? 80 - y : 0;
+        int32_t haze_rg = (haze * 2) / 3;
+        for (int32_t x = x0; x < x1; x++)
+        {
+            uint16_t g = grad[x];
+            int32_t dot = (int32_t)(int8_t)g * kx + (int32_t)(int8_t)(g >> 8) * ky + kz;
+            uint32_t li = (dot < 0) ? 0u : (uint32_t)dot >> 6;
+            if (li > 255u) li = 255u;
+            const uint8_t *pal = d->palette[row[x]];
+            uint32_t m = 60u + li;
+            out[x] = dune_rgb565((int32_t)((pal[0] * m) / 255u) + haze_rg, (int32_t)((pal[1] * m) / 255u) + haze_rg,
+                                 (int32_t)((pal[2] * m) / 255u) + haze);
+        }
+    }
+}
+
+static void dune_shade(edgeai_dune_live_t *d, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    if (d->light_dynamic)
+        dune_shade_dynamic(d, x0, y0, x1, y1);
+    else
+        edgeai_dune_shade_rect(d->hmap, d->tex, x0, y0, x1, y1);
+}
+
+/* Relights and refreshes the gradient of everything that reads texels [x0,x1) x [y0,y1); only blocks whose
+ * shading actually changed are flagged dirty (a one-unit step often leaves the grown border unchanged).
+ */
+static void dune_changed(edgeai_dune_live_t *d, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    x0 = edgeai_clamp_i32(x0 - 1, 0, DUNE_W);
+    y0 = edgeai_clamp_i32(y0 - 1, 0, DUNE_H);
+    x1 = edgeai_clamp_i32(x1 + 1, 0, DUNE_W);
+    y1 = edgeai_clamp_i32(y1 + 1, 0, DUNE_H);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    /* Gradient first: the dynamic kernel reads its normals from it. */
+    if (d->terrain) edgeai_terrain_update_grad(d->terrain, x0, y0, x1, y1);
+
+    uint16_t old[EDGEAI_TERRAIN_W];
+    for (int32_t y = y0; y < y1; y++)
+    {
+        uint16_t *row = d->tex + y * DUNE_W;
+        memcpy(old, row + x0, (size_t)(x1 - x0) * sizeof(old[0]));
+        dune_shade(d, x0, y, x1, y + 1);
+        uint8_t *blocks = d->block + (y >> EDGEAI_DUNE_BLOCK_SHIFT) * EDGEAI_DUNE_BLOCK_COLS;
+        for (int32_t x = x0; x < x1; x++)
+        {
+            if (row[x] != old[x - x0]) blocks[x >> EDGEAI_DUNE_BLOCK_SHIFT] |= kEdgeAiDuneBlockDirty;
+        }
+    }
+    d->relit_texels += (uint32_t)((x1 - x0) * (y1 - y0));
+}
+
+bool edgeai_dune_live_init(edgeai_dune_live_t *d, const uint8_t *base, const uint16_t *tex, uint32_t w,
+                           uint32_t h, edgeai_terrain_t *terrain)
+{
+    if (!d) return false;
+    memset(d, 0, sizeof(*d));
+    if (!base || !tex || w != EDGEAI_TERRAIN_W || h != EDGEAI_TERRAIN_H) return false;
+    d->base = base;
+    d->terrain = terrain;
+    memcpy(d->hmap, base, sizeof(d->hmap));
+    memcpy(d->tex, tex, sizeof(d->tex));
+
+    for (int32_t c = 0; c < 256; c++)
+    {
+        d->palette[c][0] = (uint8_t)(210 + dune_floor_div(c - 128, 10));
+        d->palette[c][1] = (uint8_t)(190 + dune_floor_div(c - 128, 14));
+        d->palette[c][2] = (uint8_t)(150 + dune_floor_div(c - 128, 18));
+    }
+    d->light[0] = EDGEAI_DUNE_LIGHT_X;
+    d->light[1] = EDGEAI_DUNE_LIGHT_Y;
+    d->light[2] = EDGEAI_DUNE_LIGHT_Z;
+    d->light_dynamic = EDGEAI_DUNE_LIGHT_DYNAMIC && (terrain != NULL);
+    return true;
+}
+
+void edgeai_dune_live_set_light(edgeai_dune_live_t *d, int32_t lx, int32_t ly, int32_t lz)
+{
+    if (!d || !d->light_dynamic) return;
+    if (lx == d->light[0] && ly == d->light[1] && lz == d->light[2]) return;
+    d->light[0] = (int16_t)lx;
+    d->light[1] = (int16_t)ly;
+    d->light[2] = (int16_t)lz;
+    /* Every row is stale now; the sweep continues from where it is. */
+    d->light_left = (uint16_t)DUNE_H;
+}
+
+void edgeai_dune_live_light_from_tilt(edgeai_dune_live_t *d, int32_t ax_q15, int32_t ay_q15)
+{
+    /* Tilting toward a side swings the light toward it, as a fixed sun over a moving board would. */
+    int32_t lx = EDGEAI_DUNE_LIGHT_X + ((ax_q15 * EDGEAI_DUNE_LIGHT_TILT) >> 15);
+    int32_t ly = EDGEAI_DUNE_LIGHT_Y + ((ay_q15 * EDGEAI_DUNE_LIGHT_TILT) >> 15);
+    edgeai_dune_live_set_light(d, lx, ly, EDGEAI_DUNE_LIGHT_Z);
+}
+
+uint32_t edgeai_dune_live_relight_rows(edgeai_dune_live_t *d, uint32_t rows)
+{
+    if (!d || !d->light_dynamic || d->light_left == 0u || d->band_y1 > d->band_y0) return 0;
+    uint32_t n = rows;
+    if (n > d->light_left) n = d->light_left;
+    if (n > (uint32_t)DUNE_H - d->light_row) n = (uint32_t)DUNE_H - d->light_row;
+    if (n == 0u) return 0;
+
+    int32_t y0 = (int32_t)d->light_row;
+    dune_shade_dynamic(d, 0, y0, DUNE_W, y0 + (int32_t)n);
+    d->band_y0 = (uint16_t)y0;
+    d->band_y1 = (uint16_t)(y0 + (int32_t)n);
+    d->light_row = (uint16_t)(((uint32_t)y0 + n) % (uint32_t)DUNE_H);
+    d->light_left = (uint16_t)(d->light_left - n);
+    d->light_rows += n;
+    return n;
+}
+
+void edgeai_dune_live_press(edgeai_dune_live_t *d, int32_t x, int32_t y, int32_t r)
+{
+    if (!d || !d->base) return;
+    int32_t rt = (r * EDGEAI_DUNE_FOOT_Q8) >> (8 + EDGEAI_TERRAIN_TEXEL_SHIFT);
+    if (rt < 1) rt = 1;
+    const int32_t cx = x >> EDGEAI_TERRAIN_TEXEL_SHIFT;
+    const int32_t cy = y >> EDGEAI_TERRAIN_TEXEL_SHIFT;
+    const int32_t rt2 = rt * rt;
+    const int32_t k_q16 = (EDGEAI_DUNE_DENT_MAX << 16) / rt2; /* depth per unit of (rt^2 - d^2) */
+
+    int32_t mx0 = DUNE_W, my0 = DUNE_H, mx1 = 0, my1 = 0;
+    for (int32_t ty = edgeai_clamp_i32(cy - rt, 0, DUNE_H); ty <= edgeai_clamp_i32(cy + rt, -1, DUNE_H - 1); ty++)
+    {
+        int32_t dy = ty - cy;
+        for (int32_t tx = edgeai_clamp_i32(cx - rt, 0, DUNE_W); tx <= edgeai_clamp_i32(cx + rt, -1, DUNE_W - 1);
+             tx++)
+        {
+            int32_t dx = tx - cx;
+            int32_t d2 = dx * dx + dy * dy;
+            if (d2 >= rt2) continue;
+
+            /* Parabolic dent: deepest under the center, zero at the patch edge. */
+            uint32_t i = (uint32_t)(ty * DUNE_W + tx);
+            int32_t floor_h = (int32_t)d->base[i] - (((rt2 - d2) * k_q16) >> 16);
+            int32_t cur = d->hmap[i];
+            if (cur <= floor_h) continue;
+            int32_t nh = cur - EDGEAI_DUNE_PRESS_STEP;
+            if (nh < floor_h) nh = floor_h;
+            if (nh < 0) nh = 0;
+            d->hmap[i] = (uint8_t)nh;
+            d->pressed_texels++;
+
+            if (tx < mx0) mx0 = tx;
+            if (ty < my0) my0 = ty;
+            if (tx > mx1) mx1 = tx;
+            if (ty > my1) my1 = ty;
+            uint32_t b = (uint32_t)(ty >> EDGEAI_DUNE_BLOCK_SHIFT) * EDGEAI_DUNE_BLOCK_COLS +
+                         (uint32_t)(tx >> EDGEAI_DUNE_BLOCK_SHIFT);
+            if (!(d->block[b] & kEdgeAiDuneBlockDisplaced))
+            {
+                d->block[b] |= kEdgeAiDuneBlockDisplaced;
+                d->displaced_blocks++;
+            }
+        }
+    }
+    if (mx0 <= mx1) dune_changed(d, mx0, my0, mx1 + 1, my1 + 1);
+}
+
+void edgeai_dune_live_relax(edgeai_dune_live_t *d)
+{
+    if (!d || !d->base) return;
+    /* Each displaced block gets its turn once every RELAX_FRAMES frames, spreading the cost. */
+    const uint32_t phase = d->frame++ % EDGEAI_DUNE_RELAX_FRAMES;
+    for (uint32_t b = phase; b < (uint32_t)EDGEAI_DUNE_BLOCK_COUNT; b += EDGEAI_DUNE_RELAX_FRAMES)
+    {
+        if (!(d->block[b] & kEdgeAiDuneBlockDisplaced)) continue;
+
+        const int32_t bx0 = (int32_t)(b % EDGEAI_DUNE_BLOCK_COLS) << EDGEAI_DUNE_BLOCK_SHIFT;
+        const int32_t by0 = (int32_t)(b / EDGEAI_DUNE_BLOCK_COLS) << EDGEAI_DUNE_BLOCK_SHIFT;
+        const int32_t bx1 = edgeai_clamp_i32(bx0 + EDGEAI_DUNE_BLOCK, 0, DUNE_W);
+        const int32_t by1 = edgeai_clamp_i32(by0 + EDGEAI_DUNE_BLOCK, 0, DUNE_H);
+        bool still = false;
+        bool moved = false;
+        for (int32_t ty = by0; ty < by1; ty++)
+        {
+            uint8_t *row = d->hmap + ty * DUNE_W;
+            const uint8_t *base = d->base + ty * DUNE_W;
+            for (int32_t tx = bx0; tx < bx1; tx++)
+            {
+                if (row[tx] == base[tx]) continue;
+                row[tx] = (uint8_t)(row[tx] + ((row[tx] < base[tx]) ? 1 : -1));
+                d->relaxed_texels++;
+                moved = true;
+                if (row[tx] != base[tx]) still = true;
+            }
+        }
+        if (!still)
+        {
+            d->block[b] &= (uint8_t)~kEdgeAiDuneBlockDisplaced;
+            d->displaced_blocks--;
+        }
+        if (moved) dune_changed(d, bx0, by0, bx1, by1);
+    }
+}
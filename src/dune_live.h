@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "terrain.h"
+
+/* Deformable dune: runtime copy of the heightmap and its shaded texture.
+ * The ball presses a parabolic dent under its contact patch each frame; displaced texels relax back
+ * toward the shipped heightmap by one height unit per EDGEAI_DUNE_RELAX_FRAMES frames. Every change
+ * relights only the texels whose shading reads it (the changed rect grown by one), refreshes the terrain
+ * gradient there, and flags the blocks whose shading changed dirty for the renderer, so the per-frame
+ * cost follows the trail length rather than the map size. Shading is the integer bump shading of
+ * tools/gen_dune_bg.py (shade_from_height), bit-exact with the shipped texture.
+ * RAM: one byte + one RGB565 texel per heightmap texel (~115 KB at 240x160), on top of the terrain
+ * gradient table, which is why it is off by default; check the SRAM total with tools/linkmap_report.py
+ * when turning it on.
+ *
+ * Dynamic lighting (EDGEAI_DUNE_LIGHT_DYNAMIC): the light follows the board tilt instead of the baked
+ * (-24, -40, 96). Normals come from the terrain gradient table, n = (-2 gx, -2 gy, 96), and the kernel is
+ * one N.L per texel plus a per-height base-color palette. A light change restarts a progressive sweep
+ * that relights at most EDGEAI_DUNE_LIGHT_ROWS texel rows per frame and hands them to the renderer as one
+ * band, so the effect costs a fixed slice of the frame and nothing once the sweep has caught up.
+ */
+
+#ifndef EDGEAI_DUNE_LIVE_ENABLE
+#define EDGEAI_DUNE_LIVE_ENABLE 0
+#endif
+
+/* Deepest dent below the shipped height, and depth added per press. */
+#ifndef EDGEAI_DUNE_DENT_MAX
+#define EDGEAI_DUNE_DENT_MAX 24
+#endif
+#ifndef EDGEAI_DUNE_PRESS_STEP
+#define EDGEAI_DUNE_PRESS_STEP 4
+#endif
+
+/* Contact patch radius as a fraction of the ball radius (Q8). */
+#ifndef EDGEAI_DUNE_FOOT_Q8
+#define EDGEAI_DUNE_FOOT_Q8 128
+#endif
+
+/* Frames per one-unit relaxation step of each displaced texel. */
+#ifndef EDGEAI_DUNE_RELAX_FRAMES
+#define EDGEAI_DUNE_RELAX_FRAMES 16u
+#endif
+
+/* Dirty blocks redrawn per frame by the renderer. */
+#ifndef EDGEAI_DUNE_DIRTY_MAX
+#define EDGEAI_DUNE_DIRTY_MAX 24
+#endif
+
+/* Tilt-driven light (needs the terrain gradient); rows relit per frame and light shift per 1 g of tilt. */
+#ifndef EDGEAI_DUNE_LIGHT_DYNAMIC
+#define EDGEAI_DUNE_LIGHT_DYNAMIC 0
+#endif
+#ifndef EDGEAI_DUNE_LIGHT_ROWS
+#define EDGEAI_DUNE_LIGHT_ROWS 8u
+#endif
+#ifndef EDGEAI_DUNE_LIGHT_TILT
+#define EDGEAI_DUNE_LIGHT_TILT 64
+#endif
+
+/* Baked light of tools/gen_dune_bg.py. */
+#define EDGEAI_DUNE_LIGHT_X (-24)
+#define EDGEAI_DUNE_LIGHT_Y (-40)
+#define EDGEAI_DUNE_LIGHT_Z 96
+
+/* Block edge in texels (power of two); blocks carry the dirty/displaced flags. */
+#define EDGEAI_DUNE_BLOCK_SHIFT 3
+#define EDGEAI_DUNE_BLOCK (1 << EDGEAI_DUNE_BLOCK_SHIFT)
+#define EDGEAI_DUNE_BLOCK_COLS ((EDGEAI_TERRAIN_W + EDGEAI_DUNE_BLOCK - 1) / EDGEAI_DUNE_BLOCK)
+#define EDGEAI_DUNE_BLOCK_ROWS ((EDGEAI_TERRAIN_H + EDGEAI_DUNE_BLOCK - 1) / EDGEAI_DUNE_BLOCK)
+#define EDGEAI_DUNE_BLOCK_COUNT (EDGEAI_DUNE_BLOCK_COLS * EDGEAI_DUNE_BLOCK_ROWS)
+
+enum
+{
+    kEdgeAiDuneBlockDirty = 1u << 0,     /* texels relit since the renderer last drew the block */
+    kEdgeAiDuneBlockDisplaced = 1u << 1, /* some texel differs from the shipped height */
+};
+
+typedef struct
+{
+    const uint8_t *base; /* shipped heightmap (relaxation target) */
+    edgeai_terrain_t *terrain;
+    uint8_t hmap[EDGEAI_TERRAIN_W * EDGEAI_TERRAIN_H];
+    uint16_t tex[EDGEAI_TERRAIN_W * EDGEAI_TERRAIN_H];
+    uint8_t block[EDGEAI_DUNE_BLOCK_COUNT];
+    uint32_t frame;
+
+    /* Dynamic lighting. */
+    bool light_dynamic;
+    int16_t light[3];
+    uint8_t palette[256][3]; /* base r, g, b per height */
+    uint16_t light_row;      /* next row of the sweep */
+    uint16_t light_left;     /* rows still lit with an older light */
+    uint16_t band_y0;        /* relit rows [band_y0, band_y1) awaiting the renderer */
+    uint16_t band_y1;
+
+    /* Counters (monotonic) and the current displaced block count. */
+    uint32_t pressed_texels;
+    uint32_t relaxed_texels;
+    uint32_t relit_texels;
+    uint32_t displaced_blocks;
+    uint32_t light_rows;     /* rows relit by the lighting sweep */
+} edgeai_dune_live_t;
+
+/* Copies `base` and its shaded `tex` (both EDGEAI_TERRAIN_W x EDGEAI_TERRAIN_H). `terrain` may be NULL;
+ * otherwise it must be (re)initialized on `d->hmap` and gets its gradient refreshed on every change.
+ */
+bool edgeai_dune_live_init(edgeai_dune_live_t *d, const uint8_t *base, const uint16_t *tex, uint32_t w,
+                           uint32_t h, edgeai_terrain_t *terrain);
+
+/* Presses the contact patch of a ball of radius `r` at LCD point (x, y). */
+void edgeai_dune_live_press(edgeai_dune_live_t *d, int32_t x, int32_t y, int32_t r);
+
+/* Once per frame: relaxes the displaced blocks whose turn it is. */
+void edgeai_dune_live_relax(edgeai_dune_live_t *d);
+
+/* Dynamic lighting: light vector from the soft tilt (Q15 of 1 g). No-op unless `light_dynamic`. */
+void edgeai_dune_live_light_from_tilt(edgeai_dune_live_t *d, int32_t ax_q15, int32_t ay_q15);
+void edgeai_dune_live_set_light(edgeai_dune_live_t *d, int32_t lx, int32_t ly, int32_t lz);
+
+/* Relights up to `rows` rows of the pending sweep into the band; nothing while the previous band is
+ * still undrawn or the sweep has caught up. Returns the rows relit.
+ */
+uint32_t edgeai_dune_live_relight_rows(edgeai_dune_live_t *d, uint32_t rows);
+
+/* Shades texels [x0,x1) x [y0,y1) of `tex` from `hmap` (full map, EDGEAI_TERRAIN_W wide). */
+void edgeai_dune_shade_rect(const uint8_t *hmap, uint16_t *tex, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
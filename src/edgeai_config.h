@@ -75,3 +75,32 @@ static inline int32_t edgeai_ball_r_for_y(int32_t cy)
 /* Render tile limits (single-blit path). */
 #define EDGEAI_TILE_MAX_W 200
 #define EDGEAI_TILE_MAX_H 200
+
+/* Shared scratch region (scratch_arena.h).
+ * - 1: the render tile and the TFLM non-persistent arena share one region, handed off by phase.
+ * - 0: separate static buffers (render tile + full TFLM arena).
+ */
+#ifndef EDGEAI_SCRATCH_SHARED
+#define EDGEAI_SCRATCH_SHARED 1
+#endif
+/* Region size; must cover both the render tile and the model's non-persistent (planned) tensors. */
+#ifndef EDGEAI_SCRATCH_BYTES
+#define EDGEAI_SCRATCH_BYTES (128u * 1024u)
+#endif
+/* TFLM persistent arena (interpreter state, op data) when the region is shared. */
+#ifndef EDGEAI_MODEL_PERSISTENT_BYTES
+#define EDGEAI_MODEL_PERSISTENT_BYTES (24u * 1024u)
+#endif
+
+/* HUD frame-time graph (bottom-left tile).
+ * One column per rendered frame: stacked per-stage bars (input, filter, sim, render, blit, NPU)
+ * plus a label row with the frame total and the graph's own cost from the previous frame.
+ */
+#ifndef EDGEAI_HUD_PERF_GRAPH
+#define EDGEAI_HUD_PERF_GRAPH 0
+#endif
+#ifndef EDGEAI_PERF_GRAPH_US_PER_PX
+#define EDGEAI_PERF_GRAPH_US_PER_PX 500
+#endif
+#define EDGEAI_PERF_GRAPH_W 96
+#define EDGEAI_PERF_GRAPH_H 48
@@ -0,0 +1,84 @@
+#include "edgeai_math.h"
+
+#include "ram_place.h"
+
+EDGEAI_RAMDATA const uint16_t g_edgeai_isqrt_seed[192] = {
+    32896, 33150, 33402, 33652, 33900, 34147, 34392, 34635,
+    34876, 35116, 35354, 35590, 35825, 36059, 36291, 36521,
+    36750, 36978, 37204, 37429, 37652, 37874, 38095, 38315,
+    38533, 38750, 38966, 39181, 39394, 39606, 39818, 40028,
+    40237, 40445, 40652, 40857, 41062, 41266, 41469, 41671,
+    41871, 42071, 42270, 42468, 42665, 42861, 43057, 43251,
+    43445, 43637, 43829, 44020, 44210, 44400, 44588, 44776,
+    44963, 45149, 45334, 45519, 45703, 45886, 46069, 46250,
+    46431, 46612, 46791, 46970, 47149, 47326, 47503, 47679,
+    47855, 48030, 48204, 48378, 48551, 48723, 48895, 49067,
+    49237, 49407, 49577, 49746, 49914, 50082, 50249, 50416,
+    50582, 50747, 50912, 51077, 51241, 51404, 51567, 51730,
+    51892, 52053, 52214, 52374, 52534, 52694, 52853, 53011,
+    53169, 53327, 53484, 53640, 53797, 53952, 54108, 54262,
+    54417, 54571, 54724, 54877, 55030, 55182, 55334, 55485,
+    55636, 55787, 55937, 56087, 56236, 56385, 56534, 56682,
+    56830, 56977, 57124, 57271, 57417, 57563, 57709, 57854,
+    57999, 58143, 58287, 58431, 58574, 58717, 58860, 59002,
+    59144, 59286, 59427, 59568, 59709, 59849, 59989, 60129,
+    60268, 60407, 60546, 60684, 60822, 60960, 61098, 61235,
+    61372, 61508, 61644, 61780, 61916, 62051, 62186, 62321,
+    62456, 62590, 62724, 62857, 62991, 63124, 63256, 63389,
+    63521, 63653, 63785, 63916, 64047, 64178, 64309, 64439,
+    64569, 64699, 64828, 64957, 65086, 65215, 65344, 65472,
+};
+
+/* Sine in Q14 for angles 0..90 degrees in 64 steps. */
+static const int16_t s_sin_q14_quarter[65] = {
+        0,   402,   804,  1205,  1606,  2006,  2404,  2801,
+     3196,  3590,  3981,  4370,  4756,  5139,  5520,  5897,
+     6270,  6639,  7005,  7366,  7723,  8076,  8423,  8765,
+     9102,  9434,  9760, 10080, 10394, 10702, 11003, 11297,
+    11585, 11866, 12140, 12406, 12665, 12916, 13160, 13395,
+    13623, 13842, 14053, 14256, 14449, 14635, 14811, 14978,
+    15137, 15286, 15426, 15557, 15679, 15791, 15893, 15986,
+    16069, 16143, 16207, 16261, 16305, 16340, 16364, 16379,
+    16384,
+};
+
+int32_t edgeai_pow_q14(int32_t x, uint32_t n)
+{
+    int32_t acc = 1 << 14;
+    while (n != 0u)
+    {
+        if (n & 1u) acc = edgeai_mul_q14(acc, x);
+        n >>= 1;
+        if (n != 0u) x = edgeai_mul_q14(x, x);
+    }
+    return acc;
+}
+
+void edgeai_sincos_q14(uint8_t a, int32_t *sin_q14, int32_t *cos_q14)
+{
+    uint32_t quad = (uint32_t)(a >> 6); /* 0..3 */
+    uint32_t off = (uint32_t)(a & 63u);
+    int32_t s = 0;
+    int32_t c = 0;
+    switch (quad)
+    {
+        case 0: /* 0..90 */
+            s = s_sin_q14_quarter[off];
+            c = s_sin_q14_quarter[64u - off];
+            break;
+        case 1: /* 90..180 */
+            s = s_sin_q14_quarter[64u - off];
+            c = -s_sin_q14_quarter[off];
+            break;
+        case 2: /* 180..270 */
+            s = -s_sin_q14_quarter[off];
+            c = -s_sin_q14_quarter[64u - off];
+            break;
+        default: /* 270..360 */
+            s = -s_sin_q14_quarter[64u - off];
+            c = s_sin_q14_quarter[off];
+            break;
+    }
+    *sin_q14 = s;
+    *cos_q14 = c;
+}
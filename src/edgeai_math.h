@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Fixed-point math shared by the renderers and the sim.
+ * - edgeai_isqrt_u32: floor square root, seeded from a 192-entry table on the top bits of the normalized
+ *   argument, one Newton step and an exact fix-up (one divide instead of 16 bit-by-bit iterations).
+ * - edgeai_recip_u32 / edgeai_div_recip_i32: a divide by the same d repeated over many numerators (the
+ *   ball radius per pixel) as one multiply-high each.
+ * - Q14 powers by rounded squaring for the shading terms, and a 256-step sine/cosine table.
+ * tools/edgeai_math_check.c checks each against exact or double-precision references and times them.
+ */
+
+/* isqrt seeds: sqrt((i + 64.5) * 2^24) for the top byte of the argument shifted up by an even count. */
+extern const uint16_t g_edgeai_isqrt_seed[192];
+
+static inline uint32_t edgeai_isqrt_u32(uint32_t x)
+{
+    /* Integer sqrt (floor). */
+    if (x == 0u) return 0u;
+    uint32_t sh = (uint32_t)__builtin_clz(x) & ~1u;
+    uint32_t y = (uint32_t)g_edgeai_isqrt_seed[((x << sh) >> 24) - 64u] >> (sh >> 1);
+    y = (y + x / y) >> 1;
+    if (y > 0xFFFFu) y = 0xFFFFu;
+    while (y * y > x) y--;
+    while (y < 0xFFFFu && (y + 1u) * (y + 1u) <= x) y++;
+    return y;
+}
+
+/* Multiplier for dividing by d in [2, 65535]: ceil(2^32 / d). */
+static inline uint32_t edgeai_recip_u32(uint32_t d)
+{
+    return 0xFFFFFFFFu / d + 1u;
+}
+
+/* n / d truncated toward zero like C division, with m = edgeai_recip_u32(d); exact while |n| * d < 2^32
+ * (Q14 numerators up to a radius of 511).
+ */
+static inline int32_t edgeai_div_recip_i32(int32_t n, uint32_t m)
+{
+    uint32_t a = (uint32_t)((n < 0) ? -n : n);
+    int32_t q = (int32_t)(((uint64_t)a * m) >> 32);
+    return (n < 0) ? -q : q;
+}
+
+/* a * b in Q14, rounded to nearest. */
+static inline int32_t edgeai_mul_q14(int32_t a, int32_t b)
+{
+    return (a * b + (1 << 13)) >> 14;
+}
+
+/* x^5 and x^16 for x in [0, 1] (Q14): three and four rounded products. */
+static inline int32_t edgeai_pow5_q14(int32_t x)
+{
+    int32_t x2 = edgeai_mul_q14(x, x);
+    return edgeai_mul_q14(edgeai_mul_q14(x2, x2), x);
+}
+
+static inline int32_t edgeai_pow16_q14(int32_t x)
+{
+    int32_t x2 = edgeai_mul_q14(x, x);
+    int32_t x4 = edgeai_mul_q14(x2, x2);
+    int32_t x8 = edgeai_mul_q14(x4, x4);
+    return edgeai_mul_q14(x8, x8);
+}
+
+/* x^n for x in [0, 1] (Q14) and any n, by square-and-multiply. */
+int32_t edgeai_pow_q14(int32_t x, uint32_t n);
+
+/* Sine and cosine in Q14 of a: 0..255 maps to 0..2*pi. */
+void edgeai_sincos_q14(uint8_t a, int32_t *sin_q14, int32_t *cos_q14);
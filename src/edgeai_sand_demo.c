@@ -5,14 +5,28 @@
 
 #include "accel4_click.h"
 #include "accel_proc.h"
+#include "ball_grid.h"
 #include "edgeai_config.h"
+#include "edgeai_math.h"
 #include "edgeai_util.h"
+#include "fpu_ab.h"
 #include "fxls8974cf.h"
+#include "latency_hist.h"
+#include "npu/model.h"
 #include "npu_api.h"
+#include "gesture.h"
 #include "par_lcd_s035.h"
+#include "particles.h"
+#include "ram_place.h"
 #include "render_world.h"
+#include "sand_surrogate.h"
+#include "scratch_arena.h"
+#include "sim_record.h"
 #include "sim_world.h"
+#include "sw_render.h"
+#include "telemetry.h"
 #include "text5x7.h"
+#include "water_sim.h"
 
 #include "app.h"
 #include "board.h"
@@ -20,12 +34,18 @@
 #include "fsl_clock.h"
 #include "fsl_debug_console.h"
 #include "fsl_lpi2c.h"
+#include "fsl_lpuart.h"
 #include "pin_mux.h"
 
 #ifndef EDGEAI_I2C
 #define EDGEAI_I2C LPI2C3
 #endif
 
+/* Debug console UART, polled for single-byte commands (text console builds only). */
+#ifndef EDGEAI_CONSOLE_LPUART
+#define EDGEAI_CONSOLE_LPUART ((LPUART_Type *)BOARD_DEBUG_UART_BASEADDR)
+#endif
+
 /* Rendering mode:
  * - 0: "raster/flicker" mode: draw primitives directly to LCD using many small writes
  *      (visually interesting but can show tearing/shutter lines).
@@ -36,6 +56,40 @@
 #define EDGEAI_RENDER_SINGLE_BLIT 1
 #endif
 
+#if EDGEAI_SCENE_CAPTURE_ENABLE
+/* Points scene capture at the active model's input tensor (again after a model switch). */
+static bool edgeai_scene_capture_attach(edgeai_npu_state_t *npu, edgeai_scene_capture_t *cap)
+{
+    edgeai_npu_tensor_view_t tv;
+    bool ok = edgeai_npu_input_view(npu, &tv) &&
+              !edgeai_scratch_overlaps_tile(tv.data, (uint32_t)tv.w * tv.h * tv.c) &&
+              edgeai_scene_capture_bind(cap, &tv);
+    render_world_set_scene_capture(ok ? cap : NULL);
+    return ok;
+}
+#endif
+
+#if EDGEAI_POSTFX_ENABLE
+/* Job-context hook: copy the output tensor into the effect map before the scratch region is released. */
+static void edgeai_postfx_on_npu_result(edgeai_npu_state_t *s, void *user)
+{
+    edgeai_npu_tensor_view_t ov;
+    if (edgeai_npu_output_view(s, &ov)) (void)edgeai_postfx_load((edgeai_postfx_t *)user, &ov);
+}
+#endif
+
+#if EDGEAI_TELEMETRY_ENABLE
+/* Appends one { len u8, name[len] } entry (names truncated to 11 chars). */
+static uint32_t edgeai_tlm_append_name(uint8_t *dst, uint32_t nl, const char *nm)
+{
+    uint32_t len = (uint32_t)strlen(nm);
+    if (len > 11u) len = 11u;
+    dst[nl++] = (uint8_t)len;
+    memcpy(&dst[nl], nm, len);
+    return nl + len;
+}
+#endif
+
 static uint32_t edgeai_i2c_get_freq(void)
 {
     return CLOCK_GetLPFlexCommClkFreq(3u);
@@ -76,6 +130,56 @@ static void dwt_cycle_counter_init(void)
     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 }
 
+#if EDGEAI_FPU_AB_ENABLE || EDGEAI_RAM_PLACE_BENCH
+static uint32_t edgeai_dwt_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+#endif
+
+#if EDGEAI_FPU_AB_ENABLE
+/* Boot-time integer-vs-float A/B (fpu_ab.h) in the render tile, before the renderer owns it. */
+static void edgeai_fpu_ab_report(void)
+{
+    if (!edgeai_scratch_acquire(kEdgeAiScratchOwnerRender)) return;
+    edgeai_fpu_ab_result_t r[kEdgeAiFpuAbCount];
+    bool ok = edgeai_fpu_ab_run(edgeai_dwt_cycles, edgeai_scratch_tile(), EDGEAI_SCRATCH_TILE_BYTES, r);
+    edgeai_scratch_release(kEdgeAiScratchOwnerRender);
+    for (int i = 0; ok && i < kEdgeAiFpuAbCount; i++)
+    {
+        PRINTF("EDGEAI: fpu_ab %s fixed=%u float=%u cyc/call err=%u/%u.%03u %s flips=%u/%u built=%s\r\n", r[i].name,
+               (unsigned)(r[i].fixed_ticks / r[i].calls), (unsigned)(r[i].float_ticks / r[i].calls),
+               (unsigned)r[i].err_max, (unsigned)(r[i].err_mean_milli / 1000u), (unsigned)(r[i].err_mean_milli % 1000u),
+               r[i].err_unit, (unsigned)r[i].flips, (unsigned)r[i].compared, r[i].built_float ? "float" : "fixed");
+    }
+}
+#endif
+
+#if EDGEAI_RAM_PLACE_BENCH
+/* Boot-time cycles of the RAM-placed hot paths (ram_place.h); compare against an EDGEAI_RAM_PLACE_ENABLE=0
+ * build for the flash numbers.
+ */
+static void edgeai_ram_place_report(void)
+{
+    if (!edgeai_scratch_acquire(kEdgeAiScratchOwnerRender)) return;
+    edgeai_ram_place_result_t r[kEdgeAiRamPlaceCount];
+    bool ok = edgeai_ram_place_run(edgeai_dwt_cycles, edgeai_scratch_tile(), EDGEAI_SCRATCH_TILE_BYTES, r);
+    edgeai_scratch_release(kEdgeAiScratchOwnerRender);
+    for (int i = 0; ok && i < kEdgeAiRamPlaceCount; i++)
+    {
+        PRINTF("EDGEAI: ram_place %s cyc/call=%u code=0x%08x %s data=0x%08x %s\r\n", r[i].name,
+               (unsigned)(r[i].ticks / r[i].calls), (unsigned)r[i].code, r[i].code_in_ram ? "ram" : "flash",
+               (unsigned)r[i].data, r[i].data ? (r[i].data_in_ram ? "ram" : "flash") : "-");
+    }
+}
+#endif
+
+static inline uint32_t edgeai_cyc_to_us(uint32_t cyc, uint32_t cps)
+{
+    if (cps == 0u) return 0u;
+    return (uint32_t)(((uint64_t)cyc * 1000000ull) / (uint64_t)cps);
+}
+
 static void edgeai_compute_bang_impulse_q16(const accel_proc_out_t *aout,
                                             int32_t tilt_ax_soft_q15,
                                             int32_t tilt_ay_soft_q15,
@@ -143,16 +247,23 @@ static void edgeai_draw_boot_title_sand_dune(void)
     int32_t x = (EDGEAI_LCD_W - w) / 2;
     int32_t y = (EDGEAI_LCD_H - h) / 2;
 
-    /* Simple 3D look: shadow then face. */
-    const int32_t ox = 4;
-    const int32_t oy = 4;
-    const uint16_t shadow = 0x2104u; /* dark gray */
-    const uint16_t face = 0xFFDEu;   /* warm white */
+    /* Simple 3D look: shadow then face, one strip blit per line. */
+    edgeai_text5x7_style_t st;
+    st.scale = scale;
+    st.fg = 0xFFDEu;            /* warm white */
+    st.bg = 0x0000u;            /* matches the boot fill */
+    st.shadow = true;
+    st.shadow_dx = 4;
+    st.shadow_dy = 4;
+    st.shadow_rgb565 = 0x2104u; /* dark gray */
 
-    edgeai_text5x7_draw_scaled(x + ox, y + oy, scale, l1, shadow);
-    edgeai_text5x7_draw_scaled(x + ox, y + oy + (7 * scale) + (2 * scale), scale, l2, shadow);
-    edgeai_text5x7_draw_scaled(x, y, scale, l1, face);
-    edgeai_text5x7_draw_scaled(x, y + (7 * scale) + (2 * scale), scale, l2, face);
+    /* The render tile is idle at boot and serves as the strip (a whole line fits in one band). */
+    if (!edgeai_scratch_acquire(kEdgeAiScratchOwnerRender)) return;
+    uint16_t *strip = edgeai_scratch_tile();
+    const uint32_t strip_px = EDGEAI_SCRATCH_TILE_BYTES / 2u;
+    edgeai_text5x7_draw(x, y, l1, &st, strip, strip_px);
+    edgeai_text5x7_draw(x, y + (7 * scale) + (2 * scale), l2, &st, strip, strip_px);
+    edgeai_scratch_release(kEdgeAiScratchOwnerRender);
 }
 
 int main(void)
@@ -217,17 +328,93 @@ int main(void)
         PRINTF("EDGEAI: accel ok addr=0x%02x\r\n", (unsigned)dev.addr7);
     }
 
-    edgeai_npu_state_t npu = {0};
+    /* Static: the deferred NPU context keeps a pointer to it. */
+    static edgeai_npu_state_t npu;
     bool npu_ok = edgeai_npu_init(&npu);
+    edgeai_npu_defer_init(&npu);
+    edgeai_scratch_set_release_hook(edgeai_npu_defer_kick);
 
     accel_proc_t accel_proc;
     accel_proc_init(&accel_proc);
+#if EDGEAI_GESTURE_ENABLE
+    static edgeai_gesture_t gesture;
+    edgeai_gesture_init(&gesture);
+#endif
 
     sim_world_t world;
     sim_world_init(&world, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    /* Dune heightmap the background is shaded from; the live copy deforms under the ball, and the
+     * terrain gradient follows whichever copy is in use.
+     */
+    uint32_t hmap_w = 0, hmap_h = 0;
+    const uint8_t *hmap = sw_render_dune_hmap(&hmap_w, &hmap_h);
+    edgeai_terrain_t *terrain_p = NULL;
+#if EDGEAI_TERRAIN_ENABLE
+    static edgeai_terrain_t terrain;
+    terrain_p = &terrain;
+#endif
+#if EDGEAI_DUNE_LIVE_ENABLE
+    static edgeai_dune_live_t dune;
+    uint32_t tex_w = 0, tex_h = 0;
+    const uint16_t *tex = sw_render_dune_tex(&tex_w, &tex_h);
+    bool dune_ok = (tex_w == hmap_w) && (tex_h == hmap_h) &&
+                   edgeai_dune_live_init(&dune, hmap, tex, hmap_w, hmap_h, terrain_p);
+    if (dune_ok) hmap = dune.hmap;
+#endif
+    if (terrain_p && !edgeai_terrain_init(terrain_p, hmap, hmap_w, hmap_h)) terrain_p = NULL;
 
     render_state_t rs;
     render_world_init(&rs, EDGEAI_LCD_W / 2, EDGEAI_LCD_H / 2);
+#if EDGEAI_PARTICLES_ENABLE
+    /* Sand spray on bangs; the cycles it takes (step only) are reported with the stats. */
+    static edgeai_particles_t spray;
+    edgeai_particles_init(&spray, 0x51A7u);
+    render_world_set_particles(&spray);
+    uint32_t spray_cyc = 0;
+#endif
+#if EDGEAI_DUNE_LIVE_ENABLE
+    if (dune_ok) render_world_set_dune(&dune);
+#endif
+
+#if EDGEAI_SAND_ENABLE
+    /* Material grid: a pile along the bottom edge, stepped once per frame from the soft tilt. */
+    static sand_grid_t sand;
+    static edgeai_sand_surrogate_t sand_sur;
+    sand_sim_init(&sand, 0x5A17u);
+    sand_sim_fill_rect(&sand, 0, (EDGEAI_SAND_H * 3) / 4, EDGEAI_SAND_W - 1, EDGEAI_SAND_H - 1, kEdgeAiMatSand);
+#if EDGEAI_SAND_SURROGATE_REFERENCE
+    static uint32_t sand_ref_rng = 0x9E3779B9u;
+    edgeai_sand_surrogate_init(&sand_sur, edgeai_sand_surrogate_run_reference, &sand_ref_rng);
+#else
+    edgeai_sand_surrogate_init(&sand_sur, NULL, NULL);
+#endif
+    render_world_set_sand(&sand);
+#if EDGEAI_BALL_GRID_ENABLE
+    static edgeai_ball_grid_t ball_grid;
+    edgeai_ball_grid_init(&ball_grid);
+#endif
+#if EDGEAI_WATER_ENABLE
+    /* A lake above the pile on the other side; water steps share the grid's active patches. */
+    static edgeai_water_t water;
+    edgeai_water_init(&water, 0x3C6Eu);
+    edgeai_water_fill_rect(&water, &sand, EDGEAI_SAND_W / 2, EDGEAI_SAND_H / 4, EDGEAI_SAND_W - 1,
+                           EDGEAI_SAND_H / 2);
+#endif
+#endif
+
+#if EDGEAI_SCENE_CAPTURE_ENABLE
+    /* The renderer writes a low-res luminance view of the scene straight into the model's input tensor. */
+    static edgeai_scene_capture_t scene_cap;
+    bool scene_cap_ok = edgeai_scene_capture_attach(&npu, &scene_cap);
+    PRINTF("EDGEAI: scene capture %s\r\n", scene_cap_ok ? "on" : "off");
+#endif
+#if EDGEAI_POSTFX_ENABLE
+    static edgeai_postfx_t postfx;
+    edgeai_postfx_init(&postfx, EDGEAI_POSTFX_MODE, EDGEAI_POSTFX_GLOW_RGB565);
+    render_world_set_postfx(&postfx);
+    npu.on_result = edgeai_postfx_on_npu_result;
+    npu.on_result_user = &postfx;
+#endif
 
     fxls8974_sample_t s = {0};
     uint32_t last_cyc = DWT->CYCCNT;
@@ -236,18 +423,37 @@ int main(void)
     uint32_t stats_accum_us = 0;
     uint32_t stats_frames = 0;
     uint32_t fps_last = 0;
+    uint32_t uptime_ms = 0;
+#if EDGEAI_TELEMETRY_ENABLE
+    uint32_t tlm_cost_cyc = 0;
+    uint32_t tlm_windows = 0;
+#endif
 
     /* Per-second timing instrumentation (C4). */
     uint32_t stats_loops = 0;
     uint32_t stats_sim_steps = 0;
-    uint64_t t_input_cyc = 0;
-    uint64_t t_filter_cyc = 0;
-    uint64_t t_sim_cyc = 0;
-    uint64_t t_render_cyc = 0;
-    uint32_t t_input_max_cyc = 0;
-    uint32_t t_filter_max_cyc = 0;
-    uint32_t t_sim_max_cyc = 0;
-    uint32_t t_render_max_cyc = 0;
+
+    /* Per-stage latency histograms, registered once in perf-stage order (ids match kEdgeAiPerfStage*). */
+    static const char *const lat_names[kEdgeAiPerfStageCount] = {
+        "input", "filter", "sim", "render", "blit", "npu",
+    };
+    int lat_id[kEdgeAiPerfStageCount];
+    for (int i = 0; i < (int)kEdgeAiPerfStageCount; i++)
+    {
+        lat_id[i] = edgeai_lhist_register(lat_names[i]);
+    }
+    /* Async NPU: "npu" holds backend run time, "npu_e2e" submit -> result. */
+    int lat_npu_e2e = edgeai_lhist_register("npu_e2e");
+#if EDGEAI_GESTURE_ENABLE
+    /* Cycles per decimated gesture sample (edgeai_gesture_update calls that push one). */
+    int lat_gesture = edgeai_lhist_register("gesture");
+#endif
+
+    /* Per-frame stage cycles for the HUD frame-time graph (reset on every drawn frame). */
+    uint32_t frame_stage_cyc[kEdgeAiPerfStageCount] = {0};
+#if EDGEAI_HUD_PERF_GRAPH
+    uint32_t perf_overlay_cyc = 0;
+#endif
 
     /* Boot banner: keep it short and printf-lite compatible (avoid %ld). */
     PRINTF("EDGEAI: tilt-ball (npu_backend=%c npu_init=%u npu_run=%u render=%s)\r\n",
@@ -255,6 +461,27 @@ int main(void)
            (unsigned)(npu_ok ? 1u : 0u),
            (unsigned)(EDGEAI_ENABLE_NPU_INFERENCE ? 1u : 0u),
            (EDGEAI_RENDER_SINGLE_BLIT ? "blit" : "raster"));
+    if (npu_ok && edgeai_npu_backend() != kEdgeAiNpuBackendStub)
+    {
+        const edgeai_model_switch_stats_t *ms = EDGEAI_MODEL_GetSwitchStats();
+        PRINTF("EDGEAI: models=%u active=%s load=%u cyc\r\n", (unsigned)EDGEAI_MODEL_GetCount(),
+               EDGEAI_MODEL_GetName((uint32_t)EDGEAI_MODEL_GetActive()), (unsigned)ms->load_cyc[0]);
+    }
+
+#if EDGEAI_FPU_AB_ENABLE
+    edgeai_fpu_ab_report();
+#endif
+#if EDGEAI_RAM_PLACE_BENCH
+    edgeai_ram_place_report();
+#endif
+
+#if EDGEAI_TELEMETRY_ENABLE
+    /* From here on, per-second stats leave as binary frames (decode with tools/telemetry_decode.py). */
+    edgeai_tlm_init();
+    bool tlm_ok = edgeai_tlm_uart_init();
+    PRINTF("EDGEAI: telemetry binary stream (uart_dma=%u rec=%u bytes)\r\n",
+           (unsigned)(tlm_ok ? 1u : 0u), (unsigned)sizeof(edgeai_tlm_stats_t));
+#endif
 
     /* Some MCXN947 configurations (or secure setups) can leave DWT->CYCCNT not advancing,
      * which makes dt==0 and "freezes" all motion. Keep a fixed timestep fallback so
@@ -280,6 +507,16 @@ int main(void)
     sim_p.miny = EDGEAI_BALL_R_MAX + 2;
     sim_p.maxx = (EDGEAI_LCD_W - 1) - (EDGEAI_BALL_R_MAX + 2);
     sim_p.maxy = (EDGEAI_LCD_H - 1) - (EDGEAI_BALL_R_MAX + 2);
+    sim_p.terrain = terrain_p;
+    sim_p.terrain_a_px_s2 = EDGEAI_TERRAIN_A_PX_S2;
+
+#if EDGEAI_SIM_REC_ENABLE
+    /* Last seconds of sim inputs + keyframes; 'd' on the console dumps them for tools/sim_replay.c. */
+    static edgeai_sim_rec_t sim_rec;
+    edgeai_sim_rec_init(&sim_rec);
+    uint32_t sim_rec_cyc = 0;
+    uint32_t sim_rec_steps = 0;
+#endif
 
     /* If the loop runs very fast, dt can be too small to hit a sim sub-step every
      * iteration. Hold a pending bang impulse until the next sim_step().
@@ -316,8 +553,8 @@ int main(void)
 
         uint32_t t_input1 = DWT->CYCCNT;
         uint32_t input_dc = t_input1 - t_input0;
-        t_input_cyc += (uint64_t)input_dc;
-        if (input_dc > t_input_max_cyc) t_input_max_cyc = input_dc;
+        edgeai_lhist_record(lat_id[kEdgeAiPerfStageInput], input_dc);
+        frame_stage_cyc[kEdgeAiPerfStageInput] += input_dc;
 
         uint32_t now = DWT->CYCCNT;
         uint32_t dc = now - last_cyc;
@@ -346,14 +583,40 @@ int main(void)
         accel_proc_update(&accel_proc, (int32_t)s.x, (int32_t)s.y, (int32_t)s.z, &aout);
         uint32_t t_filter1 = DWT->CYCCNT;
         uint32_t filter_dc = t_filter1 - t_filter0;
-        t_filter_cyc += (uint64_t)filter_dc;
-        if (filter_dc > t_filter_max_cyc) t_filter_max_cyc = filter_dc;
+        edgeai_lhist_record(lat_id[kEdgeAiPerfStageFilter], filter_dc);
+        frame_stage_cyc[kEdgeAiPerfStageFilter] += filter_dc;
+
+#if EDGEAI_GESTURE_ENABLE
+        {
+            uint32_t g_samples = gesture.samples;
+            uint32_t t_g0 = DWT->CYCCNT;
+            edgeai_gesture_kind_t gk = edgeai_gesture_update(&gesture, &aout, dt_us);
+            if (gesture.samples != g_samples) edgeai_lhist_record(lat_gesture, DWT->CYCCNT - t_g0);
+#if !EDGEAI_TELEMETRY_ENABLE
+            if (gk != kEdgeAiGestureNone)
+            {
+                PRINTF("EDGEAI: gesture %s%s\r\n", edgeai_gesture_name(gk),
+                       (gk == kEdgeAiGestureSwirl) ? ((gesture.swirl_dir > 0) ? " ccw" : " cw") : "");
+            }
+#else
+            (void)gk;
+#endif
+        }
+#endif
 
         if (aout.bang_pulse)
         {
             edgeai_compute_bang_impulse_q16(&aout, aout.ax_soft_q15, aout.ay_soft_q15,
                                             &bang_pending_dvx_q16, &bang_pending_dvy_q16);
             bang_pending = true;
+#if EDGEAI_PARTICLES_ENABLE
+            /* Spray size follows the kick, up to EDGEAI_PARTICLES_PER_BANG at the full bang gain. */
+            int32_t kick = edgeai_abs_i32(bang_pending_dvx_q16) + edgeai_abs_i32(bang_pending_dvy_q16);
+            kick = edgeai_clamp_i32(kick, 0, EDGEAI_BANG_GAIN_Q16);
+            uint32_t n = (uint32_t)(((int64_t)EDGEAI_PARTICLES_PER_BANG * kick) / EDGEAI_BANG_GAIN_Q16);
+            (void)edgeai_particles_burst(&spray, world.ball.x_q16, world.ball.y_q16, bang_pending_dvx_q16,
+                                         bang_pending_dvy_q16, n);
+#endif
         }
 
         int32_t lift_target_q16 = 0;
@@ -416,15 +679,77 @@ int main(void)
                 bang_pending_dvy_q16 = 0;
             }
             stats_sim_steps++;
+            sim_sample_terrain(&world, &sim_p, &sin);
+#if EDGEAI_SIM_REC_ENABLE
+            uint32_t t_rec0 = DWT->CYCCNT;
+            edgeai_sim_rec_step(&sim_rec, &world, &sin);
+            sim_rec_cyc += DWT->CYCCNT - t_rec0;
+            sim_rec_steps++;
+#endif
             sim_step(&world, &sin, &sim_p);
         }
+#if EDGEAI_SAND_ENABLE
+        if (iter > 0)
+        {
+            sand_gravity_t grav = sand_sim_gravity_from_tilt(aout.ax_soft_q15, aout.ay_soft_q15);
+#if EDGEAI_BALL_GRID_ENABLE
+            /* The grid's push back reaches the ball through the next sim step's input, so it is recorded. */
+            int32_t grid_dvx_q16 = 0, grid_dvy_q16 = 0;
+            if (edgeai_ball_grid_step(&ball_grid, &sand, &world.ball, &grid_dvx_q16, &grid_dvy_q16))
+            {
+                bang_pending_dvx_q16 += grid_dvx_q16;
+                bang_pending_dvy_q16 += grid_dvy_q16;
+                bang_pending = true;
+            }
+#endif
+#if EDGEAI_WATER_ENABLE
+            edgeai_water_step(&water, &sand, grav);
+#endif
+            (void)edgeai_sand_surrogate_step(&sand_sur, &sand, grav);
+        }
+#endif
+#if EDGEAI_PARTICLES_ENABLE
+        if (iter > 0)
+        {
+            /* One batch step per frame over the frame's sim time, under the same tilt as the ball. */
+            uint32_t t_spray0 = DWT->CYCCNT;
+            edgeai_particles_step(&spray, sim_step_q16 * iter,
+                                  (int32_t)(((int64_t)aout.ax_soft_q15 * sim_p.a_px_s2) << 1),
+                                  (int32_t)(((int64_t)aout.ay_soft_q15 * sim_p.a_px_s2) << 1));
+            spray_cyc += DWT->CYCCNT - t_spray0;
+        }
+#endif
         uint32_t t_sim1 = DWT->CYCCNT;
         if (iter > 0)
         {
             uint32_t sim_dc = t_sim1 - t_sim0;
-            t_sim_cyc += (uint64_t)sim_dc;
-            if (sim_dc > t_sim_max_cyc) t_sim_max_cyc = sim_dc;
+            edgeai_lhist_record(lat_id[kEdgeAiPerfStageSim], sim_dc);
+            frame_stage_cyc[kEdgeAiPerfStageSim] += sim_dc;
         }
+#if EDGEAI_SIM_REC_ENABLE
+        /* Console command 'd': dump the sim recording (the loop stalls while it prints). */
+        if ((LPUART_GetStatusFlags(EDGEAI_CONSOLE_LPUART) & (uint32_t)kLPUART_RxDataRegFullFlag) != 0u &&
+            LPUART_ReadByte(EDGEAI_CONSOLE_LPUART) == (uint8_t)'d')
+        {
+#if EDGEAI_TELEMETRY_ENABLE
+            /* Drain the queued frames first (up to 100 ms) so the text lands between whole frames; the leading
+             * newline keeps a line reader clear of the binary before it. The recording cost is reported here,
+             * since the binary stats record does not carry it (cycles/step since the last dump).
+             */
+            edgeai_tlm_uart_kick();
+            uint32_t t_wait0 = DWT->CYCCNT;
+            while (!edgeai_tlm_uart_idle() && (DWT->CYCCNT - t_wait0) < cps / 10u)
+            {
+            }
+            PRINTF("\r\nEDGEAI: sim_rec_cost cyc/step=%u steps=%u held=%u\r\n",
+                   (unsigned)(sim_rec_steps ? sim_rec_cyc / sim_rec_steps : 0u), (unsigned)sim_rec_steps,
+                   (unsigned)(sim_rec.head - sim_rec.tail));
+            sim_rec_cyc = 0;
+            sim_rec_steps = 0;
+#endif
+            (void)edgeai_sim_rec_dump(&sim_rec, &sim_p, PRINTF);
+        }
+#endif
 
         bool do_render = (render_accum_us >= render_period_us);
         if (do_render) render_accum_us = 0;
@@ -437,24 +762,90 @@ int main(void)
         hud.npu_backend = edgeai_npu_backend_char();
         if (do_render)
         {
+#if EDGEAI_DUNE_LIVE_ENABLE
+            /* Once per drawn frame, ahead of the draw so relit blocks go out with it; no dent while airborne. */
+            if (dune_ok)
+            {
+                int32_t bx = world.ball.x_q16 >> 16;
+                int32_t by = world.ball.y_q16 >> 16;
+                if ((world.ball.lift_q16 >> 16) <= 2) edgeai_dune_live_press(&dune, bx, by, edgeai_ball_r_for_y(by));
+                edgeai_dune_live_relax(&dune);
+                edgeai_dune_live_light_from_tilt(&dune, aout.ax_soft_q15, aout.ay_soft_q15);
+                (void)edgeai_dune_live_relight_rows(&dune, EDGEAI_DUNE_LIGHT_ROWS);
+            }
+#endif
             uint32_t t_render0 = DWT->CYCCNT;
             bool drew = render_world_draw(&rs, &world, true, &hud);
             uint32_t t_render1 = DWT->CYCCNT;
             uint32_t render_dc = t_render1 - t_render0;
-            t_render_cyc += (uint64_t)render_dc;
-            if (render_dc > t_render_max_cyc) t_render_max_cyc = render_dc;
-            if (drew) stats_frames++;
+
+            /* Split LCD transfer time out of the render stage. */
+            uint32_t blit_dc = par_lcd_s035_take_blit_cycles();
+            if (blit_dc > render_dc) blit_dc = render_dc;
+            edgeai_lhist_record(lat_id[kEdgeAiPerfStageRender], render_dc - blit_dc);
+            edgeai_lhist_record(lat_id[kEdgeAiPerfStageBlit], blit_dc);
+            frame_stage_cyc[kEdgeAiPerfStageRender] += render_dc - blit_dc;
+            frame_stage_cyc[kEdgeAiPerfStageBlit] += blit_dc;
+
+            if (drew)
+            {
+                stats_frames++;
+#if EDGEAI_HUD_PERF_GRAPH
+                render_perf_sample_t ps;
+                for (int i = 0; i < (int)kEdgeAiPerfStageCount; i++)
+                {
+                    ps.stage_us[i] = edgeai_cyc_to_us(frame_stage_cyc[i], cps);
+                }
+                ps.overlay_us = edgeai_cyc_to_us(perf_overlay_cyc, cps);
+
+                uint32_t t_ov0 = DWT->CYCCNT;
+                render_world_draw_perf_graph(&ps);
+                (void)par_lcd_s035_take_blit_cycles();
+                perf_overlay_cyc = DWT->CYCCNT - t_ov0;
+#endif
+                for (int i = 0; i < (int)kEdgeAiPerfStageCount; i++) frame_stage_cyc[i] = 0;
+            }
         }
 
-        if (npu_accum_us >= 200000u)
+        /* Async NPU: submit on cadence, pick up results whenever they land; the loop never waits on Invoke.
+         * With the deferred IRQ, run time is also charged to whichever stage it preempted.
+         */
+        bool npu_due = (npu_accum_us >= 200000u);
+#if EDGEAI_SCENE_CAPTURE_ENABLE
+        /* With capture on, a job is submitted only once a full image is in the tensor. */
+        if (scene_cap_ok && !edgeai_scene_capture_ready(&scene_cap)) npu_due = false;
+#endif
+        if (npu_due)
         {
             npu_accum_us = 0;
             edgeai_npu_input_t nin;
             nin.vx_q16 = world.ball.vx_q16;
             nin.vy_q16 = world.ball.vy_q16;
+            nin.tensor_ready = false;
+#if EDGEAI_SCENE_CAPTURE_ENABLE
+            nin.tensor_ready = scene_cap_ok;
+#endif
+            bool submitted = edgeai_npu_submit(&npu, &nin);
+#if EDGEAI_SCENE_CAPTURE_ENABLE
+            if (submitted && scene_cap_ok) edgeai_scene_capture_hold(&scene_cap);
+#else
+            (void)submitted;
+#endif
+        }
+#if EDGEAI_SCENE_CAPTURE_ENABLE
+        if (scene_cap_ok && scene_cap.phase == kEdgeAiSceneCapHeld && edgeai_npu_idle(&npu))
+        {
+            edgeai_scene_capture_restart(&scene_cap);
+        }
+#endif
+        {
             edgeai_npu_output_t nout;
-            if (edgeai_npu_step(&npu, &nin, &nout))
+            if (edgeai_npu_poll(&npu, &nout))
             {
+                uint32_t npu_dc = npu.last_run_cyc;
+                frame_stage_cyc[kEdgeAiPerfStageNpu] += npu_dc;
+                edgeai_lhist_record(lat_id[kEdgeAiPerfStageNpu], npu_dc);
+                edgeai_lhist_record(lat_npu_e2e, npu.last_latency_cyc);
                 world.ball.glint = nout.glint;
             }
         }
@@ -463,11 +854,113 @@ int main(void)
         {
             uint32_t fps = stats_frames;
             fps_last = fps;
+            uptime_ms += stats_accum_us / 1000u;
             stats_accum_us = 0;
             stats_frames = 0;
             int32_t cx = world.ball.x_q16 >> 16;
             int32_t cy = world.ball.y_q16 >> 16;
             int32_t lift_px = world.ball.lift_q16 >> 16;
+
+            uint32_t cps_timing = SystemCoreClock ? SystemCoreClock : 150000000u;
+            int lat_n = edgeai_lhist_stage_count();
+            if (lat_n > EDGEAI_TLM_LATENCY_MAX_STAGES) lat_n = EDGEAI_TLM_LATENCY_MAX_STAGES;
+
+#if EDGEAI_TELEMETRY_ENABLE
+            /* Binary record instead of two formatted lines; the UART DMA drains it in the background. */
+            uint32_t t_tlm0 = DWT->CYCCNT;
+            edgeai_tlm_stats_t rec;
+            rec.version = EDGEAI_TLM_VERSION;
+            rec.flags = (uint8_t)(((accel_fail > 0u) ? EDGEAI_TLM_FLAG_ACCEL_FAIL : 0u) |
+                                  (npu_ok ? EDGEAI_TLM_FLAG_NPU_OK : 0u));
+            rec.fps = (uint16_t)fps;
+            rec.uptime_ms = uptime_ms;
+            rec.loops = stats_loops;
+            rec.sim_steps = stats_sim_steps;
+            rec.raw[0] = s.x;
+            rec.raw[1] = s.y;
+            rec.raw[2] = s.z;
+            rec.lp[0] = (int16_t)aout.ax_lp;
+            rec.lp[1] = (int16_t)aout.ay_lp;
+            rec.lp[2] = (int16_t)aout.az_lp;
+            rec.hp[0] = (int16_t)edgeai_clamp_i32_sym(aout.ax_hp, 32767);
+            rec.hp[1] = (int16_t)edgeai_clamp_i32_sym(aout.ay_hp, 32767);
+            rec.hp[2] = (int16_t)edgeai_clamp_i32_sym(aout.az_hp, 32767);
+            rec.g_mag = (int16_t)edgeai_clamp_i32_sym(g_mag, 32767);
+            rec.g_hp = (int16_t)edgeai_clamp_i32_sym(g_hp, 32767);
+            rec.bang_score = (int16_t)edgeai_clamp_i32_sym(aout.bang_score, 32767);
+            rec.pos[0] = (int16_t)cx;
+            rec.pos[1] = (int16_t)cy;
+            rec.lift_px = (int16_t)lift_px;
+            rec.vel[0] = (int16_t)edgeai_clamp_i32_sym(world.ball.vx_q16 >> 16, 32767);
+            rec.vel[1] = (int16_t)edgeai_clamp_i32_sym(world.ball.vy_q16 >> 16, 32767);
+            rec.glint = world.ball.glint;
+            rec.reserved = 0;
+            rec.tlm_cost_cyc = tlm_cost_cyc;
+            rec.tlm_dropped = edgeai_tlm_dropped();
+            rec.npu_submitted = npu.submitted;
+            rec.npu_completed = npu.completed;
+            rec.npu_dropped = edgeai_npu_dropped(&npu);
+            rec.npu_skipped = npu.skipped;
+            rec.npu_deferred = npu.deferred;
+            rec.npu_failed = npu.failed;
+            (void)edgeai_tlm_write((uint8_t)kEdgeAiTlmRecordStats, &rec, (uint8_t)sizeof(rec));
+
+            edgeai_tlm_latency_t lat;
+            lat.version = EDGEAI_TLM_VERSION;
+            lat.stage_count = (uint8_t)lat_n;
+            lat.core_mhz = (uint16_t)(cps_timing / 1000000u);
+            lat.uptime_ms = uptime_ms;
+            for (int i = 0; i < lat_n; i++)
+            {
+                edgeai_lhist_summary_t sum;
+                (void)edgeai_lhist_summary(i, &sum);
+                lat.stage[i].count = sum.count;
+                lat.stage[i].p50_cyc = sum.p50;
+                lat.stage[i].p95_cyc = sum.p95;
+                lat.stage[i].p99_cyc = sum.p99;
+                lat.stage[i].max_cyc = sum.max;
+            }
+            uint32_t lat_len = 8u + (uint32_t)lat_n * (uint32_t)sizeof(edgeai_tlm_latency_stage_t);
+            (void)edgeai_tlm_write((uint8_t)kEdgeAiTlmRecordLatency, &lat, (uint8_t)lat_len);
+
+            /* Stage names let the decoder label columns; resend periodically for late attach. */
+            if ((tlm_windows++ % 10u) == 0u)
+            {
+                uint8_t names[EDGEAI_TLM_OP_MAX * 12];
+                uint32_t nl = 0;
+                for (int i = 0; i < lat_n; i++) nl = edgeai_tlm_append_name(names, nl, edgeai_lhist_name(i));
+                (void)edgeai_tlm_write((uint8_t)kEdgeAiTlmRecordStageNames, names, (uint8_t)nl);
+
+                /* Model per-op profile (cumulative) on the same cadence. */
+                const edgeai_model_profile_t *mp = EDGEAI_MODEL_GetProfile();
+                if (mp->invokes > 0u)
+                {
+                    uint32_t op_n = mp->op_count;
+                    if (op_n > EDGEAI_TLM_OP_MAX) op_n = EDGEAI_TLM_OP_MAX;
+                    edgeai_tlm_op_profile_t opr;
+                    opr.version = EDGEAI_TLM_VERSION;
+                    opr.op_count = (uint8_t)op_n;
+                    opr.core_mhz = (uint16_t)(cps_timing / 1000000u);
+                    opr.invokes = mp->invokes;
+                    opr.arena_used = mp->arena_used_bytes;
+                    opr.arena_size = mp->arena_size_bytes;
+                    nl = 0;
+                    for (uint32_t i = 0; i < op_n; i++)
+                    {
+                        const edgeai_model_op_prof_t *op = &mp->op[i];
+                        opr.op[i].avg_cyc = op->count ? (uint32_t)(op->total_cyc / op->count) : 0u;
+                        opr.op[i].max_cyc = op->max_cyc;
+                        opr.op[i].last_cyc = op->last_cyc;
+                        nl = edgeai_tlm_append_name(names, nl, op->tag ? op->tag : "?");
+                    }
+                    uint32_t opr_len = 16u + op_n * (uint32_t)sizeof(edgeai_tlm_op_t);
+                    (void)edgeai_tlm_write((uint8_t)kEdgeAiTlmRecordOpNames, names, (uint8_t)nl);
+                    (void)edgeai_tlm_write((uint8_t)kEdgeAiTlmRecordOpProfile, &opr, (uint8_t)opr_len);
+                }
+            }
+            edgeai_tlm_uart_kick();
+            tlm_cost_cyc = DWT->CYCCNT - t_tlm0;
+#else
             PRINTF("EDGEAI: fps=%u raw=(%d,%d,%d) lp=(%d,%d,%d) hp=(%d,%d,%d) gmag=%d ghp=%d bang=%d pos=(%d,%d) lift=%d v=(%d,%d) glint=%u npu=%u\r\n",
                    (unsigned)fps,
                    (int)s.x, (int)s.y, (int)s.z,
@@ -482,37 +975,92 @@ int main(void)
                    (unsigned)world.ball.glint,
                    (unsigned)(npu_ok ? 1u : 0u));
 
-            uint32_t cps_timing = SystemCoreClock ? SystemCoreClock : 150000000u;
-            uint64_t input_us_total = (t_input_cyc * 1000000ull) / (uint64_t)cps_timing;
-            uint64_t filter_us_total = (t_filter_cyc * 1000000ull) / (uint64_t)cps_timing;
-            uint64_t sim_us_total = (t_sim_cyc * 1000000ull) / (uint64_t)cps_timing;
-            uint64_t render_us_total = (t_render_cyc * 1000000ull) / (uint64_t)cps_timing;
-
-            uint32_t input_us_avg = stats_loops ? (uint32_t)(input_us_total / (uint64_t)stats_loops) : 0u;
-            uint32_t filter_us_avg = stats_loops ? (uint32_t)(filter_us_total / (uint64_t)stats_loops) : 0u;
-            uint32_t sim_us_avg = stats_sim_steps ? (uint32_t)(sim_us_total / (uint64_t)stats_sim_steps) : 0u;
-            uint32_t render_us_avg = fps ? (uint32_t)(render_us_total / (uint64_t)fps) : 0u;
-
-            uint32_t input_us_max = (uint32_t)(((uint64_t)t_input_max_cyc * 1000000ull) / (uint64_t)cps_timing);
-            uint32_t filter_us_max = (uint32_t)(((uint64_t)t_filter_max_cyc * 1000000ull) / (uint64_t)cps_timing);
-            uint32_t sim_us_max = (uint32_t)(((uint64_t)t_sim_max_cyc * 1000000ull) / (uint64_t)cps_timing);
-            uint32_t render_us_max = (uint32_t)(((uint64_t)t_render_max_cyc * 1000000ull) / (uint64_t)cps_timing);
-
-            PRINTF("EDGEAI: timing avg_us(in=%u filt=%u sim_step=%u render=%u) max_us(in=%u filt=%u sim=%u render=%u) loops=%u sim_steps=%u\r\n",
-                   (unsigned)input_us_avg, (unsigned)filter_us_avg, (unsigned)sim_us_avg, (unsigned)render_us_avg,
-                   (unsigned)input_us_max, (unsigned)filter_us_max, (unsigned)sim_us_max, (unsigned)render_us_max,
-                   (unsigned)stats_loops, (unsigned)stats_sim_steps);
+            PRINTF("EDGEAI: timing p50/p95/p99/max_us");
+            for (int i = 0; i < lat_n; i++)
+            {
+                edgeai_lhist_summary_t sum;
+                (void)edgeai_lhist_summary(i, &sum);
+                PRINTF(" %s=%u/%u/%u/%u", edgeai_lhist_name(i),
+                       (unsigned)edgeai_cyc_to_us(sum.p50, cps_timing),
+                       (unsigned)edgeai_cyc_to_us(sum.p95, cps_timing),
+                       (unsigned)edgeai_cyc_to_us(sum.p99, cps_timing),
+                       (unsigned)edgeai_cyc_to_us(sum.max, cps_timing));
+            }
+            PRINTF(" loops=%u sim_steps=%u npu_jobs=%u/%u drop=%u skip=%u defer=%u fail=%u", (unsigned)stats_loops,
+                   (unsigned)stats_sim_steps, (unsigned)npu.completed, (unsigned)npu.submitted,
+                   (unsigned)edgeai_npu_dropped(&npu), (unsigned)npu.skipped, (unsigned)npu.deferred,
+                   (unsigned)npu.failed);
+#if EDGEAI_GESTURE_ENABLE
+            PRINTF(" gestures=%u/%u/%u", (unsigned)gesture.detected[kEdgeAiGestureTap],
+                   (unsigned)gesture.detected[kEdgeAiGestureShake], (unsigned)gesture.detected[kEdgeAiGestureSwirl]);
+#endif
+#if EDGEAI_SAND_ENABLE
+            PRINTF(" sand=%u/%u/%u", (unsigned)sand_sur.batches, (unsigned)sand_sur.fallback_steps,
+                   (unsigned)sand.cells_scanned);
+#if EDGEAI_BALL_GRID_ENABLE
+            PRINTF(" ballg=%u/%u/%u", (unsigned)ball_grid.cells, (unsigned)ball_grid.moved,
+                   (unsigned)ball_grid.blocked);
+#endif
+#if EDGEAI_WATER_ENABLE
+            PRINTF(" water=%u/%u", (unsigned)water.moves, (unsigned)water.cells_scanned);
+#endif
+#endif
+#if EDGEAI_PARTICLES_ENABLE
+            /* Spray: live, spawned/dropped (monotonic), step cycles over the window. */
+            PRINTF(" spray=%u/%u/%u/%u", (unsigned)spray.live_n, (unsigned)spray.spawned, (unsigned)spray.dropped,
+                   (unsigned)spray_cyc);
+            spray_cyc = 0;
+#endif
+#if EDGEAI_DUNE_LIVE_ENABLE
+            PRINTF(" dune=%u/%u", (unsigned)dune.relit_texels, (unsigned)dune.displaced_blocks);
+#endif
+#if EDGEAI_SIM_REC_ENABLE
+            /* Recording cost (cycles/step over the window) and bytes held. */
+            PRINTF(" rec=%u/%u", (unsigned)(sim_rec_steps ? sim_rec_cyc / sim_rec_steps : 0u),
+                   (unsigned)(sim_rec.head - sim_rec.tail));
+            sim_rec_cyc = 0;
+            sim_rec_steps = 0;
+#endif
+            PRINTF("\r\n");
+            if ((uptime_ms / 1000u) % 10u == 0u && EDGEAI_MODEL_GetProfile()->invokes > 0u)
+            {
+                EDGEAI_MODEL_PrintProfile(PRINTF);
+            }
+#if EDGEAI_NPU_RECORD
+            /* Host regression input for tools/npu_host_check.cpp. */
+            (void)edgeai_npu_record_print(&npu, PRINTF);
+#endif
+#endif
+#if EDGEAI_NPU_MODEL_CYCLE_S
+            /* Hot switch between jobs; the first visit of a model pays its allocation, later ones a pointer swap. */
+            if ((uptime_ms / 1000u) % EDGEAI_NPU_MODEL_CYCLE_S == 0u && edgeai_npu_model_count() > 1u &&
+                edgeai_npu_idle(&npu))
+            {
+                /* Entries without a flatbuffer fail to select and are skipped. */
+                uint32_t n = edgeai_npu_model_count();
+                uint32_t cur = (uint32_t)EDGEAI_MODEL_GetActive();
+                uint32_t next = cur;
+                for (uint32_t k = 1u; k < n && next == cur; k++)
+                {
+                    if (edgeai_npu_select_model(&npu, (cur + k) % n)) next = (cur + k) % n;
+                }
+                if (next != cur)
+                {
+#if EDGEAI_SCENE_CAPTURE_ENABLE
+                    scene_cap_ok = edgeai_scene_capture_attach(&npu, &scene_cap);
+#endif
+#if !EDGEAI_TELEMETRY_ENABLE
+                    const edgeai_model_switch_stats_t *ms = EDGEAI_MODEL_GetSwitchStats();
+                    PRINTF("EDGEAI: model -> %s switch=%u cyc max=%u load=%u cyc\r\n", EDGEAI_MODEL_GetName(next),
+                           (unsigned)ms->last_switch_cyc, (unsigned)ms->max_switch_cyc, (unsigned)ms->load_cyc[next]);
+#endif
+                }
+            }
+#endif
 
             stats_loops = 0;
             stats_sim_steps = 0;
-            t_input_cyc = 0;
-            t_filter_cyc = 0;
-            t_sim_cyc = 0;
-            t_render_cyc = 0;
-            t_input_max_cyc = 0;
-            t_filter_max_cyc = 0;
-            t_sim_max_cyc = 0;
-            t_render_max_cyc = 0;
+            edgeai_lhist_reset_window();
         }
     }
 }
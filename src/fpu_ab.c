@@ -0,0 +1,218 @@
+#include "fpu_ab.h"
+
+#include <string.h>
+
+#include "accel_proc.h"
+#include "edgeai_config.h"
+#include "edgeai_util.h"
+#include "sim_world.h"
+#include "sw_render.h"
+
+#define FPU_AB_BALL_D (2 * EDGEAI_BALL_R_MAX + 1)
+
+_Static_assert(3u * sizeof(int32_t) <= 32u && sizeof(sim_input_t) <= 32u, "fpu_ab inputs exceed 32 bytes per step");
+_Static_assert(2u * FPU_AB_BALL_D * FPU_AB_BALL_D * sizeof(uint16_t) <= EDGEAI_FPU_AB_SCRATCH_BYTES,
+               "fpu_ab scratch smaller than two ball frames");
+
+/* Spin angles for the shaded frames (sin, cos in Q14, 45 degree steps). */
+static const int16_t s_spin_q14[8][2] = {
+    {0, 16384}, {11585, 11585}, {16384, 0}, {11585, -11585},
+    {0, -16384}, {-11585, -11585}, {-16384, 0}, {-11585, 11585},
+};
+
+static inline uint32_t fpu_ab_lcg(uint32_t *s)
+{
+    *s = *s * 1664525u + 1013904223u;
+    return *s;
+}
+
+/* Triangle wave over [-amp, amp] with the given period (steps). */
+static int32_t fpu_ab_tri(uint32_t i, uint32_t period, int32_t amp)
+{
+    int32_t ph = (int32_t)(i % period);
+    int32_t half = (int32_t)period / 2;
+    int32_t v = (ph < half) ? ph : (int32_t)period - ph;
+    return (v * 4 * amp) / (int32_t)period - amp;
+}
+
+static void fpu_ab_err(edgeai_fpu_ab_result_t *r, uint64_t *sum, int32_t e)
+{
+    uint32_t a = (uint32_t)edgeai_abs_i32(e);
+    if (a > r->err_max) r->err_max = a;
+    *sum += a;
+}
+
+static void fpu_ab_mean(edgeai_fpu_ab_result_t *r, uint64_t sum, uint32_t n)
+{
+    r->err_mean_milli = n ? (uint32_t)((sum * 1000u) / n) : 0u;
+}
+
+/* Raw samples: both axes sweep past 1g and back with sensor noise, z sits at 1g with an impact spike
+ * every so often.
+ */
+static void fpu_ab_accel(edgeai_fpu_ab_clock_fn_t clock, int32_t *raw, edgeai_fpu_ab_result_t *r)
+{
+    const uint32_t n = EDGEAI_FPU_AB_STEPS;
+    uint32_t rng = 0xACC3u;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t noise = fpu_ab_lcg(&rng);
+        raw[3 * i + 0] = fpu_ab_tri(i, 300u, EDGEAI_ACCEL_MAP_DENOM * 3 / 2) + (int32_t)(noise & 31u) - 16;
+        raw[3 * i + 1] = fpu_ab_tri(i + 70u, 190u, EDGEAI_ACCEL_MAP_DENOM) + (int32_t)((noise >> 5) & 31u) - 16;
+        raw[3 * i + 2] = EDGEAI_ACCEL_MAP_DENOM + (((i % 97u) == 0u) ? 700 : 0) + (int32_t)((noise >> 10) & 31u) - 16;
+    }
+
+    accel_proc_t s;
+    accel_proc_out_t o, of;
+    accel_proc_init(&s);
+    uint32_t t0 = clock();
+    for (uint32_t i = 0; i < n; i++) accel_proc_update_fixed(&s, raw[3 * i], raw[3 * i + 1], raw[3 * i + 2], &o);
+    r->fixed_ticks = clock() - t0;
+    accel_proc_init(&s);
+    t0 = clock();
+    for (uint32_t i = 0; i < n; i++) accel_proc_update_float(&s, raw[3 * i], raw[3 * i + 1], raw[3 * i + 2], &o);
+    r->float_ticks = clock() - t0;
+
+    /* The filter state is integer in both, so one pass can feed both curves the same deadzoned tilt. */
+    accel_proc_t sf;
+    accel_proc_init(&s);
+    accel_proc_init(&sf);
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        accel_proc_update_fixed(&s, raw[3 * i], raw[3 * i + 1], raw[3 * i + 2], &o);
+        accel_proc_update_float(&sf, raw[3 * i], raw[3 * i + 1], raw[3 * i + 2], &of);
+        fpu_ab_err(r, &sum, of.ax_soft_q15 - o.ax_soft_q15);
+        fpu_ab_err(r, &sum, of.ay_soft_q15 - o.ay_soft_q15);
+        if (o.bang_pulse != of.bang_pulse) r->flips++;
+    }
+    r->name = "accel";
+    r->err_unit = "q15";
+    r->calls = n;
+    r->compared = 2u * n;
+    fpu_ab_mean(r, sum, 2u * n);
+    r->built_float = EDGEAI_ACCEL_FLOAT;
+}
+
+/* The demo's parameters on a flat board; the slope input stands in for the terrain. */
+static void fpu_ab_sim_params(sim_params_t *p)
+{
+    memset(p, 0, sizeof(*p));
+    p->sim_step_q16 = (int32_t)((1u << 16) / 120u);
+    p->a_px_s2 = 3780;
+    p->damp_q16 = 65000;
+    p->minx = EDGEAI_BALL_R_MAX + 2;
+    p->miny = EDGEAI_BALL_R_MAX + 2;
+    p->maxx = (EDGEAI_LCD_W - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p->maxy = (EDGEAI_LCD_H - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p->terrain_a_px_s2 = EDGEAI_TERRAIN_A_PX_S2;
+}
+
+static void fpu_ab_sim(edgeai_fpu_ab_clock_fn_t clock, sim_input_t *in, edgeai_fpu_ab_result_t *r)
+{
+    const uint32_t n = EDGEAI_FPU_AB_STEPS;
+    uint32_t rng = 0x51D3u;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        memset(&in[i], 0, sizeof(in[i]));
+        in[i].ax_soft_q15 = fpu_ab_tri(i, 400u, 24000);
+        in[i].ay_soft_q15 = fpu_ab_tri(i + 90u, 260u, 20000);
+        in[i].slope_x_q8 = fpu_ab_tri(i, 150u, 96);
+        in[i].slope_y_q8 = fpu_ab_tri(i + 40u, 110u, 96);
+        if ((i % 60u) == 0u)
+        {
+            uint32_t k = fpu_ab_lcg(&rng);
+            in[i].bang_dvx_q16 = (int32_t)((k >> 16) % (2u * 250u)) * 65536 - EDGEAI_BANG_GAIN_Q16;
+            in[i].bang_dvy_q16 = (int32_t)((k & 0xFFFFu) % (2u * 250u)) * 65536 - EDGEAI_BANG_GAIN_Q16;
+        }
+        in[i].lift_target_q16 = ((i / 200u) & 1u) ? (8 << 16) : 0;
+    }
+
+    sim_params_t p;
+    fpu_ab_sim_params(&p);
+    sim_world_t w;
+    sim_world_init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    uint32_t t0 = clock();
+    for (uint32_t i = 0; i < n; i++) sim_step_fixed(&w, &in[i], &p);
+    r->fixed_ticks = clock() - t0;
+    sim_world_init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    t0 = clock();
+    for (uint32_t i = 0; i < n; i++) sim_step_float(&w, &in[i], &p);
+    r->float_ticks = clock() - t0;
+
+    /* Trajectories part ways after the first bounce that rounds differently, so each float step starts
+     * from the integer state and only that step's error is measured.
+     */
+    sim_world_t wf;
+    sim_world_init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        wf = w;
+        sim_step_fixed(&w, &in[i], &p);
+        sim_step_float(&wf, &in[i], &p);
+        fpu_ab_err(r, &sum, wf.ball.x_q16 - w.ball.x_q16);
+        fpu_ab_err(r, &sum, wf.ball.y_q16 - w.ball.y_q16);
+        if (wf.bounces != w.bounces) r->flips++;
+    }
+    r->name = "sim";
+    r->err_unit = "q16";
+    r->calls = n;
+    r->compared = 2u * n;
+    fpu_ab_mean(r, sum, 2u * n);
+    r->built_float = EDGEAI_SIM_FLOAT;
+}
+
+static void fpu_ab_shade(edgeai_fpu_ab_clock_fn_t clock, uint16_t *a, edgeai_fpu_ab_result_t *r)
+{
+    const int32_t d = FPU_AB_BALL_D;
+    const int32_t c = EDGEAI_BALL_R_MAX;
+    uint16_t *b = a + d * d;
+    uint64_t sum = 0;
+    for (uint32_t f = 0; f < EDGEAI_FPU_AB_FRAMES; f++)
+    {
+        uint32_t phase = f * 157u;
+        uint8_t glint = (uint8_t)((f * 255u) / (EDGEAI_FPU_AB_FRAMES - 1u));
+        int32_t ss = s_spin_q14[f & 7u][0];
+        int32_t cs = s_spin_q14[f & 7u][1];
+        memset(a, 0, (size_t)d * (size_t)d * sizeof(uint16_t));
+        memset(b, 0, (size_t)d * (size_t)d * sizeof(uint16_t));
+        uint32_t t0 = clock();
+        sw_render_silver_ball_fixed(a, (uint32_t)d, (uint32_t)d, 0, 0, c, c, c, phase, glint, ss, cs);
+        uint32_t t1 = clock();
+        sw_render_silver_ball_float(b, (uint32_t)d, (uint32_t)d, 0, 0, c, c, c, phase, glint, ss, cs);
+        uint32_t t2 = clock();
+        r->fixed_ticks += t1 - t0;
+        r->float_ticks += t2 - t1;
+
+        for (int32_t i = 0; i < d * d; i++)
+        {
+            if (a[i] == 0u && b[i] == 0u) continue;
+            int32_t dr = (int32_t)(b[i] >> 11) - (int32_t)(a[i] >> 11);
+            int32_t dg = (int32_t)((b[i] >> 5) & 63u) - (int32_t)((a[i] >> 5) & 63u);
+            int32_t db = (int32_t)(b[i] & 31u) - (int32_t)(a[i] & 31u);
+            int32_t e = edgeai_abs_i32(dr);
+            if (edgeai_abs_i32(dg) > e) e = edgeai_abs_i32(dg);
+            if (edgeai_abs_i32(db) > e) e = edgeai_abs_i32(db);
+            fpu_ab_err(r, &sum, e);
+            if (a[i] != b[i]) r->flips++;
+            r->compared++;
+        }
+    }
+    r->name = "shade";
+    r->err_unit = "rgb565";
+    r->calls = EDGEAI_FPU_AB_FRAMES;
+    fpu_ab_mean(r, sum, r->compared);
+    r->built_float = EDGEAI_BALL_SHADE_FLOAT;
+}
+
+bool edgeai_fpu_ab_run(edgeai_fpu_ab_clock_fn_t clock, void *scratch, uint32_t scratch_bytes,
+                       edgeai_fpu_ab_result_t out[kEdgeAiFpuAbCount])
+{
+    if (!clock || !scratch || !out || scratch_bytes < EDGEAI_FPU_AB_SCRATCH_BYTES) return false;
+    memset(out, 0, sizeof(out[0]) * kEdgeAiFpuAbCount);
+    fpu_ab_accel(clock, (int32_t *)scratch, &out[kEdgeAiFpuAbAccel]);
+    fpu_ab_sim(clock, (sim_input_t *)scratch, &out[kEdgeAiFpuAbSim]);
+    fpu_ab_shade(clock, (uint16_t *)scratch, &out[kEdgeAiFpuAbShade]);
+    return true;
+}
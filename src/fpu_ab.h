@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* A/B of the integer and single-precision float variants of accel_proc_update, sim_step and the ball
+ * shader (EDGEAI_ACCEL_FLOAT, EDGEAI_SIM_FLOAT, EDGEAI_BALL_SHADE_FLOAT).
+ * Both variants of each function run on the same synthetic inputs; cost comes from a caller clock (DWT
+ * cycles on target, ns on host) and the error is the float output against the integer one:
+ * - accel: soft response over a tilt sweep with noise and impacts (Q15 LSB); flips: bang pulses that differ.
+ * - sim: one step from the same state, tilt and slope sweeps with bangs (ball position, Q16 LSB);
+ *   flips: steps whose bounce count differs.
+ * - shade: the largest ball over a range of phases, glints and spins (largest rgb565 channel step);
+ *   flips: pixels that differ.
+ * Pure C with no SDK dependencies, so the same module builds for target and host.
+ */
+
+#ifndef EDGEAI_FPU_AB_ENABLE
+#define EDGEAI_FPU_AB_ENABLE 0
+#endif
+
+/* Calls per variant for accel and sim. */
+#ifndef EDGEAI_FPU_AB_STEPS
+#define EDGEAI_FPU_AB_STEPS 1024u
+#endif
+
+/* Shaded frames per variant. */
+#ifndef EDGEAI_FPU_AB_FRAMES
+#define EDGEAI_FPU_AB_FRAMES 16u
+#endif
+
+/* Caller scratch for the pregenerated inputs and the two shaded frames. */
+#define EDGEAI_FPU_AB_SCRATCH_BYTES ((uint32_t)EDGEAI_FPU_AB_STEPS * 32u)
+
+typedef enum
+{
+    kEdgeAiFpuAbAccel = 0,
+    kEdgeAiFpuAbSim,
+    kEdgeAiFpuAbShade,
+    kEdgeAiFpuAbCount,
+} edgeai_fpu_ab_fn_t;
+
+typedef uint32_t (*edgeai_fpu_ab_clock_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    const char *err_unit;
+    uint32_t calls;        /* per variant */
+    uint32_t fixed_ticks;  /* total over `calls` */
+    uint32_t float_ticks;
+    uint32_t err_max;
+    uint32_t err_mean_milli; /* mean error x1000 over the compared outputs */
+    uint32_t flips;
+    uint32_t compared;     /* outputs compared (samples, steps, pixels) */
+    uint32_t built_float;  /* the variant this build selects */
+} edgeai_fpu_ab_result_t;
+
+/* Runs the three comparisons. `scratch` (EDGEAI_FPU_AB_SCRATCH_BYTES, 4-byte aligned) is only used during
+ * the call. Returns false when the scratch is too small.
+ */
+bool edgeai_fpu_ab_run(edgeai_fpu_ab_clock_fn_t clock, void *scratch, uint32_t scratch_bytes,
+                       edgeai_fpu_ab_result_t out[kEdgeAiFpuAbCount]);
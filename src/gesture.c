@@ -0,0 +1,249 @@
+#include "gesture.h"
+
+#include <string.h>
+
+#include "edgeai_config.h"
+#include "edgeai_util.h"
+#include "tensor_util.h"
+
+#define EDGEAI_GESTURE_MASK ((uint32_t)EDGEAI_GESTURE_WIN - 1u)
+/* Deviation clamp keeps every window sum inside int32 (jerk: 64 * 3 * 2048^2). */
+#define EDGEAI_GESTURE_D_LIM (EDGEAI_ACCEL_MAP_DENOM * 2)
+
+void edgeai_gesture_init(edgeai_gesture_t *g)
+{
+    if (!g) return;
+    memset(g, 0, sizeof(*g));
+    g->pend_mag = -1;
+}
+
+const char *edgeai_gesture_name(edgeai_gesture_kind_t k)
+{
+    switch (k)
+    {
+        case kEdgeAiGestureTap: return "tap";
+        case kEdgeAiGestureShake: return "shake";
+        case kEdgeAiGestureSwirl: return "swirl";
+        default: return "none";
+    }
+}
+
+static int32_t edgeai_gesture_dominant(const int32_t e[3])
+{
+    int32_t d = 0;
+    if (e[1] > e[d]) d = 1;
+    if (e[2] > e[d]) d = 2;
+    return d;
+}
+
+static edgeai_gesture_kind_t edgeai_gesture_classify(edgeai_gesture_t *g)
+{
+    const int32_t win = EDGEAI_GESTURE_WIN;
+    const int32_t sw = EDGEAI_GESTURE_SHORT;
+
+    if (g->cooldown > 0)
+    {
+        g->cooldown--;
+        return kEdgeAiGestureNone;
+    }
+    if (g->count < (uint32_t)win) return kEdgeAiGestureNone;
+
+    /* Swirl: sustained XY energy turning one way; a linear shake has near-zero rotation. */
+    int32_t exy = g->energy[0] + g->energy[1];
+    if (exy >= EDGEAI_GESTURE_SWIRL_E * win && g->zc[0] >= 2 && g->zc[1] >= 2 &&
+        ((int64_t)edgeai_abs_i32(g->rot) << 8) >= (int64_t)EDGEAI_GESTURE_SWIRL_RATIO_Q8 * exy)
+    {
+        g->swirl_dir = (g->rot > 0) ? 1 : -1;
+        return kEdgeAiGestureSwirl;
+    }
+
+    /* Shake: back-and-forth on the dominant axis. */
+    int32_t dom = edgeai_gesture_dominant(g->energy);
+    if (g->energy[dom] >= EDGEAI_GESTURE_SHAKE_E * win && g->zc[dom] >= EDGEAI_GESTURE_SHAKE_ZC)
+    {
+        return kEdgeAiGestureShake;
+    }
+
+    /* Tap: a jerk spike well above the rest of the window (tilting is smooth, so its jerk stays low),
+     * confirmed once the short window has settled back to the background level.
+     */
+    int64_t spike = (int64_t)g->jerk_short * (win - sw);
+    int64_t background = (int64_t)(g->jerk - g->jerk_short) * sw; /* both scaled to (win - sw) * sw */
+    if (g->tap_wait > 0)
+    {
+        int64_t quiet = (int64_t)EDGEAI_GESTURE_QUIET_E * sw * (win - sw);
+        if (--g->tap_wait == 0 && spike <= ((background > quiet) ? background : quiet))
+        {
+            return kEdgeAiGestureTap;
+        }
+        return kEdgeAiGestureNone;
+    }
+    if (g->jerk_short >= EDGEAI_GESTURE_TAP_PEAK_E * sw && spike >= background * EDGEAI_GESTURE_TAP_RATIO)
+    {
+        g->tap_wait = EDGEAI_GESTURE_TAP_SETTLE;
+    }
+    return kEdgeAiGestureNone;
+}
+
+edgeai_gesture_kind_t edgeai_gesture_push(edgeai_gesture_t *g, int32_t dx, int32_t dy, int32_t dz)
+{
+    if (!g) return kEdgeAiGestureNone;
+
+    int32_t d[3] = {
+        edgeai_clamp_i32_sym(dx, EDGEAI_GESTURE_D_LIM),
+        edgeai_clamp_i32_sym(dy, EDGEAI_GESTURE_D_LIM),
+        edgeai_clamp_i32_sym(dz, EDGEAI_GESTURE_D_LIM),
+    };
+
+    uint32_t head = g->head;
+    const edgeai_gesture_sample_t *prev = &g->ring[(head - 1u) & EDGEAI_GESTURE_MASK];
+    edgeai_gesture_sample_t *slot = &g->ring[head];
+    const edgeai_gesture_sample_t *short_out = &g->ring[(head - (uint32_t)EDGEAI_GESTURE_SHORT) & EDGEAI_GESTURE_MASK];
+    bool have_prev = (g->count > 0u);
+    bool full = (g->count >= (uint32_t)EDGEAI_GESTURE_WIN);
+
+    /* Drop the evicted sample (the slot being overwritten) and the one leaving the short window. */
+    if (full)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            g->energy[i] -= slot->sq[i];
+            g->zc[i] -= (slot->zc >> i) & 1u;
+        }
+        g->rot -= slot->cross;
+        g->jerk -= slot->jerk;
+    }
+    if (g->count >= (uint32_t)EDGEAI_GESTURE_SHORT)
+    {
+        g->jerk_short -= short_out->jerk;
+    }
+
+    edgeai_gesture_sample_t s;
+    s.zc = 0;
+    s.jerk = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        s.d[i] = (int16_t)d[i];
+        s.sq[i] = d[i] * d[i];
+        int32_t j = have_prev ? (d[i] - prev->d[i]) : 0;
+        s.jerk += j * j;
+
+        int8_t sign = (d[i] > EDGEAI_GESTURE_ZC_HYST) ? 1 : ((d[i] < -EDGEAI_GESTURE_ZC_HYST) ? -1 : 0);
+        if (sign != 0)
+        {
+            if (g->zc_sign[i] != 0 && sign != g->zc_sign[i]) s.zc |= (uint8_t)(1u << i);
+            g->zc_sign[i] = sign;
+        }
+    }
+    s.cross = have_prev ? ((int32_t)prev->d[0] * d[1] - (int32_t)prev->d[1] * d[0]) : 0;
+
+    *slot = s;
+    for (int i = 0; i < 3; i++)
+    {
+        g->energy[i] += s.sq[i];
+        g->zc[i] += (s.zc >> i) & 1u;
+    }
+    g->rot += s.cross;
+    g->jerk += s.jerk;
+    g->jerk_short += s.jerk;
+
+    g->head = (head + 1u) & EDGEAI_GESTURE_MASK;
+    if (!full) g->count++;
+    g->samples++;
+
+    edgeai_gesture_kind_t k = edgeai_gesture_classify(g);
+    if (k != kEdgeAiGestureNone)
+    {
+        g->detected[k]++;
+        g->cooldown = EDGEAI_GESTURE_COOLDOWN;
+        g->tap_wait = 0;
+    }
+    return k;
+}
+
+edgeai_gesture_kind_t edgeai_gesture_update(edgeai_gesture_t *g, const accel_proc_out_t *a, uint32_t dt_us)
+{
+    if (!g || !a) return kEdgeAiGestureNone;
+
+    /* accel_proc splits the mapped sample into LP + HP; the sum is the mapped acceleration. */
+    int32_t acc[3] = {a->ax_lp + a->ax_hp, a->ay_lp + a->ay_hp, a->az_lp + a->az_hp};
+    if (!g->grav_ok)
+    {
+        for (int i = 0; i < 3; i++) g->grav_q4[i] = acc[i] << 4;
+        g->grav_ok = true;
+    }
+
+    /* Peak-preserving decimation: keep the largest deviation within the period. */
+    int32_t d[3], mag = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        d[i] = acc[i] - (g->grav_q4[i] >> 4);
+        mag += edgeai_abs_i32(d[i]);
+    }
+    if (mag > g->pend_mag)
+    {
+        g->pend[0] = d[0];
+        g->pend[1] = d[1];
+        g->pend[2] = d[2];
+        g->pend_mag = mag;
+    }
+
+    /* At most one sample per call, so a long frame does not replay stale data. */
+    g->accum_us += dt_us;
+    if (g->accum_us < EDGEAI_GESTURE_PERIOD_US) return kEdgeAiGestureNone;
+    g->accum_us -= EDGEAI_GESTURE_PERIOD_US;
+    if (g->accum_us >= EDGEAI_GESTURE_PERIOD_US) g->accum_us = 0;
+
+    for (int i = 0; i < 3; i++) g->grav_q4[i] += ((acc[i] << 4) - g->grav_q4[i]) >> EDGEAI_GESTURE_GRAV_SHIFT;
+    g->pend_mag = -1;
+    return edgeai_gesture_push(g, g->pend[0], g->pend[1], g->pend[2]);
+}
+
+void edgeai_gesture_features(const edgeai_gesture_t *g, edgeai_gesture_features_t *f)
+{
+    if (!g || !f) return;
+    int32_t n = (g->count > 0u) ? (int32_t)g->count : 1;
+    for (int i = 0; i < 3; i++)
+    {
+        f->energy[i] = g->energy[i] / n;
+        f->zc[i] = g->zc[i];
+    }
+    f->dominant = edgeai_gesture_dominant(g->energy);
+    f->rot = g->rot;
+    f->jerk = g->jerk / n;
+    f->jerk_short = g->jerk_short / EDGEAI_GESTURE_SHORT;
+}
+
+bool edgeai_gesture_fill_tensor(const edgeai_gesture_t *g, const edgeai_npu_tensor_view_t *v)
+{
+    if (!g || !v || !v->data || v->scale <= 0.0f) return false;
+    if ((uint32_t)v->w * v->h * v->c < (uint32_t)EDGEAI_GESTURE_WIN * 3u) return false;
+
+    /* q = real / scale + zp with real = hp / 1 g. */
+    const float k = 1.0f / (v->scale * (float)EDGEAI_ACCEL_MAP_DENOM);
+    uint8_t *dst = v->data;
+    uint32_t idx = (g->count >= (uint32_t)EDGEAI_GESTURE_WIN) ? g->head : 0u;
+    for (uint32_t n = 0; n < (uint32_t)EDGEAI_GESTURE_WIN; n++)
+    {
+        const edgeai_gesture_sample_t *s = &g->ring[(idx + n) & EDGEAI_GESTURE_MASK];
+        bool valid = (n < g->count);
+        for (int i = 0; i < 3; i++)
+        {
+            float r = valid ? (float)s->d[i] : 0.0f;
+            *dst++ = (uint8_t)edgeai_tensor_quantize_inv(r, k, v->zero_point, v->is_signed);
+        }
+    }
+    return true;
+}
+
+edgeai_gesture_kind_t edgeai_gesture_decode(const edgeai_npu_tensor_view_t *v)
+{
+    if (!v || !v->data || v->scale <= 0.0f) return kEdgeAiGestureNone;
+    if ((uint32_t)v->w * v->h * v->c < (uint32_t)kEdgeAiGestureCount) return kEdgeAiGestureNone;
+
+    int32_t best_q = 0;
+    uint32_t best = edgeai_tensor_argmax_q(v->data, (uint32_t)kEdgeAiGestureCount, v->is_signed, &best_q);
+    float score = edgeai_tensor_dequantize(best_q, v->scale, v->zero_point);
+    if (score < EDGEAI_GESTURE_NPU_MIN_SCORE) return kEdgeAiGestureNone;
+    return (edgeai_gesture_kind_t)best;
+}
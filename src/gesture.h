@@ -0,0 +1,166 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "accel_proc.h"
+#include "npu_api.h"
+
+/* Tap/shake/swirl gestures from the accelerometer, separate from the single-threshold bang pulse.
+ * The mapped acceleration (accel_proc LP + HP) minus a slow gravity estimate is decimated to a fixed
+ * rate into a ring, keeping the largest deviation of each period so short taps survive. The
+ * accel_proc HP path alone is too fast a high-pass for shakes and swirls (a few Hz).
+ * Window features are running sums updated per sample (add the new sample, drop the evicted one), so
+ * the cost per sample does not depend on the window length.
+ *
+ * Features: per-axis energy, per-axis zero crossings (with hysteresis), dominant axis, the XY
+ * rotation sum (cross product of consecutive samples; its sign is the swirl direction), and jerk
+ * energy over the window and over its last EDGEAI_GESTURE_SHORT samples (taps).
+ * The CPU classifier thresholds those features; a model can instead be fed from the same window
+ * (edgeai_gesture_fill_tensor / edgeai_gesture_decode).
+ */
+
+#ifndef EDGEAI_GESTURE_ENABLE
+#define EDGEAI_GESTURE_ENABLE 1
+#endif
+
+/* Window length in samples (power of two). */
+#ifndef EDGEAI_GESTURE_WIN
+#define EDGEAI_GESTURE_WIN 64
+#endif
+
+/* Sample period; features and thresholds assume this rate regardless of the main-loop rate. */
+#ifndef EDGEAI_GESTURE_PERIOD_US
+#define EDGEAI_GESTURE_PERIOD_US 10000u
+#endif
+
+/* Gravity estimate time constant: 2^N samples (4 -> ~1 Hz corner at 100 Hz). */
+#ifndef EDGEAI_GESTURE_GRAV_SHIFT
+#define EDGEAI_GESTURE_GRAV_SHIFT 4
+#endif
+
+/* Samples in the short (impulse) window used for taps. */
+#ifndef EDGEAI_GESTURE_SHORT
+#define EDGEAI_GESTURE_SHORT 4
+#endif
+
+/* Samples to wait after a spike before a tap is confirmed (a longer motion cancels it). */
+#ifndef EDGEAI_GESTURE_TAP_SETTLE
+#define EDGEAI_GESTURE_TAP_SETTLE 8
+#endif
+
+/* Samples ignored after any detection. */
+#ifndef EDGEAI_GESTURE_COOLDOWN
+#define EDGEAI_GESTURE_COOLDOWN 40
+#endif
+
+/* Thresholds (counts, 512 = 1 g, clamped to +-2 g; energies are mean squares per sample, tap
+ * thresholds apply to jerk, the sample-to-sample difference).
+ */
+#ifndef EDGEAI_GESTURE_ZC_HYST
+#define EDGEAI_GESTURE_ZC_HYST 40
+#endif
+#ifndef EDGEAI_GESTURE_TAP_PEAK_E
+#define EDGEAI_GESTURE_TAP_PEAK_E (200 * 200)
+#endif
+#ifndef EDGEAI_GESTURE_QUIET_E
+#define EDGEAI_GESTURE_QUIET_E (30 * 30)
+#endif
+/* Tap spike jerk over the window background (per-sample means). */
+#ifndef EDGEAI_GESTURE_TAP_RATIO
+#define EDGEAI_GESTURE_TAP_RATIO 16
+#endif
+#ifndef EDGEAI_GESTURE_SHAKE_E
+#define EDGEAI_GESTURE_SHAKE_E (120 * 120)
+#endif
+#ifndef EDGEAI_GESTURE_SHAKE_ZC
+#define EDGEAI_GESTURE_SHAKE_ZC 5
+#endif
+#ifndef EDGEAI_GESTURE_SWIRL_E
+#define EDGEAI_GESTURE_SWIRL_E (60 * 60)
+#endif
+/* Minimum mean rotation per sample, |rot| / (ex + ey), in Q8 (~radians per sample). */
+#ifndef EDGEAI_GESTURE_SWIRL_RATIO_Q8
+#define EDGEAI_GESTURE_SWIRL_RATIO_Q8 20
+#endif
+
+/* NPU path: minimum dequantized class score. */
+#ifndef EDGEAI_GESTURE_NPU_MIN_SCORE
+#define EDGEAI_GESTURE_NPU_MIN_SCORE 0.6f
+#endif
+
+#if (EDGEAI_GESTURE_WIN & (EDGEAI_GESTURE_WIN - 1)) != 0
+#error "EDGEAI_GESTURE_WIN must be a power of two"
+#endif
+
+typedef enum
+{
+    kEdgeAiGestureNone = 0,
+    kEdgeAiGestureTap,
+    kEdgeAiGestureShake,
+    kEdgeAiGestureSwirl,
+    kEdgeAiGestureCount,
+} edgeai_gesture_kind_t;
+
+typedef struct
+{
+    int16_t d[3];   /* deviation from gravity */
+    uint8_t zc;     /* bit per axis: a crossing completed at this sample */
+    int32_t sq[3];  /* per-axis energy term */
+    int32_t cross;  /* XY rotation term */
+    int32_t jerk;   /* squared difference to the previous sample, all axes */
+} edgeai_gesture_sample_t;
+
+typedef struct
+{
+    edgeai_gesture_sample_t ring[EDGEAI_GESTURE_WIN];
+    uint32_t head;   /* next write slot */
+    uint32_t count;  /* samples pushed (saturates at the window length) */
+    uint32_t accum_us;
+    int32_t grav_q4[3];  /* slow LP of the mapped acceleration, Q4 */
+    int32_t pend[3];     /* largest deviation seen in the current period */
+    int32_t pend_mag;    /* its L1 magnitude, -1 when empty */
+    bool grav_ok;
+
+    /* Running window features. */
+    int32_t energy[3];
+    int32_t zc[3];
+    int32_t rot;
+    int32_t jerk;
+    int32_t jerk_short;   /* last EDGEAI_GESTURE_SHORT samples */
+    int8_t zc_sign[3];    /* last sign beyond the hysteresis band */
+
+    int32_t tap_wait;     /* >0 while a spike awaits confirmation */
+    int32_t cooldown;
+    int8_t swirl_dir;     /* +1 counter-clockwise, -1 clockwise (last swirl) */
+
+    uint32_t samples;
+    uint32_t detected[kEdgeAiGestureCount];
+} edgeai_gesture_t;
+
+typedef struct
+{
+    int32_t energy[3]; /* mean square per sample, counts^2 */
+    int32_t zc[3];
+    int32_t dominant;  /* axis with the largest energy */
+    int32_t rot;       /* window rotation sum (sign = direction) */
+    int32_t jerk;      /* mean per sample, window */
+    int32_t jerk_short; /* mean per sample, short window */
+} edgeai_gesture_features_t;
+
+void edgeai_gesture_init(edgeai_gesture_t *g);
+
+/* Feeds one accel_proc output covering `dt_us`; returns a gesture when one completes, else None. */
+edgeai_gesture_kind_t edgeai_gesture_update(edgeai_gesture_t *g, const accel_proc_out_t *a, uint32_t dt_us);
+
+/* Pushes one decimated, gravity-removed sample directly (host tools, replay). */
+edgeai_gesture_kind_t edgeai_gesture_push(edgeai_gesture_t *g, int32_t dx, int32_t dy, int32_t dz);
+
+void edgeai_gesture_features(const edgeai_gesture_t *g, edgeai_gesture_features_t *f);
+const char *edgeai_gesture_name(edgeai_gesture_kind_t k);
+
+/* NPU path: window (oldest first, x/y/z interleaved, real = g) quantized into a tensor of at least
+ * EDGEAI_GESTURE_WIN * 3 elements; decode takes the argmax of kEdgeAiGestureCount class scores.
+ */
+bool edgeai_gesture_fill_tensor(const edgeai_gesture_t *g, const edgeai_npu_tensor_view_t *v);
+edgeai_gesture_kind_t edgeai_gesture_decode(const edgeai_npu_tensor_view_t *v);
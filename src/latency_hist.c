@@ -0,0 +1,92 @@
+#include "latency_hist.h"
+
+#include <stddef.h>
+#include <string.h>
+
+typedef struct
+{
+    const char *name;
+    uint32_t count;
+    uint32_t max;
+    uint16_t bins[EDGEAI_LHIST_BUCKETS];
+} edgeai_lhist_stage_t;
+
+static edgeai_lhist_stage_t s_stages[EDGEAI_LHIST_MAX_STAGES];
+static int s_stage_count = 0;
+
+int edgeai_lhist_register(const char *name)
+{
+    if (s_stage_count >= EDGEAI_LHIST_MAX_STAGES) return -1;
+    int id = s_stage_count++;
+    memset(&s_stages[id], 0, sizeof(s_stages[id]));
+    s_stages[id].name = name;
+    return id;
+}
+
+int edgeai_lhist_stage_count(void)
+{
+    return s_stage_count;
+}
+
+const char *edgeai_lhist_name(int id)
+{
+    if (id < 0 || id >= s_stage_count) return NULL;
+    return s_stages[id].name;
+}
+
+void edgeai_lhist_record(int id, uint32_t value)
+{
+    if ((unsigned)id >= (unsigned)s_stage_count) return;
+    edgeai_lhist_stage_t *st = &s_stages[id];
+    uint16_t *bin = &st->bins[edgeai_lhist_bucket(value)];
+    if (*bin != 0xFFFFu) (*bin)++;
+    st->count++;
+    if (value > st->max) st->max = value;
+}
+
+static uint32_t edgeai_lhist_rank_value(const edgeai_lhist_stage_t *st, uint32_t rank)
+{
+    /* rank is 1-based and counted over the stored bins (bins saturate at 0xFFFF). */
+    uint32_t acc = 0;
+    for (uint32_t b = 0; b < EDGEAI_LHIST_BUCKETS; b++)
+    {
+        acc += st->bins[b];
+        if (acc >= rank)
+        {
+            uint32_t v = edgeai_lhist_bucket_upper(b);
+            return (v > st->max) ? st->max : v;
+        }
+    }
+    return st->max;
+}
+
+bool edgeai_lhist_summary(int id, edgeai_lhist_summary_t *out)
+{
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+    if ((unsigned)id >= (unsigned)s_stage_count) return false;
+
+    const edgeai_lhist_stage_t *st = &s_stages[id];
+    out->count = st->count;
+    out->max = st->max;
+    if (st->count == 0u) return true;
+
+    uint32_t total = 0;
+    for (uint32_t b = 0; b < EDGEAI_LHIST_BUCKETS; b++) total += st->bins[b];
+
+    /* Nearest-rank percentiles: ceil(p * total / 100). */
+    out->p50 = edgeai_lhist_rank_value(st, (total * 50u + 99u) / 100u);
+    out->p95 = edgeai_lhist_rank_value(st, (total * 95u + 99u) / 100u);
+    out->p99 = edgeai_lhist_rank_value(st, (total * 99u + 99u) / 100u);
+    return true;
+}
+
+void edgeai_lhist_reset_window(void)
+{
+    for (int i = 0; i < s_stage_count; i++)
+    {
+        s_stages[i].count = 0;
+        s_stages[i].max = 0;
+        memset(s_stages[i].bins, 0, sizeof(s_stages[i].bins));
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Per-stage latency histograms (log2-linear buckets over DWT cycle deltas).
+ * - Values below 2^(SUB_BITS+1) land in exact buckets; above that each power of two is split
+ *   into 2^SUB_BITS linear sub-buckets (12.5% relative resolution with SUB_BITS=3).
+ * - Recording is a CLZ, a shift and a saturating increment; no division.
+ * - Pure C with no SDK dependencies, so the same module builds for target and host.
+ */
+
+#ifndef EDGEAI_LHIST_SUB_BITS
+#define EDGEAI_LHIST_SUB_BITS 3u
+#endif
+#ifndef EDGEAI_LHIST_MAX_STAGES
+#define EDGEAI_LHIST_MAX_STAGES 8
+#endif
+
+#define EDGEAI_LHIST_SUB (1u << EDGEAI_LHIST_SUB_BITS)
+#define EDGEAI_LHIST_BUCKETS ((32u - EDGEAI_LHIST_SUB_BITS + 1u) * EDGEAI_LHIST_SUB)
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p95;
+    uint32_t p99;
+    uint32_t max;
+} edgeai_lhist_summary_t;
+
+/* Register a stage once at init. Returns its id, or -1 when the table is full. */
+int edgeai_lhist_register(const char *name);
+int edgeai_lhist_stage_count(void);
+const char *edgeai_lhist_name(int id);
+
+void edgeai_lhist_record(int id, uint32_t value);
+
+/* Percentiles are reported as the upper bound of the bucket (clamped to the window max). */
+bool edgeai_lhist_summary(int id, edgeai_lhist_summary_t *out);
+
+/* Start a new window for every registered stage. */
+void edgeai_lhist_reset_window(void);
+
+static inline uint32_t edgeai_lhist_bucket(uint32_t v)
+{
+    if (v < (2u * EDGEAI_LHIST_SUB)) return v;
+    uint32_t e = 31u - (uint32_t)__builtin_clz(v);
+    uint32_t shift = e - EDGEAI_LHIST_SUB_BITS;
+    return ((shift + 1u) << EDGEAI_LHIST_SUB_BITS) + ((v >> shift) & (EDGEAI_LHIST_SUB - 1u));
+}
+
+static inline uint32_t edgeai_lhist_bucket_upper(uint32_t b)
+{
+    if (b < (2u * EDGEAI_LHIST_SUB)) return b;
+    uint32_t shift = (b >> EDGEAI_LHIST_SUB_BITS) - 1u;
+    uint32_t mant = EDGEAI_LHIST_SUB + (b & (EDGEAI_LHIST_SUB - 1u));
+    uint64_t hi = ((uint64_t)(mant + 1u) << shift) - 1u;
+    return (hi > 0xFFFFFFFFull) ? 0xFFFFFFFFu : (uint32_t)hi;
+}
@@ -7,20 +7,224 @@
 #include "npu/model.h"
 
 #include <assert.h>
+#include <new>
 
+#include "tensorflow/lite/micro/micro_allocator.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
 #include "tensorflow/lite/micro/micro_op_resolver.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
 #include "npu/model_data.h"
+#include "npu/model_profiler.h"
+
+extern "C" {
+#include "scratch_arena.h"
+}
 
-static const tflite::Model *s_model = nullptr;
 static tflite::MicroInterpreter *s_interpreter = nullptr;
 
 extern tflite::MicroOpResolver &EDGEAI_MODEL_GetOpsResolver();
 
-/* Tensor arena for TFLM. Size comes from the model header (kTensorArenaSize). */
-static uint8_t s_tensorArena[kTensorArenaSize] __attribute__((aligned(16)));
+/* Model registry.
+ * Each model keeps its own interpreter, op resolver and persistent slice (tensor metadata, op data),
+ * all carved from one persistent arena; every model plans its activations into the same
+ * non-persistent arena, since only the active model runs. A model is allocated on first selection
+ * and later switches only swap the active interpreter. Add models to this table; an entry without an
+ * embedded flatbuffer gets one through EDGEAI_MODEL_SetData before init, or stays unselectable.
+ */
+typedef struct
+{
+    const char *name;
+    const uint8_t *data;
+    tflite::MicroOpResolver &(*resolver)();
+    uint32_t persistent_bytes; /* slice of the persistent arena; 0 shares the remainder */
+} edgeai_model_desc_t;
+
+static const edgeai_model_desc_t s_models[] = {
+    {"ds_cnn_npu", model_data, EDGEAI_MODEL_GetOpsResolver, 0u},
+    /* No second converted model is embedded yet; host checks load one here to exercise switching. */
+    {"aux", nullptr, EDGEAI_MODEL_GetOpsResolver, 0u},
+};
+
+#define EDGEAI_MODEL_COUNT ((uint32_t)(sizeof(s_models) / sizeof(s_models[0])))
+static_assert(EDGEAI_MODEL_COUNT <= EDGEAI_MODEL_MAX, "raise EDGEAI_MODEL_MAX");
+
+typedef struct
+{
+    tflite::MicroInterpreter *interp;
+    uint32_t persistent_off;
+    uint32_t persistent_bytes;
+    uint32_t arena_used;
+} edgeai_model_slot_t;
+
+/* Persistent allocations stay resident. */
+static uint8_t s_persistentArena[EDGEAI_MODEL_PERSISTENT_BYTES] __attribute__((aligned(16)));
+#if !EDGEAI_SCRATCH_SHARED
+/* Non-persistent arena; with EDGEAI_SCRATCH_SHARED it is the scratch region shared with the render tile. */
+static uint8_t s_nonPersistentArena[kTensorArenaSize - EDGEAI_MODEL_PERSISTENT_BYTES] __attribute__((aligned(16)));
+#endif
+
+alignas(tflite::MicroInterpreter) static uint8_t s_interpStorage[EDGEAI_MODEL_MAX][sizeof(tflite::MicroInterpreter)];
+static edgeai_model_slot_t s_slots[EDGEAI_MODEL_MAX];
+static const uint8_t *s_dataOverride[EDGEAI_MODEL_MAX];
+static bool s_registryInit = false;
+static int32_t s_active = -1;
+static edgeai_model_switch_stats_t s_switch;
+
+static edgeai_model_profile_t s_profile;
+#if EDGEAI_MODEL_PROFILE
+static EdgeAiModelProfiler s_profiler(&s_profile);
+#endif
+
+static uint8_t *model_np_arena(uint32_t *bytes)
+{
+#if EDGEAI_SCRATCH_SHARED
+    return edgeai_scratch_model_arena(bytes);
+#else
+    *bytes = (uint32_t)sizeof(s_nonPersistentArena);
+    return s_nonPersistentArena;
+#endif
+}
+
+static const uint8_t *model_data_of(uint32_t id)
+{
+    return s_dataOverride[id] ? s_dataOverride[id] : s_models[id].data;
+}
+
+/* Assigns persistent slices in table order to the entries that have a flatbuffer; entries with 0 split
+ * what the fixed ones leave. An entry without one gets no slice, so it costs the others nothing.
+ */
+static bool model_registry_init(void)
+{
+    uint32_t fixed = 0, shared_n = 0;
+    for (uint32_t i = 0; i < EDGEAI_MODEL_COUNT; i++)
+    {
+        if (!model_data_of(i)) continue;
+        fixed += (s_models[i].persistent_bytes + 15u) & ~15u;
+        if (s_models[i].persistent_bytes == 0u) shared_n++;
+    }
+    if (fixed > sizeof(s_persistentArena)) return false;
+    uint32_t share = shared_n ? (((uint32_t)sizeof(s_persistentArena) - fixed) / shared_n) & ~15u : 0u;
+
+    uint32_t off = 0;
+    for (uint32_t i = 0; i < EDGEAI_MODEL_COUNT; i++)
+    {
+        uint32_t n = s_models[i].persistent_bytes ? ((s_models[i].persistent_bytes + 15u) & ~15u) : share;
+        if (!model_data_of(i)) n = 0u;
+        s_slots[i].interp = nullptr;
+        s_slots[i].persistent_off = off;
+        s_slots[i].persistent_bytes = n;
+        s_slots[i].arena_used = 0;
+        off += n;
+    }
+    s_registryInit = true;
+    return true;
+}
+
+static status_t model_load(uint32_t id)
+{
+    const edgeai_model_desc_t *d = &s_models[id];
+    edgeai_model_slot_t *slot = &s_slots[id];
+
+    if (!model_data_of(id) || slot->persistent_bytes == 0u) return kStatus_Fail;
+    const tflite::Model *model = tflite::GetModel(model_data_of(id));
+    if (!model || (model->version() != TFLITE_SCHEMA_VERSION))
+    {
+        return kStatus_Fail;
+    }
+
+#if EDGEAI_MODEL_PROFILE
+    tflite::MicroProfilerInterface *profiler = &s_profiler;
+#else
+    tflite::MicroProfilerInterface *profiler = nullptr;
+#endif
+    uint32_t np_bytes = 0;
+    uint8_t *np_arena = model_np_arena(&np_bytes);
+    tflite::MicroAllocator *allocator = tflite::MicroAllocator::Create(
+        &s_persistentArena[slot->persistent_off], slot->persistent_bytes, np_arena, np_bytes);
+    if (!allocator) return kStatus_Fail;
+
+    tflite::MicroInterpreter *interp =
+        new (s_interpStorage[id]) tflite::MicroInterpreter(model, d->resolver(), allocator, nullptr, profiler);
+    if (interp->AllocateTensors() != kTfLiteOk)
+    {
+        interp->~MicroInterpreter();
+        return kStatus_Fail;
+    }
+    slot->interp = interp;
+    slot->arena_used = (uint32_t)interp->arena_used_bytes();
+    s_switch.loads++;
+    return kStatus_Success;
+}
+
+status_t EDGEAI_MODEL_Init(void)
+{
+    if (!s_registryInit && !model_registry_init()) return kStatus_Fail;
+    return EDGEAI_MODEL_Select(0u);
+}
+
+status_t EDGEAI_MODEL_SetData(uint32_t id, const uint8_t *data)
+{
+    if (id >= EDGEAI_MODEL_COUNT) return kStatus_Fail;
+    /* After init the slices are fixed: only a slot that has one and is not allocated yet can change. */
+    if (s_registryInit && (s_slots[id].interp != nullptr || s_slots[id].persistent_bytes == 0u)) return kStatus_Fail;
+    if (s_registryInit && !data && !s_models[id].data) return kStatus_Fail;
+    s_dataOverride[id] = data;
+    return kStatus_Success;
+}
+
+uint32_t EDGEAI_MODEL_GetCount(void)
+{
+    return EDGEAI_MODEL_COUNT;
+}
+
+const char *EDGEAI_MODEL_GetName(uint32_t id)
+{
+    return (id < EDGEAI_MODEL_COUNT) ? s_models[id].name : nullptr;
+}
+
+int32_t EDGEAI_MODEL_GetActive(void)
+{
+    return s_active;
+}
+
+status_t EDGEAI_MODEL_Select(uint32_t id)
+{
+    if (!s_registryInit || id >= EDGEAI_MODEL_COUNT) return kStatus_Fail;
+    if ((int32_t)id == s_active) return kStatus_Success;
+
+    uint32_t t0 = EDGEAI_MODEL_PROFILE_NOW();
+    bool first = (s_slots[id].interp == nullptr);
+    if (first && model_load(id) != kStatus_Success) return kStatus_Fail;
+
+    s_interpreter = s_slots[id].interp;
+    s_active = (int32_t)id;
+
+    /* Op rows are per model; arena usage is the active model's (persistent slice + plan). */
+    EDGEAI_MODEL_ResetProfile();
+    uint32_t np_bytes = 0;
+    (void)model_np_arena(&np_bytes);
+    s_profile.arena_used_bytes = s_slots[id].arena_used;
+    s_profile.arena_size_bytes = s_slots[id].persistent_bytes + np_bytes;
+
+    uint32_t dc = EDGEAI_MODEL_PROFILE_NOW() - t0;
+    if (first)
+    {
+        s_switch.load_cyc[id] = dc;
+    }
+    else
+    {
+        s_switch.switches++;
+        s_switch.last_switch_cyc = dc;
+        if (dc > s_switch.max_switch_cyc) s_switch.max_switch_cyc = dc;
+    }
+    return kStatus_Success;
+}
+
+const edgeai_model_switch_stats_t *EDGEAI_MODEL_GetSwitchStats(void)
+{
+    return &s_switch;
+}
 
 static uint8_t *get_tensor_data(TfLiteTensor *tensor, edgeai_tensor_dims_t *dims, edgeai_tensor_type_t *type)
 {
@@ -46,31 +250,32 @@ static uint8_t *get_tensor_data(TfLiteTensor *tensor, edgeai_tensor_dims_t *dims
     return tensor->data.uint8;
 }
 
-status_t EDGEAI_MODEL_Init(void)
+uint8_t *EDGEAI_MODEL_GetInputTensorData(edgeai_tensor_dims_t *dims, edgeai_tensor_type_t *type)
 {
-    s_model = tflite::GetModel(model_data);
-    if (!s_model || (s_model->version() != TFLITE_SCHEMA_VERSION))
-    {
-        return kStatus_Fail;
-    }
-
-    tflite::MicroOpResolver &resolver = EDGEAI_MODEL_GetOpsResolver();
-
-    static tflite::MicroInterpreter static_interpreter(s_model, resolver, s_tensorArena, kTensorArenaSize);
-    s_interpreter = &static_interpreter;
-
-    if (s_interpreter->AllocateTensors() != kTfLiteOk)
-    {
-        return kStatus_Fail;
-    }
+    if (!s_interpreter) return nullptr;
+    return get_tensor_data(s_interpreter->input(0), dims, type);
+}
 
+static status_t get_quant_params(const TfLiteTensor *tensor, float *scale, int32_t *zero_point)
+{
+    if (!tensor || !scale || !zero_point) return kStatus_Fail;
+    if (tensor->type != kTfLiteInt8 && tensor->type != kTfLiteUInt8) return kStatus_Fail;
+    if (tensor->params.scale <= 0.0f) return kStatus_Fail;
+    *scale = tensor->params.scale;
+    *zero_point = (int32_t)tensor->params.zero_point;
     return kStatus_Success;
 }
 
-uint8_t *EDGEAI_MODEL_GetInputTensorData(edgeai_tensor_dims_t *dims, edgeai_tensor_type_t *type)
+status_t EDGEAI_MODEL_GetInputQuantParams(float *scale, int32_t *zero_point)
 {
-    if (!s_interpreter) return nullptr;
-    return get_tensor_data(s_interpreter->input(0), dims, type);
+    if (!s_interpreter) return kStatus_Fail;
+    return get_quant_params(s_interpreter->input(0), scale, zero_point);
+}
+
+status_t EDGEAI_MODEL_GetOutputQuantParams(float *scale, int32_t *zero_point)
+{
+    if (!s_interpreter) return kStatus_Fail;
+    return get_quant_params(s_interpreter->output(0), scale, zero_point);
 }
 
 uint8_t *EDGEAI_MODEL_GetOutputTensorData(edgeai_tensor_dims_t *dims, edgeai_tensor_type_t *type)
@@ -82,6 +287,52 @@ uint8_t *EDGEAI_MODEL_GetOutputTensorData(edgeai_tensor_dims_t *dims, edgeai_ten
 status_t EDGEAI_MODEL_RunInference(void)
 {
     if (!s_interpreter) return kStatus_Fail;
-    return (s_interpreter->Invoke() == kTfLiteOk) ? kStatus_Success : kStatus_Fail;
+#if EDGEAI_MODEL_PROFILE
+    s_profiler.BeginInvoke();
+    TfLiteStatus st = s_interpreter->Invoke();
+    s_profiler.EndInvoke();
+#else
+    TfLiteStatus st = s_interpreter->Invoke();
+#endif
+    /* Scratch buffers requested during Invoke count toward the high-water mark. */
+    s_profile.arena_used_bytes = (uint32_t)s_interpreter->arena_used_bytes();
+    if (s_active >= 0) s_slots[s_active].arena_used = s_profile.arena_used_bytes;
+    return (st == kTfLiteOk) ? kStatus_Success : kStatus_Fail;
+}
+
+const edgeai_model_profile_t *EDGEAI_MODEL_GetProfile(void)
+{
+    return &s_profile;
+}
+
+void EDGEAI_MODEL_ResetProfile(void)
+{
+    uint32_t used = s_profile.arena_used_bytes;
+    uint32_t size = s_profile.arena_size_bytes;
+    s_profile = edgeai_model_profile_t{};
+    s_profile.arena_used_bytes = used;
+    s_profile.arena_size_bytes = size;
+}
+
+void EDGEAI_MODEL_PrintProfile(edgeai_model_print_fn_t print_fn)
+{
+    if (!print_fn) return;
+    const edgeai_model_profile_t *p = &s_profile;
+    print_fn("EDGEAI: model %s arena used=%u/%u bytes invokes=%u last=%u max=%u cyc\r\n",
+             (s_active >= 0) ? s_models[s_active].name : "-",
+             (unsigned)p->arena_used_bytes, (unsigned)p->arena_size_bytes, (unsigned)p->invokes,
+             (unsigned)p->invoke_last_cyc, (unsigned)p->invoke_max_cyc);
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < p->op_count; i++) sum += p->op[i].total_cyc;
+    for (uint32_t i = 0; i < p->op_count; i++)
+    {
+        const edgeai_model_op_prof_t *op = &p->op[i];
+        uint32_t avg = op->count ? (uint32_t)(op->total_cyc / op->count) : 0u;
+        uint32_t share_pm = sum ? (uint32_t)((op->total_cyc * 1000u) / sum) : 0u;
+        print_fn("EDGEAI:  op%u %s n=%u avg=%u max=%u cyc share=%u.%u%%\r\n",
+                 (unsigned)i, op->tag ? op->tag : "?", (unsigned)op->count, (unsigned)avg,
+                 (unsigned)op->max_cyc, (unsigned)(share_pm / 10u), (unsigned)(share_pm % 10u));
+    }
 }
 
@@ -31,11 +31,78 @@ typedef enum
     kEdgeAiTensorType_INT8    = 2
 } edgeai_tensor_type_t;
 
+/* Per-op profiler: DWT cycles per operator, attached to the interpreter when enabled. */
+#ifndef EDGEAI_MODEL_PROFILE
+#define EDGEAI_MODEL_PROFILE 0
+#endif
+
+#define EDGEAI_MODEL_PROFILE_MAX_OPS 16
+
+typedef struct
+{
+    const char *tag; /* op name reported by TFLM (static storage) */
+    uint32_t count;
+    uint32_t last_cyc;
+    uint32_t max_cyc;
+    uint64_t total_cyc;
+} edgeai_model_op_prof_t;
+
+typedef struct
+{
+    uint32_t invokes;
+    uint32_t invoke_last_cyc;
+    uint32_t invoke_max_cyc;
+    uint32_t op_count; /* ops seen per Invoke (execution order) */
+    uint32_t arena_used_bytes; /* TFLM high-water mark (persistent + peak scratch) */
+    uint32_t arena_size_bytes;
+    edgeai_model_op_prof_t op[EDGEAI_MODEL_PROFILE_MAX_OPS];
+} edgeai_model_profile_t;
+
+typedef int (*edgeai_model_print_fn_t)(const char *fmt, ...);
+
+/* Model registry (see s_models in model.cpp). */
+#define EDGEAI_MODEL_MAX 4
+
+typedef struct
+{
+    uint32_t loads;           /* allocations (AllocateTensors); one per model however often it is selected */
+    uint32_t switches;        /* selections of an already-allocated model */
+    uint32_t last_switch_cyc;
+    uint32_t max_switch_cyc;
+    uint32_t load_cyc[EDGEAI_MODEL_MAX]; /* first selection: interpreter setup + AllocateTensors */
+} edgeai_model_switch_stats_t;
+
+/* Sets up the registry and selects model 0. */
 status_t EDGEAI_MODEL_Init(void);
+/* Replaces the flatbuffer of registry entry `id` before its first selection; NULL restores the embedded
+ * one. Host builds load the CPU-equivalent graph this way (the embedded model needs the Neutron op).
+ * Persistent slices are assigned at init to the entries that have a flatbuffer, so an entry without an
+ * embedded one must get its data before EDGEAI_MODEL_Init.
+ */
+status_t EDGEAI_MODEL_SetData(uint32_t id, const uint8_t *data);
+/* Registered entries, including ones without a flatbuffer (their selection fails). */
+uint32_t EDGEAI_MODEL_GetCount(void);
+const char *EDGEAI_MODEL_GetName(uint32_t id);
+int32_t EDGEAI_MODEL_GetActive(void);
+/* Makes `id` the active model (allocating it on first use). The caller owns the non-persistent arena
+ * (inference phase) and must re-fetch tensor pointers afterwards.
+ */
+status_t EDGEAI_MODEL_Select(uint32_t id);
+const edgeai_model_switch_stats_t *EDGEAI_MODEL_GetSwitchStats(void);
 uint8_t *EDGEAI_MODEL_GetInputTensorData(edgeai_tensor_dims_t *dims, edgeai_tensor_type_t *type);
+/* Affine quantization of input 0: real = scale * (q - zero_point). Fails for non-quantized inputs. */
+status_t EDGEAI_MODEL_GetInputQuantParams(float *scale, int32_t *zero_point);
 uint8_t *EDGEAI_MODEL_GetOutputTensorData(edgeai_tensor_dims_t *dims, edgeai_tensor_type_t *type);
+/* Same as EDGEAI_MODEL_GetInputQuantParams, for output 0. */
+status_t EDGEAI_MODEL_GetOutputQuantParams(float *scale, int32_t *zero_point);
 status_t EDGEAI_MODEL_RunInference(void);
 
+/* Profile since the last reset; arena fields are valid after a successful init even without the profiler. */
+const edgeai_model_profile_t *EDGEAI_MODEL_GetProfile(void);
+void EDGEAI_MODEL_ResetProfile(void);
+/* Per-op table (avg/max/share of Invoke) plus arena usage, one line per op. */
+void EDGEAI_MODEL_PrintProfile(edgeai_model_print_fn_t print_fn);
+
 #if defined(__cplusplus)
 }
 #endif
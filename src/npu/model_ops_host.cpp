@@ -0,0 +1,34 @@
+/*
+ * Op resolver for the host NPU backend (EDGEAI_NPU_BACKEND=2).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+
+/* TFLM reference kernels for the CPU-equivalent graph (the model as fed to the Neutron converter).
+ * There is no NEUTRON_GRAPH kernel here: the embedded converted model fails AllocateTensors on purpose,
+ * so a host run never reports outputs of a placeholder op. Load the CPU graph with EDGEAI_MODEL_SetData.
+ */
+tflite::MicroOpResolver &EDGEAI_MODEL_GetOpsResolver()
+{
+    static tflite::MicroMutableOpResolver<14> s_microOpResolver;
+
+    s_microOpResolver.AddAdd();
+    s_microOpResolver.AddAveragePool2D();
+    s_microOpResolver.AddConv2D();
+    s_microOpResolver.AddDepthwiseConv2D();
+    s_microOpResolver.AddDequantize();
+    s_microOpResolver.AddFullyConnected();
+    s_microOpResolver.AddMaxPool2D();
+    s_microOpResolver.AddMean();
+    s_microOpResolver.AddPad();
+    s_microOpResolver.AddQuantize();
+    s_microOpResolver.AddRelu();
+    s_microOpResolver.AddReshape();
+    s_microOpResolver.AddSlice();
+    s_microOpResolver.AddSoftmax();
+
+    return s_microOpResolver;
+}
@@ -0,0 +1,46 @@
+/*
+ * Per-operator profiler for the TFLM interpreter.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "npu/model_profiler.h"
+
+uint32_t EdgeAiModelProfiler::BeginEvent(const char *tag)
+{
+    uint32_t id = m_next++;
+    if (id >= EDGEAI_MODEL_PROFILE_MAX_OPS) return EDGEAI_MODEL_PROFILE_MAX_OPS;
+
+    edgeai_model_op_prof_t *op = &m_out->op[id];
+    op->tag = tag;
+    if (id + 1u > m_out->op_count) m_out->op_count = id + 1u;
+    m_start[id] = EDGEAI_MODEL_PROFILE_NOW();
+    return id;
+}
+
+void EdgeAiModelProfiler::EndEvent(uint32_t event_handle)
+{
+    uint32_t now = EDGEAI_MODEL_PROFILE_NOW();
+    if (event_handle >= EDGEAI_MODEL_PROFILE_MAX_OPS) return;
+
+    edgeai_model_op_prof_t *op = &m_out->op[event_handle];
+    uint32_t dc = now - m_start[event_handle];
+    op->count++;
+    op->last_cyc = dc;
+    op->total_cyc += dc;
+    if (dc > op->max_cyc) op->max_cyc = dc;
+}
+
+void EdgeAiModelProfiler::BeginInvoke()
+{
+    m_next = 0;
+    m_invokeStart = EDGEAI_MODEL_PROFILE_NOW();
+}
+
+void EdgeAiModelProfiler::EndInvoke()
+{
+    uint32_t dc = EDGEAI_MODEL_PROFILE_NOW() - m_invokeStart;
+    m_out->invokes++;
+    m_out->invoke_last_cyc = dc;
+    if (dc > m_out->invoke_max_cyc) m_out->invoke_max_cyc = dc;
+}
@@ -0,0 +1,40 @@
+/*
+ * Per-operator profiler for the TFLM interpreter.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _EDGEAI_NPU_MODEL_PROFILER_H_
+#define _EDGEAI_NPU_MODEL_PROFILER_H_
+
+#include "npu/model.h"
+
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+
+/* Cycle source. Host builds override it (for example with a nanosecond clock). */
+#ifndef EDGEAI_MODEL_PROFILE_NOW
+#define EDGEAI_MODEL_PROFILE_NOW() (DWT->CYCCNT)
+#endif
+
+/* Events are keyed by their order inside one Invoke, so repeated op types (two QUANTIZE nodes)
+ * get separate rows. BeginInvoke/EndInvoke bracket each EDGEAI_MODEL_RunInference call.
+ */
+class EdgeAiModelProfiler : public tflite::MicroProfilerInterface
+{
+public:
+    explicit EdgeAiModelProfiler(edgeai_model_profile_t *out) : m_out(out) {}
+
+    uint32_t BeginEvent(const char *tag) override;
+    void EndEvent(uint32_t event_handle) override;
+
+    void BeginInvoke();
+    void EndInvoke();
+
+private:
+    edgeai_model_profile_t *m_out;
+    uint32_t m_next = 0;
+    uint32_t m_invokeStart = 0;
+    uint32_t m_start[EDGEAI_MODEL_PROFILE_MAX_OPS] = {0};
+};
+
+#endif /* _EDGEAI_NPU_MODEL_PROFILER_H_ */
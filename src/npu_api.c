@@ -1,30 +1,59 @@
 #include "npu_api.h"
 
+#include <string.h>
+
+#include "scratch_arena.h"
+
 bool edgeai_npu_stub_init(edgeai_npu_state_t *s);
+bool edgeai_npu_stub_input_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v);
+bool edgeai_npu_stub_output_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v);
 bool edgeai_npu_stub_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai_npu_output_t *out);
 
 bool edgeai_npu_neutron_init(edgeai_npu_state_t *s);
+bool edgeai_npu_neutron_input_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v);
+bool edgeai_npu_neutron_output_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v);
 bool edgeai_npu_neutron_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai_npu_output_t *out);
+uint32_t edgeai_npu_neutron_model_count(void);
+bool edgeai_npu_neutron_select(edgeai_npu_state_t *s, uint32_t id);
 
 edgeai_npu_backend_t edgeai_npu_backend(void)
 {
     if (EDGEAI_NPU_BACKEND == (int)kEdgeAiNpuBackendNeutron) return kEdgeAiNpuBackendNeutron;
+    if (EDGEAI_NPU_BACKEND == (int)kEdgeAiNpuBackendHost) return kEdgeAiNpuBackendHost;
     return kEdgeAiNpuBackendStub;
 }
 
 char edgeai_npu_backend_char(void)
 {
-    return (edgeai_npu_backend() == kEdgeAiNpuBackendNeutron) ? 'N' : 'S';
+    switch (edgeai_npu_backend())
+    {
+        case kEdgeAiNpuBackendNeutron: return 'N';
+        case kEdgeAiNpuBackendHost: return 'H';
+        default: return 'S';
+    }
+}
+
+/* Neutron and host share the TFLM glue (npu_backend_neutron.cpp); only the op resolver and the
+ * model flatbuffer differ.
+ */
+static bool edgeai_npu_is_tflm(void)
+{
+    return edgeai_npu_backend() != kEdgeAiNpuBackendStub;
 }
 
 bool edgeai_npu_init(edgeai_npu_state_t *s)
 {
     if (!s) return false;
+    memset(s, 0, sizeof(*s));
     s->init_ok = false;
+    s->job_pending = -1;
 
-    if (edgeai_npu_backend() == kEdgeAiNpuBackendNeutron)
+    if (edgeai_npu_is_tflm())
     {
+        /* Tensor allocation plans into the shared scratch region. */
+        if (!edgeai_scratch_acquire(kEdgeAiScratchOwnerInference)) return false;
         s->init_ok = edgeai_npu_neutron_init(s);
+        edgeai_scratch_release(kEdgeAiScratchOwnerInference);
         return s->init_ok;
     }
 
@@ -38,10 +67,220 @@ bool edgeai_npu_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai
     if (!EDGEAI_ENABLE_NPU_INFERENCE) return false;
     if (!s->init_ok) return false;
 
-    if (edgeai_npu_backend() == kEdgeAiNpuBackendNeutron)
+    if (edgeai_npu_is_tflm())
     {
         return edgeai_npu_neutron_step(s, in, out);
     }
     return edgeai_npu_stub_step(s, in, out);
 }
 
+bool edgeai_npu_input_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v)
+{
+    if (!s || !v || !s->init_ok) return false;
+    if (edgeai_npu_is_tflm())
+    {
+        return edgeai_npu_neutron_input_view(s, v);
+    }
+    return edgeai_npu_stub_input_view(s, v);
+}
+
+bool edgeai_npu_output_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v)
+{
+    if (!s || !v || !s->init_ok) return false;
+    if (edgeai_npu_is_tflm())
+    {
+        return edgeai_npu_neutron_output_view(s, v);
+    }
+    return edgeai_npu_stub_output_view(s, v);
+}
+
+bool edgeai_npu_submit(edgeai_npu_state_t *s, const edgeai_npu_input_t *in)
+{
+    if (!s || !in) return false;
+    if (!EDGEAI_ENABLE_NPU_INFERENCE || !s->init_ok)
+    {
+        s->skipped++;
+        return false;
+    }
+
+    /* job_write is never the published slot, so the deferred context never sees a partial job. */
+    uint32_t w = s->job_write;
+    s->job[w].in = *in;
+    s->job[w].submit_cyc = edgeai_npu_defer_now();
+    s->job_pending = (int32_t)w;
+    s->job_write = w ^ 1u;
+    s->submitted++;
+
+#if EDGEAI_NPU_ASYNC_DEFER_IRQ
+    edgeai_npu_defer_kick();
+#endif
+    return true;
+}
+
+void edgeai_npu_async_run(edgeai_npu_state_t *s)
+{
+    if (!s) return;
+    int32_t idx = s->job_pending;
+    if (idx < 0) return;
+
+    /* The renderer holds the shared scratch region: leave the job pending; its release re-kicks. */
+    if (!edgeai_scratch_acquire(kEdgeAiScratchOwnerInference))
+    {
+        s->deferred++;
+        return;
+    }
+
+    edgeai_npu_job_t job = s->job[idx];
+    s->job_pending = -1;
+    s->started++;
+
+    uint32_t back = s->result_front ^ 1u;
+    uint32_t t0 = edgeai_npu_defer_now();
+    bool ok = edgeai_npu_step(s, &job.in, &s->result[back]);
+    uint32_t t1 = edgeai_npu_defer_now();
+    s->last_run_cyc = t1 - t0;
+    if (!ok)
+    {
+        s->failed++;
+        edgeai_scratch_release(kEdgeAiScratchOwnerInference);
+        return;
+    }
+
+    /* Output tensors are only valid until the region goes back to the renderer. */
+    if (s->on_result) s->on_result(s, s->on_result_user);
+    edgeai_scratch_release(kEdgeAiScratchOwnerInference);
+
+    /* Publish: flip the front buffer, then bump the sequence. */
+    s->result_front = back;
+    s->last_latency_cyc = t1 - job.submit_cyc;
+    s->completed++;
+    s->result_seq++;
+}
+
+bool edgeai_npu_poll(edgeai_npu_state_t *s, edgeai_npu_output_t *out)
+{
+    if (!s || !out) return false;
+
+#if !EDGEAI_NPU_ASYNC_DEFER_IRQ
+    edgeai_npu_async_run(s);
+#endif
+
+    uint32_t seq = s->result_seq;
+    if (seq == s->result_seen) return false;
+
+    /* A completion during the copy writes the other buffer; re-read if the sequence moved. */
+    for (int tries = 0; tries < 2; tries++)
+    {
+        *out = s->result[s->result_front];
+        uint32_t seq2 = s->result_seq;
+        if (seq2 == seq) break;
+        seq = seq2;
+    }
+    s->result_seen = seq;
+    return true;
+}
+
+uint32_t edgeai_npu_dropped(const edgeai_npu_state_t *s)
+{
+    if (!s) return 0;
+    uint32_t pending = (s->job_pending >= 0) ? 1u : 0u;
+    return s->submitted - s->started - pending;
+}
+
+bool edgeai_npu_idle(const edgeai_npu_state_t *s)
+{
+    if (!s) return true;
+    if (s->job_pending >= 0) return false;
+    return (s->completed + s->failed) == s->started;
+}
+
+uint32_t edgeai_npu_model_count(void)
+{
+    if (edgeai_npu_is_tflm()) return edgeai_npu_neutron_model_count();
+    return 1u;
+}
+
+bool edgeai_npu_select_model(edgeai_npu_state_t *s, uint32_t id)
+{
+    if (!s || !s->init_ok || !edgeai_npu_idle(s)) return false;
+    if (!edgeai_npu_is_tflm()) return (id == 0u);
+
+    /* A first selection plans tensors into the shared scratch region. */
+    if (!edgeai_scratch_acquire(kEdgeAiScratchOwnerInference)) return false;
+    bool ok = edgeai_npu_neutron_select(s, id);
+    edgeai_scratch_release(kEdgeAiScratchOwnerInference);
+    return ok;
+}
+
+void edgeai_npu_record_input(edgeai_npu_state_t *s, const uint8_t *data, uint32_t n)
+{
+#if EDGEAI_NPU_RECORD
+    if (!s || !data || s->rec.ready) return;
+    if ((s->started % (uint32_t)EDGEAI_NPU_RECORD) != 0u) return;
+    if (n > EDGEAI_NPU_RECORD_MAX_BYTES) n = EDGEAI_NPU_RECORD_MAX_BYTES;
+    memcpy(s->rec.in, data, n);
+    s->rec.in_len = (uint16_t)n;
+    s->rec.seq = s->started;
+    s->rec.armed = true;
+#else
+    (void)s;
+    (void)data;
+    (void)n;
+#endif
+}
+
+void edgeai_npu_record_output(edgeai_npu_state_t *s, const uint8_t *data, uint32_t n, uint8_t glint)
+{
+#if EDGEAI_NPU_RECORD
+    if (!s || !data || !s->rec.armed) return;
+    if (n > EDGEAI_NPU_RECORD_MAX_BYTES) n = EDGEAI_NPU_RECORD_MAX_BYTES;
+    memcpy(s->rec.out, data, n);
+    s->rec.out_len = (uint16_t)n;
+    s->rec.glint = glint;
+    s->rec.armed = false;
+    s->rec.ready = true;
+#else
+    (void)s;
+    (void)data;
+    (void)n;
+    (void)glint;
+#endif
+}
+
+#if EDGEAI_NPU_RECORD
+static void edgeai_npu_record_hex(edgeai_npu_print_fn_t print_fn, const uint8_t *p, uint32_t n)
+{
+    static const char k_hex[] = "0123456789abcdef";
+    char buf[65];
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        buf[k++] = k_hex[p[i] >> 4];
+        buf[k++] = k_hex[p[i] & 15u];
+        if (k == 64u || i + 1u == n)
+        {
+            buf[k] = '\0';
+            print_fn("%s", buf);
+            k = 0;
+        }
+    }
+}
+#endif
+
+bool edgeai_npu_record_print(edgeai_npu_state_t *s, edgeai_npu_print_fn_t print_fn)
+{
+#if EDGEAI_NPU_RECORD
+    if (!s || !print_fn || !s->rec.ready) return false;
+    print_fn("EDGEAI: npu_rec %u glint=%u in=", (unsigned)s->rec.seq, (unsigned)s->rec.glint);
+    edgeai_npu_record_hex(print_fn, s->rec.in, s->rec.in_len);
+    print_fn(" out=");
+    edgeai_npu_record_hex(print_fn, s->rec.out, s->rec.out_len);
+    print_fn("\r\n");
+    s->rec.ready = false;
+    return true;
+#else
+    (void)s;
+    (void)print_fn;
+    return false;
+#endif
+}
@@ -3,21 +3,22 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef enum
 {
     kEdgeAiNpuBackendStub = 0,
     kEdgeAiNpuBackendNeutron = 1,
+    kEdgeAiNpuBackendHost = 2,
 } edgeai_npu_backend_t;
 
-typedef struct
-{
-    bool init_ok;
-} edgeai_npu_state_t;
-
 typedef struct
 {
     int32_t vx_q16;
     int32_t vy_q16;
+    bool tensor_ready; /* input tensor already holds a captured scene (scene_capture.h) */
 } edgeai_npu_input_t;
 
 typedef struct
@@ -25,6 +26,89 @@ typedef struct
     uint8_t glint;
 } edgeai_npu_output_t;
 
+typedef struct
+{
+    edgeai_npu_input_t in;
+    uint32_t submit_cyc;
+} edgeai_npu_job_t;
+
+/* Input tensor as seen by writers that fill it in place (NHWC, int8/uint8 only). */
+typedef struct
+{
+    uint8_t *data;
+    uint16_t w;
+    uint16_t h;
+    uint16_t c;
+    bool is_signed;
+    float scale;
+    int32_t zero_point;
+} edgeai_npu_tensor_view_t;
+
+/* Output recording for host regression (tools/npu_host_check.cpp): every EDGEAI_NPU_RECORD-th job,
+ * the packed input tensor and the raw output tensor are copied out of the job context and printed
+ * from the main loop as one `EDGEAI: npu_rec` line. 0 disables (no buffers).
+ */
+#ifndef EDGEAI_NPU_RECORD
+#define EDGEAI_NPU_RECORD 0
+#endif
+
+#ifndef EDGEAI_NPU_RECORD_MAX_BYTES
+#define EDGEAI_NPU_RECORD_MAX_BYTES 1024u
+#endif
+
+typedef struct
+{
+    uint8_t in[EDGEAI_NPU_RECORD_MAX_BYTES];
+    uint8_t out[EDGEAI_NPU_RECORD_MAX_BYTES];
+    uint16_t in_len;
+    uint16_t out_len;
+    uint8_t glint;
+    bool armed;          /* input captured, output pending */
+    volatile bool ready; /* complete record waiting to be printed */
+    uint32_t seq;        /* job number of the record */
+} edgeai_npu_record_t;
+
+typedef int (*edgeai_npu_print_fn_t)(const char *fmt, ...);
+
+typedef struct edgeai_npu_state edgeai_npu_state_t;
+
+/* Runs in the job context right after a successful step, while output tensors are still valid. */
+typedef void (*edgeai_npu_result_fn_t)(edgeai_npu_state_t *s, void *user);
+
+struct edgeai_npu_state
+{
+    bool init_ok;
+
+    /* Async pipeline state (edgeai_npu_submit / edgeai_npu_poll).
+     * Inputs and outputs are double-buffered: the main loop writes a job slot that is not
+     * published and reads a result slot that the deferred context is not writing.
+     */
+    edgeai_npu_job_t job[2];
+    uint32_t job_write;
+    volatile int32_t job_pending; /* published job slot, -1 when none */
+    edgeai_npu_output_t result[2];
+    volatile uint32_t result_front;
+    volatile uint32_t result_seq;
+    uint32_t result_seen;
+
+    /* Counters (monotonic). dropped = published jobs replaced before they started. */
+    uint32_t submitted;
+    volatile uint32_t started;
+    volatile uint32_t completed;
+    volatile uint32_t failed;
+    uint32_t skipped; /* submits rejected: backend not initialized or inference disabled */
+    volatile uint32_t last_latency_cyc; /* submit -> result */
+    volatile uint32_t last_run_cyc;     /* backend step only */
+    volatile uint32_t deferred;         /* job runs postponed because the scratch region was busy */
+
+    edgeai_npu_result_fn_t on_result;
+    void *on_result_user;
+
+#if EDGEAI_NPU_RECORD
+    edgeai_npu_record_t rec;
+#endif
+};
+
 /* NPU run gating.
  * Default is disabled; enable only after the selected backend is validated.
  */
@@ -32,14 +116,67 @@ typedef struct
 #define EDGEAI_ENABLE_NPU_INFERENCE 0
 #endif
 
-/* Backend selection: 0=stub, 1=neutron(TFLM+LinkServer). */
+/* Backend selection: 0=stub, 1=neutron(TFLM+LinkServer), 2=host (TFLM reference kernels on Linux,
+ * running the CPU-equivalent graph; see npu/model_ops_host.cpp).
+ */
 #ifndef EDGEAI_NPU_BACKEND
 #define EDGEAI_NPU_BACKEND ((int)kEdgeAiNpuBackendStub)
 #endif
 
+/* Async execution context:
+ * - 1: jobs run from a low-priority, software-pended interrupt (npu_defer.c), so `Invoke` never
+ *      runs inside the main loop's control flow. The deferred IRQ must stay below any interrupt the
+ *      backend itself waits on.
+ * - 0: jobs run from `edgeai_npu_poll` in the main loop (bring-up / host builds).
+ */
+#ifndef EDGEAI_NPU_ASYNC_DEFER_IRQ
+#define EDGEAI_NPU_ASYNC_DEFER_IRQ 1
+#endif
+
+/* Rotates through the registered models every N seconds (0 = stay on model 0); exercises hot switching. */
+#ifndef EDGEAI_NPU_MODEL_CYCLE_S
+#define EDGEAI_NPU_MODEL_CYCLE_S 0
+#endif
+
 edgeai_npu_backend_t edgeai_npu_backend(void);
 char edgeai_npu_backend_char(void);
 
 bool edgeai_npu_init(edgeai_npu_state_t *s);
 bool edgeai_npu_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai_npu_output_t *out);
 
+/* Input tensor view for zero-copy writers; false when the backend has no quantized image input. */
+bool edgeai_npu_input_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v);
+/* Output tensor view; with a shared scratch region only valid inside `on_result`. */
+bool edgeai_npu_output_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v);
+
+/* Non-blocking pipeline.
+ * - submit: copies `in` into a free job slot and publishes it (latest wins; an unstarted job is dropped).
+ * - poll: returns true once per completed job with the newest result; never waits.
+ */
+bool edgeai_npu_submit(edgeai_npu_state_t *s, const edgeai_npu_input_t *in);
+bool edgeai_npu_poll(edgeai_npu_state_t *s, edgeai_npu_output_t *out);
+uint32_t edgeai_npu_dropped(const edgeai_npu_state_t *s);
+/* True when no job is pending or running (the input tensor may be written). */
+bool edgeai_npu_idle(const edgeai_npu_state_t *s);
+
+/* Hot model switch (registry in npu/model.cpp). Only while idle; tensor views must be re-fetched after. */
+uint32_t edgeai_npu_model_count(void);
+bool edgeai_npu_select_model(edgeai_npu_state_t *s, uint32_t id);
+
+/* Recording hooks for the TFLM backends (no-ops unless EDGEAI_NPU_RECORD). */
+void edgeai_npu_record_input(edgeai_npu_state_t *s, const uint8_t *data, uint32_t n);
+void edgeai_npu_record_output(edgeai_npu_state_t *s, const uint8_t *data, uint32_t n, uint8_t glint);
+/* Prints and releases a completed record; false when none is waiting. */
+bool edgeai_npu_record_print(edgeai_npu_state_t *s, edgeai_npu_print_fn_t print_fn);
+
+/* Job body, called from the deferred context. */
+void edgeai_npu_async_run(edgeai_npu_state_t *s);
+
+/* Deferred-context platform hooks (npu_defer.c). */
+void edgeai_npu_defer_init(edgeai_npu_state_t *s);
+void edgeai_npu_defer_kick(void);
+uint32_t edgeai_npu_defer_now(void);
+
+#if defined(__cplusplus)
+}
+#endif
@@ -1,11 +1,16 @@
 #include "npu_api.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "edgeai_util.h"
 #include "npu/model.h"
+#include "tensor_util.h"
 
-/* Neutron backend: wraps the existing TFLM+Neutron integration and reduces output to a single 0..255 glint value. */
+/* Neutron backend: wraps the existing TFLM+Neutron integration and reduces output to a single 0..255 glint value.
+ * The host backend (EDGEAI_NPU_BACKEND=2) runs this same glue with the reference-kernel resolver of
+ * npu/model_ops_host.cpp and the CPU-equivalent graph, so packing and reduction match the target.
+ */
 
 static bool s_inited = false;
 static edgeai_tensor_dims_t s_in_dims = {0};
@@ -14,6 +19,8 @@ static uint8_t *s_in_data = nullptr;
 static edgeai_tensor_dims_t s_out_dims = {0};
 static edgeai_tensor_type_t s_out_type = kEdgeAiTensorType_UINT8;
 static uint8_t *s_out_data = nullptr;
+static float s_out_scale = 0.0f; /* 0: no affine quantization reported */
+static int32_t s_out_zp = 0;
 
 static uint32_t edgeai_dims_elems(const edgeai_tensor_dims_t *d)
 {
@@ -27,6 +34,19 @@ static uint32_t edgeai_dims_elems(const edgeai_tensor_dims_t *d)
     return n;
 }
 
+static bool edgeai_npu_neutron_refresh(void)
+{
+    s_in_data = EDGEAI_MODEL_GetInputTensorData(&s_in_dims, &s_in_type);
+    s_out_data = EDGEAI_MODEL_GetOutputTensorData(&s_out_dims, &s_out_type);
+    if (EDGEAI_MODEL_GetOutputQuantParams(&s_out_scale, &s_out_zp) != kStatus_Success || s_out_scale <= 0.0f)
+    {
+        s_out_scale = 0.0f;
+        s_out_zp = 0;
+    }
+    s_inited = (s_in_data != nullptr) && (s_out_data != nullptr);
+    return s_inited;
+}
+
 extern "C" bool edgeai_npu_neutron_init(edgeai_npu_state_t *s)
 {
     if (!s) return false;
@@ -37,63 +57,142 @@ extern "C" bool edgeai_npu_neutron_init(edgeai_npu_state_t *s)
     s_out_dims = {0};
     s_in_type = kEdgeAiTensorType_UINT8;
     s_out_type = kEdgeAiTensorType_UINT8;
+    s_out_scale = 0.0f;
+    s_out_zp = 0;
 
     /* Model init is known to fault on some setups; keep it gated. */
     if (!EDGEAI_ENABLE_NPU_INFERENCE) return false;
 
-    bool ok = (EDGEAI_MODEL_Init() == kStatus_Success);
-    if (!ok) return false;
+    if (EDGEAI_MODEL_Init() != kStatus_Success) return false;
+    return edgeai_npu_neutron_refresh();
+}
 
-    s_in_data = EDGEAI_MODEL_GetInputTensorData(&s_in_dims, &s_in_type);
-    s_out_data = EDGEAI_MODEL_GetOutputTensorData(&s_out_dims, &s_out_type);
-    ok = (s_in_data != nullptr) && (s_out_data != nullptr);
-    s_inited = ok;
-    return ok;
+extern "C" uint32_t edgeai_npu_neutron_model_count(void)
+{
+    return EDGEAI_MODEL_GetCount();
 }
 
-extern "C" bool edgeai_npu_neutron_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai_npu_output_t *out)
+extern "C" bool edgeai_npu_neutron_select(edgeai_npu_state_t *s, uint32_t id)
 {
     (void)s;
-    if (!s_inited || !in || !out) return false;
+    if (!s_inited) return false;
+    if (EDGEAI_MODEL_Select(id) != kStatus_Success) return false;
+    /* Each model has its own tensors; the cached pointers belong to the previous one. */
+    s_inited = false;
+    return edgeai_npu_neutron_refresh();
+}
 
-    uint32_t n = edgeai_dims_elems(&s_in_dims);
-    if (n == 0) n = 1;
+/* NHWC; lower ranks collapse to a single row/channel. */
+static bool edgeai_tensor_view(uint8_t *data, const edgeai_tensor_dims_t *d, edgeai_tensor_type_t type,
+                               float scale, int32_t zp, edgeai_npu_tensor_view_t *v)
+{
+    if (!data || type == kEdgeAiTensorType_FLOAT32) return false;
 
-    uint8_t base = 127u;
-    uint8_t amp = (uint8_t)edgeai_clamp_i32(edgeai_abs_i32(in->vx_q16 >> 16) + edgeai_abs_i32(in->vy_q16 >> 16), 0, 80);
-    for (uint32_t i = 0; i < n; i++)
+    uint32_t h = 1, w = 1, c = 1;
+    if (d->size == 4u)
+    {
+        h = d->data[1];
+        w = d->data[2];
+        c = d->data[3];
+    }
+    else if (d->size == 3u)
+    {
+        h = d->data[1];
+        w = d->data[2];
+    }
+    else
     {
-        uint8_t t = (uint8_t)(i & 31u);
-        uint8_t v = (t < 16u) ? (uint8_t)(base + (amp * t) / 16u) : (uint8_t)(base + (amp * (31u - t)) / 16u);
-        s_in_data[i] = v;
+        w = edgeai_dims_elems(d);
     }
+    if (w == 0u || h == 0u || c == 0u || w > 0xFFFFu || h > 0xFFFFu || c > 0xFFFFu) return false;
+
+    v->data = data;
+    v->w = (uint16_t)w;
+    v->h = (uint16_t)h;
+    v->c = (uint16_t)c;
+    v->is_signed = (type == kEdgeAiTensorType_INT8);
+    v->scale = scale;
+    v->zero_point = zp;
+    return true;
+}
 
-    if (EDGEAI_MODEL_RunInference() != kStatus_Success) return false;
+extern "C" bool edgeai_npu_neutron_input_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v)
+{
+    (void)s;
+    if (!s_inited || !v) return false;
+    float scale = 0.0f;
+    int32_t zp = 0;
+    if (EDGEAI_MODEL_GetInputQuantParams(&scale, &zp) != kStatus_Success) return false;
+    return edgeai_tensor_view(s_in_data, &s_in_dims, s_in_type, scale, zp, v);
+}
 
-    uint32_t out_n = edgeai_dims_elems(&s_out_dims);
-    if (out_n == 0) out_n = 1;
+extern "C" bool edgeai_npu_neutron_output_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v)
+{
+    (void)s;
+    if (!s_inited || !v) return false;
+    float scale = 0.0f;
+    int32_t zp = 0;
+    if (EDGEAI_MODEL_GetOutputQuantParams(&scale, &zp) != kStatus_Success) return false;
+    return edgeai_tensor_view(s_out_data, &s_out_dims, s_out_type, scale, zp, v);
+}
 
-    if (s_out_type == kEdgeAiTensorType_UINT8)
+/* Speed-driven triangle pattern for jobs without a captured scene: one 32-byte period, then copies. */
+static void edgeai_npu_pack_speed(const edgeai_npu_input_t *in, uint8_t *dst, uint32_t n)
+{
+    uint8_t base = 127u;
+    uint8_t amp = (uint8_t)edgeai_clamp_i32(edgeai_abs_i32(in->vx_q16 >> 16) + edgeai_abs_i32(in->vy_q16 >> 16), 0, 80);
+    uint8_t period[32];
+    for (uint32_t t = 0; t < 32u; t++)
     {
-        uint32_t m = 0;
-        for (uint32_t i = 0; i < out_n; i++) if (s_out_data[i] > m) m = s_out_data[i];
-        out->glint = (uint8_t)m;
-        return true;
+        period[t] = (t < 16u) ? (uint8_t)(base + (amp * t) / 16u) : (uint8_t)(base + (amp * (31u - t)) / 16u);
     }
-    if (s_out_type == kEdgeAiTensorType_INT8)
+    for (uint32_t i = 0; i < n; i += 32u)
     {
-        int8_t *p = (int8_t *)s_out_data;
-        int32_t mm = -128;
-        for (uint32_t i = 0; i < out_n; i++) if ((int32_t)p[i] > mm) mm = (int32_t)p[i];
-        out->glint = (uint8_t)edgeai_clamp_i32(mm + 128, 0, 255);
-        return true;
+        uint32_t len = (n - i < 32u) ? (n - i) : 32u;
+        memcpy(dst + i, period, len);
     }
+}
 
-    float *p = (float *)s_out_data;
-    float mm = p[0];
-    for (uint32_t i = 1; i < out_n; i++) if (p[i] > mm) mm = p[i];
-    if (mm < 0.0f) mm = 0.0f;
-    if (mm > 1.0f) mm = 1.0f;
-    out->glint = (uint8_t)(mm * 255.0f);
+/* Output maximum as real 0..1 mapped to 0..255. Quantized outputs reduce on codes and dequantize once
+ * with the tensor's scale/zero-point; without them the full code range maps to 0..255.
+ */
+static uint8_t edgeai_npu_reduce_glint(const uint8_t *data, edgeai_tensor_type_t type, uint32_t n)
+{
+    if (type == kEdgeAiTensorType_FLOAT32)
+    {
+        float mm = edgeai_tensor_max_f32((const float *)data, n);
+        if (mm < 0.0f) mm = 0.0f;
+        if (mm > 1.0f) mm = 1.0f;
+        return (uint8_t)(mm * 255.0f);
+    }
+
+    const bool is_signed = (type == kEdgeAiTensorType_INT8);
+    int32_t q = edgeai_tensor_max_q(data, n, is_signed);
+    if (s_out_scale > 0.0f) return edgeai_tensor_unit_u8(q, s_out_scale, s_out_zp);
+    return (uint8_t)(is_signed ? q + 128 : q);
+}
+
+static uint32_t edgeai_type_bytes(edgeai_tensor_type_t type)
+{
+    return (type == kEdgeAiTensorType_FLOAT32) ? 4u : 1u;
+}
+
+extern "C" bool edgeai_npu_neutron_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai_npu_output_t *out)
+{
+    if (!s_inited || !in || !out) return false;
+
+    /* A captured scene is already in the tensor; otherwise fall back to the speed-driven pattern. */
+    uint32_t in_n = edgeai_dims_elems(&s_in_dims);
+    if (in_n == 0) in_n = 1;
+    if (!in->tensor_ready) edgeai_npu_pack_speed(in, s_in_data, in_n);
+    /* Before Invoke: the planner may reuse the input buffer for later activations. */
+    edgeai_npu_record_input(s, s_in_data, in_n * edgeai_type_bytes(s_in_type));
+
+    if (EDGEAI_MODEL_RunInference() != kStatus_Success) return false;
+
+    uint32_t out_n = edgeai_dims_elems(&s_out_dims);
+    if (out_n == 0) out_n = 1;
+    out->glint = edgeai_npu_reduce_glint(s_out_data, s_out_type, out_n);
+    edgeai_npu_record_output(s, s_out_data, out_n * edgeai_type_bytes(s_out_type), out->glint);
     return true;
 }
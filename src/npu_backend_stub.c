@@ -1,6 +1,27 @@
 #include "npu_api.h"
 
 #include "edgeai_util.h"
+#include "postfx.h"
+
+/* Stub tensors: a luminance input the scene capture can fill and an effect map computed on the CPU,
+ * so the capture -> post-process -> composite path runs without the NPU.
+ */
+#define EDGEAI_STUB_TENSOR_W 80u
+#define EDGEAI_STUB_TENSOR_H 60u
+
+static uint8_t s_stub_in[EDGEAI_STUB_TENSOR_W * EDGEAI_STUB_TENSOR_H];
+static uint8_t s_stub_out[EDGEAI_STUB_TENSOR_W * EDGEAI_STUB_TENSOR_H];
+
+static void edgeai_npu_stub_view(uint8_t *data, edgeai_npu_tensor_view_t *v)
+{
+    v->data = data;
+    v->w = (uint16_t)EDGEAI_STUB_TENSOR_W;
+    v->h = (uint16_t)EDGEAI_STUB_TENSOR_H;
+    v->c = 1u;
+    v->is_signed = false;
+    v->scale = 1.0f / 255.0f;
+    v->zero_point = 0;
+}
 
 bool edgeai_npu_stub_init(edgeai_npu_state_t *s)
 {
@@ -8,11 +29,33 @@ bool edgeai_npu_stub_init(edgeai_npu_state_t *s)
     return true;
 }
 
+bool edgeai_npu_stub_input_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v)
+{
+    (void)s;
+    if (!v) return false;
+    edgeai_npu_stub_view(s_stub_in, v);
+    return true;
+}
+
+bool edgeai_npu_stub_output_view(edgeai_npu_state_t *s, edgeai_npu_tensor_view_t *v)
+{
+    (void)s;
+    if (!v) return false;
+    edgeai_npu_stub_view(s_stub_out, v);
+    return true;
+}
+
 bool edgeai_npu_stub_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai_npu_output_t *out)
 {
     (void)s;
     if (!in || !out) return false;
 
+    /* Deterministic CPU reference of the post-process model. */
+    if (in->tensor_ready)
+    {
+        edgeai_postfx_reference(EDGEAI_POSTFX_MODE, s_stub_in, EDGEAI_STUB_TENSOR_W, EDGEAI_STUB_TENSOR_H, s_stub_out);
+    }
+
     /* Procedural modulation based on speed. */
     int32_t sx = edgeai_abs_i32(in->vx_q16 >> 16);
     int32_t sy = edgeai_abs_i32(in->vy_q16 >> 16);
@@ -20,4 +63,3 @@ bool edgeai_npu_stub_step(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, e
     out->glint = (uint8_t)sp;
     return true;
 }
-
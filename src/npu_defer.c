@@ -0,0 +1,48 @@
+#include "npu_api.h"
+
+#include "fsl_common.h"
+
+/* Deferred NPU context: a spare peripheral vector used as a software interrupt.
+ * `edgeai_npu_submit` pends it; it runs at the lowest priority, so it only preempts thread mode
+ * (the main loop) and never the LCD/UART DMA or I2C interrupts.
+ * LP_FLEXCOMM9 is unused on this board setup; override both macros to move it.
+ */
+#ifndef EDGEAI_NPU_DEFER_IRQn
+#define EDGEAI_NPU_DEFER_IRQn LP_FLEXCOMM9_IRQn
+#endif
+#ifndef EDGEAI_NPU_DEFER_IRQHandler
+#define EDGEAI_NPU_DEFER_IRQHandler LP_FLEXCOMM9_IRQHandler
+#endif
+
+static edgeai_npu_state_t *s_deferState = NULL;
+
+void edgeai_npu_defer_init(edgeai_npu_state_t *s)
+{
+    s_deferState = s;
+#if EDGEAI_NPU_ASYNC_DEFER_IRQ
+    NVIC_SetPriority(EDGEAI_NPU_DEFER_IRQn, (1u << __NVIC_PRIO_BITS) - 1u);
+    NVIC_ClearPendingIRQ(EDGEAI_NPU_DEFER_IRQn);
+    NVIC_EnableIRQ(EDGEAI_NPU_DEFER_IRQn);
+#endif
+}
+
+void edgeai_npu_defer_kick(void)
+{
+#if EDGEAI_NPU_ASYNC_DEFER_IRQ
+    NVIC_SetPendingIRQ(EDGEAI_NPU_DEFER_IRQn);
+#endif
+}
+
+uint32_t edgeai_npu_defer_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+#if EDGEAI_NPU_ASYNC_DEFER_IRQ
+void EDGEAI_NPU_DEFER_IRQHandler(void);
+void EDGEAI_NPU_DEFER_IRQHandler(void)
+{
+    if (s_deferState) edgeai_npu_async_run(s_deferState);
+    __DSB();
+}
+#endif
@@ -2,6 +2,8 @@
 
 #include <string.h>
 
+#include "edgeai_math.h"
+
 #include "fsl_clock.h"
 #include "fsl_common.h"
 #include "fsl_debug_console.h"
@@ -42,6 +44,7 @@
 #define EDGEAI_FLEXIO_TIMER             0u
 
 static volatile bool s_memWriteDone = false;
+static uint32_t s_blitCycles = 0;
 static st7796s_handle_t s_lcdHandle;
 static dbi_flexio_edma_xfer_handle_t s_dbiFlexioXferHandle;
 
@@ -179,10 +182,19 @@ void par_lcd_s035_blit_rect(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint
     uint32_t h = (uint32_t)(y1 - y0 + 1);
     uint32_t n = w * h;
 
+    uint32_t t0 = DWT->CYCCNT;
     ST7796S_SelectArea(&s_lcdHandle, (uint16_t)x0, (uint16_t)y0, (uint16_t)x1, (uint16_t)y1);
     s_memWriteDone = false;
     ST7796S_WritePixels(&s_lcdHandle, rgb565, n);
     lcd_wait_write_done();
+    s_blitCycles += DWT->CYCCNT - t0;
+}
+
+uint32_t par_lcd_s035_take_blit_cycles(void)
+{
+    uint32_t c = s_blitCycles;
+    s_blitCycles = 0;
+    return c;
 }
 
 static void lcd_fill_span(uint16_t x0, uint16_t y, uint16_t x1, uint16_t color)
@@ -267,26 +279,6 @@ static inline uint16_t pack_rgb565_u8(uint32_t r8, uint32_t g8, uint32_t b8)
     return (uint16_t)((r << 11) | (g << 5) | b);
 }
 
-static inline uint32_t isqrt_u32(uint32_t x)
-{
-    /* Integer sqrt (floor). */
-    uint32_t op = x;
-    uint32_t res = 0;
-    uint32_t one = 1uL << 30;
-    while (one > op) one >>= 2;
-    while (one != 0)
-    {
-        if (op >= res + one)
-        {
-            op -= res + one;
-            res = res + 2u * one;
-        }
-        res >>= 1;
-        one >>= 2;
-    }
-    return res;
-}
-
 static inline uint32_t xorshift32(uint32_t x)
 {
     x ^= x << 13;
@@ -358,7 +350,8 @@ void par_lcd_s035_draw_silver_ball(int32_t cx, int32_t cy, int32_t r,
                                    uint32_t phase, uint8_t glint,
                                    int32_t spin_sin_q14, int32_t spin_cos_q14)
 {
-    if (r <= 0) return;
+    /* The normals divide by r through a reciprocal (edgeai_math.h), exact for r in 2..511. */
+    if (r <= 1) return;
 
     /* Ray-traced sphere shading for a single object (analytic ray/sphere). */
     const int32_t x0 = (cx - r < 0) ? 0 : (cx - r);
@@ -374,6 +367,7 @@ void par_lcd_s035_draw_silver_ball(int32_t cx, int32_t cy, int32_t r,
     const int32_t Lz = 11469;  /*  0.7 */
 
     const uint32_t r2 = (uint32_t)(r * r);
+    const uint32_t r_recip = edgeai_recip_u32((uint32_t)r);
     const uint32_t seed = (phase * 0xA511E9B3u) ^ ((uint32_t)glint * 0x63D83595u);
     const uint32_t off_u = (phase >> 3) & 255u;
     const uint32_t off_v = (phase >> 4) & 255u;
@@ -393,7 +387,7 @@ void par_lcd_s035_draw_silver_ball(int32_t cx, int32_t cy, int32_t r,
         }
 
         /* Compute max dx for this row. */
-        uint32_t dx_max = isqrt_u32(r2 - (uint32_t)dy2);
+        uint32_t dx_max = edgeai_isqrt_u32(r2 - (uint32_t)dy2);
         int32_t sx0 = cx - (int32_t)dx_max;
         int32_t sx1 = cx + (int32_t)dx_max;
         if (sx0 < x0) sx0 = x0;
@@ -406,12 +400,12 @@ void par_lcd_s035_draw_silver_ball(int32_t cx, int32_t cy, int32_t r,
             if (d2 > r2) continue;
 
             /* z = sqrt(r^2 - x^2 - y^2) */
-            uint32_t zz = isqrt_u32(r2 - d2);
+            uint32_t zz = edgeai_isqrt_u32(r2 - d2);
 
             /* Normal in Q14: n = (dx,dy,z)/r. */
-            int32_t nx = (dx << 14) / r;
-            int32_t ny = (dy << 14) / r;
-            int32_t nz = ((int32_t)zz << 14) / r;
+            int32_t nx = edgeai_div_recip_i32(dx << 14, r_recip);
+            int32_t ny = edgeai_div_recip_i32(dy << 14, r_recip);
+            int32_t nz = edgeai_div_recip_i32((int32_t)zz << 14, r_recip);
 
             /* Diffuse = max(dot(n, L), 0) in Q14. */
             int32_t ndl = (nx * Lx + ny * Ly + nz * Lz) >> 14;
@@ -422,20 +416,13 @@ void par_lcd_s035_draw_silver_ball(int32_t cx, int32_t cy, int32_t r,
             int32_t rz = ((2 * ndl * nz) >> 14) - Lz;
             if (rz < 0) rz = 0;
 
-            /* Normalize-ish spec base to [0..1] Q14 by dividing by 1.0*Q14 (approx). */
-            int32_t s = rz;
-            /* pow16 */
-            int32_t s2 = (s * s) >> 14;
-            int32_t s4 = (s2 * s2) >> 14;
-            int32_t s8 = (s4 * s4) >> 14;
-            int32_t s16 = (s8 * s8) >> 14;
+            /* Spec: rz^16. */
+            int32_t s16 = edgeai_pow16_q14(rz);
 
             /* Fresnel term ~ (1-nz)^5, nz in Q14. */
             int32_t inv = (1 << 14) - nz;
             if (inv < 0) inv = 0;
-            int32_t f2 = (inv * inv) >> 14;
-            int32_t f4 = (f2 * f2) >> 14;
-            int32_t f5 = (f4 * inv) >> 14;
+            int32_t f5 = edgeai_pow5_q14(inv);
 
             /* Base "silver" tint (kept slightly dark; reflections add punch). */
             uint32_t br = 150, bg = 155, bb = 165;
@@ -479,10 +466,7 @@ void par_lcd_s035_draw_silver_ball(int32_t cx, int32_t cy, int32_t r,
             /* Add a small sun spot in the sky. */
             int32_t sun_dot = (Rxr * Lx + Ryr * Ly + Rz * Lz) >> 14;
             if (sun_dot < 0) sun_dot = 0;
-            int32_t sd2 = (sun_dot * sun_dot) >> 14;
-            int32_t sd4 = (sd2 * sd2) >> 14;
-            int32_t sd8 = (sd4 * sd4) >> 14;
-            int32_t sd16 = (sd8 * sd8) >> 14;
+            int32_t sd16 = edgeai_pow16_q14(sun_dot);
             uint32_t sun_k = (uint32_t)((sd16 * 220) >> 14); /* 0..220 */
             env_r += sun_k;
             env_g += (sun_k * 210u) / 220u;
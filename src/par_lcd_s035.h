@@ -14,6 +14,9 @@ void par_lcd_s035_fill(uint16_t rgb565);
 /* Blit a full RGB565 rectangle to the LCD in one transfer (inclusive coords). */
 void par_lcd_s035_blit_rect(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t *rgb565);
 
+/* DWT cycles spent inside `par_lcd_s035_blit_rect` since the previous call (counter is cleared). */
+uint32_t par_lcd_s035_take_blit_cycles(void);
+
 /* Filled circle in LCD pixel coordinates. */
 void par_lcd_s035_draw_filled_circle(int32_t cx, int32_t cy, int32_t r, uint16_t rgb565);
 
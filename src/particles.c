@@ -0,0 +1,214 @@
+#include "particles.h"
+
+#include <string.h>
+
+#include "edgeai_config.h"
+#include "edgeai_util.h"
+
+/* Random speed added in every direction (px/s), so a bang with no clear direction still sprays. */
+#define PARTICLES_ISO_PX_S 60
+
+/* Sand tones around the grid's sand color. */
+static const uint16_t s_spray_rgb565[4] = {0xDDAEu, 0xE60Fu, 0xC52Cu, 0xF6F3u};
+
+static inline uint32_t particles_xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+/* dst * (32 - a) + src * a over 32, all three channels at once (green moved above blue). */
+static inline uint16_t particles_blend(uint16_t dst, uint16_t src, uint32_t a)
+{
+    uint32_t d = ((uint32_t)dst | ((uint32_t)dst << 16)) & 0x07E0F81Fu;
+    uint32_t s = ((uint32_t)src | ((uint32_t)src << 16)) & 0x07E0F81Fu;
+    uint32_t m = ((d * (32u - a) + s * a) >> 5) & 0x07E0F81Fu;
+    return (uint16_t)(m | (m >> 16));
+}
+
+static inline void particles_bounds_clear(int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1)
+{
+    *x0 = INT16_MAX;
+    *y0 = INT16_MAX;
+    *x1 = INT16_MIN;
+    *y1 = INT16_MIN;
+}
+
+static inline void particles_bounds_add(edgeai_particles_t *p, int32_t px, int32_t py)
+{
+    if (px < p->cur_x0) p->cur_x0 = (int16_t)px;
+    if (py < p->cur_y0) p->cur_y0 = (int16_t)py;
+    if (px + 1 > p->cur_x1) p->cur_x1 = (int16_t)(px + 1);
+    if (py + 1 > p->cur_y1) p->cur_y1 = (int16_t)(py + 1);
+}
+
+void edgeai_particles_init(edgeai_particles_t *p, uint32_t seed)
+{
+    if (!p) return;
+    memset(p, 0, sizeof(*p));
+    for (uint32_t i = 0; i < EDGEAI_PARTICLES_MAX; i++) p->next_free[i] = (uint16_t)(i + 1u);
+    p->free_head = 0;
+    p->frame_max = EDGEAI_PARTICLES_FRAME_MAX;
+    p->rng = seed ? seed : 0x2545F491u;
+    particles_bounds_clear(&p->cur_x0, &p->cur_y0, &p->cur_x1, &p->cur_y1);
+    particles_bounds_clear(&p->drawn_x0, &p->drawn_y0, &p->drawn_x1, &p->drawn_y1);
+}
+
+uint32_t edgeai_particles_burst(edgeai_particles_t *p, int32_t x_q16, int32_t y_q16, int32_t dvx_q16, int32_t dvy_q16,
+                                uint32_t n)
+{
+    if (!p) return 0;
+    uint32_t made = 0;
+    for (; made < n; made++)
+    {
+        if (p->free_head >= EDGEAI_PARTICLES_MAX)
+        {
+            p->dropped += n - made;
+            break;
+        }
+        uint16_t s = p->free_head;
+        p->free_head = p->next_free[s];
+
+        /* Along the impulse at 1/4..1 of it, plus up to half of it sideways and a random isotropic part. */
+        uint32_t r0 = particles_xorshift32(&p->rng);
+        uint32_t r1 = particles_xorshift32(&p->rng);
+        int64_t along_q16 = 16384 + (int64_t)(((r0 & 0xFFFFu) * 3u) >> 2);
+        int64_t side_q16 = (int64_t)(r0 >> 16) - 32768;
+        int32_t iso_x = (int32_t)((r1 & 0xFFu) - 128u) * PARTICLES_ISO_PX_S * 512;
+        int32_t iso_y = (int32_t)(((r1 >> 8) & 0xFFu) - 128u) * PARTICLES_ISO_PX_S * 512;
+        p->vx_q16[s] = (int32_t)((dvx_q16 * along_q16 - dvy_q16 * side_q16) >> 16) + iso_x;
+        p->vy_q16[s] = (int32_t)((dvy_q16 * along_q16 + dvx_q16 * side_q16) >> 16) + iso_y;
+        p->x_q16[s] = x_q16 + (int32_t)(((r1 >> 16) & 7u) - 3u) * 65536;
+        p->y_q16[s] = y_q16 + (int32_t)(((r1 >> 19) & 7u) - 3u) * 65536;
+        p->life[s] = (uint8_t)(EDGEAI_PARTICLES_LIFE / 2 + (r1 >> 22) % (EDGEAI_PARTICLES_LIFE / 2 + 1));
+        p->rgb565[s] = s_spray_rgb565[r1 >> 30];
+        particles_bounds_add(p, p->x_q16[s] >> 16, p->y_q16[s] >> 16);
+        p->live[p->live_n++] = s;
+    }
+    p->spawned += made;
+    return made;
+}
+
+void edgeai_particles_step(edgeai_particles_t *p, int32_t dt_q16, int32_t ax_q16, int32_t ay_q16)
+{
+    if (!p || p->live_n == 0u) return;
+
+    /* Over the cap: the oldest go first. */
+    uint32_t first = 0;
+    if (p->live_n > p->frame_max)
+    {
+        first = (uint32_t)p->live_n - p->frame_max;
+        for (uint32_t i = 0; i < first; i++)
+        {
+            uint16_t s = p->live[i];
+            p->next_free[s] = p->free_head;
+            p->free_head = s;
+        }
+        p->retired += first;
+    }
+
+    particles_bounds_clear(&p->cur_x0, &p->cur_y0, &p->cur_x1, &p->cur_y1);
+    const int32_t dvx = (int32_t)(((int64_t)ax_q16 * dt_q16) >> 16);
+    const int32_t dvy = (int32_t)(((int64_t)ay_q16 * dt_q16) >> 16);
+    uint32_t out = 0;
+    for (uint32_t i = first; i < p->live_n; i++)
+    {
+        uint16_t s = p->live[i];
+        int32_t vx = (int32_t)(((int64_t)(p->vx_q16[s] + dvx) * EDGEAI_PARTICLES_DAMP_Q16) >> 16);
+        int32_t vy = (int32_t)(((int64_t)(p->vy_q16[s] + dvy) * EDGEAI_PARTICLES_DAMP_Q16) >> 16);
+        int32_t x = p->x_q16[s] + (int32_t)(((int64_t)vx * dt_q16) >> 16);
+        int32_t y = p->y_q16[s] + (int32_t)(((int64_t)vy * dt_q16) >> 16);
+        uint32_t life = p->life[s];
+        int32_t px = x >> 16;
+        int32_t py = y >> 16;
+        bool on_screen = px >= 0 && py >= 0 && px < EDGEAI_LCD_W - 1 && py < EDGEAI_LCD_H - 1;
+        if (life <= 1u || !on_screen)
+        {
+            p->next_free[s] = p->free_head;
+            p->free_head = s;
+            continue;
+        }
+        p->vx_q16[s] = vx;
+        p->vy_q16[s] = vy;
+        p->x_q16[s] = x;
+        p->y_q16[s] = y;
+        p->life[s] = (uint8_t)(life - 1u);
+        particles_bounds_add(p, px, py);
+        p->live[out++] = s;
+    }
+    p->live_n = (uint16_t)out;
+}
+
+void edgeai_particles_draw(const edgeai_particles_t *p, uint16_t *dst, uint32_t w, uint32_t h, int32_t x0,
+                           int32_t y0)
+{
+    if (!p || !dst || p->live_n == 0u) return;
+    if (p->cur_x1 < x0 || p->cur_y1 < y0 || p->cur_x0 >= x0 + (int32_t)w || p->cur_y0 >= y0 + (int32_t)h) return;
+
+    for (uint32_t i = 0; i < p->live_n; i++)
+    {
+        uint16_t s = p->live[i];
+        uint32_t life = p->life[s];
+        uint32_t a = (life * 32u) / (uint32_t)EDGEAI_PARTICLES_LIFE;
+        if (a > 32u) a = 32u;
+        int32_t size = (life * 2u > (uint32_t)EDGEAI_PARTICLES_LIFE) ? 2 : 1;
+        int32_t tx = (p->x_q16[s] >> 16) - x0;
+        int32_t ty = (p->y_q16[s] >> 16) - y0;
+        for (int32_t yy = ty; yy < ty + size; yy++)
+        {
+            if ((uint32_t)yy >= h) continue;
+            uint16_t *row = &dst[(uint32_t)yy * w];
+            for (int32_t xx = tx; xx < tx + size; xx++)
+            {
+                if ((uint32_t)xx >= w) continue;
+                row[xx] = particles_blend(row[xx], p->rgb565[s], a);
+            }
+        }
+    }
+}
+
+bool edgeai_particles_dirty_rect(const edgeai_particles_t *p, int32_t *x0, int32_t *y0, int32_t *x1, int32_t *y1)
+{
+    if (!p || !x0 || !y0 || !x1 || !y1) return false;
+    bool cur = p->cur_x0 <= p->cur_x1 && p->live_n != 0u;
+    bool drawn = p->drawn_x0 <= p->drawn_x1;
+    if (!cur && !drawn) return false;
+    int32_t ax0 = INT16_MAX, ay0 = INT16_MAX, ax1 = INT16_MIN, ay1 = INT16_MIN;
+    if (cur)
+    {
+        ax0 = p->cur_x0;
+        ay0 = p->cur_y0;
+        ax1 = p->cur_x1;
+        ay1 = p->cur_y1;
+    }
+    if (drawn)
+    {
+        if (p->drawn_x0 < ax0) ax0 = p->drawn_x0;
+        if (p->drawn_y0 < ay0) ay0 = p->drawn_y0;
+        if (p->drawn_x1 > ax1) ax1 = p->drawn_x1;
+        if (p->drawn_y1 > ay1) ay1 = p->drawn_y1;
+    }
+    *x0 = edgeai_clamp_i32(ax0, 0, EDGEAI_LCD_W - 1);
+    *y0 = edgeai_clamp_i32(ay0, 0, EDGEAI_LCD_H - 1);
+    *x1 = edgeai_clamp_i32(ax1, 0, EDGEAI_LCD_W - 1);
+    *y1 = edgeai_clamp_i32(ay1, 0, EDGEAI_LCD_H - 1);
+    return true;
+}
+
+void edgeai_particles_mark_drawn(edgeai_particles_t *p)
+{
+    if (!p) return;
+    if (p->live_n == 0u)
+    {
+        particles_bounds_clear(&p->drawn_x0, &p->drawn_y0, &p->drawn_x1, &p->drawn_y1);
+        return;
+    }
+    p->drawn_x0 = p->cur_x0;
+    p->drawn_y0 = p->cur_y0;
+    p->drawn_x1 = p->cur_x1;
+    p->drawn_y1 = p->cur_y1;
+}
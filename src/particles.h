@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Pooled particles for the sand spray thrown up by a bang.
+ * Fixed capacity, struct-of-arrays Q16 state and a free list of slots: nothing is allocated, a burst takes
+ * slots from the free list and a dead particle returns its slot. The live slots are kept in a dense list in
+ * spawn order (oldest first), so integration and rasterization are plain loops over it.
+ *
+ * Cost cap: at most `frame_max` particles are integrated and drawn per frame; a step that finds more alive
+ * retires the oldest first. A particle leaving the screen or reaching the end of its life is freed.
+ */
+
+#ifndef EDGEAI_PARTICLES_ENABLE
+#define EDGEAI_PARTICLES_ENABLE 1
+#endif
+
+/* Pool capacity (slots). */
+#ifndef EDGEAI_PARTICLES_MAX
+#define EDGEAI_PARTICLES_MAX 256
+#endif
+
+/* Default per-frame cap on live particles (integrated + drawn). */
+#ifndef EDGEAI_PARTICLES_FRAME_MAX
+#define EDGEAI_PARTICLES_FRAME_MAX 192
+#endif
+
+/* Particles per bang at the full bang gain (fewer for weaker bangs). */
+#ifndef EDGEAI_PARTICLES_PER_BANG
+#define EDGEAI_PARTICLES_PER_BANG 48
+#endif
+
+/* Longest life in frames; a particle fades out over its life and shrinks from 2 px to 1 px halfway. */
+#ifndef EDGEAI_PARTICLES_LIFE
+#define EDGEAI_PARTICLES_LIFE 40
+#endif
+
+/* Velocity kept per frame (Q16): the spray slows quickly, like sand in air. */
+#ifndef EDGEAI_PARTICLES_DAMP_Q16
+#define EDGEAI_PARTICLES_DAMP_Q16 60293
+#endif
+
+#if EDGEAI_PARTICLES_MAX > 65535
+#error "EDGEAI_PARTICLES_MAX must fit the uint16_t slot lists"
+#endif
+
+typedef struct
+{
+    /* Per slot (SoA). */
+    int32_t x_q16[EDGEAI_PARTICLES_MAX];
+    int32_t y_q16[EDGEAI_PARTICLES_MAX];
+    int32_t vx_q16[EDGEAI_PARTICLES_MAX];
+    int32_t vy_q16[EDGEAI_PARTICLES_MAX];
+    uint16_t rgb565[EDGEAI_PARTICLES_MAX];
+    uint8_t life[EDGEAI_PARTICLES_MAX]; /* frames left */
+    uint16_t next_free[EDGEAI_PARTICLES_MAX];
+
+    uint16_t live[EDGEAI_PARTICLES_MAX]; /* live slots, oldest first */
+    uint16_t live_n;
+    uint16_t free_head; /* EDGEAI_PARTICLES_MAX: pool empty */
+    uint16_t frame_max;
+    uint32_t rng;
+
+    /* Bounds of the current dots and of the dots last drawn (LCD px, inclusive); empty when x0 > x1. */
+    int16_t cur_x0, cur_y0, cur_x1, cur_y1;
+    int16_t drawn_x0, drawn_y0, drawn_x1, drawn_y1;
+
+    /* Counters (monotonic). */
+    uint32_t spawned;
+    uint32_t dropped; /* burst particles with no free slot */
+    uint32_t retired; /* retired early by the cap */
+} edgeai_particles_t;
+
+void edgeai_particles_init(edgeai_particles_t *p, uint32_t seed);
+
+/* Spawns up to `n` particles at (x, y) (LCD px, Q16), thrown along the impulse (dvx, dvy) (Q16 px/s) in a
+ * fan with random spread and speed. Returns the number spawned.
+ */
+uint32_t edgeai_particles_burst(edgeai_particles_t *p, int32_t x_q16, int32_t y_q16, int32_t dvx_q16, int32_t dvy_q16,
+                                uint32_t n);
+
+/* Integrates every live particle over one frame of dt_q16 seconds under acceleration (ax, ay) (Q16 px/s^2),
+ * ages it, retires dead and out-of-bounds particles to the free list and updates the current bounds.
+ */
+void edgeai_particles_step(edgeai_particles_t *p, int32_t dt_q16, int32_t ax_q16, int32_t ay_q16);
+
+/* Rasterizes the live particles into a w x h RGB565 tile at LCD offset (x0, y0), blended by age. */
+void edgeai_particles_draw(const edgeai_particles_t *p, uint16_t *dst, uint32_t w, uint32_t h, int32_t x0,
+                           int32_t y0);
+
+/* Rectangle to redraw this frame: the dots last drawn plus the current ones. Returns false when both are
+ * empty.
+ */
+bool edgeai_particles_dirty_rect(const edgeai_particles_t *p, int32_t *x0, int32_t *y0, int32_t *x1, int32_t *y1);
+
+/* Records the current dots as drawn (after the frame's blits). */
+void edgeai_particles_mark_drawn(edgeai_particles_t *p);
@@ -0,0 +1,153 @@
+#include "postfx.h"
+
+#include <string.h>
+
+#include "edgeai_config.h"
+#include "edgeai_util.h"
+#include "tensor_util.h"
+
+void edgeai_postfx_init(edgeai_postfx_t *fx, edgeai_postfx_mode_t mode, uint16_t glow_rgb565)
+{
+    if (!fx) return;
+    memset(fx, 0, sizeof(*fx));
+    fx->mode = mode;
+    fx->glow_rgb565 = glow_rgb565;
+}
+
+bool edgeai_postfx_load(edgeai_postfx_t *fx, const edgeai_npu_tensor_view_t *v)
+{
+    if (!fx || !v || !v->data || v->scale <= 0.0f) return false;
+    if (v->w < 2u || v->h < 2u || v->c == 0u) return false;
+    if (v->w > EDGEAI_POSTFX_MAP_MAX_W || v->h > EDGEAI_POSTFX_MAP_MAX_H) return false;
+
+    /* One dequantize per code, then a table lookup per element. */
+    uint8_t lut[256];
+    edgeai_tensor_dequant_lut(v->scale, v->zero_point, v->is_signed, 255.0f, lut);
+
+    uint32_t n = (uint32_t)v->w * (uint32_t)v->h;
+    const uint8_t *src = v->data;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        fx->map[i] = lut[*src];
+        src += v->c;
+    }
+    fx->w = v->w;
+    fx->h = v->h;
+    fx->loads++;
+    return true;
+}
+
+static inline uint32_t postfx_px(const uint8_t *lum, uint32_t w, uint32_t h, int32_t x, int32_t y)
+{
+    x = edgeai_clamp_i32(x, 0, (int32_t)w - 1);
+    y = edgeai_clamp_i32(y, 0, (int32_t)h - 1);
+    return lum[(uint32_t)y * w + (uint32_t)x];
+}
+
+void edgeai_postfx_reference(edgeai_postfx_mode_t mode, const uint8_t *lum, uint32_t w, uint32_t h, uint8_t *out)
+{
+    if (!lum || !out || w == 0 || h == 0) return;
+
+    for (int32_t y = 0; y < (int32_t)h; y++)
+    {
+        for (int32_t x = 0; x < (int32_t)w; x++)
+        {
+            int32_t v;
+            if (mode == kEdgeAiPostFxEdge)
+            {
+                int32_t p00 = (int32_t)postfx_px(lum, w, h, x - 1, y - 1);
+                int32_t p10 = (int32_t)postfx_px(lum, w, h, x, y - 1);
+                int32_t p20 = (int32_t)postfx_px(lum, w, h, x + 1, y - 1);
+                int32_t p01 = (int32_t)postfx_px(lum, w, h, x - 1, y);
+                int32_t p21 = (int32_t)postfx_px(lum, w, h, x + 1, y);
+                int32_t p02 = (int32_t)postfx_px(lum, w, h, x - 1, y + 1);
+                int32_t p12 = (int32_t)postfx_px(lum, w, h, x, y + 1);
+                int32_t p22 = (int32_t)postfx_px(lum, w, h, x + 1, y + 1);
+                int32_t gx = (p20 + 2 * p21 + p22) - (p00 + 2 * p01 + p02);
+                int32_t gy = (p02 + 2 * p12 + p22) - (p00 + 2 * p10 + p20);
+                v = (edgeai_abs_i32(gx) + edgeai_abs_i32(gy)) >> 2;
+            }
+            else
+            {
+                /* Bright-pass (>= 160 maps to 0..255), then box blur; 7282/65536 ~= 1/9. */
+                uint32_t sum = 0;
+                for (int32_t dy = -1; dy <= 1; dy++)
+                {
+                    for (int32_t dx = -1; dx <= 1; dx++)
+                    {
+                        int32_t b = (int32_t)postfx_px(lum, w, h, x + dx, y + dy) - 160;
+                        if (b > 0) sum += (uint32_t)((b * 255) / 95);
+                    }
+                }
+                v = (int32_t)((sum * 7282u) >> 16);
+            }
+            out[(uint32_t)y * w + (uint32_t)x] = (uint8_t)edgeai_clamp_i32(v, 0, 255);
+        }
+    }
+}
+
+void edgeai_postfx_composite(const edgeai_postfx_t *fx, uint16_t *tile, uint32_t tw, uint32_t th, int32_t x0, int32_t y0)
+{
+    if (!fx || !tile || fx->w == 0 || fx->h == 0 || tw == 0 || th == 0) return;
+
+    const int32_t mw = fx->w;
+    const int32_t mh = fx->h;
+    const int32_t umax = (mw - 1) << 16;
+    const int32_t vmax = (mh - 1) << 16;
+
+    /* Map coordinate of pixel centers in Q16: u = (sx + 0.5) * mw / W - 0.5. */
+    const int32_t du = (int32_t)(((uint32_t)mw << 16) / EDGEAI_LCD_W);
+    const int32_t dv = (int32_t)(((uint32_t)mh << 16) / EDGEAI_LCD_H);
+    const int32_t u0 = x0 * du + (du >> 1) - (1 << 15);
+
+    const uint32_t gr = (uint32_t)(fx->glow_rgb565 >> 11) & 0x1Fu;
+    const uint32_t gg = (uint32_t)(fx->glow_rgb565 >> 5) & 0x3Fu;
+    const uint32_t gb = (uint32_t)fx->glow_rgb565 & 0x1Fu;
+    const bool additive = (fx->mode != kEdgeAiPostFxEdge);
+
+    for (uint32_t y = 0; y < th; y++)
+    {
+        int32_t v = (y0 + (int32_t)y) * dv + (dv >> 1) - (1 << 15);
+        v = edgeai_clamp_i32(v, 0, vmax);
+        int32_t iy = v >> 16;
+        uint32_t fy = (uint32_t)(v >> 8) & 0xFFu;
+        const uint8_t *r0 = &fx->map[iy * mw];
+        const uint8_t *r1 = (iy + 1 < mh) ? (r0 + mw) : r0;
+
+        uint16_t *row = &tile[y * tw];
+        int32_t u = u0;
+        for (uint32_t x = 0; x < tw; x++, u += du)
+        {
+            int32_t uc = edgeai_clamp_i32(u, 0, umax);
+            int32_t ix = uc >> 16;
+            uint32_t fx8 = (uint32_t)(uc >> 8) & 0xFFu;
+            int32_t ix1 = (ix + 1 < mw) ? (ix + 1) : ix;
+
+            uint32_t top = (uint32_t)r0[ix] * (256u - fx8) + (uint32_t)r0[ix1] * fx8;
+            uint32_t bot = (uint32_t)r1[ix] * (256u - fx8) + (uint32_t)r1[ix1] * fx8;
+            uint32_t a = (top * (256u - fy) + bot * fy) >> 16; /* 0..255 */
+            if (a == 0) continue;
+
+            uint32_t c = row[x];
+            uint32_t r = (c >> 11) & 0x1Fu;
+            uint32_t g = (c >> 5) & 0x3Fu;
+            uint32_t b = c & 0x1Fu;
+            if (additive)
+            {
+                r += (gr * a) >> 8;
+                g += (gg * a) >> 8;
+                b += (gb * a) >> 8;
+                if (r > 0x1Fu) r = 0x1Fu;
+                if (g > 0x3Fu) g = 0x3Fu;
+                if (b > 0x1Fu) b = 0x1Fu;
+            }
+            else
+            {
+                r = (r * (256u - a) + gr * a) >> 8;
+                g = (g * (256u - a) + gg * a) >> 8;
+                b = (b * (256u - a) + gb * a) >> 8;
+            }
+            row[x] = (uint16_t)((r << 11) | (g << 5) | b);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "npu_api.h"
+
+/* NPU post-process composite (docs/TODO.md N1).
+ * A low-res effect map (0..255 intensity) is bilinearly upsampled over each dirty tile right before
+ * the blit and blended in as an additive glow or an edge outline. The map comes from the model's output
+ * tensor (`edgeai_postfx_load`); the stub backend produces it with `edgeai_postfx_reference`, the
+ * deterministic CPU version of the same effect.
+ */
+
+#ifndef EDGEAI_POSTFX_ENABLE
+#define EDGEAI_POSTFX_ENABLE 1
+#endif
+
+#ifndef EDGEAI_POSTFX_MAP_MAX_W
+#define EDGEAI_POSTFX_MAP_MAX_W 80
+#endif
+
+#ifndef EDGEAI_POSTFX_MAP_MAX_H
+#define EDGEAI_POSTFX_MAP_MAX_H 60
+#endif
+
+typedef enum
+{
+    kEdgeAiPostFxGlow = 0, /* additive: rgb += glow * a */
+    kEdgeAiPostFxEdge = 1, /* outline: rgb = lerp(rgb, glow, a) */
+} edgeai_postfx_mode_t;
+
+#ifndef EDGEAI_POSTFX_MODE
+#define EDGEAI_POSTFX_MODE kEdgeAiPostFxGlow
+#endif
+
+#ifndef EDGEAI_POSTFX_GLOW_RGB565
+#define EDGEAI_POSTFX_GLOW_RGB565 0xFEA0u
+#endif
+
+typedef struct
+{
+    edgeai_postfx_mode_t mode;
+    uint16_t glow_rgb565;
+    uint16_t w; /* 0: no map loaded, composite is a no-op */
+    uint16_t h;
+    uint32_t loads;
+    uint8_t map[EDGEAI_POSTFX_MAP_MAX_W * EDGEAI_POSTFX_MAP_MAX_H];
+} edgeai_postfx_t;
+
+void edgeai_postfx_init(edgeai_postfx_t *fx, edgeai_postfx_mode_t mode, uint16_t glow_rgb565);
+
+/* Copies a spatial output tensor (w,h > 1; channel 0) into the map, dequantized to 0..255 for real 0..1.
+ * Returns false (map unchanged) for non-spatial or oversized outputs.
+ */
+bool edgeai_postfx_load(edgeai_postfx_t *fx, const edgeai_npu_tensor_view_t *v);
+
+/* CPU reference effect over a luminance image (w*h bytes), written to `out` (w*h bytes).
+ * Glow: bright-pass then 3x3 box blur. Edge: Sobel |gx|+|gy|. Borders clamp to edge.
+ */
+void edgeai_postfx_reference(edgeai_postfx_mode_t mode, const uint8_t *lum, uint32_t w, uint32_t h, uint8_t *out);
+
+/* Blends the upsampled map into an RGB565 tile at (x0,y0) in LCD space. */
+void edgeai_postfx_composite(const edgeai_postfx_t *fx, uint16_t *tile, uint32_t tw, uint32_t th, int32_t x0, int32_t y0);
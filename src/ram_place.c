@@ -0,0 +1,159 @@
+#include "ram_place.h"
+
+#include <string.h>
+
+#include "accel_proc.h"
+#include "edgeai_config.h"
+#include "edgeai_math.h"
+#include "sim_world.h"
+#include "sw_render.h"
+
+#define RAM_PLACE_BALL_D (2 * EDGEAI_BALL_R_MAX + 1)
+
+_Static_assert(3u * sizeof(int32_t) * EDGEAI_RAM_PLACE_CALLS <= EDGEAI_RAM_PLACE_SCRATCH_BYTES &&
+                   sizeof(sim_input_t) * EDGEAI_RAM_PLACE_CALLS <= EDGEAI_RAM_PLACE_SCRATCH_BYTES,
+               "ram_place inputs exceed the scratch");
+_Static_assert(RAM_PLACE_BALL_D * RAM_PLACE_BALL_D * sizeof(uint16_t) <= EDGEAI_RAM_PLACE_SCRATCH_BYTES,
+               "ram_place scratch smaller than one ball frame");
+
+static inline uint32_t ram_place_lcg(uint32_t *s)
+{
+    *s = *s * 1664525u + 1013904223u;
+    return *s;
+}
+
+bool edgeai_ram_place_in_ram(uintptr_t addr)
+{
+    uint32_t a = (uint32_t)addr & ~0x10000000u; /* secure alias */
+    return (a >= 0x04000000u && a < 0x04018000u) || (a >= 0x20000000u && a < 0x20080000u);
+}
+
+static void ram_place_code(edgeai_ram_place_result_t *r, const char *name, uintptr_t code, const void *data)
+{
+    r->name = name;
+    r->calls = EDGEAI_RAM_PLACE_CALLS;
+    r->code = code;
+    r->data = (uintptr_t)data;
+    r->code_in_ram = edgeai_ram_place_in_ram(code);
+    r->data_in_ram = data != NULL && edgeai_ram_place_in_ram((uintptr_t)data);
+}
+
+/* Tilt sweeps with noise and an impact every so often. */
+static void ram_place_accel(edgeai_ram_place_clock_fn_t clock, int32_t *raw, edgeai_ram_place_result_t *r)
+{
+    uint32_t rng = 0xACC3u;
+    for (uint32_t i = 0; i < EDGEAI_RAM_PLACE_CALLS; i++)
+    {
+        uint32_t k = ram_place_lcg(&rng);
+        int32_t sweep = (int32_t)(i * 8u) - (int32_t)(EDGEAI_RAM_PLACE_CALLS * 4u);
+        raw[3 * i + 0] = sweep + (int32_t)(k & 31u) - 16;
+        raw[3 * i + 1] = -sweep / 2 + (int32_t)((k >> 5) & 31u) - 16;
+        raw[3 * i + 2] = EDGEAI_ACCEL_MAP_DENOM + (((i % 61u) == 0u) ? 700 : 0);
+    }
+    accel_proc_t s;
+    accel_proc_out_t o;
+    accel_proc_init(&s);
+    accel_proc_update(&s, raw[0], raw[1], raw[2], &o);
+    uint32_t t0 = clock();
+    for (uint32_t i = 0; i < EDGEAI_RAM_PLACE_CALLS; i++)
+    {
+        accel_proc_update(&s, raw[3 * i], raw[3 * i + 1], raw[3 * i + 2], &o);
+    }
+    r->ticks = clock() - t0;
+#if EDGEAI_ACCEL_FLOAT
+    ram_place_code(r, "accel_proc_update", (uintptr_t)accel_proc_update_float, NULL);
+#else
+    ram_place_code(r, "accel_proc_update", (uintptr_t)accel_proc_update_fixed, NULL);
+#endif
+}
+
+/* Tilt and slope with bangs, so the steps include wall bounces. */
+static void ram_place_sim(edgeai_ram_place_clock_fn_t clock, sim_input_t *in, edgeai_ram_place_result_t *r)
+{
+    uint32_t rng = 0x51D3u;
+    for (uint32_t i = 0; i < EDGEAI_RAM_PLACE_CALLS; i++)
+    {
+        uint32_t k = ram_place_lcg(&rng);
+        memset(&in[i], 0, sizeof(in[i]));
+        in[i].ax_soft_q15 = ((i / 64u) & 1u) ? 24000 : -24000;
+        in[i].ay_soft_q15 = ((i / 40u) & 1u) ? 20000 : -20000;
+        in[i].slope_x_q8 = (int32_t)(k & 127u) - 64;
+        in[i].slope_y_q8 = (int32_t)((k >> 7) & 127u) - 64;
+        if ((i % 50u) == 0u) in[i].bang_dvx_q16 = EDGEAI_BANG_GAIN_Q16;
+    }
+    sim_params_t p;
+    memset(&p, 0, sizeof(p));
+    p.sim_step_q16 = (int32_t)((1u << 16) / 120u);
+    p.a_px_s2 = 3780;
+    p.damp_q16 = 65000;
+    p.minx = EDGEAI_BALL_R_MAX + 2;
+    p.miny = EDGEAI_BALL_R_MAX + 2;
+    p.maxx = (EDGEAI_LCD_W - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p.maxy = (EDGEAI_LCD_H - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p.terrain_a_px_s2 = EDGEAI_TERRAIN_A_PX_S2;
+    sim_world_t w;
+    sim_world_init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    sim_step(&w, &in[0], &p);
+    uint32_t t0 = clock();
+    for (uint32_t i = 0; i < EDGEAI_RAM_PLACE_CALLS; i++) sim_step(&w, &in[i], &p);
+    r->ticks = clock() - t0;
+#if EDGEAI_SIM_FLOAT
+    ram_place_code(r, "sim_step", (uintptr_t)sim_step_float, NULL);
+#else
+    ram_place_code(r, "sim_step", (uintptr_t)sim_step_fixed, NULL);
+#endif
+}
+
+/* The shipped texture (the live copy, if any, is swapped out for the run): blocks walk across the screen
+ * so the reads cover the whole texture.
+ */
+static void ram_place_dune_bg(edgeai_ram_place_clock_fn_t clock, uint16_t *dst, edgeai_ram_place_result_t *r)
+{
+    const uint16_t *prev = sw_render_dune_tex(NULL, NULL);
+    sw_render_set_dune_tex(NULL);
+    const uint16_t *tex = sw_render_dune_tex(NULL, NULL);
+    const uint32_t bw = EDGEAI_RAM_PLACE_BG_W, bh = EDGEAI_RAM_PLACE_BG_H;
+    const uint32_t nx = EDGEAI_LCD_W / bw, ny = EDGEAI_LCD_H / bh;
+    sw_render_dune_bg(dst, bw, bh, 0, 0);
+    uint32_t t0 = clock();
+    for (uint32_t i = 0; i < EDGEAI_RAM_PLACE_CALLS; i++)
+    {
+        uint32_t b = i % (nx * ny);
+        sw_render_dune_bg(dst, bw, bh, (int32_t)((b % nx) * bw), (int32_t)((b / nx) * bh));
+    }
+    r->ticks = clock() - t0;
+    sw_render_set_dune_tex(prev);
+    ram_place_code(r, "sw_render_dune_bg", (uintptr_t)sw_render_dune_bg, tex);
+}
+
+/* The largest ball over a range of phases and glints. */
+static void ram_place_ball(edgeai_ram_place_clock_fn_t clock, uint16_t *dst, edgeai_ram_place_result_t *r)
+{
+    const int32_t d = RAM_PLACE_BALL_D;
+    const int32_t c = EDGEAI_BALL_R_MAX;
+    memset(dst, 0, (size_t)d * (size_t)d * sizeof(uint16_t));
+    sw_render_silver_ball(dst, (uint32_t)d, (uint32_t)d, 0, 0, c, c, c, 0u, 0u, 0, 16384);
+    uint32_t t0 = clock();
+    for (uint32_t i = 0; i < EDGEAI_RAM_PLACE_CALLS; i++)
+    {
+        sw_render_silver_ball(dst, (uint32_t)d, (uint32_t)d, 0, 0, c, c, c, i * 157u, (uint8_t)i, 0, 16384);
+    }
+    r->ticks = clock() - t0;
+#if EDGEAI_BALL_SHADE_FLOAT
+    ram_place_code(r, "sw_render_silver_ball", (uintptr_t)sw_render_silver_ball_float, NULL);
+#else
+    ram_place_code(r, "sw_render_silver_ball", (uintptr_t)sw_render_silver_ball_fixed, g_edgeai_isqrt_seed);
+#endif
+}
+
+bool edgeai_ram_place_run(edgeai_ram_place_clock_fn_t clock, void *scratch, uint32_t scratch_bytes,
+                          edgeai_ram_place_result_t out[kEdgeAiRamPlaceCount])
+{
+    if (!clock || !scratch || !out || scratch_bytes < EDGEAI_RAM_PLACE_SCRATCH_BYTES) return false;
+    memset(out, 0, sizeof(out[0]) * kEdgeAiRamPlaceCount);
+    ram_place_accel(clock, (int32_t *)scratch, &out[kEdgeAiRamPlaceAccel]);
+    ram_place_sim(clock, (sim_input_t *)scratch, &out[kEdgeAiRamPlaceSim]);
+    ram_place_dune_bg(clock, (uint16_t *)scratch, &out[kEdgeAiRamPlaceDuneBg]);
+    ram_place_ball(clock, (uint16_t *)scratch, &out[kEdgeAiRamPlaceBall]);
+    return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "dune_live.h"
+
+/* Zero-wait-state RAM placement of the per-frame hot paths.
+ * EDGEAI_RAMFUNC functions and EDGEAI_RAMDATA tables go to the CodeQuickAccess / DataQuickAccess input
+ * sections (the names behind the SDK's AT_QUICKACCESS_SECTION_* macros). The SDK's armgcc linker script
+ * keeps both inside .data, so the startup code copies them from flash to SRAM with the initialized data;
+ * calls between flash and RAM get linker veneers.
+ *
+ * Tagged: accel_proc_update, sim_step, sw_render_dune_bg and the ball shader (the variant the build selects
+ * and its helpers) and the isqrt seed table. g_dune_tex (76.8 KB) is opt-in, see EDGEAI_RAM_PLACE_DUNE_TEX.
+ *
+ * tools/linkmap_report.py --placement lists where each one landed; the overlay runs it after every build.
+ * With EDGEAI_RAM_PLACE_BENCH=1 the firmware times the tagged functions at boot, so a build with
+ * EDGEAI_RAM_PLACE_ENABLE=0 next to the default one gives the flash-vs-RAM cycles. Host builds leave
+ * everything in place.
+ */
+
+#ifndef EDGEAI_RAM_PLACE_ENABLE
+#define EDGEAI_RAM_PLACE_ENABLE 1
+#endif
+
+/* The shipped dune texture in SRAM (76.8 KB). Off by default to keep static RAM within budget; never useful
+ * with the live dune, whose texture copy is already in RAM.
+ */
+#ifndef EDGEAI_RAM_PLACE_DUNE_TEX
+#define EDGEAI_RAM_PLACE_DUNE_TEX 0
+#endif
+
+#if EDGEAI_RAM_PLACE_DUNE_TEX && EDGEAI_DUNE_LIVE_ENABLE
+#error "EDGEAI_RAM_PLACE_DUNE_TEX duplicates the live dune's RAM texture"
+#endif
+
+#if EDGEAI_RAM_PLACE_ENABLE && defined(__GNUC__) && defined(__arm__)
+#define EDGEAI_RAMFUNC __attribute__((section("CodeQuickAccess")))
+#define EDGEAI_RAMDATA __attribute__((section("DataQuickAccess")))
+#else
+#define EDGEAI_RAMFUNC
+#define EDGEAI_RAMDATA
+#endif
+
+/* RAM only for the variant a 0/1 build flag selects, e.g. EDGEAI_RAMFUNC_IF(EDGEAI_SIM_FLOAT). */
+#define EDGEAI_RAMFUNC_IF(flag) EDGEAI_RAMFUNC_IF_(flag)
+#define EDGEAI_RAMFUNC_IF_(flag) EDGEAI_RAMFUNC_IF_##flag
+#define EDGEAI_RAMFUNC_IF_0
+#define EDGEAI_RAMFUNC_IF_1 EDGEAI_RAMFUNC
+#define EDGEAI_RAMFUNC_UNLESS(flag) EDGEAI_RAMFUNC_UNLESS_(flag)
+#define EDGEAI_RAMFUNC_UNLESS_(flag) EDGEAI_RAMFUNC_UNLESS_##flag
+#define EDGEAI_RAMFUNC_UNLESS_0 EDGEAI_RAMFUNC
+#define EDGEAI_RAMFUNC_UNLESS_1
+
+#ifndef EDGEAI_RAM_PLACE_BENCH
+#define EDGEAI_RAM_PLACE_BENCH 0
+#endif
+
+/* Timed calls per function (after one warm-up call). */
+#ifndef EDGEAI_RAM_PLACE_CALLS
+#define EDGEAI_RAM_PLACE_CALLS 256u
+#endif
+
+/* Background block drawn per dune_bg call. */
+#define EDGEAI_RAM_PLACE_BG_W 120u
+#define EDGEAI_RAM_PLACE_BG_H 80u
+
+/* Caller scratch for the pregenerated inputs and the drawn block. */
+#define EDGEAI_RAM_PLACE_SCRATCH_BYTES (EDGEAI_RAM_PLACE_BG_W * EDGEAI_RAM_PLACE_BG_H * 2u)
+
+typedef enum
+{
+    kEdgeAiRamPlaceAccel = 0,
+    kEdgeAiRamPlaceSim,
+    kEdgeAiRamPlaceDuneBg,
+    kEdgeAiRamPlaceBall,
+    kEdgeAiRamPlaceCount,
+} edgeai_ram_place_fn_t;
+
+typedef uint32_t (*edgeai_ram_place_clock_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    uint32_t calls;
+    uint32_t ticks;   /* total over `calls` */
+    uintptr_t code;   /* entry of the variant the build runs */
+    uintptr_t data;   /* table it streams from (0: none) */
+    bool code_in_ram;
+    bool data_in_ram;
+} edgeai_ram_place_result_t;
+
+/* True for the MCXN947 SRAM windows (SRAMX on the code bus, SRAM A..H on the system bus, either alias). */
+bool edgeai_ram_place_in_ram(uintptr_t addr);
+
+/* Times the tagged functions on synthetic inputs with the caller's clock. `scratch`
+ * (EDGEAI_RAM_PLACE_SCRATCH_BYTES, 4-byte aligned) is only used during the call. Returns false when the
+ * scratch is too small.
+ */
+bool edgeai_ram_place_run(edgeai_ram_place_clock_fn_t clock, void *scratch, uint32_t scratch_bytes,
+                          edgeai_ram_place_result_t out[kEdgeAiRamPlaceCount]);
@@ -1,8 +1,12 @@
 #include "render_world.h"
 
+#include <string.h>
+
 #include "edgeai_config.h"
+#include "edgeai_math.h"
 #include "edgeai_util.h"
 #include "par_lcd_s035.h"
+#include "scratch_arena.h"
 #include "sw_render.h"
 #include "text5x7.h"
 
@@ -10,52 +14,29 @@
 #define EDGEAI_RENDER_SINGLE_BLIT 1
 #endif
 
-/* Sine in Q14 for angles 0..90 degrees in 64 steps. */
-static const int16_t s_sin_q14_quarter[65] = {
-        0,   402,   804,  1205,  1606,  2006,  2404,  2801,
-     3196,  3590,  3981,  4370,  4756,  5139,  5520,  5897,
-     6270,  6639,  7005,  7366,  7723,  8076,  8423,  8765,
-     9102,  9434,  9760, 10080, 10394, 10702, 11003, 11297,
-    11585, 11866, 12140, 12406, 12665, 12916, 13160, 13395,
-    13623, 13842, 14053, 14256, 14449, 14635, 14811, 14978,
-    15137, 15286, 15426, 15557, 15679, 15791, 15893, 15986,
-    16069, 16143, 16207, 16261, 16305, 16340, 16364, 16379,
-    16384,
-};
+/* Dirty sand patches redrawn per frame; the rest wait for later frames. */
+#ifndef EDGEAI_SAND_DIRTY_MAX
+#define EDGEAI_SAND_DIRTY_MAX 16
+#endif
 
-static inline void render_sincos_q14(uint8_t a, int32_t *sin_q14, int32_t *cos_q14)
+#if EDGEAI_RENDER_SINGLE_BLIT
+/* Single tile buffer shared by all renderer paths. It lives in the scratch region (scratch_arena.h)
+ * and is only valid between render_world_tile_begin() and render_world_tile_end().
+ */
+static uint16_t *s_tile = NULL;
+
+static bool render_world_tile_begin(void)
 {
-    /* a: 0..255 maps to 0..2*pi. */
-    uint32_t quad = (uint32_t)(a >> 6); /* 0..3 */
-    uint32_t off = (uint32_t)(a & 63u);
-    int32_t s = 0;
-    int32_t c = 0;
-    switch (quad)
-    {
-        case 0: /* 0..90 */
-            s = s_sin_q14_quarter[off];
-            c = s_sin_q14_quarter[64u - off];
-            break;
-        case 1: /* 90..180 */
-            s = s_sin_q14_quarter[64u - off];
-            c = -s_sin_q14_quarter[off];
-            break;
-        case 2: /* 180..270 */
-            s = -s_sin_q14_quarter[off];
-            c = -s_sin_q14_quarter[64u - off];
-            break;
-        default: /* 270..360 */
-            s = -s_sin_q14_quarter[64u - off];
-            c = s_sin_q14_quarter[off];
-            break;
-    }
-    *sin_q14 = s;
-    *cos_q14 = c;
+    if (!edgeai_scratch_acquire(kEdgeAiScratchOwnerRender)) return false;
+    s_tile = edgeai_scratch_tile();
+    return true;
 }
 
-#if EDGEAI_RENDER_SINGLE_BLIT
-/* Single tile buffer shared by all renderer paths. */
-static uint16_t s_tile[EDGEAI_TILE_MAX_W * EDGEAI_TILE_MAX_H];
+static void render_world_tile_end(void)
+{
+    s_tile = NULL;
+    edgeai_scratch_release(kEdgeAiScratchOwnerRender);
+}
 #endif
 
 enum
@@ -68,8 +49,174 @@ enum
     EDGEAI_SIG_H = 9,
     EDGEAI_SIG_X0 = EDGEAI_LCD_W - EDGEAI_SIG_W - 2,
     EDGEAI_SIG_Y0 = 2,
+    EDGEAI_PERF_LABEL_H = 9,
+    EDGEAI_PERF_TILE_H = EDGEAI_PERF_GRAPH_H + EDGEAI_PERF_LABEL_H,
+    EDGEAI_PERF_X0 = 2,
+    EDGEAI_PERF_Y0 = EDGEAI_LCD_H - EDGEAI_PERF_TILE_H - 2,
 };
 
+#if EDGEAI_HUD_PERF_GRAPH
+/* Persistent graph tile (label row + plot). Only the newest column is redrawn each frame. */
+static uint16_t s_perf_tile[EDGEAI_PERF_GRAPH_W * EDGEAI_PERF_TILE_H];
+static bool s_perf_tile_init = false;
+
+/* Stage colors, bottom to top: input, filter, sim, render, blit, NPU. */
+static const uint16_t s_perf_stage_rgb565[kEdgeAiPerfStageCount] = {
+    0x001Fu, 0x07FFu, 0x07E0u, 0xFFE0u, 0xFD20u, 0xF81Fu,
+};
+#endif
+
+static edgeai_scene_capture_t *s_scene_cap = NULL;
+static const edgeai_postfx_t *s_postfx = NULL;
+static sand_grid_t *s_sand = NULL;
+static uint32_t s_sand_cursor = 0;
+static edgeai_dune_live_t *s_dune = NULL;
+static uint32_t s_dune_cursor = 0;
+static edgeai_particles_t *s_particles = NULL;
+
+/* Indexed by sand_material_t; empty and the ball's cells stay transparent. */
+static const uint16_t s_sand_palette[5] = {
+    0x0000u, 0xDDAEu, 0x3B79u, 0x94B4u, 0x0000u,
+};
+
+void render_world_set_scene_capture(edgeai_scene_capture_t *cap)
+{
+    s_scene_cap = cap;
+}
+
+void render_world_set_postfx(const edgeai_postfx_t *fx)
+{
+    s_postfx = fx;
+}
+
+void render_world_set_sand(sand_grid_t *grid)
+{
+    s_sand = grid;
+    s_sand_cursor = 0;
+}
+
+void render_world_set_particles(edgeai_particles_t *p)
+{
+    s_particles = p;
+}
+
+void render_world_set_dune(edgeai_dune_live_t *dune)
+{
+    s_dune = dune;
+    s_dune_cursor = 0;
+    sw_render_set_dune_tex(dune ? dune->tex : NULL);
+}
+
+#if EDGEAI_RENDER_SINGLE_BLIT
+static void render_world_sand_overlay(uint32_t w, uint32_t h, int32_t x0, int32_t y0)
+{
+    if (!s_sand) return;
+    sw_render_cells(s_tile, w, h, x0, y0, &s_sand->cell[0][0], EDGEAI_SAND_W, EDGEAI_SAND_H,
+                    EDGEAI_SAND_CELL_PX, s_sand_palette);
+}
+
+/* Redraws dirty patches round-robin, so a large change spreads over several frames. */
+static void render_world_draw_sand_patches(void)
+{
+    if (!s_sand) return;
+    const int32_t patch_px = EDGEAI_SAND_PATCH * EDGEAI_SAND_CELL_PX;
+    uint32_t drawn = 0;
+    for (uint32_t k = 0; k < (uint32_t)EDGEAI_SAND_PATCH_COUNT && drawn < (uint32_t)EDGEAI_SAND_DIRTY_MAX; k++)
+    {
+        uint32_t p = (s_sand_cursor + k) % (uint32_t)EDGEAI_SAND_PATCH_COUNT;
+        if (!s_sand->dirty[p]) continue;
+        s_sand->dirty[p] = 0u;
+        drawn++;
+
+        int32_t px0 = (int32_t)(p % EDGEAI_SAND_PATCH_COLS) * patch_px;
+        int32_t py0 = (int32_t)(p / EDGEAI_SAND_PATCH_COLS) * patch_px;
+        int32_t px1 = edgeai_clamp_i32(px0 + patch_px - 1, 0, EDGEAI_LCD_W - 1);
+        int32_t py1 = edgeai_clamp_i32(py0 + patch_px - 1, 0, EDGEAI_LCD_H - 1);
+        uint32_t pw = (uint32_t)(px1 - px0 + 1);
+        uint32_t ph = (uint32_t)(py1 - py0 + 1);
+        sw_render_dune_bg(s_tile, pw, ph, px0, py0);
+        render_world_sand_overlay(pw, ph, px0, py0);
+        edgeai_postfx_composite(s_postfx, s_tile, pw, ph, px0, py0);
+        par_lcd_s035_blit_rect(px0, py0, px1, py1, s_tile);
+        s_sand_cursor = (p + 1u) % (uint32_t)EDGEAI_SAND_PATCH_COUNT;
+    }
+}
+
+/* Relit dune blocks, round-robin like the sand patches (the background under them changed). */
+static void render_world_draw_dune_blocks(void)
+{
+    if (!s_dune) return;
+    const int32_t block_px = EDGEAI_DUNE_BLOCK << EDGEAI_TERRAIN_TEXEL_SHIFT;
+    uint32_t drawn = 0;
+    for (uint32_t k = 0; k < (uint32_t)EDGEAI_DUNE_BLOCK_COUNT && drawn < (uint32_t)EDGEAI_DUNE_DIRTY_MAX; k++)
+    {
+        uint32_t b = (s_dune_cursor + k) % (uint32_t)EDGEAI_DUNE_BLOCK_COUNT;
+        if (!(s_dune->block[b] & kEdgeAiDuneBlockDirty)) continue;
+        s_dune->block[b] &= (uint8_t)~kEdgeAiDuneBlockDirty;
+        drawn++;
+
+        int32_t px0 = (int32_t)(b % EDGEAI_DUNE_BLOCK_COLS) * block_px;
+        int32_t py0 = (int32_t)(b / EDGEAI_DUNE_BLOCK_COLS) * block_px;
+        int32_t px1 = edgeai_clamp_i32(px0 + block_px - 1, 0, EDGEAI_LCD_W - 1);
+        int32_t py1 = edgeai_clamp_i32(py0 + block_px - 1, 0, EDGEAI_LCD_H - 1);
+        uint32_t pw = (uint32_t)(px1 - px0 + 1);
+        uint32_t ph = (uint32_t)(py1 - py0 + 1);
+        sw_render_dune_bg(s_tile, pw, ph, px0, py0);
+        render_world_sand_overlay(pw, ph, px0, py0);
+        edgeai_postfx_composite(s_postfx, s_tile, pw, ph, px0, py0);
+        par_lcd_s035_blit_rect(px0, py0, px1, py1, s_tile);
+        s_dune_cursor = (b + 1u) % (uint32_t)EDGEAI_DUNE_BLOCK_COUNT;
+    }
+}
+
+/* Spray rectangle (dots last drawn plus current ones) reaching outside the ball tile, cut into tiles. One
+ * burst spreads less than a tile; two far-apart bursts take more.
+ */
+static void render_world_draw_spray(int32_t sx0, int32_t sy0, int32_t sx1, int32_t sy1)
+{
+    for (int32_t y0 = sy0; y0 <= sy1; y0 += EDGEAI_TILE_MAX_H)
+    {
+        int32_t y1 = edgeai_clamp_i32(y0 + EDGEAI_TILE_MAX_H - 1, 0, sy1);
+        for (int32_t x0 = sx0; x0 <= sx1; x0 += EDGEAI_TILE_MAX_W)
+        {
+            int32_t x1 = edgeai_clamp_i32(x0 + EDGEAI_TILE_MAX_W - 1, 0, sx1);
+            uint32_t tw = (uint32_t)(x1 - x0 + 1);
+            uint32_t th = (uint32_t)(y1 - y0 + 1);
+            sw_render_dune_bg(s_tile, tw, th, x0, y0);
+            render_world_sand_overlay(tw, th, x0, y0);
+            edgeai_particles_draw(s_particles, s_tile, tw, th, x0, y0);
+            edgeai_postfx_composite(s_postfx, s_tile, tw, th, x0, y0);
+            par_lcd_s035_blit_rect(x0, y0, x1, y1, s_tile);
+        }
+    }
+}
+
+/* Rows relit by the dynamic-light sweep: one full-width band per frame, cut into tiles. */
+static void render_world_draw_dune_band(void)
+{
+    if (!s_dune || s_dune->band_y1 <= s_dune->band_y0) return;
+    const int32_t by0 = (int32_t)s_dune->band_y0 << EDGEAI_TERRAIN_TEXEL_SHIFT;
+    const int32_t by1 = edgeai_clamp_i32(((int32_t)s_dune->band_y1 << EDGEAI_TERRAIN_TEXEL_SHIFT) - 1, 0,
+                                         EDGEAI_LCD_H - 1);
+    s_dune->band_y0 = s_dune->band_y1 = 0;
+
+    for (int32_t y0 = by0; y0 <= by1; y0 += EDGEAI_TILE_MAX_H)
+    {
+        int32_t y1 = edgeai_clamp_i32(y0 + EDGEAI_TILE_MAX_H - 1, 0, by1);
+        for (int32_t x0 = 0; x0 < EDGEAI_LCD_W; x0 += EDGEAI_TILE_MAX_W)
+        {
+            int32_t x1 = edgeai_clamp_i32(x0 + EDGEAI_TILE_MAX_W - 1, 0, EDGEAI_LCD_W - 1);
+            uint32_t tw = (uint32_t)(x1 - x0 + 1);
+            uint32_t th = (uint32_t)(y1 - y0 + 1);
+            sw_render_dune_bg(s_tile, tw, th, x0, y0);
+            render_world_sand_overlay(tw, th, x0, y0);
+            edgeai_postfx_composite(s_postfx, s_tile, tw, th, x0, y0);
+            par_lcd_s035_blit_rect(x0, y0, x1, y1, s_tile);
+        }
+    }
+}
+#endif
+
 void render_world_init(render_state_t *rs, int32_t cx, int32_t cy)
 {
     if (!rs) return;
@@ -87,6 +234,7 @@ void render_world_init(render_state_t *rs, int32_t cx, int32_t cy)
 void render_world_draw_full_background(void)
 {
 #if EDGEAI_RENDER_SINGLE_BLIT
+    if (!render_world_tile_begin()) return;
     for (int32_t y0 = 0; y0 < EDGEAI_LCD_H; y0 += EDGEAI_TILE_MAX_H)
     {
         int32_t y1 = y0 + EDGEAI_TILE_MAX_H - 1;
@@ -103,6 +251,7 @@ void render_world_draw_full_background(void)
             par_lcd_s035_blit_rect(x0, y0, x1, y1, s_tile);
         }
     }
+    render_world_tile_end();
 #endif
 }
 
@@ -126,7 +275,10 @@ static void render_world_draw_hud_tile(uint16_t *dst, uint32_t w, uint32_t h,
     status[13] = ' '; status[14] = 'I'; status[15] = ':'; status[16] = hud->npu_run_enabled ? '1' : '0';
     status[17] = '\0';
 
-    sw_render_text5x7(dst, w, h, x0, y0, ov_x0, ov_y0, status, 0x001Fu);
+    edgeai_text5x7_style_t st = {0};
+    st.scale = 1;
+    st.fg = 0x001Fu;
+    edgeai_text5x7_raster(dst, w, h, x0, y0, ov_x0, ov_y0, status, &st);
 }
 
 #if EDGEAI_RENDER_SINGLE_BLIT
@@ -153,7 +305,10 @@ static void render_world_draw_signature_overlay(void)
     const int32_t y1 = y0 + EDGEAI_SIG_H - 1;
 
     sw_render_dune_bg(s_tile, EDGEAI_SIG_W, EDGEAI_SIG_H, x0, y0);
-    sw_render_text5x7(s_tile, EDGEAI_SIG_W, EDGEAI_SIG_H, x0, y0, x0, y0, sig, 0x0000u);
+    edgeai_text5x7_style_t st = {0};
+    st.scale = 1;
+    st.fg = 0x0000u;
+    edgeai_text5x7_raster(s_tile, EDGEAI_SIG_W, EDGEAI_SIG_H, x0, y0, x0, y0, sig, &st);
     par_lcd_s035_blit_rect(x0, y0, x1, y1, s_tile);
 }
 #endif
@@ -165,6 +320,10 @@ bool render_world_draw(render_state_t *rs,
 {
     if (!rs || !world || !hud) return false;
     if (!do_render) return false;
+#if EDGEAI_RENDER_SINGLE_BLIT
+    /* An inference job holding the scratch region skips this frame (before any state changes). */
+    if (!render_world_tile_begin()) return false;
+#endif
 
     int32_t cx = world->ball.x_q16 >> 16;
     int32_t cy_ground = world->ball.y_q16 >> 16;
@@ -192,7 +351,7 @@ bool render_world_draw(render_state_t *rs,
     uint32_t phase = rs->frame;
     int32_t spin_sin_q14 = 0;
     int32_t spin_cos_q14 = (1 << 14);
-    render_sincos_q14((uint8_t)phase, &spin_sin_q14, &spin_cos_q14);
+    edgeai_sincos_q14((uint8_t)phase, &spin_sin_q14, &spin_cos_q14);
 
     int32_t shadow_alpha = 60;
     if (EDGEAI_BALL_LIFT_MAX_PX > 0)
@@ -254,7 +413,21 @@ bool render_world_draw(render_state_t *rs,
     }
 
 #if EDGEAI_RENDER_SINGLE_BLIT
+    /* Patches first: the ball tile below is drawn over any patch it overlaps. */
+    render_world_draw_dune_band();
+    render_world_draw_dune_blocks();
+    render_world_draw_sand_patches();
+
+    int32_t sx0, sy0, sx1, sy1;
+    if (s_particles && edgeai_particles_dirty_rect(s_particles, &sx0, &sy0, &sx1, &sy1) &&
+        (sx0 < x0 || sy0 < y0 || sx1 > x1 || sy1 > y1))
+    {
+        render_world_draw_spray(sx0, sy0, sx1, sy1);
+    }
+
     sw_render_dune_bg(s_tile, (uint32_t)w, (uint32_t)h, x0, y0);
+    render_world_sand_overlay((uint32_t)w, (uint32_t)h, x0, y0);
+    edgeai_particles_draw(s_particles, s_tile, (uint32_t)w, (uint32_t)h, x0, y0);
 
     for (int i = 0; i < EDGEAI_TRAIL_N; i++)
     {
@@ -270,6 +443,10 @@ bool render_world_draw(render_state_t *rs,
     sw_render_silver_ball(s_tile, (uint32_t)w, (uint32_t)h, x0, y0,
                           cx, cy_draw, r_draw, phase, world->ball.glint, spin_sin_q14, spin_cos_q14);
 
+    /* Capture the scene before the effect is composited, so the model never sees its own output. */
+    edgeai_scene_capture_rows(s_scene_cap, s_tile, (uint32_t)w, (uint32_t)h, x0, y0);
+    edgeai_postfx_composite(s_postfx, s_tile, (uint32_t)w, (uint32_t)h, x0, y0);
+
     par_lcd_s035_blit_rect(x0, y0, x1, y1, s_tile);
 
 	    /* If the main dirty-rect is clamped, the removed trail point can fall outside the
@@ -290,6 +467,8 @@ bool render_world_draw(render_state_t *rs,
 	            int32_t eh = ey1 - ey0 + 1;
 
 	            sw_render_dune_bg(s_tile, (uint32_t)ew, (uint32_t)eh, ex0, ey0);
+	            render_world_sand_overlay((uint32_t)ew, (uint32_t)eh, ex0, ey0);
+	            edgeai_particles_draw(s_particles, s_tile, (uint32_t)ew, (uint32_t)eh, ex0, ey0);
 
 	            for (int i = 0; i < EDGEAI_TRAIL_N; i++)
 	            {
@@ -304,6 +483,7 @@ bool render_world_draw(render_state_t *rs,
             sw_render_ball_shadow(s_tile, (uint32_t)ew, (uint32_t)eh, ex0, ey0, cx, cy_ground, r_ground, (uint32_t)shadow_alpha);
             sw_render_silver_ball(s_tile, (uint32_t)ew, (uint32_t)eh, ex0, ey0,
                                   cx, cy_draw, r_draw, phase, world->ball.glint, spin_sin_q14, spin_cos_q14);
+            edgeai_postfx_composite(s_postfx, s_tile, (uint32_t)ew, (uint32_t)eh, ex0, ey0);
 
             par_lcd_s035_blit_rect(ex0, ey0, ex1, ey1, s_tile);
 	        }
@@ -311,6 +491,8 @@ bool render_world_draw(render_state_t *rs,
 
     render_world_draw_hud_overlay(hud);
     render_world_draw_signature_overlay();
+    edgeai_particles_mark_drawn(s_particles);
+    render_world_tile_end();
 #else
     uint16_t bg = hud->accel_fail ? 0x1800u : 0x0000u;
     par_lcd_s035_fill_rect(x0, y0, x1, y1, bg);
@@ -328,6 +510,8 @@ bool render_world_draw(render_state_t *rs,
 	    par_lcd_s035_draw_ball_shadow(cx, cy_ground, r_ground, (uint32_t)shadow_alpha);
 	    par_lcd_s035_draw_silver_ball(cx, cy_draw, r_draw, phase, world->ball.glint, spin_sin_q14, spin_cos_q14);
 
+    edgeai_scene_capture_rows(s_scene_cap, NULL, 0, 0, 0, 0);
+
     char d3[4];
     edgeai_u32_to_dec3(d3, hud->fps_last);
     char status[40];
@@ -340,17 +524,30 @@ bool render_world_draw(render_state_t *rs,
     const int32_t ov_y0 = EDGEAI_HUD_Y0;
     const int32_t ov_x1 = ov_x0 + EDGEAI_HUD_W - 1;
     const int32_t ov_y1 = ov_y0 + EDGEAI_HUD_H - 1;
-    par_lcd_s035_fill_rect(ov_x0, ov_y0, ov_x1, ov_y1, 0x0000u);
-    edgeai_text5x7_draw_scaled(ov_x0, ov_y0, 1, status, 0x001Fu);
-
+    /* The text strip is the render tile, which this path does not otherwise use; skipped while an
+     * inference holds the scratch region.
+     */
+    if (edgeai_scratch_acquire(kEdgeAiScratchOwnerRender))
     {
+        uint16_t *strip = edgeai_scratch_tile();
+        const uint32_t strip_px = EDGEAI_SCRATCH_TILE_BYTES / 2u;
+        edgeai_text5x7_style_t hud_st = {0};
+        hud_st.scale = 1;
+        hud_st.fg = 0x001Fu;
+        hud_st.bg = 0x0000u;
+        edgeai_text5x7_draw_rect(ov_x0, ov_y0, ov_x1, ov_y1, ov_x0, ov_y0, status, &hud_st, strip, strip_px);
+
         static const char sig[] = "(c)RICHARD HABERKERN";
         const int32_t sx0 = EDGEAI_SIG_X0;
         const int32_t sy0 = EDGEAI_SIG_Y0;
         const int32_t sx1 = sx0 + EDGEAI_SIG_W - 1;
         const int32_t sy1 = sy0 + EDGEAI_SIG_H - 1;
-        par_lcd_s035_fill_rect(sx0, sy0, sx1, sy1, 0xFFFFu);
-        edgeai_text5x7_draw_scaled(sx0, sy0, 1, sig, 0x0000u);
+        edgeai_text5x7_style_t sig_st = {0};
+        sig_st.scale = 1;
+        sig_st.fg = 0x0000u;
+        sig_st.bg = 0xFFFFu;
+        edgeai_text5x7_draw_rect(sx0, sy0, sx1, sy1, sx0, sy0, sig, &sig_st, strip, strip_px);
+        edgeai_scratch_release(kEdgeAiScratchOwnerRender);
     }
 #endif
 
@@ -358,3 +555,79 @@ bool render_world_draw(render_state_t *rs,
     rs->prev_y = cy_draw;
     return true;
 }
+
+void render_world_draw_perf_graph(const render_perf_sample_t *sample)
+{
+#if EDGEAI_HUD_PERF_GRAPH
+    if (!sample) return;
+
+    const uint32_t w = EDGEAI_PERF_GRAPH_W;
+    const int32_t gh = EDGEAI_PERF_GRAPH_H;
+    const uint16_t bg = 0x0000u;
+    uint16_t *plot = &s_perf_tile[EDGEAI_PERF_LABEL_H * w];
+
+    if (!s_perf_tile_init)
+    {
+        sw_render_clear(s_perf_tile, w, EDGEAI_PERF_TILE_H, bg);
+        s_perf_tile_init = true;
+    }
+
+    /* Scroll: shift every plot row left by one column. */
+    for (int32_t y = 0; y < gh; y++)
+    {
+        uint16_t *row = &plot[(uint32_t)y * w];
+        memmove(&row[0], &row[1], (w - 1u) * sizeof(row[0]));
+    }
+
+    /* Newest column: stacked stage bars from the bottom, clipped at the top. */
+    const uint32_t col = w - 1u;
+    int32_t y = gh;
+    uint32_t total_us = 0;
+    for (int i = 0; i < (int)kEdgeAiPerfStageCount; i++)
+    {
+        uint32_t us = sample->stage_us[i];
+        total_us += us;
+        int32_t hpx = (int32_t)((us + (EDGEAI_PERF_GRAPH_US_PER_PX / 2u)) / EDGEAI_PERF_GRAPH_US_PER_PX);
+        for (; (hpx > 0) && (y > 0); hpx--)
+        {
+            y--;
+            plot[(uint32_t)y * w + col] = s_perf_stage_rgb565[i];
+        }
+    }
+    while (y > 0)
+    {
+        y--;
+        plot[(uint32_t)y * w + col] = bg;
+    }
+
+    /* 60 FPS budget marker (drawn only where the bars leave background). */
+    const int32_t budget_y = gh - (int32_t)(16667u / EDGEAI_PERF_GRAPH_US_PER_PX);
+    if ((budget_y >= 0) && (budget_y < gh) && (plot[(uint32_t)budget_y * w + col] == bg))
+    {
+        plot[(uint32_t)budget_y * w + col] = 0x8410u;
+    }
+
+    /* Label row: "F:<frame ms> OV:<graph us>". */
+    char f3[4];
+    char o3[4];
+    edgeai_u32_to_dec3(f3, (total_us + 500u) / 1000u);
+    edgeai_u32_to_dec3(o3, sample->overlay_us);
+    char label[13];
+    label[0] = 'F'; label[1] = ':'; label[2] = f3[0]; label[3] = f3[1]; label[4] = f3[2];
+    label[5] = ' '; label[6] = 'O'; label[7] = 'V'; label[8] = ':';
+    label[9] = o3[0]; label[10] = o3[1]; label[11] = o3[2];
+    label[12] = '\0';
+
+    sw_render_clear(s_perf_tile, w, EDGEAI_PERF_LABEL_H, bg);
+    edgeai_text5x7_style_t st = {0};
+    st.scale = 1;
+    st.fg = 0xFFFFu;
+    edgeai_text5x7_raster(s_perf_tile, w, EDGEAI_PERF_LABEL_H, 0, 0, 1, 1, label, &st);
+
+    par_lcd_s035_blit_rect(EDGEAI_PERF_X0, EDGEAI_PERF_Y0,
+                           EDGEAI_PERF_X0 + (int32_t)w - 1, EDGEAI_PERF_Y0 + EDGEAI_PERF_TILE_H - 1,
+                           s_perf_tile);
+#else
+    (void)sample;
+#endif
+}
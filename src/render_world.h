@@ -3,6 +3,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "dune_live.h"
+#include "particles.h"
+#include "postfx.h"
+#include "sand_sim.h"
+#include "scene_capture.h"
 #include "sim_world.h"
 
 typedef struct
@@ -25,13 +30,61 @@ typedef struct
     char npu_backend;
 } render_hud_t;
 
+/* Per-frame stage timings for the HUD frame-time graph (`EDGEAI_HUD_PERF_GRAPH`). */
+typedef enum
+{
+    kEdgeAiPerfStageInput = 0,
+    kEdgeAiPerfStageFilter,
+    kEdgeAiPerfStageSim,
+    kEdgeAiPerfStageRender,
+    kEdgeAiPerfStageBlit,
+    kEdgeAiPerfStageNpu,
+    kEdgeAiPerfStageCount,
+} render_perf_stage_t;
+
+typedef struct
+{
+    uint32_t stage_us[kEdgeAiPerfStageCount];
+    uint32_t overlay_us; /* cost of the previous graph update (shift + draw + blit) */
+} render_perf_sample_t;
+
 void render_world_init(render_state_t *rs, int32_t cx, int32_t cy);
 
 /* Full-screen background draw (tiled to fit EDGEAI_TILE_MAX_*). */
 void render_world_draw_full_background(void);
 
+/* Scene capture fed from each composed dirty tile (single-blit mode) or the background (raster mode).
+ * NULL detaches.
+ */
+void render_world_set_scene_capture(edgeai_scene_capture_t *cap);
+
+/* Post-process effect layer composited into each dirty tile before its blit (single-blit mode). NULL detaches. */
+void render_world_set_postfx(const edgeai_postfx_t *fx);
+
+/* Material grid drawn over the dune background (single-blit mode): the ball tile shows it, and up to
+ * EDGEAI_SAND_DIRTY_MAX dirty patches are redrawn per frame (their dirty flags are cleared). NULL detaches.
+ */
+void render_world_set_sand(sand_grid_t *grid);
+
+/* Live dune (single-blit mode): the background samples its texture, the pending dynamic-light band is
+ * drawn, and up to EDGEAI_DUNE_DIRTY_MAX relit blocks are redrawn per frame (their dirty flags are cleared).
+ * NULL restores the shipped texture.
+ */
+void render_world_set_dune(edgeai_dune_live_t *dune);
+
+/* Spray particles (single-blit mode): drawn into the ball tile, plus tiles of their own when the dots last
+ * drawn or the current ones reach outside it. The caller steps them; each drawn frame marks them drawn.
+ * NULL detaches.
+ */
+void render_world_set_particles(edgeai_particles_t *p);
+
 /* Renders one frame if do_render is true. Returns true when a draw was issued. */
 bool render_world_draw(render_state_t *rs,
                        const sim_world_t *world,
                        bool do_render,
                        const render_hud_t *hud);
+
+/* Scroll the frame-time graph tile by one column, draw `sample` as the newest column and blit the tile.
+ * Uses its own persistent buffer, so it works in both single-blit and raster modes.
+ */
+void render_world_draw_perf_graph(const render_perf_sample_t *sample);
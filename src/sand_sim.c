@@ -1,2 +1,223 @@
-/* Placeholder for future grid-based sand simulation module. */
+#include "sand_sim.h"
 
+#include <string.h>
+
+#include "edgeai_util.h"
+
+/* 8 directions in clockwise screen order (+y down); the diagonals of a gravity direction are its ring neighbors. */
+static const int8_t s_dir_x[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int8_t s_dir_y[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+static int32_t sand_dir_index(sand_gravity_t g)
+{
+    for (int32_t i = 0; i < 8; i++)
+    {
+        if (s_dir_x[i] == g.gx && s_dir_y[i] == g.gy) return i;
+    }
+    return -1;
+}
+
+static inline uint32_t sand_xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+typedef struct
+{
+    uint8_t *cells;
+    int32_t stride;
+    int32_t w;
+    int32_t h;
+    const uint8_t *active; /* per patch; NULL scans everything */
+    uint8_t *changed;      /* per patch; NULL skips bookkeeping */
+} sand_view_t;
+
+/* A grain may enter empty cells and sink through water. */
+static inline bool sand_can_enter(uint8_t dst)
+{
+    return (dst == (uint8_t)kEdgeAiMatEmpty) || (dst == (uint8_t)kEdgeAiMatWater);
+}
+
+static inline bool sand_try_move(const sand_view_t *v, int32_t x, int32_t y, int32_t dx, int32_t dy)
+{
+    int32_t nx = x + dx;
+    int32_t ny = y + dy;
+    if (nx < 0 || ny < 0 || nx >= v->w || ny >= v->h) return false;
+    uint8_t *dst = &v->cells[ny * v->stride + nx];
+    if (!sand_can_enter(*dst)) return false;
+    v->cells[y * v->stride + x] = *dst;
+    *dst = (uint8_t)kEdgeAiMatSand;
+    if (v->changed)
+    {
+        v->changed[sand_sim_patch_of(x, y)] = 1u;
+        v->changed[sand_sim_patch_of(nx, ny)] = 1u;
+    }
+    return true;
+}
+
+static inline uint32_t sand_update_cell(const sand_view_t *v, int32_t x, int32_t y, int32_t dir, uint32_t *rng)
+{
+    if (v->cells[y * v->stride + x] != (uint8_t)kEdgeAiMatSand) return 0u;
+    if (sand_try_move(v, x, y, s_dir_x[dir], s_dir_y[dir])) return 1u;
+
+    /* Blocked: slide along one of the two diagonals of gravity, random side first. */
+    int32_t side = (sand_xorshift32(rng) & 1u) ? 1 : 7;
+    int32_t d1 = (dir + side) & 7;
+    int32_t d2 = (dir + 8 - side) & 7;
+    if (sand_try_move(v, x, y, s_dir_x[d1], s_dir_y[d1])) return 1u;
+    if (sand_try_move(v, x, y, s_dir_x[d2], s_dir_y[d2])) return 1u;
+    return 0u;
+}
+
+/* Scan order: lines perpendicular to the dominant gravity axis, farthest "downhill" line first, and
+ * within a line toward -gx for diagonal gravity. Every move target is then already visited, so no grain
+ * moves twice in one step. Without a lateral component the line direction alternates randomly.
+ */
+static uint32_t sand_scan(const sand_view_t *v, sand_gravity_t g, uint32_t *rng, uint32_t *scanned)
+{
+    int32_t dir = sand_dir_index(g);
+    if (dir < 0) return 0u;
+
+    const bool rows = (g.gy != 0);
+    const int32_t lines = rows ? v->h : v->w;
+    const int32_t len = rows ? v->w : v->h;
+    const int32_t down = rows ? g.gy : g.gx;
+    const int32_t lateral = rows ? g.gx : 0;
+    const int32_t segs = (len + EDGEAI_SAND_PATCH - 1) / EDGEAI_SAND_PATCH;
+
+    uint32_t moves = 0;
+    uint32_t visited = 0;
+    for (int32_t li = 0; li < lines; li++)
+    {
+        int32_t line = (down > 0) ? (lines - 1 - li) : li;
+        bool reverse = (lateral > 0) || ((lateral == 0) && (sand_xorshift32(rng) & 1u));
+
+        for (int32_t si = 0; si < segs; si++)
+        {
+            int32_t seg = reverse ? (segs - 1 - si) : si;
+            int32_t a0 = seg * EDGEAI_SAND_PATCH;
+            int32_t a1 = a0 + EDGEAI_SAND_PATCH;
+            if (a1 > len) a1 = len;
+            if (v->active)
+            {
+                int32_t px = rows ? seg : (line / EDGEAI_SAND_PATCH);
+                int32_t py = rows ? (line / EDGEAI_SAND_PATCH) : seg;
+                if (!v->active[py * EDGEAI_SAND_PATCH_COLS + px]) continue;
+            }
+            visited += (uint32_t)(a1 - a0);
+            for (int32_t k = 0; k < a1 - a0; k++)
+            {
+                int32_t a = reverse ? (a1 - 1 - k) : (a0 + k);
+                moves += rows ? sand_update_cell(v, a, line, dir, rng) : sand_update_cell(v, line, a, dir, rng);
+            }
+        }
+    }
+    if (scanned) *scanned = visited;
+    return moves;
+}
+
+void sand_sim_init(sand_grid_t *g, uint32_t seed)
+{
+    if (!g) return;
+    memset(g, 0, sizeof(*g));
+    g->rng = seed ? seed : 0x2545F491u;
+    g->gravity.gx = 0;
+    g->gravity.gy = 1;
+}
+
+void sand_sim_fill_rect(sand_grid_t *g, int32_t x0, int32_t y0, int32_t x1, int32_t y1, sand_material_t m)
+{
+    if (!g) return;
+    x0 = edgeai_clamp_i32(x0, 0, EDGEAI_SAND_W - 1);
+    x1 = edgeai_clamp_i32(x1, 0, EDGEAI_SAND_W - 1);
+    y0 = edgeai_clamp_i32(y0, 0, EDGEAI_SAND_H - 1);
+    y1 = edgeai_clamp_i32(y1, 0, EDGEAI_SAND_H - 1);
+    for (int32_t y = y0; y <= y1; y++)
+    {
+        memset(&g->cell[y][x0], (int)m, (size_t)(x1 - x0 + 1));
+        for (int32_t x = x0; x <= x1; x += EDGEAI_SAND_PATCH) g->changed[sand_sim_patch_of(x, y)] = 1u;
+        g->changed[sand_sim_patch_of(x1, y)] = 1u;
+    }
+    sand_sim_end_step(g);
+}
+
+sand_gravity_t sand_sim_gravity_from_tilt(int32_t ax_q15, int32_t ay_q15)
+{
+    sand_gravity_t g = {0, 0};
+    int32_t ax = edgeai_abs_i32(ax_q15);
+    int32_t ay = edgeai_abs_i32(ay_q15);
+    if (ax + ay < EDGEAI_SAND_TILT_MIN_Q15) return g;
+
+    /* 45-degree sectors: an axis counts when it is within tan(67.5) ~ 5/2 of the other. */
+    if (5 * ax >= 2 * ay) g.gx = (int8_t)((ax_q15 > 0) ? 1 : -1);
+    if (5 * ay >= 2 * ax) g.gy = (int8_t)((ay_q15 > 0) ? 1 : -1);
+    return g;
+}
+
+uint32_t sand_sim_step_region(uint8_t *cells, int32_t stride, int32_t w, int32_t h, sand_gravity_t grav,
+                              uint32_t *rng)
+{
+    if (!cells || !rng || w <= 0 || h <= 0) return 0u;
+    sand_view_t v = {cells, stride, w, h, NULL, NULL};
+    return sand_scan(&v, grav, rng, NULL);
+}
+
+void sand_sim_end_step(sand_grid_t *g)
+{
+    if (!g) return;
+    /* A change wakes its patch and the 8 around it (grains above may now fall, neighbors may slide). */
+    memset(g->active, 0, sizeof(g->active));
+    for (int32_t py = 0; py < EDGEAI_SAND_PATCH_ROWS; py++)
+    {
+        for (int32_t px = 0; px < EDGEAI_SAND_PATCH_COLS; px++)
+        {
+            if (!g->changed[py * EDGEAI_SAND_PATCH_COLS + px]) continue;
+            g->dirty[py * EDGEAI_SAND_PATCH_COLS + px] = 1u;
+            for (int32_t ny = py - 1; ny <= py + 1; ny++)
+            {
+                if (ny < 0 || ny >= EDGEAI_SAND_PATCH_ROWS) continue;
+                for (int32_t nx = px - 1; nx <= px + 1; nx++)
+                {
+                    if (nx < 0 || nx >= EDGEAI_SAND_PATCH_COLS) continue;
+                    g->active[ny * EDGEAI_SAND_PATCH_COLS + nx] = 1u;
+                }
+            }
+        }
+    }
+    memset(g->changed, 0, sizeof(g->changed));
+}
+
+bool sand_sim_set_gravity(sand_grid_t *g, sand_gravity_t grav)
+{
+    if (!g) return false;
+    if (grav.gx == g->gravity.gx && grav.gy == g->gravity.gy) return false;
+    g->gravity = grav;
+    memset(g->active, 1, sizeof(g->active));
+    return true;
+}
+
+void sand_sim_step(sand_grid_t *g, sand_gravity_t grav)
+{
+    if (!g) return;
+    (void)sand_sim_set_gravity(g, grav);
+
+    sand_view_t v = {&g->cell[0][0], EDGEAI_SAND_W, EDGEAI_SAND_W, EDGEAI_SAND_H, g->active, g->changed};
+    g->cells_scanned = 0;
+    g->moves = sand_scan(&v, grav, &g->rng, &g->cells_scanned);
+    g->steps++;
+    sand_sim_end_step(g);
+}
+
+uint32_t sand_sim_count(const sand_grid_t *g, sand_material_t m)
+{
+    if (!g) return 0u;
+    uint32_t n = 0;
+    const uint8_t *c = &g->cell[0][0];
+    for (uint32_t i = 0; i < (uint32_t)(EDGEAI_SAND_W * EDGEAI_SAND_H); i++) n += (c[i] == (uint8_t)m) ? 1u : 0u;
+    return n;
+}
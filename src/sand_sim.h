@@ -1,4 +1,108 @@
 #pragma once
 
-/* Placeholder for future grid-based sand simulation module. */
+#include <stdbool.h>
+#include <stdint.h>
 
+#include "edgeai_config.h"
+
+/* Falling-sand material grid (docs/SIM_ARCHITECTURE.md).
+ * One byte per cell (material id), 8-way quantized gravity from tilt, gravity-dependent scan order
+ * and xorshift tie-breaking, so a step is deterministic for a given seed and input sequence.
+ * Cells are grouped into EDGEAI_SAND_PATCH x EDGEAI_SAND_PATCH patches; only active patches (a cell
+ * changed there or next to it last step) are scanned, and changed patches are flagged dirty for the
+ * renderer.
+ */
+
+#ifndef EDGEAI_SAND_ENABLE
+#define EDGEAI_SAND_ENABLE 0
+#endif
+
+/* LCD pixels per cell (nearest-neighbor upscale). */
+#ifndef EDGEAI_SAND_CELL_PX
+#define EDGEAI_SAND_CELL_PX 4
+#endif
+
+#define EDGEAI_SAND_W (EDGEAI_LCD_W / EDGEAI_SAND_CELL_PX)
+#define EDGEAI_SAND_H (EDGEAI_LCD_H / EDGEAI_SAND_CELL_PX)
+
+/* Patch edge in cells (power of two; also the surrogate model's patch size). */
+#ifndef EDGEAI_SAND_PATCH
+#define EDGEAI_SAND_PATCH 8
+#endif
+
+#define EDGEAI_SAND_PATCH_COLS ((EDGEAI_SAND_W + EDGEAI_SAND_PATCH - 1) / EDGEAI_SAND_PATCH)
+#define EDGEAI_SAND_PATCH_ROWS ((EDGEAI_SAND_H + EDGEAI_SAND_PATCH - 1) / EDGEAI_SAND_PATCH)
+#define EDGEAI_SAND_PATCH_COUNT (EDGEAI_SAND_PATCH_COLS * EDGEAI_SAND_PATCH_ROWS)
+
+/* Minimum tilt (Q15 of 1 g) before grains slide; a level board keeps the pile still. */
+#ifndef EDGEAI_SAND_TILT_MIN_Q15
+#define EDGEAI_SAND_TILT_MIN_Q15 4096
+#endif
+
+#if (EDGEAI_SAND_PATCH & (EDGEAI_SAND_PATCH - 1)) != 0
+#error "EDGEAI_SAND_PATCH must be a power of two"
+#endif
+
+typedef enum
+{
+    kEdgeAiMatEmpty = 0,
+    kEdgeAiMatSand = 1,
+    kEdgeAiMatWater = 2,
+    kEdgeAiMatMetal = 3,
+    kEdgeAiMatBall = 4, /* the ball's footprint (ball_grid.h); solid to the rules, not drawn */
+} sand_material_t;
+
+typedef struct
+{
+    int8_t gx; /* -1, 0, +1 in screen coordinates (+y is down) */
+    int8_t gy;
+} sand_gravity_t;
+
+typedef struct
+{
+    uint8_t cell[EDGEAI_SAND_H][EDGEAI_SAND_W];
+    uint8_t active[EDGEAI_SAND_PATCH_COUNT];  /* scanned this step */
+    uint8_t changed[EDGEAI_SAND_PATCH_COUNT]; /* a cell changed during the current step */
+    uint8_t dirty[EDGEAI_SAND_PATCH_COUNT];   /* changed since the renderer last drew the patch */
+    sand_gravity_t gravity;
+    uint32_t rng;
+    uint32_t steps;
+    uint32_t moves;         /* grains moved in the last step */
+    uint32_t cells_scanned; /* cells visited in the last step */
+} sand_grid_t;
+
+void sand_sim_init(sand_grid_t *g, uint32_t seed);
+
+/* Fills a cell rectangle (inclusive bounds, clipped) and wakes the patches it touches. */
+void sand_sim_fill_rect(sand_grid_t *g, int32_t x0, int32_t y0, int32_t x1, int32_t y1, sand_material_t m);
+
+/* 8-way gravity from the tilt vector; zero below EDGEAI_SAND_TILT_MIN_Q15. */
+sand_gravity_t sand_sim_gravity_from_tilt(int32_t ax_q15, int32_t ay_q15);
+
+/* Sets gravity; a change wakes every patch. Returns true on a change. */
+bool sand_sim_set_gravity(sand_grid_t *g, sand_gravity_t grav);
+
+/* Updates gravity (waking every patch on a change) and runs one deterministic rule step. */
+void sand_sim_step(sand_grid_t *g, sand_gravity_t grav);
+
+/* Rule step over a w x h window of cells (row stride `stride`) with no patch bookkeeping.
+ * Cells outside the window count as walls. Used for patch-local reference updates.
+ */
+uint32_t sand_sim_step_region(uint8_t *cells, int32_t stride, int32_t w, int32_t h, sand_gravity_t grav,
+                              uint32_t *rng);
+
+/* Re-derives active patches from the `changed` flags (3x3 dilation) and clears them. */
+void sand_sim_end_step(sand_grid_t *g);
+
+uint32_t sand_sim_count(const sand_grid_t *g, sand_material_t m);
+
+static inline uint8_t sand_sim_get(const sand_grid_t *g, int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= EDGEAI_SAND_W || y >= EDGEAI_SAND_H) return (uint8_t)kEdgeAiMatMetal;
+    return g->cell[y][x];
+}
+
+static inline uint32_t sand_sim_patch_of(int32_t x, int32_t y)
+{
+    return (uint32_t)((y / EDGEAI_SAND_PATCH) * EDGEAI_SAND_PATCH_COLS + (x / EDGEAI_SAND_PATCH));
+}
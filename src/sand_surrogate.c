@@ -0,0 +1,253 @@
+#include "sand_surrogate.h"
+
+#include <string.h>
+
+#define EDGEAI_SAND_Q_EMPTY (-127)
+#define EDGEAI_SAND_Q_SAND 127
+#define EDGEAI_SAND_Q_STATIC 0
+
+static inline int8_t sand_surrogate_encode(uint8_t m)
+{
+    if (m == (uint8_t)kEdgeAiMatSand) return (int8_t)EDGEAI_SAND_Q_SAND;
+    if (m == (uint8_t)kEdgeAiMatEmpty) return (int8_t)EDGEAI_SAND_Q_EMPTY;
+    return (int8_t)EDGEAI_SAND_Q_STATIC;
+}
+
+void edgeai_sand_surrogate_init(edgeai_sand_surrogate_t *s, edgeai_sand_surrogate_run_fn_t run, void *user)
+{
+    if (!s) return;
+    memset(s, 0, sizeof(*s));
+    s->run = run;
+    s->user = user;
+}
+
+/* Window k of a phase starts at cell k * PATCH - offset; phase 1 shifts the grid by half a patch. */
+#define EDGEAI_SAND_WIN_COLS (EDGEAI_SAND_PATCH_COLS + 1)
+#define EDGEAI_SAND_WIN_ROWS (EDGEAI_SAND_PATCH_ROWS + 1)
+
+static inline int32_t sand_surrogate_offset(uint32_t phase)
+{
+    return (phase & 1u) ? (EDGEAI_SAND_PATCH / 2) : 0;
+}
+
+/* True when the window overlaps an active grid patch. */
+static bool sand_surrogate_window_active(const sand_grid_t *g, int32_t x0, int32_t y0)
+{
+    int32_t x1 = x0 + EDGEAI_SAND_PATCH - 1;
+    int32_t y1 = y0 + EDGEAI_SAND_PATCH - 1;
+    if (x1 < 0 || y1 < 0 || x0 >= EDGEAI_SAND_W || y0 >= EDGEAI_SAND_H) return false;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= EDGEAI_SAND_W) x1 = EDGEAI_SAND_W - 1;
+    if (y1 >= EDGEAI_SAND_H) y1 = EDGEAI_SAND_H - 1;
+    return g->active[sand_sim_patch_of(x0, y0)] || g->active[sand_sim_patch_of(x1, y0)] ||
+           g->active[sand_sim_patch_of(x0, y1)] || g->active[sand_sim_patch_of(x1, y1)];
+}
+
+/* A window whose inner cells hold no grain, or no free cell, cannot change this step. */
+static bool sand_surrogate_window_static(const sand_grid_t *g, int32_t x0, int32_t y0)
+{
+    bool sand = false, room = false;
+    for (int32_t y = y0; y < y0 + EDGEAI_SAND_PATCH; y++)
+    {
+        for (int32_t x = x0; x < x0 + EDGEAI_SAND_PATCH; x++)
+        {
+            uint8_t m = sand_sim_get(g, x, y);
+            sand |= (m == (uint8_t)kEdgeAiMatSand);
+            room |= (m == (uint8_t)kEdgeAiMatEmpty) || (m == (uint8_t)kEdgeAiMatWater);
+        }
+        if (sand && room) return false;
+    }
+    return true;
+}
+
+uint32_t edgeai_sand_surrogate_gather(const sand_grid_t *g, uint32_t phase, int8_t *in, uint16_t *window,
+                                      uint32_t max)
+{
+    if (!g) return 0u;
+    const int8_t gx = (int8_t)(g->gravity.gx * 127);
+    const int8_t gy = (int8_t)(g->gravity.gy * 127);
+    const int32_t off = sand_surrogate_offset(phase);
+    uint32_t n = 0;
+    for (int32_t wy = 0; wy < EDGEAI_SAND_WIN_ROWS; wy++)
+    {
+        for (int32_t wx = 0; wx < EDGEAI_SAND_WIN_COLS; wx++)
+        {
+            int32_t x0 = wx * EDGEAI_SAND_PATCH - off;
+            int32_t y0 = wy * EDGEAI_SAND_PATCH - off;
+            if (!sand_surrogate_window_active(g, x0, y0)) continue;
+            if (sand_surrogate_window_static(g, x0, y0)) continue;
+            if (n < max && in && window)
+            {
+                int8_t *dst = &in[n * EDGEAI_SAND_SURROGATE_IN_BYTES];
+                for (int32_t y = y0 - 1; y <= y0 + EDGEAI_SAND_PATCH; y++)
+                {
+                    for (int32_t x = x0 - 1; x <= x0 + EDGEAI_SAND_PATCH; x++)
+                    {
+                        *dst++ = sand_surrogate_encode(sand_sim_get(g, x, y));
+                        *dst++ = gx;
+                        *dst++ = gy;
+                    }
+                }
+                window[n] = (uint16_t)(wy * EDGEAI_SAND_WIN_COLS + wx);
+            }
+            n++;
+        }
+    }
+    return n;
+}
+
+static int32_t sand_surrogate_grains_in(const int8_t *in, uint32_t n)
+{
+    int32_t grains = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const int8_t *p = &in[i * EDGEAI_SAND_SURROGATE_IN_BYTES];
+        for (int32_t y = 1; y <= EDGEAI_SAND_PATCH; y++)
+        {
+            for (int32_t x = 1; x <= EDGEAI_SAND_PATCH; x++)
+            {
+                grains += (p[(y * EDGEAI_SAND_SURROGATE_IN_EDGE + x) * EDGEAI_SAND_SURROGATE_IN_C] > 0) ? 1 : 0;
+            }
+        }
+    }
+    return grains;
+}
+
+/* Grains after scatter: static cells keep their material whatever the model says. */
+static int32_t sand_surrogate_grains_out(const int8_t *in, const int8_t *out, uint32_t n)
+{
+    int32_t grains = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const int8_t *p = &in[i * EDGEAI_SAND_SURROGATE_IN_BYTES];
+        const int8_t *o = &out[i * EDGEAI_SAND_SURROGATE_OUT_BYTES];
+        for (int32_t y = 0; y < EDGEAI_SAND_PATCH; y++)
+        {
+            for (int32_t x = 0; x < EDGEAI_SAND_PATCH; x++)
+            {
+                int8_t q = p[((y + 1) * EDGEAI_SAND_SURROGATE_IN_EDGE + x + 1) * EDGEAI_SAND_SURROGATE_IN_C];
+                if (q == (int8_t)EDGEAI_SAND_Q_STATIC) continue;
+                grains += (o[y * EDGEAI_SAND_PATCH + x] > 0) ? 1 : 0;
+            }
+        }
+    }
+    return grains;
+}
+
+static void sand_surrogate_scatter(sand_grid_t *g, uint32_t phase, const uint16_t *window, const int8_t *out,
+                                   uint32_t n)
+{
+    const int32_t off = sand_surrogate_offset(phase);
+    uint32_t moves = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        int32_t x0 = (int32_t)(window[i] % EDGEAI_SAND_WIN_COLS) * EDGEAI_SAND_PATCH - off;
+        int32_t y0 = (int32_t)(window[i] / EDGEAI_SAND_WIN_COLS) * EDGEAI_SAND_PATCH - off;
+        const int8_t *o = &out[i * EDGEAI_SAND_SURROGATE_OUT_BYTES];
+        for (int32_t y = 0; y < EDGEAI_SAND_PATCH; y++)
+        {
+            int32_t cy = y0 + y;
+            if (cy < 0 || cy >= EDGEAI_SAND_H) continue;
+            for (int32_t x = 0; x < EDGEAI_SAND_PATCH; x++)
+            {
+                int32_t cx = x0 + x;
+                if (cx < 0 || cx >= EDGEAI_SAND_W) continue;
+                uint8_t *c = &g->cell[cy][cx];
+                if (*c != (uint8_t)kEdgeAiMatEmpty && *c != (uint8_t)kEdgeAiMatSand) continue;
+                uint8_t m = (o[y * EDGEAI_SAND_PATCH + x] > 0) ? (uint8_t)kEdgeAiMatSand : (uint8_t)kEdgeAiMatEmpty;
+                if (m == *c) continue;
+                *c = m;
+                g->changed[sand_sim_patch_of(cx, cy)] = 1u;
+                moves++;
+            }
+        }
+    }
+    g->moves = moves / 2u; /* a move empties one cell and fills another */
+}
+
+bool edgeai_sand_surrogate_step(edgeai_sand_surrogate_t *s, sand_grid_t *g, sand_gravity_t grav)
+{
+    if (!s || !g) return false;
+    (void)sand_sim_set_gravity(g, grav);
+
+    bool use = (s->run != NULL) && (grav.gx != 0 || grav.gy != 0);
+    uint32_t n = 0;
+    if (use)
+    {
+        n = edgeai_sand_surrogate_gather(g, s->phase, s->in, s->window, EDGEAI_SAND_SURROGATE_BATCH);
+        s->last_patches = n;
+        if (n > (uint32_t)EDGEAI_SAND_SURROGATE_BATCH)
+        {
+            s->overflows++;
+            use = false;
+        }
+    }
+    if (use && n > 0u)
+    {
+        if (!s->run(s->user, s->in, s->out, n))
+        {
+            s->run_failures++;
+            use = false;
+        }
+        else
+        {
+            s->last_drift = sand_surrogate_grains_out(s->in, s->out, n) - sand_surrogate_grains_in(s->in, n);
+            int32_t drift = (s->last_drift < 0) ? -s->last_drift : s->last_drift;
+            if (drift > EDGEAI_SAND_SURROGATE_DRIFT_MAX)
+            {
+                s->drift_rejects++;
+                use = false;
+            }
+        }
+    }
+
+    if (!use)
+    {
+        s->fallback_steps++;
+        sand_sim_step(g, grav);
+        return false;
+    }
+
+    g->cells_scanned = n * (uint32_t)(EDGEAI_SAND_PATCH * EDGEAI_SAND_PATCH);
+    if (n > 0u) sand_surrogate_scatter(g, s->phase, s->window, s->out, n);
+    else g->moves = 0;
+    g->steps++;
+    sand_sim_end_step(g);
+    s->phase ^= 1u;
+    s->batches++;
+    return true;
+}
+
+bool edgeai_sand_surrogate_run_reference(void *user, const int8_t *in, int8_t *out, uint32_t n)
+{
+    uint32_t *rng = (uint32_t *)user;
+    if (!rng || !in || !out) return false;
+
+    uint8_t cells[EDGEAI_SAND_SURROGATE_IN_EDGE * EDGEAI_SAND_SURROGATE_IN_EDGE];
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const int8_t *p = &in[i * EDGEAI_SAND_SURROGATE_IN_BYTES];
+        for (int32_t k = 0; k < EDGEAI_SAND_SURROGATE_IN_EDGE * EDGEAI_SAND_SURROGATE_IN_EDGE; k++)
+        {
+            int8_t q = p[k * EDGEAI_SAND_SURROGATE_IN_C];
+            cells[k] = (q > 0) ? (uint8_t)kEdgeAiMatSand : ((q < 0) ? (uint8_t)kEdgeAiMatEmpty : (uint8_t)kEdgeAiMatMetal);
+        }
+        sand_gravity_t grav;
+        grav.gx = (int8_t)((p[1] > 0) ? 1 : ((p[1] < 0) ? -1 : 0));
+        grav.gy = (int8_t)((p[2] > 0) ? 1 : ((p[2] < 0) ? -1 : 0));
+        (void)sand_sim_step_region(&cells[EDGEAI_SAND_SURROGATE_IN_EDGE + 1], EDGEAI_SAND_SURROGATE_IN_EDGE,
+                                   EDGEAI_SAND_PATCH, EDGEAI_SAND_PATCH, grav, rng);
+
+        int8_t *o = &out[i * EDGEAI_SAND_SURROGATE_OUT_BYTES];
+        for (int32_t y = 0; y < EDGEAI_SAND_PATCH; y++)
+        {
+            for (int32_t x = 0; x < EDGEAI_SAND_PATCH; x++)
+            {
+                uint8_t m = cells[(y + 1) * EDGEAI_SAND_SURROGATE_IN_EDGE + x + 1];
+                *o++ = (m == (uint8_t)kEdgeAiMatSand) ? (int8_t)EDGEAI_SAND_Q_SAND : (int8_t)EDGEAI_SAND_Q_EMPTY;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sand_sim.h"
+
+/* Surrogate (model-assisted) sand step, docs/TODO.md N3.
+ * Every active patch is gathered with a one-cell halo into one batched int8 tensor
+ * [N][P+2][P+2][3], a single runner call maps it to [N][P][P][1], and the result is scattered back.
+ * Input channels (int8, real = q / 127):
+ *   0: material: empty -127, sand +127, static (metal, water, off-grid) 0
+ *   1: gravity x (-127, 0, +127), constant over the patch
+ *   2: gravity y
+ * Output: > 0 is sand, otherwise empty; static cells are never overwritten.
+ * Grains move only inside their patch (the halo is context, read-only), so every patch conserves its
+ * grain count and patches never disagree about a shared cell; the patch grid is shifted by half a patch
+ * on alternate steps so grains still cross patch borders (block partitioning, as in Margolus
+ * neighborhoods). Water counts as static on this path, so grains do not sink through it.
+ *
+ * Deterministic CPU fallback (sand_sim_step) when no runner is attached, the runner fails, more
+ * patches are active than fit one batch, or the batch changes the grain count by more than
+ * EDGEAI_SAND_SURROGATE_DRIFT_MAX (the batch is then discarded before scatter).
+ */
+
+/* Attach the reference runner in the firmware (exercises gather/scatter and the batch path on target
+ * until a patch model is registered).
+ */
+#ifndef EDGEAI_SAND_SURROGATE_REFERENCE
+#define EDGEAI_SAND_SURROGATE_REFERENCE 0
+#endif
+
+/* Patches per batch (the model's batch dimension). */
+#ifndef EDGEAI_SAND_SURROGATE_BATCH
+#define EDGEAI_SAND_SURROGATE_BATCH 32
+#endif
+
+/* Largest grain-count change accepted from one batch. */
+#ifndef EDGEAI_SAND_SURROGATE_DRIFT_MAX
+#define EDGEAI_SAND_SURROGATE_DRIFT_MAX 4
+#endif
+
+#define EDGEAI_SAND_SURROGATE_IN_EDGE (EDGEAI_SAND_PATCH + 2)
+#define EDGEAI_SAND_SURROGATE_IN_C 3
+#define EDGEAI_SAND_SURROGATE_IN_BYTES \
+    (EDGEAI_SAND_SURROGATE_IN_EDGE * EDGEAI_SAND_SURROGATE_IN_EDGE * EDGEAI_SAND_SURROGATE_IN_C)
+#define EDGEAI_SAND_SURROGATE_OUT_BYTES (EDGEAI_SAND_PATCH * EDGEAI_SAND_PATCH)
+
+/* Runs `n` patches: `in` holds n * IN_BYTES, `out` receives n * OUT_BYTES. Returns false on failure. */
+typedef bool (*edgeai_sand_surrogate_run_fn_t)(void *user, const int8_t *in, int8_t *out, uint32_t n);
+
+typedef struct
+{
+    edgeai_sand_surrogate_run_fn_t run;
+    void *user;
+
+    int8_t in[EDGEAI_SAND_SURROGATE_BATCH * EDGEAI_SAND_SURROGATE_IN_BYTES];
+    int8_t out[EDGEAI_SAND_SURROGATE_BATCH * EDGEAI_SAND_SURROGATE_OUT_BYTES];
+    uint16_t window[EDGEAI_SAND_SURROGATE_BATCH]; /* gathered window index per batch entry */
+    uint32_t phase;                                /* 0: patch grid, 1: shifted by half a patch */
+
+    /* Counters (monotonic) and the last step. */
+    uint32_t batches;        /* steps taken by the surrogate */
+    uint32_t fallback_steps; /* steps taken by the CPU rule */
+    uint32_t overflows;      /* fallbacks because too many patches were active */
+    uint32_t run_failures;
+    uint32_t drift_rejects;
+    uint32_t last_patches;
+    int32_t last_drift;      /* grains out - grains in of the last batch */
+} edgeai_sand_surrogate_t;
+
+/* `run` may be NULL (CPU rule only). */
+void edgeai_sand_surrogate_init(edgeai_sand_surrogate_t *s, edgeai_sand_surrogate_run_fn_t run, void *user);
+
+/* One grid step through the surrogate or the CPU fallback. Returns true when the surrogate was used. */
+bool edgeai_sand_surrogate_step(edgeai_sand_surrogate_t *s, sand_grid_t *g, sand_gravity_t grav);
+
+/* Gathers the windows of `phase` that overlap an active patch into `in` (at most `max`, window indices
+ * into `window`), skipping windows with no grain or no free cell. Returns the window count, which may
+ * exceed `max` (nothing beyond `max` is written).
+ */
+uint32_t edgeai_sand_surrogate_gather(const sand_grid_t *g, uint32_t phase, int8_t *in, uint16_t *window,
+                                      uint32_t max);
+
+/* Reference runner: decodes each patch and applies the CPU rule inside it with its borders as walls
+ * (sand_sim_step_region). The target a model is trained for, and a debug comparison on target.
+ * `user` is a uint32_t PRNG state.
+ */
+bool edgeai_sand_surrogate_run_reference(void *user, const int8_t *in, int8_t *out, uint32_t n);
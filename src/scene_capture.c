@@ -0,0 +1,109 @@
+#include "scene_capture.h"
+
+#include <string.h>
+
+#include "edgeai_config.h"
+#include "sw_render.h"
+#include "tensor_util.h"
+
+static inline uint32_t edgeai_luma_rgb565(uint16_t c)
+{
+    uint32_t r5 = (uint32_t)(c >> 11) & 0x1Fu;
+    uint32_t g6 = (uint32_t)(c >> 5) & 0x3Fu;
+    uint32_t b5 = (uint32_t)c & 0x1Fu;
+    uint32_t r8 = (r5 << 3) | (r5 >> 2);
+    uint32_t g8 = (g6 << 2) | (g6 >> 4);
+    uint32_t b8 = (b5 << 3) | (b5 >> 2);
+    /* BT.601 weights in Q8. */
+    return (r8 * 77u + g8 * 150u + b8 * 29u) >> 8;
+}
+
+bool edgeai_scene_capture_bind(edgeai_scene_capture_t *cap, const edgeai_npu_tensor_view_t *v)
+{
+    if (!cap) return false;
+    memset(cap, 0, sizeof(*cap));
+    cap->phase = kEdgeAiSceneCapOff;
+    if (!v || !v->data || v->scale <= 0.0f) return false;
+    if (v->w == 0 || v->h == 0 || v->c == 0) return false;
+    if (v->w > EDGEAI_SCENE_CAP_MAX_W || v->h > EDGEAI_SCENE_CAP_MAX_H) return false;
+
+    cap->dst = v->data;
+    cap->w = v->w;
+    cap->h = v->h;
+    cap->c = v->c;
+
+    /* Quantize once per luminance level: q = round(y / 255 / scale) + zero_point, clamped to the type. */
+    edgeai_tensor_quant_lut(1.0f / 255.0f, v->scale, v->zero_point, v->is_signed, cap->lut);
+
+    for (uint32_t x = 0; x < cap->w; x++)
+    {
+        cap->col_sx[x] = (uint16_t)((x * EDGEAI_LCD_W + EDGEAI_LCD_W / 2u) / cap->w);
+    }
+
+    cap->next_row = 0;
+    cap->phase = kEdgeAiSceneCapFilling;
+    return true;
+}
+
+void edgeai_scene_capture_rows(edgeai_scene_capture_t *cap,
+                               const uint16_t *tile, uint32_t tw, uint32_t th, int32_t x0, int32_t y0)
+{
+    if (!cap || cap->phase != kEdgeAiSceneCapFilling) return;
+
+    uint32_t tex_w = 0, tex_h = 0;
+    const uint16_t *tex = sw_render_dune_tex(&tex_w, &tex_h);
+    const uint32_t c = cap->c;
+
+    for (uint32_t n = 0; n < EDGEAI_SCENE_CAP_ROWS_PER_FRAME && cap->next_row < cap->h; n++)
+    {
+        uint32_t ry = cap->next_row++;
+        int32_t sy = (int32_t)((ry * EDGEAI_LCD_H + EDGEAI_LCD_H / 2u) / cap->h);
+
+        uint32_t ty = (uint32_t)sy >> 1;
+        if (ty >= tex_h) ty = tex_h - 1u;
+        const uint16_t *brow = &tex[ty * tex_w];
+
+        const uint16_t *trow = NULL;
+        if (tile && sy >= y0 && sy < y0 + (int32_t)th) trow = &tile[(uint32_t)(sy - y0) * tw];
+
+        uint8_t *out = &cap->dst[ry * cap->w * c];
+        for (uint32_t x = 0; x < cap->w; x++)
+        {
+            int32_t sx = cap->col_sx[x];
+            uint16_t px;
+            if (trow && sx >= x0 && sx < x0 + (int32_t)tw)
+            {
+                px = trow[sx - x0];
+            }
+            else
+            {
+                uint32_t tx = (uint32_t)sx >> 1;
+                if (tx >= tex_w) tx = tex_w - 1u;
+                px = brow[tx];
+            }
+
+            uint8_t q = cap->lut[edgeai_luma_rgb565(px)];
+            for (uint32_t k = 0; k < c; k++) out[k] = q;
+            out += c;
+        }
+    }
+
+    if (cap->next_row >= cap->h)
+    {
+        cap->phase = kEdgeAiSceneCapReady;
+        cap->captures++;
+    }
+}
+
+void edgeai_scene_capture_hold(edgeai_scene_capture_t *cap)
+{
+    if (!cap || cap->phase != kEdgeAiSceneCapReady) return;
+    cap->phase = kEdgeAiSceneCapHeld;
+}
+
+void edgeai_scene_capture_restart(edgeai_scene_capture_t *cap)
+{
+    if (!cap || cap->phase == kEdgeAiSceneCapOff) return;
+    cap->next_row = 0;
+    cap->phase = kEdgeAiSceneCapFilling;
+}
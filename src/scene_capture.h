@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "npu_api.h"
+
+/* Scene capture into the NPU input tensor.
+ * The composed frame (dune background, overridden by the current dirty tile where they overlap) is
+ * point-sampled down to the tensor resolution as luminance and quantized through a 256-entry LUT built
+ * from the tensor's scale/zero-point (luminance 0..255 maps to real 0..1). Rows land directly in the
+ * tensor buffer in bands during rendering; no intermediate low-res framebuffer exists.
+ *
+ * Ownership: the tensor is written only while filling; once a full image is ready it is held until
+ * the inference job that reads it has finished (TFLM may reuse input memory during Invoke).
+ */
+
+#ifndef EDGEAI_SCENE_CAPTURE_ENABLE
+#define EDGEAI_SCENE_CAPTURE_ENABLE 1
+#endif
+
+#ifndef EDGEAI_SCENE_CAP_MAX_W
+#define EDGEAI_SCENE_CAP_MAX_W 160
+#endif
+
+#ifndef EDGEAI_SCENE_CAP_MAX_H
+#define EDGEAI_SCENE_CAP_MAX_H 120
+#endif
+
+/* Tensor rows written per rendered frame (spreads one capture over several frames). */
+#ifndef EDGEAI_SCENE_CAP_ROWS_PER_FRAME
+#define EDGEAI_SCENE_CAP_ROWS_PER_FRAME 16
+#endif
+
+typedef enum
+{
+    kEdgeAiSceneCapOff = 0,
+    kEdgeAiSceneCapFilling,
+    kEdgeAiSceneCapReady,
+    kEdgeAiSceneCapHeld,
+} edgeai_scene_cap_phase_t;
+
+typedef struct
+{
+    uint8_t *dst;
+    uint16_t w;
+    uint16_t h;
+    uint16_t c;
+    uint16_t next_row;
+    edgeai_scene_cap_phase_t phase;
+    uint32_t captures; /* completed images */
+    uint16_t col_sx[EDGEAI_SCENE_CAP_MAX_W];
+    uint8_t lut[256];
+} edgeai_scene_capture_t;
+
+/* Binds to a tensor view and starts filling. Fails (and stays off) for oversized tensors. */
+bool edgeai_scene_capture_bind(edgeai_scene_capture_t *cap, const edgeai_npu_tensor_view_t *v);
+
+/* Writes up to EDGEAI_SCENE_CAP_ROWS_PER_FRAME tensor rows. `tile` is the composed RGB565 dirty tile
+ * at (x0,y0) in LCD space, or NULL to sample the background only.
+ */
+void edgeai_scene_capture_rows(edgeai_scene_capture_t *cap,
+                               const uint16_t *tile, uint32_t tw, uint32_t th, int32_t x0, int32_t y0);
+
+static inline bool edgeai_scene_capture_ready(const edgeai_scene_capture_t *cap)
+{
+    return cap && cap->phase == kEdgeAiSceneCapReady;
+}
+
+/* Ready -> Held: an inference job owns the tensor. */
+void edgeai_scene_capture_hold(edgeai_scene_capture_t *cap);
+
+/* Held/Ready -> Filling from row 0. */
+void edgeai_scene_capture_restart(edgeai_scene_capture_t *cap);
@@ -0,0 +1,88 @@
+#include "scratch_arena.h"
+
+#if EDGEAI_SCRATCH_SHARED
+_Static_assert(EDGEAI_SCRATCH_BYTES >= EDGEAI_SCRATCH_TILE_BYTES, "scratch region smaller than the render tile");
+
+static uint8_t s_scratch[EDGEAI_SCRATCH_BYTES] __attribute__((aligned(16)));
+#define EDGEAI_SCRATCH_TILE_PTR ((uint16_t *)(void *)&s_scratch[EDGEAI_SCRATCH_BYTES - EDGEAI_SCRATCH_TILE_BYTES])
+#else
+static uint16_t s_scratchTile[EDGEAI_TILE_MAX_W * EDGEAI_TILE_MAX_H] __attribute__((aligned(16)));
+#define EDGEAI_SCRATCH_TILE_PTR (s_scratchTile)
+#endif
+
+static volatile edgeai_scratch_owner_t s_owner = kEdgeAiScratchOwnerNone;
+static volatile bool s_waiter = false;
+static void (*s_releaseHook)(void) = NULL;
+static edgeai_scratch_stats_t s_stats;
+
+uint16_t *edgeai_scratch_tile(void)
+{
+    return EDGEAI_SCRATCH_TILE_PTR;
+}
+
+uint8_t *edgeai_scratch_model_arena(uint32_t *bytes)
+{
+#if EDGEAI_SCRATCH_SHARED
+    if (bytes) *bytes = EDGEAI_SCRATCH_BYTES;
+    return s_scratch;
+#else
+    if (bytes) *bytes = 0;
+    return NULL;
+#endif
+}
+
+bool edgeai_scratch_acquire(edgeai_scratch_owner_t who)
+{
+    edgeai_scratch_owner_t cur = s_owner;
+    if (cur != kEdgeAiScratchOwnerNone && cur != who)
+    {
+        s_waiter = true;
+        s_stats.contended++;
+        return false;
+    }
+    s_owner = who;
+    if (who == kEdgeAiScratchOwnerRender) s_stats.render_acquires++;
+    else s_stats.inference_acquires++;
+    return true;
+}
+
+void edgeai_scratch_release(edgeai_scratch_owner_t who)
+{
+    if (s_owner != who) return;
+    s_owner = kEdgeAiScratchOwnerNone;
+    if (s_waiter)
+    {
+        s_waiter = false;
+        if (s_releaseHook) s_releaseHook();
+    }
+}
+
+edgeai_scratch_owner_t edgeai_scratch_owner(void)
+{
+    return s_owner;
+}
+
+void edgeai_scratch_set_release_hook(void (*fn)(void))
+{
+    s_releaseHook = fn;
+}
+
+bool edgeai_scratch_overlaps_tile(const void *p, uint32_t len)
+{
+#if EDGEAI_SCRATCH_SHARED
+    uintptr_t a0 = (uintptr_t)p;
+    uintptr_t a1 = a0 + len;
+    uintptr_t t0 = (uintptr_t)EDGEAI_SCRATCH_TILE_PTR;
+    uintptr_t t1 = t0 + EDGEAI_SCRATCH_TILE_BYTES;
+    return (a0 < t1) && (t0 < a1);
+#else
+    (void)p;
+    (void)len;
+    return false;
+#endif
+}
+
+void edgeai_scratch_get_stats(edgeai_scratch_stats_t *out)
+{
+    if (out) *out = s_stats;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "edgeai_config.h"
+
+/* Phase-aware scratch region.
+ * The render tile and the TFLM non-persistent arena (planned activations, input/output tensors) are
+ * never live at the same instant, so with EDGEAI_SCRATCH_SHARED they occupy one region:
+ *
+ *   [0 .................................... EDGEAI_SCRATCH_BYTES)
+ *   [ model non-persistent arena (whole region) ...............)
+ *                         [ render tile (last TILE bytes) .....)
+ *
+ * Ownership is explicit: the renderer holds the region for a frame, an inference job holds it for one
+ * Invoke. Acquire never waits; a job that finds the region busy stays pending and is re-kicked through
+ * the release hook when the renderer lets go. The deferred job context preempts thread mode, so
+ * owner updates need no locking on a single core.
+ *
+ * Anything that must survive a render phase inside the model arena (the scene-capture input tensor)
+ * must lie outside the tile range; see `edgeai_scratch_overlaps_tile`.
+ */
+
+typedef enum
+{
+    kEdgeAiScratchOwnerNone = 0,
+    kEdgeAiScratchOwnerRender,
+    kEdgeAiScratchOwnerInference,
+} edgeai_scratch_owner_t;
+
+#define EDGEAI_SCRATCH_TILE_BYTES ((uint32_t)(EDGEAI_TILE_MAX_W * EDGEAI_TILE_MAX_H * 2u))
+
+uint16_t *edgeai_scratch_tile(void);
+uint8_t *edgeai_scratch_model_arena(uint32_t *bytes);
+
+bool edgeai_scratch_acquire(edgeai_scratch_owner_t who);
+void edgeai_scratch_release(edgeai_scratch_owner_t who);
+edgeai_scratch_owner_t edgeai_scratch_owner(void);
+
+/* Called after a release that had a waiter (for example `edgeai_npu_defer_kick`). */
+void edgeai_scratch_set_release_hook(void (*fn)(void));
+
+/* True when [p, p+len) intersects the render tile (always false when not shared). */
+bool edgeai_scratch_overlaps_tile(const void *p, uint32_t len);
+
+typedef struct
+{
+    uint32_t render_acquires;
+    uint32_t inference_acquires;
+    uint32_t contended; /* acquires refused because the other phase held the region */
+} edgeai_scratch_stats_t;
+
+void edgeai_scratch_get_stats(edgeai_scratch_stats_t *out);
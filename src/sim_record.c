@@ -0,0 +1,205 @@
+#include "sim_record.h"
+
+#include <string.h>
+
+#if (EDGEAI_SIM_REC_BYTES & (EDGEAI_SIM_REC_BYTES - 1u)) != 0
+#error "EDGEAI_SIM_REC_BYTES must be a power of two"
+#endif
+#if (EDGEAI_SIM_REC_KEYS & (EDGEAI_SIM_REC_KEYS - 1u)) != 0
+#error "EDGEAI_SIM_REC_KEYS must be a power of two"
+#endif
+
+_Static_assert(sizeof(sim_input_t) == EDGEAI_SIM_REC_FIELDS * sizeof(int32_t), "sim_input_t is not 7 x int32");
+
+/* Largest record: keyframe followed by a step with every field at its longest varint. */
+#define SIM_REC_STEP_MAX (1u + EDGEAI_SIM_REC_FIELDS * 5u)
+#define SIM_REC_RECORD_MAX (EDGEAI_SIM_REC_KEY_BYTES + SIM_REC_STEP_MAX)
+
+static uint8_t *sim_rec_put_u32(uint8_t *o, uint32_t v)
+{
+    o[0] = (uint8_t)v;
+    o[1] = (uint8_t)(v >> 8);
+    o[2] = (uint8_t)(v >> 16);
+    o[3] = (uint8_t)(v >> 24);
+    return o + 4;
+}
+
+static uint32_t sim_rec_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Drops the oldest keyframe and its steps; the ring then starts at the next keyframe (or is empty). */
+static void sim_rec_drop_oldest(edgeai_sim_rec_t *r)
+{
+    r->key_tail++;
+    r->tail = (r->key_tail == r->key_head) ? r->head : r->key_pos[r->key_tail & (EDGEAI_SIM_REC_KEYS - 1u)];
+}
+
+void edgeai_sim_rec_init(edgeai_sim_rec_t *r)
+{
+    if (!r) return;
+    memset(r, 0, sizeof(*r));
+}
+
+void edgeai_sim_rec_step(edgeai_sim_rec_t *r, const sim_world_t *w, const sim_input_t *in)
+{
+    bool key = (r->key_head == r->key_tail) || (r->since_key >= EDGEAI_SIM_REC_KEY_STEPS);
+    if (key && r->key_head - r->key_tail == EDGEAI_SIM_REC_KEYS) sim_rec_drop_oldest(r);
+
+    /* Make room for the longest record first, so it can be encoded in place. */
+    uint32_t need = key ? SIM_REC_RECORD_MAX : SIM_REC_STEP_MAX;
+    while (r->key_head != r->key_tail && (r->head + need) - r->tail > EDGEAI_SIM_REC_BYTES) sim_rec_drop_oldest(r);
+    if (r->key_head == r->key_tail)
+    {
+        /* The only keyframe went: this step starts a new one. */
+        key = true;
+        r->tail = r->head;
+    }
+
+    uint8_t tmp[SIM_REC_RECORD_MAX];
+    uint32_t idx = r->head & (EDGEAI_SIM_REC_BYTES - 1u);
+    uint8_t *start = (idx + SIM_REC_RECORD_MAX <= EDGEAI_SIM_REC_BYTES) ? &r->ring[idx] : tmp;
+    uint8_t *o = start;
+
+    if (key)
+    {
+        *o++ = EDGEAI_SIM_REC_KEY_TAG;
+        o = sim_rec_put_u32(o, r->steps);
+        o = sim_rec_put_u32(o, (uint32_t)w->ball.x_q16);
+        o = sim_rec_put_u32(o, (uint32_t)w->ball.y_q16);
+        o = sim_rec_put_u32(o, (uint32_t)w->ball.vx_q16);
+        o = sim_rec_put_u32(o, (uint32_t)w->ball.vy_q16);
+        o = sim_rec_put_u32(o, (uint32_t)w->ball.lift_q16);
+        *o++ = w->ball.glint;
+        memset(r->prev, 0, sizeof(r->prev));
+        r->key_pos[r->key_head & (EDGEAI_SIM_REC_KEYS - 1u)] = r->head;
+        r->key_head++;
+        r->keyframes++;
+        r->since_key = 0;
+    }
+
+    int32_t cur[EDGEAI_SIM_REC_FIELDS];
+    memcpy(cur, in, sizeof(cur));
+    uint8_t *mask = o++;
+    uint32_t m = 0;
+    for (uint32_t i = 0; i < EDGEAI_SIM_REC_FIELDS; i++)
+    {
+        uint32_t d = (uint32_t)cur[i] - (uint32_t)r->prev[i];
+        if (d == 0u) continue;
+        m |= 1u << i;
+        uint32_t z = (d << 1) ^ (uint32_t)((int32_t)d >> 31);
+        while (z >= 0x80u)
+        {
+            *o++ = (uint8_t)(z | 0x80u);
+            z >>= 7;
+        }
+        *o++ = (uint8_t)z;
+        r->prev[i] = cur[i];
+    }
+    *mask = (uint8_t)m;
+
+    uint32_t n = (uint32_t)(o - start);
+    if (start == tmp)
+    {
+        uint32_t first = EDGEAI_SIM_REC_BYTES - idx;
+        if (first > n) first = n;
+        memcpy(&r->ring[idx], tmp, first);
+        memcpy(&r->ring[0], tmp + first, n - first);
+    }
+    r->head += n;
+    r->bytes += n;
+    r->since_key++;
+    r->steps++;
+}
+
+uint32_t edgeai_sim_rec_copy(const edgeai_sim_rec_t *r, uint8_t *dst, uint32_t max)
+{
+    if (!r || !dst) return 0;
+    uint32_t n = r->head - r->tail;
+    if (n > max) return 0;
+    uint32_t idx = r->tail & (EDGEAI_SIM_REC_BYTES - 1u);
+    uint32_t first = EDGEAI_SIM_REC_BYTES - idx;
+    if (first > n) first = n;
+    memcpy(dst, &r->ring[idx], first);
+    memcpy(dst + first, &r->ring[0], n - first);
+    return n;
+}
+
+bool edgeai_sim_rec_dump(const edgeai_sim_rec_t *r, const sim_params_t *p, edgeai_sim_rec_print_fn_t print_fn)
+{
+    if (!r || !p || !print_fn || r->head == r->tail) return false;
+    static const char k_hex[] = "0123456789abcdef";
+    print_fn("EDGEAI: sim_rec %u params=%d,%d,%d,%d,%d,%d,%d,%d swept=%d,%d,%d float=%d data=",
+             (unsigned)EDGEAI_SIM_REC_VERSION, (int)p->sim_step_q16, (int)p->a_px_s2, (int)p->damp_q16,
+             (int)p->minx, (int)p->miny, (int)p->maxx, (int)p->maxy, (int)p->terrain_a_px_s2,
+             (int)EDGEAI_SIM_SWEPT, (int)EDGEAI_SIM_SUBSTEP_PX, (int)EDGEAI_SIM_SUBSTEP_MAX,
+             (int)EDGEAI_SIM_FLOAT);
+    char buf[65];
+    uint32_t k = 0;
+    for (uint32_t pos = r->tail; pos != r->head; pos++)
+    {
+        uint8_t b = r->ring[pos & (EDGEAI_SIM_REC_BYTES - 1u)];
+        buf[k++] = k_hex[b >> 4];
+        buf[k++] = k_hex[b & 15u];
+        if (k == 64u || pos + 1u == r->head)
+        {
+            buf[k] = '\0';
+            print_fn("%s", buf);
+            k = 0;
+        }
+    }
+    print_fn("\r\n");
+    return true;
+}
+
+void edgeai_sim_rec_reader_init(edgeai_sim_rec_reader_t *rd, const uint8_t *data, uint32_t len)
+{
+    memset(rd, 0, sizeof(*rd));
+    rd->data = data;
+    rd->len = len;
+}
+
+edgeai_sim_rec_item_t edgeai_sim_rec_read(edgeai_sim_rec_reader_t *rd)
+{
+    if (rd->pos >= rd->len) return kEdgeAiSimRecEnd;
+    const uint8_t *p = rd->data + rd->pos;
+    uint32_t left = rd->len - rd->pos;
+
+    if (p[0] == EDGEAI_SIM_REC_KEY_TAG)
+    {
+        if (left < EDGEAI_SIM_REC_KEY_BYTES) return kEdgeAiSimRecError;
+        sim_world_init(&rd->key, 0, 0);
+        rd->step = sim_rec_get_u32(p + 1);
+        rd->key.ball.x_q16 = (int32_t)sim_rec_get_u32(p + 5);
+        rd->key.ball.y_q16 = (int32_t)sim_rec_get_u32(p + 9);
+        rd->key.ball.vx_q16 = (int32_t)sim_rec_get_u32(p + 13);
+        rd->key.ball.vy_q16 = (int32_t)sim_rec_get_u32(p + 17);
+        rd->key.ball.lift_q16 = (int32_t)sim_rec_get_u32(p + 21);
+        rd->key.ball.glint = p[25];
+        memset(rd->prev, 0, sizeof(rd->prev));
+        rd->pos += EDGEAI_SIM_REC_KEY_BYTES;
+        return kEdgeAiSimRecKey;
+    }
+    if (p[0] & 0x80u) return kEdgeAiSimRecError;
+
+    uint32_t i = 1;
+    for (uint32_t f = 0; f < EDGEAI_SIM_REC_FIELDS; f++)
+    {
+        if (!(p[0] & (1u << f))) continue;
+        uint32_t z = 0;
+        for (uint32_t shift = 0;; shift += 7u)
+        {
+            if (i >= left || shift > 28u) return kEdgeAiSimRecError;
+            uint8_t b = p[i++];
+            z |= (uint32_t)(b & 0x7Fu) << shift;
+            if (!(b & 0x80u)) break;
+        }
+        int32_t d = (int32_t)(z >> 1) ^ -(int32_t)(z & 1u);
+        rd->prev[f] = (int32_t)((uint32_t)rd->prev[f] + (uint32_t)d);
+    }
+    memcpy(&rd->in, rd->prev, sizeof(rd->in));
+    rd->pos += i;
+    rd->step++;
+    return kEdgeAiSimRecStep;
+}
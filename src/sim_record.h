@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sim_world.h"
+
+/* Sim recorder: a fixed-size byte ring holding the inputs of every sim_step plus periodic keyframes of
+ * the ball state, enough to replay any stretch from a keyframe bit-exactly (tools/sim_replay.c).
+ *
+ * Records (little-endian), back to back:
+ *   keyframe: 0x80 | step u32 | x, y, vx, vy, lift i32 | glint u8              (26 bytes)
+ *   step:     mask u8 (bit i: input field i changed) | zigzag varint delta per set bit
+ * Deltas are against the previous step's input; a keyframe resets that to all zeros, so decoding can
+ * start at any keyframe. A steady tilt costs one or a few bytes per step. When the ring is full the
+ * oldest keyframe and its steps are dropped as a whole, so the ring always starts at a keyframe.
+ *
+ * Dump: one `EDGEAI: sim_rec` text line with the sim parameters and the ring contents in hex.
+ */
+
+#ifndef EDGEAI_SIM_REC_ENABLE
+#define EDGEAI_SIM_REC_ENABLE 1
+#endif
+
+/* Ring size in bytes (power of two). */
+#ifndef EDGEAI_SIM_REC_BYTES
+#define EDGEAI_SIM_REC_BYTES 8192u
+#endif
+
+/* Steps between keyframes (120 = 1 s at the demo's sim rate). */
+#ifndef EDGEAI_SIM_REC_KEY_STEPS
+#define EDGEAI_SIM_REC_KEY_STEPS 120u
+#endif
+
+/* Keyframes tracked in the ring (power of two). */
+#ifndef EDGEAI_SIM_REC_KEYS
+#define EDGEAI_SIM_REC_KEYS 32u
+#endif
+
+#define EDGEAI_SIM_REC_VERSION 2u
+#define EDGEAI_SIM_REC_KEY_TAG 0x80u
+#define EDGEAI_SIM_REC_KEY_BYTES 26u
+#define EDGEAI_SIM_REC_FIELDS 7u /* int32 fields of sim_input_t */
+
+typedef struct
+{
+    uint8_t ring[EDGEAI_SIM_REC_BYTES];
+    uint32_t head; /* free-running byte positions; data is [tail, head) */
+    uint32_t tail;
+    uint32_t key_pos[EDGEAI_SIM_REC_KEYS]; /* byte position of each keyframe */
+    uint32_t key_head;                     /* free-running keyframe indices */
+    uint32_t key_tail;
+    uint32_t since_key;
+    int32_t prev[EDGEAI_SIM_REC_FIELDS];
+
+    /* Counters (monotonic). */
+    uint32_t steps;
+    uint32_t bytes;
+    uint32_t keyframes;
+} edgeai_sim_rec_t;
+
+typedef int (*edgeai_sim_rec_print_fn_t)(const char *fmt, ...);
+
+void edgeai_sim_rec_init(edgeai_sim_rec_t *r);
+
+/* Records one step; call right before sim_step(w, in, ...) with the same world and input. */
+void edgeai_sim_rec_step(edgeai_sim_rec_t *r, const sim_world_t *w, const sim_input_t *in);
+
+/* Copies the ring contents (oldest keyframe first) into `dst`; returns the byte count, 0 if it does not fit. */
+uint32_t edgeai_sim_rec_copy(const edgeai_sim_rec_t *r, uint8_t *dst, uint32_t max);
+
+/* Prints the `EDGEAI: sim_rec` line. */
+bool edgeai_sim_rec_dump(const edgeai_sim_rec_t *r, const sim_params_t *p, edgeai_sim_rec_print_fn_t print_fn);
+
+/* Decoder (host replay). */
+typedef enum
+{
+    kEdgeAiSimRecEnd = 0,
+    kEdgeAiSimRecKey,   /* `key` holds the ball state before step `step` */
+    kEdgeAiSimRecStep,  /* `in` holds the input of step `step` - 1 */
+    kEdgeAiSimRecError, /* truncated or malformed record */
+} edgeai_sim_rec_item_t;
+
+typedef struct
+{
+    const uint8_t *data;
+    uint32_t len;
+    uint32_t pos;
+    uint32_t step; /* index of the next step */
+    sim_world_t key;
+    sim_input_t in;
+    int32_t prev[EDGEAI_SIM_REC_FIELDS];
+} edgeai_sim_rec_reader_t;
+
+void edgeai_sim_rec_reader_init(edgeai_sim_rec_reader_t *rd, const uint8_t *data, uint32_t len);
+edgeai_sim_rec_item_t edgeai_sim_rec_read(edgeai_sim_rec_reader_t *rd);
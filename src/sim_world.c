@@ -2,6 +2,7 @@
 
 #include "edgeai_config.h"
 #include "edgeai_util.h"
+#include "ram_place.h"
 
 void sim_world_init(sim_world_t *w, int32_t lcd_w, int32_t lcd_h)
 {
@@ -12,28 +13,161 @@ void sim_world_init(sim_world_t *w, int32_t lcd_w, int32_t lcd_h)
     w->ball.vy_q16 = 0;
     w->ball.lift_q16 = 0;
     w->ball.glint = 0;
+    w->substeps = 0;
+    w->bounces = 0;
 }
 
-void sim_step(sim_world_t *w, const sim_input_t *in, const sim_params_t *p)
+#if EDGEAI_SIM_SWEPT
+/* Walls for a ball centered at row `cy`: the bounds are set for the largest radius and move out by the
+ * difference to the perspective radius drawn there.
+ */
+EDGEAI_RAMFUNC_UNLESS(EDGEAI_SIM_FLOAT)
+static void sim_bounds(const sim_params_t *p, int32_t cy, int32_t b[4])
 {
-    if (!w || !in || !p) return;
+    int32_t shrink = EDGEAI_BALL_R_MAX - edgeai_ball_r_for_y(cy);
+    b[0] = (p->minx - shrink) << 16;
+    b[1] = (p->maxx + shrink) << 16;
+    b[2] = (p->miny - shrink) << 16;
+    b[3] = (p->maxy + shrink) << 16;
+}
 
-    w->ball.lift_q16 += (in->lift_target_q16 - w->ball.lift_q16) >> EDGEAI_BALL_LIFT_SMOOTH_SHIFT;
+/* Moves one axis by `d` between walls lo/hi (Q16). A wall crossed while moving toward it is hit at its time
+ * of impact, and the rest of the move comes back off it scaled by the 3/4 restitution, like the velocity.
+ * A ball already outside (the walls moved with the radius) is put back without a bounce.
+ */
+EDGEAI_RAMFUNC_UNLESS(EDGEAI_SIM_FLOAT)
+static uint32_t sim_sweep_axis(int32_t *pos, int32_t *vel, int32_t d, int32_t lo, int32_t hi)
+{
+    uint32_t hits = 0;
+    int32_t x = *pos + d;
+    if (x < lo)
+    {
+        if (*vel < 0 && *pos >= lo)
+        {
+            x = lo + (int32_t)(((int64_t)(lo - x) * 3) / 4);
+            *vel = -(*vel * 3) / 4;
+            hits = 1;
+        }
+        else
+        {
+            x = lo;
+        }
+    }
+    else if (x > hi)
+    {
+        if (*vel > 0 && *pos <= hi)
+        {
+            x = hi - (int32_t)(((int64_t)(x - hi) * 3) / 4);
+            *vel = -(*vel * 3) / 4;
+            hits = 1;
+        }
+        else
+        {
+            x = hi;
+        }
+    }
+    *pos = edgeai_clamp_i32(x, lo, hi);
+    return hits;
+}
 
-    /* One-shot velocity impulse from an impact/bang (provided by the main loop). */
-    w->ball.vx_q16 += in->bang_dvx_q16;
-    w->ball.vy_q16 += in->bang_dvy_q16;
+EDGEAI_RAMFUNC_UNLESS(EDGEAI_SIM_FLOAT)
+static void sim_move_swept(sim_world_t *w, const sim_params_t *p)
+{
+    int32_t ax = edgeai_abs_i32(w->ball.vx_q16);
+    int32_t ay = edgeai_abs_i32(w->ball.vy_q16);
+    int32_t vmax = (ax > ay) ? ax : ay;
+    int32_t disp_q16 = (int32_t)(((int64_t)vmax * p->sim_step_q16) >> 16);
+    int32_t n = 1 + disp_q16 / (EDGEAI_SIM_SUBSTEP_PX << 16);
+    if (n > EDGEAI_SIM_SUBSTEP_MAX) n = EDGEAI_SIM_SUBSTEP_MAX;
 
-    /* soft_q15 * a_px_s2 gives Q15 px/s^2; convert to Q16 by <<1 */
-    int32_t ax_a_q16 = (int32_t)(((int64_t)in->ax_soft_q15 * p->a_px_s2) << 1);
-    int32_t ay_a_q16 = (int32_t)(((int64_t)in->ay_soft_q15 * p->a_px_s2) << 1);
+    int32_t dt_sub = (n > 1) ? p->sim_step_q16 / n : p->sim_step_q16;
+    int32_t dt_left = p->sim_step_q16;
+    for (int32_t i = 0; i < n; i++)
+    {
+        int32_t dt = (i == n - 1) ? dt_left : dt_sub;
+        dt_left -= dt;
+        int32_t dx = (int32_t)(((int64_t)w->ball.vx_q16 * dt) >> 16);
+        int32_t dy = (int32_t)(((int64_t)w->ball.vy_q16 * dt) >> 16);
+        /* The walls move with the row (the radius does); take them at the row the substep heads for, so a
+         * ball running into the near wall meets it where it is drawn there.
+         */
+        int32_t b[4];
+        sim_bounds(p, (w->ball.y_q16 + dy) >> 16, b);
+        w->bounces += sim_sweep_axis(&w->ball.x_q16, &w->ball.vx_q16, dx, b[0], b[1]);
+        w->bounces += sim_sweep_axis(&w->ball.y_q16, &w->ball.vy_q16, dy, b[2], b[3]);
+    }
+    w->substeps += (uint32_t)n;
+}
 
-    w->ball.vx_q16 += (int32_t)(((int64_t)ax_a_q16 * p->sim_step_q16) >> 16);
-    w->ball.vy_q16 += (int32_t)(((int64_t)ay_a_q16 * p->sim_step_q16) >> 16);
+/* sim_sweep_axis in float pixels. */
+EDGEAI_RAMFUNC_IF(EDGEAI_SIM_FLOAT)
+static uint32_t sim_sweep_axis_float(float *pos, float *vel, float d, float lo, float hi)
+{
+    uint32_t hits = 0;
+    float x = *pos + d;
+    if (x < lo)
+    {
+        if (*vel < 0.0f && *pos >= lo)
+        {
+            x = lo + (lo - x) * 0.75f;
+            *vel = -*vel * 0.75f;
+            hits = 1;
+        }
+        else
+        {
+            x = lo;
+        }
+    }
+    else if (x > hi)
+    {
+        if (*vel > 0.0f && *pos <= hi)
+        {
+            x = hi - (x - hi) * 0.75f;
+            *vel = -*vel * 0.75f;
+            hits = 1;
+        }
+        else
+        {
+            x = hi;
+        }
+    }
+    *pos = (x < lo) ? lo : ((x > hi) ? hi : x);
+    return hits;
+}
 
-    w->ball.vx_q16 = (int32_t)(((int64_t)w->ball.vx_q16 * p->damp_q16) >> 16);
-    w->ball.vy_q16 = (int32_t)(((int64_t)w->ball.vy_q16 * p->damp_q16) >> 16);
+/* sim_move_swept for the float step: velocity (px/s) comes in, the ball goes out in Q16. */
+EDGEAI_RAMFUNC_IF(EDGEAI_SIM_FLOAT)
+static void sim_move_swept_float(sim_world_t *w, const sim_params_t *p, float vx, float vy)
+{
+    const float dt = (float)p->sim_step_q16 * (1.0f / 65536.0f);
+    float vmax = (vx < 0.0f) ? -vx : vx;
+    float vay = (vy < 0.0f) ? -vy : vy;
+    if (vay > vmax) vmax = vay;
+    int32_t n = 1 + (int32_t)(vmax * dt * (1.0f / (float)EDGEAI_SIM_SUBSTEP_PX));
+    if (n > EDGEAI_SIM_SUBSTEP_MAX) n = EDGEAI_SIM_SUBSTEP_MAX;
 
+    const float dt_sub = dt / (float)n;
+    float x = (float)w->ball.x_q16 * (1.0f / 65536.0f);
+    float y = (float)w->ball.y_q16 * (1.0f / 65536.0f);
+    for (int32_t i = 0; i < n; i++)
+    {
+        float dx = vx * dt_sub;
+        float dy = vy * dt_sub;
+        int32_t shrink = EDGEAI_BALL_R_MAX - edgeai_ball_r_for_y((int32_t)(y + dy));
+        w->bounces += sim_sweep_axis_float(&x, &vx, dx, (float)(p->minx - shrink), (float)(p->maxx + shrink));
+        w->bounces += sim_sweep_axis_float(&y, &vy, dy, (float)(p->miny - shrink), (float)(p->maxy + shrink));
+    }
+    w->substeps += (uint32_t)n;
+    w->ball.x_q16 = (int32_t)(x * 65536.0f);
+    w->ball.y_q16 = (int32_t)(y * 65536.0f);
+    w->ball.vx_q16 = (int32_t)(vx * 65536.0f);
+    w->ball.vy_q16 = (int32_t)(vy * 65536.0f);
+}
+#else
+/* Integrate, then clamp to the perspective-shrunk bounds with the 3/4 restitution. */
+EDGEAI_RAMFUNC
+static void sim_move_clamp(sim_world_t *w, const sim_params_t *p)
+{
     w->ball.x_q16 += (int32_t)(((int64_t)w->ball.vx_q16 * p->sim_step_q16) >> 16);
     w->ball.y_q16 += (int32_t)(((int64_t)w->ball.vy_q16 * p->sim_step_q16) >> 16);
 
@@ -55,4 +189,84 @@ void sim_step(sim_world_t *w, const sim_input_t *in, const sim_params_t *p)
     if (cx > maxx) { cx = maxx; w->ball.x_q16 = cx << 16; w->ball.vx_q16 = -(w->ball.vx_q16 * 3) / 4; }
     if (cy < miny) { cy = miny; w->ball.y_q16 = cy << 16; w->ball.vy_q16 = -(w->ball.vy_q16 * 3) / 4; }
     if (cy > maxy) { cy = maxy; w->ball.y_q16 = cy << 16; w->ball.vy_q16 = -(w->ball.vy_q16 * 3) / 4; }
+    w->substeps++;
+}
+#endif
+
+void sim_sample_terrain(const sim_world_t *w, const sim_params_t *p, sim_input_t *in)
+{
+    int32_t gx_q16 = 0, gy_q16 = 0;
+    if (p->terrain) edgeai_terrain_sample(p->terrain, w->ball.x_q16, w->ball.y_q16, &gx_q16, &gy_q16);
+    in->slope_x_q8 = (gx_q16 + 128) >> 8;
+    in->slope_y_q8 = (gy_q16 + 128) >> 8;
+}
+
+EDGEAI_RAMFUNC
+void sim_step(sim_world_t *w, const sim_input_t *in, const sim_params_t *p)
+{
+#if EDGEAI_SIM_FLOAT
+    sim_step_float(w, in, p);
+#else
+    sim_step_fixed(w, in, p);
+#endif
+}
+
+EDGEAI_RAMFUNC_UNLESS(EDGEAI_SIM_FLOAT)
+void sim_step_fixed(sim_world_t *w, const sim_input_t *in, const sim_params_t *p)
+{
+    if (!w || !in || !p) return;
+
+    w->ball.lift_q16 += (in->lift_target_q16 - w->ball.lift_q16) >> EDGEAI_BALL_LIFT_SMOOTH_SHIFT;
+
+    /* One-shot velocity impulse from an impact/bang (provided by the main loop). */
+    w->ball.vx_q16 += in->bang_dvx_q16;
+    w->ball.vy_q16 += in->bang_dvy_q16;
+
+    /* soft_q15 * a_px_s2 gives Q15 px/s^2; convert to Q16 by <<1 */
+    int32_t ax_a_q16 = (int32_t)(((int64_t)in->ax_soft_q15 * p->a_px_s2) << 1);
+    int32_t ay_a_q16 = (int32_t)(((int64_t)in->ay_soft_q15 * p->a_px_s2) << 1);
+
+    /* Terrain: downhill along the heightmap gradient at the ball center (Q8 slope * px/s^2). */
+    ax_a_q16 -= (int32_t)(((int64_t)in->slope_x_q8 * p->terrain_a_px_s2) << 8);
+    ay_a_q16 -= (int32_t)(((int64_t)in->slope_y_q8 * p->terrain_a_px_s2) << 8);
+
+    w->ball.vx_q16 += (int32_t)(((int64_t)ax_a_q16 * p->sim_step_q16) >> 16);
+    w->ball.vy_q16 += (int32_t)(((int64_t)ay_a_q16 * p->sim_step_q16) >> 16);
+
+    w->ball.vx_q16 = (int32_t)(((int64_t)w->ball.vx_q16 * p->damp_q16) >> 16);
+    w->ball.vy_q16 = (int32_t)(((int64_t)w->ball.vy_q16 * p->damp_q16) >> 16);
+
+#if EDGEAI_SIM_SWEPT
+    sim_move_swept(w, p);
+#else
+    sim_move_clamp(w, p);
+#endif
+}
+
+EDGEAI_RAMFUNC_IF(EDGEAI_SIM_FLOAT)
+void sim_step_float(sim_world_t *w, const sim_input_t *in, const sim_params_t *p)
+{
+    if (!w || !in || !p) return;
+
+    w->ball.lift_q16 += (in->lift_target_q16 - w->ball.lift_q16) >> EDGEAI_BALL_LIFT_SMOOTH_SHIFT;
+
+    /* Same rules in px, px/s and px/s^2; the inputs keep their fixed-point scales. */
+    const float dt = (float)p->sim_step_q16 * (1.0f / 65536.0f);
+    const float damp = (float)p->damp_q16 * (1.0f / 65536.0f);
+    const float tilt_k = (float)p->a_px_s2 * (1.0f / 32768.0f);
+    const float slope_k = (float)p->terrain_a_px_s2 * (1.0f / 256.0f);
+    float ax = (float)in->ax_soft_q15 * tilt_k - (float)in->slope_x_q8 * slope_k;
+    float ay = (float)in->ay_soft_q15 * tilt_k - (float)in->slope_y_q8 * slope_k;
+    float vx = (float)(w->ball.vx_q16 + in->bang_dvx_q16) * (1.0f / 65536.0f);
+    float vy = (float)(w->ball.vy_q16 + in->bang_dvy_q16) * (1.0f / 65536.0f);
+    vx = (vx + ax * dt) * damp;
+    vy = (vy + ay * dt) * damp;
+
+#if EDGEAI_SIM_SWEPT
+    sim_move_swept_float(w, p, vx, vy);
+#else
+    w->ball.vx_q16 = (int32_t)(vx * 65536.0f);
+    w->ball.vy_q16 = (int32_t)(vy * 65536.0f);
+    sim_move_clamp(w, p);
+#endif
 }
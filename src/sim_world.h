@@ -2,6 +2,31 @@
 
 #include <stdint.h>
 
+#include "terrain.h"
+
+/* Swept motion: each step's displacement is split into substeps of at most EDGEAI_SIM_SUBSTEP_PX
+ * (up to EDGEAI_SIM_SUBSTEP_MAX, so a slow ball pays for one), and every substep resolves wall hits at
+ * their time of impact against the perspective-shrunk bounds: the part of the move past the wall is
+ * reflected with the restitution instead of being clamped away. 0 keeps the integrate-then-clamp step.
+ */
+#ifndef EDGEAI_SIM_SWEPT
+#define EDGEAI_SIM_SWEPT 1
+#endif
+#ifndef EDGEAI_SIM_SUBSTEP_PX
+#define EDGEAI_SIM_SUBSTEP_PX 8
+#endif
+#ifndef EDGEAI_SIM_SUBSTEP_MAX
+#define EDGEAI_SIM_SUBSTEP_MAX 8
+#endif
+
+/* Arithmetic of sim_step: 0 Q16 integer, 1 single-precision float on the FPU. The state stays Q16 between
+ * steps either way, so the two share every interface (and tools/fpu_ab_bench.c compares them). A recording
+ * replays bit for bit only through the variant that made it: build tools/sim_replay.c with the same flag.
+ */
+#ifndef EDGEAI_SIM_FLOAT
+#define EDGEAI_SIM_FLOAT 0
+#endif
+
 typedef struct
 {
     int32_t x_q16;
@@ -15,6 +40,9 @@ typedef struct
 typedef struct
 {
     ball_state_t ball;
+    /* Counters (monotonic). */
+    uint32_t substeps;
+    uint32_t bounces;
 } sim_world_t;
 
 typedef struct
@@ -24,6 +52,8 @@ typedef struct
     int32_t bang_dvx_q16;
     int32_t bang_dvy_q16;
     int32_t lift_target_q16;
+    int32_t slope_x_q8; /* terrain gradient at the ball (sim_sample_terrain), 0 on a flat board */
+    int32_t slope_y_q8;
 } sim_input_t;
 
 typedef struct
@@ -35,7 +65,19 @@ typedef struct
     int32_t miny;
     int32_t maxx;
     int32_t maxy;
+    const edgeai_terrain_t *terrain; /* NULL: flat board (read by sim_sample_terrain) */
+    int32_t terrain_a_px_s2;         /* px/s^2 per unit of slope */
 } sim_params_t;
 
 void sim_world_init(sim_world_t *w, int32_t lcd_w, int32_t lcd_h);
+/* Fills in->slope_* from p->terrain at the ball, right before the sim_step that uses it. The slope is part
+ * of the input rather than read inside the step, so a step depends only on the world and its input
+ * (recorded and replayed by sim_record.h) even while the dune deforms under the ball. Q8 keeps the
+ * recorded deltas short; the bilinear sample has no more real precision than that.
+ */
+void sim_sample_terrain(const sim_world_t *w, const sim_params_t *p, sim_input_t *in);
+
 void sim_step(sim_world_t *w, const sim_input_t *in, const sim_params_t *p);
+/* Both variants are always built; sim_step is the one EDGEAI_SIM_FLOAT selects. */
+void sim_step_fixed(sim_world_t *w, const sim_input_t *in, const sim_params_t *p);
+void sim_step_float(sim_world_t *w, const sim_input_t *in, const sim_params_t *p);
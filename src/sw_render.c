@@ -1,121 +1,19 @@
 #include "sw_render.h"
 
+#include <math.h>
 #include <string.h>
 
-#include "dune_bg.h"
-
-static const uint8_t *sw_glyph5x7(char c)
-{
-    static const uint8_t SPACE[7] = {0, 0, 0, 0, 0, 0, 0};
-    static const uint8_t COLON[7] = {0x00, 0x04, 0x04, 0x00, 0x04, 0x04, 0x00};
-
-    static const uint8_t B[7] = {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E};
-    static const uint8_t A[7] = {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11};
-    static const uint8_t C[7] = {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E};
-    static const uint8_t D[7] = {0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E};
-    static const uint8_t E[7] = {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F};
-    static const uint8_t H[7] = {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11};
-    static const uint8_t I[7] = {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E};
-    static const uint8_t K[7] = {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11};
-    static const uint8_t N[7] = {0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x11};
-    static const uint8_t R[7] = {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11};
-    static const uint8_t S[7] = {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E};
-    static const uint8_t LP[7] = {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02};
-    static const uint8_t RP[7] = {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08};
-
-    static const uint8_t D0[7] = {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E};
-    static const uint8_t D1[7] = {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E};
-    static const uint8_t D2[7] = {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F};
-    static const uint8_t D3[7] = {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E};
-    static const uint8_t D4[7] = {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02};
-    static const uint8_t D5[7] = {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E};
-    static const uint8_t D6[7] = {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E};
-    static const uint8_t D7[7] = {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08};
-    static const uint8_t D8[7] = {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E};
-    static const uint8_t D9[7] = {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C};
-
-    switch (c)
-    {
-        case 'A': return A;
-        case 'B': return B;
-        case 'C': return C;
-        case 'D': return D;
-        case 'E': return E;
-        case 'H': return H;
-        case 'I': return I;
-        case 'K': return K;
-        case 'N': return N;
-        case 'R': return R;
-        case 'S': return S;
-        case 'c': return C;
-        case '(': return LP;
-        case ')': return RP;
-        case ':': return COLON;
-        case '0': return D0;
-        case '1': return D1;
-        case '2': return D2;
-        case '3': return D3;
-        case '4': return D4;
-        case '5': return D5;
-        case '6': return D6;
-        case '7': return D7;
-        case '8': return D8;
-        case '9': return D9;
-        case ' ': return SPACE;
-        default: return SPACE;
-    }
-}
+#include "edgeai_math.h"
+#include "ram_place.h"
 
-void sw_render_text5x7(uint16_t *dst, uint32_t w, uint32_t h,
-                       int32_t x0, int32_t y0,
-                       int32_t x, int32_t y, const char *s, uint16_t rgb565)
-{
-    if (!dst || !s) return;
+/* The generated header places the shipped texture through DUNE_TEX_ATTR. */
+#if EDGEAI_RAM_PLACE_DUNE_TEX
+#define DUNE_TEX_ATTR EDGEAI_RAMDATA
+#endif
+#include "dune_bg.h"
 
-    int32_t cx = x - x0;
-    int32_t cy = y - y0;
-    while (*s)
-    {
-        const uint8_t *g = sw_glyph5x7(*s);
-        for (int32_t row = 0; row < 7; row++)
-        {
-            uint8_t bits = g[row];
-            int32_t yy = cy + row;
-            if ((uint32_t)yy >= h) continue;
-            uint16_t *p = &dst[(uint32_t)yy * w];
-            for (int32_t col = 0; col < 5; col++)
-            {
-                if (bits & (1u << (4 - col)))
-                {
-                    int32_t xx = cx + col;
-                    if ((uint32_t)xx < w) p[(uint32_t)xx] = rgb565;
-                }
-            }
-        }
-        cx += 6;
-        s++;
-    }
-}
-
-static inline uint32_t sw_isqrt_u32(uint32_t x)
-{
-    /* Integer sqrt (floor). */
-    uint32_t op = x;
-    uint32_t res = 0;
-    uint32_t one = 1uL << 30;
-    while (one > op) one >>= 2;
-    while (one != 0)
-    {
-        if (op >= res + one)
-        {
-            op -= res + one;
-            res = res + 2u * one;
-        }
-        res >>= 1;
-        one >>= 2;
-    }
-    return res;
-}
+/* Texture sampled by the background fill; a live (relit) copy may replace the shipped one. */
+static const uint16_t *s_dune_tex = g_dune_tex;
 
 static inline void sw_put(uint16_t *dst, uint32_t w, uint32_t h,
                           int32_t x, int32_t y, uint16_t c)
@@ -135,6 +33,26 @@ void sw_render_clear(uint16_t *dst, uint32_t w, uint32_t h, uint16_t rgb565)
     for (uint32_t i = 0; i < w * h; i++) dst[i] = rgb565;
 }
 
+const uint16_t *sw_render_dune_tex(uint32_t *w, uint32_t *h)
+{
+    if (w) *w = DUNE_TEX_W;
+    if (h) *h = DUNE_TEX_H;
+    return s_dune_tex;
+}
+
+void sw_render_set_dune_tex(const uint16_t *tex)
+{
+    s_dune_tex = tex ? tex : g_dune_tex;
+}
+
+const uint8_t *sw_render_dune_hmap(uint32_t *w, uint32_t *h)
+{
+    if (w) *w = DUNE_TEX_W;
+    if (h) *h = DUNE_TEX_H;
+    return g_dune_hmap;
+}
+
+EDGEAI_RAMFUNC
 void sw_render_dune_bg(uint16_t *dst, uint32_t w, uint32_t h,
                        int32_t x0, int32_t y0)
 {
@@ -147,7 +65,7 @@ void sw_render_dune_bg(uint16_t *dst, uint32_t w, uint32_t h,
         uint32_t ty = ((uint32_t)gy) >> 1;
         if (ty >= DUNE_TEX_H) ty = DUNE_TEX_H - 1u;
 
-        const uint16_t *src = &g_dune_tex[ty * DUNE_TEX_W];
+        const uint16_t *src = &s_dune_tex[ty * DUNE_TEX_W];
         uint16_t *row = &dst[y * w];
 
         for (uint32_t x = 0; x < w; x++)
@@ -161,6 +79,34 @@ void sw_render_dune_bg(uint16_t *dst, uint32_t w, uint32_t h,
     }
 }
 
+void sw_render_cells(uint16_t *dst, uint32_t w, uint32_t h,
+                     int32_t x0, int32_t y0,
+                     const uint8_t *cells, uint32_t cols, uint32_t rows, uint32_t cell_px,
+                     const uint16_t *palette)
+{
+    if (!dst || !cells || !palette || w == 0 || h == 0 || cell_px == 0) return;
+
+    for (uint32_t y = 0; y < h; y++)
+    {
+        int32_t gy = y0 + (int32_t)y;
+        if (gy < 0) continue;
+        uint32_t cy = (uint32_t)gy / cell_px;
+        if (cy >= rows) break;
+
+        const uint8_t *src = &cells[cy * cols];
+        uint16_t *row = &dst[y * w];
+        for (uint32_t x = 0; x < w; x++)
+        {
+            int32_t gx = x0 + (int32_t)x;
+            if (gx < 0) continue;
+            uint32_t cx = (uint32_t)gx / cell_px;
+            if (cx >= cols) break;
+            uint16_t c = palette[src[cx]];
+            if (c != 0u) row[x] = c;
+        }
+    }
+}
+
 void sw_render_filled_circle(uint16_t *dst, uint32_t w, uint32_t h,
                              int32_t x0, int32_t y0,
                              int32_t cx, int32_t cy, int32_t r, uint16_t rgb565)
@@ -182,7 +128,7 @@ void sw_render_filled_circle(uint16_t *dst, uint32_t w, uint32_t h,
         int32_t dy = y - lc_y;
         int32_t dy2 = dy * dy;
         if (dy2 > r2) continue;
-        int32_t dx_max = (int32_t)sw_isqrt_u32((uint32_t)(r2 - dy2));
+        int32_t dx_max = (int32_t)edgeai_isqrt_u32((uint32_t)(r2 - dy2));
         int32_t x_min = lc_x - dx_max;
         int32_t x_max = lc_x + dx_max;
         if (x_min < 0) x_min = 0;
@@ -213,7 +159,8 @@ void sw_render_ball_shadow(uint16_t *dst, uint32_t w, uint32_t h,
         int32_t ly = y - y0;
         if ((uint32_t)ly >= h) continue;
         int32_t dy = y - sh_cy;
-        uint32_t dy2 = (uint32_t)(dy * dy);
+        uint32_t dy_term = ((uint32_t)(dy * dy) * 256u) / (uint32_t)(ry * ry);
+        if (dy_term >= 256u) continue;
 
         int32_t bx0 = sh_cx - rx;
         int32_t bx1 = sh_cx + rx;
@@ -225,7 +172,7 @@ void sw_render_ball_shadow(uint16_t *dst, uint32_t w, uint32_t h,
             int32_t dx = x - sh_cx;
             uint32_t dx2 = (uint32_t)(dx * dx);
 
-            uint32_t d = (dx2 * 256u) / (uint32_t)(rx * rx) + (dy2 * 256u) / (uint32_t)(ry * ry);
+            uint32_t d = (dx2 * 256u) / (uint32_t)(rx * rx) + dy_term;
             if (d >= 256u) continue;
 
             uint32_t t = 256u - d;            /* 0..255 */
@@ -255,13 +202,29 @@ static inline uint8_t sw_noise_u8(uint32_t x, uint32_t y, uint32_t seed)
     return (uint8_t)(n >> 24);
 }
 
+EDGEAI_RAMFUNC
 void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
                            int32_t x0, int32_t y0,
                            int32_t cx, int32_t cy, int32_t r,
                            uint32_t phase, uint8_t glint,
                            int32_t spin_sin_q14, int32_t spin_cos_q14)
 {
-    if (!dst || r <= 0) return;
+#if EDGEAI_BALL_SHADE_FLOAT
+    sw_render_silver_ball_float(dst, w, h, x0, y0, cx, cy, r, phase, glint, spin_sin_q14, spin_cos_q14);
+#else
+    sw_render_silver_ball_fixed(dst, w, h, x0, y0, cx, cy, r, phase, glint, spin_sin_q14, spin_cos_q14);
+#endif
+}
+
+EDGEAI_RAMFUNC_UNLESS(EDGEAI_BALL_SHADE_FLOAT)
+void sw_render_silver_ball_fixed(uint16_t *dst, uint32_t w, uint32_t h,
+                                 int32_t x0, int32_t y0,
+                                 int32_t cx, int32_t cy, int32_t r,
+                                 uint32_t phase, uint8_t glint,
+                                 int32_t spin_sin_q14, int32_t spin_cos_q14)
+{
+    /* The normals divide by r through a reciprocal (edgeai_math.h), exact for r in 2..511. */
+    if (!dst || r <= 1) return;
 
     int32_t sx0 = cx - r;
     int32_t sx1 = cx + r;
@@ -274,6 +237,7 @@ void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
     const int32_t Lz = 11469;  /*  0.7 */
 
     const uint32_t r2 = (uint32_t)(r * r);
+    const uint32_t r_recip = edgeai_recip_u32((uint32_t)r);
     const uint32_t seed = (phase * 0xA511E9B3u) ^ ((uint32_t)glint * 0x63D83595u);
     const uint32_t off_u = (phase >> 3) & 255u;
     const uint32_t off_v = (phase >> 4) & 255u;
@@ -287,7 +251,7 @@ void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
         int32_t dy2 = dy * dy;
         if ((uint32_t)dy2 > r2) continue;
 
-        uint32_t dx_max_u = sw_isqrt_u32(r2 - (uint32_t)dy2);
+        uint32_t dx_max_u = edgeai_isqrt_u32(r2 - (uint32_t)dy2);
         int32_t rx0 = cx - (int32_t)dx_max_u;
         int32_t rx1 = cx + (int32_t)dx_max_u;
         if (rx0 < sx0) rx0 = sx0;
@@ -302,12 +266,12 @@ void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
             uint32_t d2 = (uint32_t)(dx * dx + dy2);
             if (d2 > r2) continue;
 
-            uint32_t zz = sw_isqrt_u32(r2 - d2);
+            uint32_t zz = edgeai_isqrt_u32(r2 - d2);
 
             /* Normal in Q14: n = (dx,dy,z)/r. */
-            int32_t nx = (dx << 14) / r;
-            int32_t ny = (dy << 14) / r;
-            int32_t nz = ((int32_t)zz << 14) / r;
+            int32_t nx = edgeai_div_recip_i32(dx << 14, r_recip);
+            int32_t ny = edgeai_div_recip_i32(dy << 14, r_recip);
+            int32_t nz = edgeai_div_recip_i32((int32_t)zz << 14, r_recip);
 
             int32_t ndl = (nx * Lx + ny * Ly + nz * Lz) >> 14;
             if (ndl < 0) ndl = 0;
@@ -315,17 +279,11 @@ void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
             int32_t rz = ((2 * ndl * nz) >> 14) - Lz;
             if (rz < 0) rz = 0;
 
-            int32_t s = rz;
-            int32_t s2 = (s * s) >> 14;
-            int32_t s4 = (s2 * s2) >> 14;
-            int32_t s8 = (s4 * s4) >> 14;
-            int32_t s16 = (s8 * s8) >> 14;
+            int32_t s16 = edgeai_pow16_q14(rz);
 
             int32_t inv = (1 << 14) - nz;
             if (inv < 0) inv = 0;
-            int32_t f2 = (inv * inv) >> 14;
-            int32_t f4 = (f2 * f2) >> 14;
-            int32_t f5 = (f4 * inv) >> 14;
+            int32_t f5 = edgeai_pow5_q14(inv);
 
             /* Base "silver" tint (kept slightly dark; reflections add punch). */
             uint32_t br = 150, bg = 155, bb = 165;
@@ -366,10 +324,7 @@ void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
             /* Add a small sun spot in the sky. */
             int32_t sun_dot = (Rxr * Lx + Ryr * Ly + Rz * Lz) >> 14;
             if (sun_dot < 0) sun_dot = 0;
-            int32_t sd2 = (sun_dot * sun_dot) >> 14;
-            int32_t sd4 = (sd2 * sd2) >> 14;
-            int32_t sd8 = (sd4 * sd4) >> 14;
-            int32_t sd16 = (sd8 * sd8) >> 14;
+            int32_t sd16 = edgeai_pow16_q14(sun_dot);
             uint32_t sun_k = (uint32_t)((sd16 * 220) >> 14); /* 0..220 */
             env_r += sun_k;
             env_g += (sun_k * 210u) / 220u;
@@ -413,3 +368,131 @@ void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
         }
     }
 }
+
+/* The fixed shader's model in float: unit vectors and weights in [0, 1], colors in 8-bit units. One
+ * square root per pixel replaces the integer sqrt and the three divides by r.
+ */
+EDGEAI_RAMFUNC_IF(EDGEAI_BALL_SHADE_FLOAT)
+void sw_render_silver_ball_float(uint16_t *dst, uint32_t w, uint32_t h,
+                                 int32_t x0, int32_t y0,
+                                 int32_t cx, int32_t cy, int32_t r,
+                                 uint32_t phase, uint8_t glint,
+                                 int32_t spin_sin_q14, int32_t spin_cos_q14)
+{
+    if (!dst || r <= 0) return;
+
+    const float Lx = -6553.0f / 16384.0f;
+    const float Ly = -9830.0f / 16384.0f;
+    const float Lz = 11469.0f / 16384.0f;
+    const float inv_r = 1.0f / (float)r;
+    const float spin_s = (float)spin_sin_q14 * (1.0f / 16384.0f);
+    const float spin_c = (float)spin_cos_q14 * (1.0f / 16384.0f);
+    const float amb = 1966.0f / 16384.0f;
+    const float diff_k = 9011.0f / 16384.0f;
+    const float spec_k = 1.0f + (float)((uint32_t)glint * 8192u / 255u) * (1.0f / 16384.0f);
+    const float fre_k = 0.25f;
+    const int32_t thresh = 252 - ((int32_t)glint >> 4);
+
+    const int32_t r2 = r * r;
+    const uint32_t seed = (phase * 0xA511E9B3u) ^ ((uint32_t)glint * 0x63D83595u);
+    const uint32_t off_u = (phase >> 3) & 255u;
+    const uint32_t off_v = (phase >> 4) & 255u;
+
+    for (int32_t y = cy - r; y <= cy + r; y++)
+    {
+        int32_t ly = y - y0;
+        if ((uint32_t)ly >= h) continue;
+
+        int32_t dy = y - cy;
+        int32_t dy2 = dy * dy;
+        if (dy2 > r2) continue;
+
+        int32_t dx_max = (int32_t)sqrtf((float)(r2 - dy2));
+        const float ny = (float)dy * inv_r;
+
+        for (int32_t x = cx - dx_max; x <= cx + dx_max; x++)
+        {
+            int32_t lx = x - x0;
+            if ((uint32_t)lx >= w) continue;
+
+            int32_t dx = x - cx;
+            int32_t d2 = dx * dx + dy2;
+            if (d2 > r2) continue;
+
+            float nx = (float)dx * inv_r;
+            float nz = sqrtf((float)(r2 - d2)) * inv_r;
+
+            float ndl = nx * Lx + ny * Ly + nz * Lz;
+            if (ndl < 0.0f) ndl = 0.0f;
+            float rz = 2.0f * ndl * nz - Lz;
+            if (rz < 0.0f) rz = 0.0f;
+            float s2 = rz * rz;
+            float s4 = s2 * s2;
+            float s8 = s4 * s4;
+            float s16 = s8 * s8;
+
+            float inv = 1.0f - nz;
+            if (inv < 0.0f) inv = 0.0f;
+            float f2 = inv * inv;
+            float f5 = f2 * f2 * inv;
+
+            float spec = s16 * spec_k;
+            float fre = f5 * fre_k;
+            float I = amb + ndl * diff_k;
+            if (I > 2.0f) I = 2.0f;
+            float rr = 150.0f * I;
+            float gg = 155.0f * I;
+            float bb = 165.0f * I;
+
+            /* Environment reflection, rotated by spin, with the sun spot. */
+            float Rx = 2.0f * nz * nx;
+            float Ry = 2.0f * nz * ny;
+            float Rz = 2.0f * nz * nz - 1.0f;
+            float Rxr = Rx * spin_c - Ry * spin_s;
+            float Ryr = Rx * spin_s + Ry * spin_c;
+            float t = (Rz + 1.0f) * 0.5f;
+            if (t < 0.0f) t = 0.0f;
+            if (t > 1.0f) t = 1.0f;
+            float env_r = 160.0f + (90.0f - 160.0f) * t;
+            float env_g = 120.0f + (135.0f - 120.0f) * t;
+            float env_b = 80.0f + (180.0f - 80.0f) * t;
+
+            float sun = Rxr * Lx + Ryr * Ly + Rz * Lz;
+            if (sun < 0.0f) sun = 0.0f;
+            float sd2 = sun * sun;
+            float sd4 = sd2 * sd2;
+            float sd8 = sd4 * sd4;
+            float sd16 = sd8 * sd8;
+            env_r += 220.0f * sd16;
+            env_g += 210.0f * sd16;
+            env_b += 170.0f * sd16;
+
+            float refl_k = 0.5f + 0.5f * f5;
+            rr += env_r * refl_k;
+            gg += env_g * refl_k;
+            bb += env_b * refl_k;
+
+            /* Moving sparkles in the specular highlight (the same hash lattice as the fixed shader). */
+            if (glint > 12u && s16 > 2500.0f / 16384.0f)
+            {
+                float fu = (nx * spin_c - ny * spin_s + 1.0f) * 128.0f;
+                float fv = (nx * spin_s + ny * spin_c + 1.0f) * 128.0f;
+                uint32_t iu = (uint32_t)(fu > 0.0f ? fu : 0.0f) + off_u;
+                uint32_t iv = (uint32_t)(fv > 0.0f ? fv : 0.0f) + off_v;
+                int32_t n = (int32_t)sw_noise_u8(iu & 255u, iv & 255u, seed);
+                if (n > thresh)
+                {
+                    float sparkle = (float)(n - thresh) * (1.0f / 16.0f);
+                    if (sparkle > 1.0f) sparkle = 1.0f;
+                    spec += sparkle * s16;
+                }
+            }
+
+            rr += 255.0f * spec + 40.0f * fre;
+            gg += 255.0f * spec + 60.0f * fre;
+            bb += 255.0f * spec + 90.0f * fre;
+
+            sw_put(dst, w, h, lx, ly, sw_pack_rgb565_u8((uint32_t)rr, (uint32_t)gg, (uint32_t)bb));
+        }
+    }
+}
@@ -20,9 +20,19 @@ static inline uint16_t sw_pack_rgb565_u8(uint32_t r8, uint32_t g8, uint32_t b8)
 void sw_render_clear(uint16_t *dst, uint32_t w, uint32_t h, uint16_t rgb565);
 void sw_render_dune_bg(uint16_t *dst, uint32_t w, uint32_t h,
                        int32_t x0, int32_t y0);
-void sw_render_text5x7(uint16_t *dst, uint32_t w, uint32_t h,
-                       int32_t x0, int32_t y0,
-                       int32_t x, int32_t y, const char *s, uint16_t rgb565);
+/* Dune background texture (RGB565, half LCD resolution) for samplers outside this module. */
+const uint16_t *sw_render_dune_tex(uint32_t *w, uint32_t *h);
+/* Replaces the sampled texture with a same-size copy (dune_live.h); NULL restores the shipped one. */
+void sw_render_set_dune_tex(const uint16_t *tex);
+/* Dune heightmap the texture was shaded from (same size, one byte per texel). */
+const uint8_t *sw_render_dune_hmap(uint32_t *w, uint32_t *h);
+/* Material cell overlay: cells (cols x rows, row-major) upscaled by cell_px in LCD space; a cell
+ * value indexes `palette`, and a palette entry of 0 is transparent.
+ */
+void sw_render_cells(uint16_t *dst, uint32_t w, uint32_t h,
+                     int32_t x0, int32_t y0,
+                     const uint8_t *cells, uint32_t cols, uint32_t rows, uint32_t cell_px,
+                     const uint16_t *palette);
 void sw_render_filled_circle(uint16_t *dst, uint32_t w, uint32_t h,
                              int32_t x0, int32_t y0,
                              int32_t cx, int32_t cy, int32_t r, uint16_t rgb565);
@@ -34,3 +44,19 @@ void sw_render_silver_ball(uint16_t *dst, uint32_t w, uint32_t h,
                            int32_t cx, int32_t cy, int32_t r,
                            uint32_t phase, uint8_t glint,
                            int32_t spin_sin_q14, int32_t spin_cos_q14);
+/* Both shaders are always built (tools/fpu_ab_bench.c compares them); sw_render_silver_ball is the one
+ * EDGEAI_BALL_SHADE_FLOAT selects: 0 Q14 integer, 1 single-precision float on the FPU.
+ */
+#ifndef EDGEAI_BALL_SHADE_FLOAT
+#define EDGEAI_BALL_SHADE_FLOAT 0
+#endif
+void sw_render_silver_ball_fixed(uint16_t *dst, uint32_t w, uint32_t h,
+                                 int32_t x0, int32_t y0,
+                                 int32_t cx, int32_t cy, int32_t r,
+                                 uint32_t phase, uint8_t glint,
+                                 int32_t spin_sin_q14, int32_t spin_cos_q14);
+void sw_render_silver_ball_float(uint16_t *dst, uint32_t w, uint32_t h,
+                                 int32_t x0, int32_t y0,
+                                 int32_t cx, int32_t cy, int32_t r,
+                                 uint32_t phase, uint8_t glint,
+                                 int32_t spin_sin_q14, int32_t spin_cos_q14);
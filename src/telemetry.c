@@ -0,0 +1,105 @@
+#include "telemetry.h"
+
+#include <string.h>
+
+#if (EDGEAI_TLM_RING_BYTES & (EDGEAI_TLM_RING_BYTES - 1u)) != 0
+#error "EDGEAI_TLM_RING_BYTES must be a power of two"
+#endif
+
+/* Single producer (main loop) / single consumer (transport, may run from a DMA ISR).
+ * Indices are free-running; the producer only advances head, the consumer only advances tail.
+ */
+static uint8_t s_ring[EDGEAI_TLM_RING_BYTES];
+static volatile uint32_t s_head = 0;
+static volatile uint32_t s_tail = 0;
+static uint16_t s_seq = 0;
+static uint32_t s_dropped = 0;
+
+static uint16_t edgeai_tlm_crc16_update(uint16_t crc, const uint8_t *p, uint32_t n)
+{
+    while (n--)
+    {
+        crc ^= (uint16_t)((uint16_t)*p++ << 8);
+        for (int i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void edgeai_tlm_put(uint32_t *pos, const uint8_t *src, uint32_t n)
+{
+    uint32_t idx = *pos & (EDGEAI_TLM_RING_BYTES - 1u);
+    uint32_t first = EDGEAI_TLM_RING_BYTES - idx;
+    if (first > n) first = n;
+    memcpy(&s_ring[idx], src, first);
+    if (n > first) memcpy(&s_ring[0], src + first, n - first);
+    *pos += n;
+}
+
+void edgeai_tlm_init(void)
+{
+    s_head = 0;
+    s_tail = 0;
+    s_seq = 0;
+    s_dropped = 0;
+}
+
+bool edgeai_tlm_write(uint8_t type, const void *payload, uint8_t len)
+{
+    if (!payload && len) return false;
+
+    uint32_t need = (uint32_t)len + EDGEAI_TLM_FRAME_OVERHEAD;
+    uint32_t head = s_head;
+    uint32_t used = head - s_tail;
+    if (need > (EDGEAI_TLM_RING_BYTES - used))
+    {
+        s_dropped++;
+        return false;
+    }
+
+    uint8_t hdr[6];
+    hdr[0] = EDGEAI_TLM_SYNC0;
+    hdr[1] = EDGEAI_TLM_SYNC1;
+    hdr[2] = type;
+    hdr[3] = len;
+    hdr[4] = (uint8_t)(s_seq & 0xFFu);
+    hdr[5] = (uint8_t)(s_seq >> 8);
+    s_seq++;
+
+    uint16_t crc = edgeai_tlm_crc16_update(0xFFFFu, &hdr[2], 4u);
+    crc = edgeai_tlm_crc16_update(crc, (const uint8_t *)payload, len);
+    uint8_t tail[2] = {(uint8_t)(crc & 0xFFu), (uint8_t)(crc >> 8)};
+
+    edgeai_tlm_put(&head, hdr, sizeof(hdr));
+    edgeai_tlm_put(&head, (const uint8_t *)payload, len);
+    edgeai_tlm_put(&head, tail, sizeof(tail));
+
+    /* Publish only after the whole frame is in the ring. */
+    s_head = head;
+    return true;
+}
+
+uint32_t edgeai_tlm_dropped(void)
+{
+    return s_dropped;
+}
+
+uint32_t edgeai_tlm_peek(const uint8_t **data)
+{
+    uint32_t tail = s_tail;
+    uint32_t avail = s_head - tail;
+    uint32_t idx = tail & (EDGEAI_TLM_RING_BYTES - 1u);
+    uint32_t contig = EDGEAI_TLM_RING_BYTES - idx;
+    if (contig > avail) contig = avail;
+    if (data) *data = &s_ring[idx];
+    return contig;
+}
+
+void edgeai_tlm_consume(uint32_t n)
+{
+    uint32_t avail = s_head - s_tail;
+    if (n > avail) n = avail;
+    s_tail += n;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Binary telemetry stream.
+ * Records are framed into a byte ring; a transport (LPUART + EDMA on target) drains the ring in the
+ * background, so the main loop only pays for packing and a short copy.
+ *
+ * Frame layout (little-endian):
+ *   0xA5 0x5A | type u8 | len u8 | seq u16 | payload[len] | crc16 u16
+ * The CRC is CRC-16/CCITT-FALSE over type, len, seq and payload. Decoder: `tools/telemetry_decode.py`.
+ */
+
+#ifndef EDGEAI_TELEMETRY_ENABLE
+#define EDGEAI_TELEMETRY_ENABLE 1
+#endif
+
+/* Ring size in bytes (power of two). */
+#ifndef EDGEAI_TLM_RING_BYTES
+#define EDGEAI_TLM_RING_BYTES 1024u
+#endif
+
+#define EDGEAI_TLM_SYNC0 0xA5u
+#define EDGEAI_TLM_SYNC1 0x5Au
+#define EDGEAI_TLM_VERSION 4u
+#define EDGEAI_TLM_FRAME_OVERHEAD 8u
+
+typedef enum
+{
+    kEdgeAiTlmRecordStats = 1,
+    kEdgeAiTlmRecordLatency = 2,
+    kEdgeAiTlmRecordStageNames = 3,
+    kEdgeAiTlmRecordOpProfile = 4,
+    kEdgeAiTlmRecordOpNames = 5,
+} edgeai_tlm_record_type_t;
+
+#define EDGEAI_TLM_LATENCY_MAX_STAGES 8
+
+enum
+{
+    EDGEAI_TLM_FLAG_ACCEL_FAIL = 1u << 0,
+    EDGEAI_TLM_FLAG_NPU_OK = 1u << 1,
+};
+
+/* Once-per-second stats window (stage timings are in `edgeai_tlm_latency_t`). */
+typedef struct __attribute__((packed))
+{
+    uint8_t version;
+    uint8_t flags;
+    uint16_t fps;
+    uint32_t uptime_ms;
+    uint32_t loops;
+    uint32_t sim_steps;
+    int16_t raw[3];
+    int16_t lp[3];
+    int16_t hp[3];
+    int16_t g_mag;
+    int16_t g_hp;
+    int16_t bang_score;
+    int16_t pos[2];
+    int16_t lift_px;
+    int16_t vel[2];
+    uint8_t glint;
+    uint8_t reserved;
+    uint32_t tlm_cost_cyc; /* cycles spent packing + queueing the previous record */
+    uint32_t tlm_dropped;  /* records dropped because the ring was full */
+    uint32_t npu_submitted; /* async NPU jobs (monotonic) */
+    uint32_t npu_completed;
+    uint32_t npu_dropped;   /* jobs replaced before they started */
+    uint32_t npu_skipped;   /* submits rejected (backend not initialized or inference disabled) */
+    uint32_t npu_deferred;  /* job runs postponed because the scratch region was busy */
+    uint32_t npu_failed;    /* jobs whose backend step failed */
+} edgeai_tlm_stats_t;
+
+/* Per-stage latency window in DWT cycles (see latency_hist.h). Only `stage_count` entries are sent. */
+typedef struct __attribute__((packed))
+{
+    uint32_t count;
+    uint32_t p50_cyc;
+    uint32_t p95_cyc;
+    uint32_t p99_cyc;
+    uint32_t max_cyc;
+} edgeai_tlm_latency_stage_t;
+
+typedef struct __attribute__((packed))
+{
+    uint8_t version;
+    uint8_t stage_count;
+    uint16_t core_mhz;
+    uint32_t uptime_ms;
+    edgeai_tlm_latency_stage_t stage[EDGEAI_TLM_LATENCY_MAX_STAGES];
+} edgeai_tlm_latency_t;
+
+/* Stage names payload: repeated { len u8, name[len] } in stage id order. */
+
+/* Model per-op profile (npu/model.h), cumulative since boot. Only `op_count` entries are sent;
+ * names follow in a kEdgeAiTlmRecordOpNames record using the stage-names layout.
+ */
+#define EDGEAI_TLM_OP_MAX 16
+
+typedef struct __attribute__((packed))
+{
+    uint32_t avg_cyc;
+    uint32_t max_cyc;
+    uint32_t last_cyc;
+} edgeai_tlm_op_t;
+
+typedef struct __attribute__((packed))
+{
+    uint8_t version;
+    uint8_t op_count;
+    uint16_t core_mhz;
+    uint32_t invokes;
+    uint32_t arena_used;
+    uint32_t arena_size;
+    edgeai_tlm_op_t op[EDGEAI_TLM_OP_MAX];
+} edgeai_tlm_op_profile_t;
+
+void edgeai_tlm_init(void);
+
+/* Frame and queue one record. Returns false (and counts a drop) when the ring lacks space. */
+bool edgeai_tlm_write(uint8_t type, const void *payload, uint8_t len);
+uint32_t edgeai_tlm_dropped(void);
+
+/* Transport side: contiguous queued bytes starting at *data, then release them once sent. */
+uint32_t edgeai_tlm_peek(const uint8_t **data);
+void edgeai_tlm_consume(uint32_t n);
+
+/* Target transport (telemetry_uart.c): LPUART TX via EDMA on the debug console UART. */
+bool edgeai_tlm_uart_init(void);
+void edgeai_tlm_uart_kick(void);
+/* True when no transfer is in flight (everything queued has gone out). */
+bool edgeai_tlm_uart_idle(void);
@@ -0,0 +1,91 @@
+#include "telemetry.h"
+
+#include "fsl_common.h"
+#include "fsl_edma.h"
+#include "fsl_lpuart_edma.h"
+
+#include "board.h"
+
+/* Telemetry transport: LPUART TX via EDMA on the debug console UART.
+ * The DMA completion callback releases the sent span and immediately starts the next one,
+ * so the ring drains without main-loop involvement once kicked.
+ * Text PRINTF output shares the same UART; the decoder resynchronizes on the frame sync + CRC.
+ */
+
+#ifndef EDGEAI_TLM_LPUART
+#define EDGEAI_TLM_LPUART ((LPUART_Type *)BOARD_DEBUG_UART_BASEADDR)
+#endif
+#ifndef EDGEAI_TLM_DMA
+#define EDGEAI_TLM_DMA DMA0
+#endif
+#ifndef EDGEAI_TLM_DMA_CHANNEL
+#define EDGEAI_TLM_DMA_CHANNEL 7u
+#endif
+#ifndef EDGEAI_TLM_DMA_REQUEST
+#define EDGEAI_TLM_DMA_REQUEST kDma0RequestLPFlexcomm4Tx
+#endif
+
+static edma_handle_t s_txEdmaHandle;
+static lpuart_edma_handle_t s_uartEdmaHandle;
+static volatile bool s_txBusy = false;
+static volatile uint32_t s_txLen = 0;
+static bool s_inited = false;
+
+static void edgeai_tlm_uart_start(void)
+{
+    const uint8_t *p = NULL;
+    uint32_t n = edgeai_tlm_peek(&p);
+    if (n == 0u)
+    {
+        s_txBusy = false;
+        return;
+    }
+
+    lpuart_transfer_t xfer;
+    xfer.txData = p;
+    xfer.dataSize = n;
+    s_txLen = n;
+    s_txBusy = true;
+    if (LPUART_SendEDMA(EDGEAI_TLM_LPUART, &s_uartEdmaHandle, &xfer) != kStatus_Success)
+    {
+        s_txBusy = false;
+    }
+}
+
+static void edgeai_tlm_uart_cb(LPUART_Type *base, lpuart_edma_handle_t *handle, status_t status, void *userData)
+{
+    (void)base;
+    (void)handle;
+    (void)userData;
+    if (status != kStatus_LPUART_TxIdle) return;
+
+    edgeai_tlm_consume(s_txLen);
+    s_txLen = 0;
+    edgeai_tlm_uart_start();
+}
+
+bool edgeai_tlm_uart_init(void)
+{
+    edma_config_t cfg;
+    EDMA_GetDefaultConfig(&cfg);
+    EDMA_Init(EDGEAI_TLM_DMA, &cfg);
+    EDMA_SetChannelMux(EDGEAI_TLM_DMA, EDGEAI_TLM_DMA_CHANNEL, EDGEAI_TLM_DMA_REQUEST);
+    EDMA_CreateHandle(&s_txEdmaHandle, EDGEAI_TLM_DMA, EDGEAI_TLM_DMA_CHANNEL);
+
+    LPUART_TransferCreateHandleEDMA(EDGEAI_TLM_LPUART, &s_uartEdmaHandle, edgeai_tlm_uart_cb, NULL,
+                                    &s_txEdmaHandle, NULL);
+    s_txBusy = false;
+    s_inited = true;
+    return true;
+}
+
+void edgeai_tlm_uart_kick(void)
+{
+    if (!s_inited || s_txBusy) return;
+    edgeai_tlm_uart_start();
+}
+
+bool edgeai_tlm_uart_idle(void)
+{
+    return !s_inited || !s_txBusy;
+}
@@ -0,0 +1,192 @@
+#include "tensor_util.h"
+
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "fsl_common.h" /* CMSIS SIMD intrinsics */
+#define EDGEAI_TENSOR_DSP 1
+#else
+#define EDGEAI_TENSOR_DSP 0
+#endif
+
+/* Signed codes are biased to unsigned (x ^ 0x80 = x + 128) so one lane max/sum serves both types. */
+#define TU_BIAS4 0x80808080u
+
+#if EDGEAI_TENSOR_DSP
+static inline uint32_t tu_max_u8x4(uint32_t a, uint32_t b)
+{
+    (void)__USUB8(a, b); /* GE[i] = a[i] >= b[i] */
+    return __SEL(a, b);
+}
+
+static inline uint32_t tu_sad_u8x4(uint32_t a, uint32_t acc)
+{
+    return __USADA8(a, 0u, acc);
+}
+#else
+static inline uint32_t tu_max_u8x4(uint32_t a, uint32_t b)
+{
+    /* SWAR: per-lane a >= b from the top bits and a borrow-free 7-bit compare, widened to a lane mask. */
+    uint32_t low_ge = (a | TU_BIAS4) - (b & ~TU_BIAS4);
+    uint32_t ge = ((a & ~b) | (~(a ^ b) & low_ge)) & TU_BIAS4;
+    uint32_t mask = (ge >> 7) * 0xFFu;
+    return (a & mask) | (b & ~mask);
+}
+
+static inline uint32_t tu_sad_u8x4(uint32_t a, uint32_t acc)
+{
+    return acc + (a & 0xFFu) + ((a >> 8) & 0xFFu) + ((a >> 16) & 0xFFu) + (a >> 24);
+}
+#endif
+
+static inline uint32_t tu_word(const uint8_t *p)
+{
+    uint32_t w;
+    memcpy(&w, p, sizeof(w)); /* p is word-aligned here; compiles to a single load */
+    return w;
+}
+
+/* Largest biased byte (0..255). */
+static uint32_t tu_max_biased(const uint8_t *p, uint32_t n, uint32_t bias)
+{
+    uint32_t m = 0;
+    while (n > 0u && ((uintptr_t)p & 3u) != 0u)
+    {
+        uint32_t v = (uint32_t)*p++ ^ (bias & 0xFFu);
+        if (v > m) m = v;
+        n--;
+    }
+
+    uint32_t acc0 = 0, acc1 = 0;
+    for (; n >= 8u; n -= 8u, p += 8)
+    {
+        acc0 = tu_max_u8x4(tu_word(p) ^ bias, acc0);
+        acc1 = tu_max_u8x4(tu_word(p + 4) ^ bias, acc1);
+    }
+    for (; n >= 4u; n -= 4u, p += 4) acc0 = tu_max_u8x4(tu_word(p) ^ bias, acc0);
+    acc0 = tu_max_u8x4(acc0, acc1);
+    acc0 = tu_max_u8x4(acc0, acc0 >> 16);
+    acc0 = tu_max_u8x4(acc0, acc0 >> 8);
+    if ((acc0 & 0xFFu) > m) m = acc0 & 0xFFu;
+
+    while (n-- > 0u)
+    {
+        uint32_t v = (uint32_t)*p++ ^ (bias & 0xFFu);
+        if (v > m) m = v;
+    }
+    return m;
+}
+
+int32_t edgeai_tensor_max_q(const uint8_t *data, uint32_t n, bool is_signed)
+{
+    if (!data || n == 0u) return is_signed ? -128 : 0;
+    uint32_t m = tu_max_biased(data, n, is_signed ? TU_BIAS4 : 0u);
+    return is_signed ? (int32_t)m - 128 : (int32_t)m;
+}
+
+uint32_t edgeai_tensor_argmax_q(const uint8_t *data, uint32_t n, bool is_signed, int32_t *max_q)
+{
+    int32_t m = edgeai_tensor_max_q(data, n, is_signed);
+    if (max_q) *max_q = m;
+    if (!data || n == 0u) return 0;
+    /* The raw byte of the maximum is unique per type, so the first match is the first argmax. */
+    const uint8_t *hit = (const uint8_t *)memchr(data, (int)(uint8_t)m, n);
+    return hit ? (uint32_t)(hit - data) : 0u;
+}
+
+int32_t edgeai_tensor_sum_q(const uint8_t *data, uint32_t n, bool is_signed)
+{
+    if (!data || n == 0u) return 0;
+    const uint32_t bias = is_signed ? TU_BIAS4 : 0u;
+    const uint8_t *p = data;
+    uint32_t left = n;
+    uint32_t acc = 0;
+    while (left > 0u && ((uintptr_t)p & 3u) != 0u)
+    {
+        acc += (uint32_t)*p++ ^ (bias & 0xFFu);
+        left--;
+    }
+    for (; left >= 8u; left -= 8u, p += 8)
+    {
+        acc = tu_sad_u8x4(tu_word(p) ^ bias, acc);
+        acc = tu_sad_u8x4(tu_word(p + 4) ^ bias, acc);
+    }
+    for (; left >= 4u; left -= 4u, p += 4) acc = tu_sad_u8x4(tu_word(p) ^ bias, acc);
+    while (left-- > 0u) acc += (uint32_t)*p++ ^ (bias & 0xFFu);
+
+    return is_signed ? (int32_t)acc - (int32_t)(n * 128u) : (int32_t)acc;
+}
+
+float edgeai_tensor_max_f32(const float *data, uint32_t n)
+{
+    if (!data || n == 0u) return 0.0f;
+    float m = data[0];
+    for (uint32_t i = 1; i < n; i++) if (data[i] > m) m = data[i];
+    return m;
+}
+
+uint32_t edgeai_tensor_argmax_f32(const float *data, uint32_t n)
+{
+    if (!data || n == 0u) return 0;
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < n; i++) if (data[i] > data[best]) best = i;
+    return best;
+}
+
+int32_t edgeai_tensor_quantize(float real, float scale, int32_t zero_point, bool is_signed)
+{
+    if (scale <= 0.0f) return zero_point;
+    return edgeai_tensor_quantize_inv(real, 1.0f / scale, zero_point, is_signed);
+}
+
+uint8_t edgeai_tensor_unit_u8(int32_t q, float scale, int32_t zero_point)
+{
+    float v = edgeai_tensor_dequantize(q, scale, zero_point) * 255.0f + 0.5f;
+    if (v <= 0.0f) return 0;
+    if (v >= 255.0f) return 255;
+    return (uint8_t)v;
+}
+
+void edgeai_tensor_quantize_f32(const float *src, uint32_t n, float scale, int32_t zero_point, bool is_signed,
+                                uint8_t *dst)
+{
+    if (!src || !dst || scale <= 0.0f) return;
+    const float inv = 1.0f / scale;
+    for (uint32_t i = 0; i < n; i++) dst[i] = (uint8_t)edgeai_tensor_quantize_inv(src[i], inv, zero_point, is_signed);
+}
+
+void edgeai_tensor_dequantize_q(const uint8_t *src, uint32_t n, float scale, int32_t zero_point, bool is_signed,
+                                float *dst)
+{
+    if (!src || !dst) return;
+    if (is_signed)
+    {
+        const int8_t *s = (const int8_t *)src;
+        for (uint32_t i = 0; i < n; i++) dst[i] = edgeai_tensor_dequantize((int32_t)s[i], scale, zero_point);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < n; i++) dst[i] = edgeai_tensor_dequantize((int32_t)src[i], scale, zero_point);
+    }
+}
+
+void edgeai_tensor_dequant_lut(float scale, int32_t zero_point, bool is_signed, float gain, uint8_t lut[256])
+{
+    if (!lut) return;
+    for (int32_t b = 0; b < 256; b++)
+    {
+        int32_t q = is_signed ? (int32_t)(int8_t)(uint8_t)b : b;
+        float v = edgeai_tensor_dequantize(q, scale, zero_point) * gain + 0.5f;
+        lut[b] = (v <= 0.0f) ? 0u : (v >= 255.0f) ? 255u : (uint8_t)v;
+    }
+}
+
+void edgeai_tensor_quant_lut(float step, float scale, int32_t zero_point, bool is_signed, uint8_t lut[256])
+{
+    if (!lut || scale <= 0.0f) return;
+    const float inv = step / scale;
+    for (uint32_t i = 0; i < 256u; i++)
+    {
+        lut[i] = (uint8_t)edgeai_tensor_quantize_inv((float)i, inv, zero_point, is_signed);
+    }
+}
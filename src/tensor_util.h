@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Quantized tensor helpers shared by the NPU glue and the tensor consumers (glint, gesture, post-process,
+ * scene capture).
+ * - Reductions work on raw int8/uint8 codes (`is_signed` selects the type) and return codes, so they are
+ *   exact; callers dequantize the one value they need.
+ * - On cores with the DSP extension the byte reductions run four lanes per word (USUB8/SEL for max,
+ *   USADA8 for sum); elsewhere the same word loop runs on portable SWAR lanes.
+ * - Affine quantization: real = scale * (q - zero_point); quantize rounds half away from zero and
+ *   saturates to the type.
+ * Pure C (the DSP intrinsics come from CMSIS only when available), so it builds for target and host.
+ */
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Largest code; -128 / 0 when n == 0. */
+int32_t edgeai_tensor_max_q(const uint8_t *data, uint32_t n, bool is_signed);
+/* Index of the first largest code (0 when n == 0); the code goes to `max_q` when non-NULL. */
+uint32_t edgeai_tensor_argmax_q(const uint8_t *data, uint32_t n, bool is_signed, int32_t *max_q);
+/* Sum of the codes (n up to 2^23). */
+int32_t edgeai_tensor_sum_q(const uint8_t *data, uint32_t n, bool is_signed);
+
+float edgeai_tensor_max_f32(const float *data, uint32_t n);
+uint32_t edgeai_tensor_argmax_f32(const float *data, uint32_t n);
+
+static inline float edgeai_tensor_dequantize(int32_t q, float scale, int32_t zero_point)
+{
+    return scale * (float)(q - zero_point);
+}
+
+/* q = round(real * inv_scale) + zero_point, saturated; callers fold constant factors into `inv_scale`. */
+static inline int32_t edgeai_tensor_quantize_inv(float real, float inv_scale, int32_t zero_point, bool is_signed)
+{
+    float r = real * inv_scale;
+    int32_t q = (int32_t)(r + (r >= 0.0f ? 0.5f : -0.5f)) + zero_point;
+    int32_t lo = is_signed ? -128 : 0;
+    int32_t hi = is_signed ? 127 : 255;
+    if (q < lo) return lo;
+    if (q > hi) return hi;
+    return q;
+}
+
+int32_t edgeai_tensor_quantize(float real, float scale, int32_t zero_point, bool is_signed);
+
+/* Real 0..1 as 0..255 (rounded, saturated); the glint/effect-intensity mapping of one code. */
+uint8_t edgeai_tensor_unit_u8(int32_t q, float scale, int32_t zero_point);
+
+void edgeai_tensor_quantize_f32(const float *src, uint32_t n, float scale, int32_t zero_point, bool is_signed,
+                                uint8_t *dst);
+void edgeai_tensor_dequantize_q(const uint8_t *src, uint32_t n, float scale, int32_t zero_point, bool is_signed,
+                                float *dst);
+
+/* lut[raw byte] = round(real * gain) saturated to 0..255: one dequantize per code for per-element maps. */
+void edgeai_tensor_dequant_lut(float scale, int32_t zero_point, bool is_signed, float gain, uint8_t lut[256]);
+/* lut[i] = quantize(i * step) as a raw byte: one quantize per input level for per-element packing. */
+void edgeai_tensor_quant_lut(float step, float scale, int32_t zero_point, bool is_signed, uint8_t lut[256]);
+
+#if defined(__cplusplus)
+}
+#endif
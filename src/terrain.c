@@ -0,0 +1,80 @@
+#include "terrain.h"
+
+#include <string.h>
+
+#include "edgeai_util.h"
+
+static inline uint16_t terrain_pack(int32_t gx, int32_t gy)
+{
+    return (uint16_t)((uint8_t)(int8_t)gx | ((uint16_t)(uint8_t)(int8_t)gy << 8));
+}
+
+bool edgeai_terrain_init(edgeai_terrain_t *t, const uint8_t *hmap, uint32_t w, uint32_t h)
+{
+    if (!t) return false;
+    memset(t, 0, sizeof(*t));
+    if (!hmap || w != EDGEAI_TERRAIN_W || h != EDGEAI_TERRAIN_H) return false;
+    t->hmap = hmap;
+    edgeai_terrain_update_grad(t, 0, 0, (int32_t)EDGEAI_TERRAIN_W, (int32_t)EDGEAI_TERRAIN_H);
+    return true;
+}
+
+void edgeai_terrain_update_grad(edgeai_terrain_t *t, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    if (!t || !t->hmap) return;
+    const int32_t w = (int32_t)EDGEAI_TERRAIN_W;
+    const int32_t h = (int32_t)EDGEAI_TERRAIN_H;
+    x0 = edgeai_clamp_i32(x0, 0, w);
+    x1 = edgeai_clamp_i32(x1, 0, w);
+    y0 = edgeai_clamp_i32(y0, 0, h);
+    y1 = edgeai_clamp_i32(y1, 0, h);
+
+    /* Central difference with clamped edges, as the texture shading in tools/gen_dune_bg.py. */
+    const uint8_t *hm = t->hmap;
+    for (int32_t y = y0; y < y1; y++)
+    {
+        const uint8_t *up = hm + (uint32_t)((y > 0) ? y - 1 : y) * (uint32_t)w;
+        const uint8_t *dn = hm + (uint32_t)((y < h - 1) ? y + 1 : y) * (uint32_t)w;
+        const uint8_t *row = hm + (uint32_t)y * (uint32_t)w;
+        uint16_t *g = t->grad + (uint32_t)y * (uint32_t)w;
+        for (int32_t x = x0; x < x1; x++)
+        {
+            int32_t xl = (x > 0) ? x - 1 : x;
+            int32_t xr = (x < w - 1) ? x + 1 : x;
+            int32_t gx = ((int32_t)row[xr] - (int32_t)row[xl]) >> 1;
+            int32_t gy = ((int32_t)dn[x] - (int32_t)up[x]) >> 1;
+            g[x] = terrain_pack(edgeai_clamp_i32_sym(gx, 127), edgeai_clamp_i32_sym(gy, 127));
+        }
+    }
+}
+
+void edgeai_terrain_sample(const edgeai_terrain_t *t, int32_t x_q16, int32_t y_q16, int32_t *gx_q16,
+                           int32_t *gy_q16)
+{
+    int32_t gx = 0, gy = 0;
+    if (t && t->hmap)
+    {
+        /* Texel centers sit at half-texel offsets. */
+        int32_t u = (x_q16 >> EDGEAI_TERRAIN_TEXEL_SHIFT) - 32768;
+        int32_t v = (y_q16 >> EDGEAI_TERRAIN_TEXEL_SHIFT) - 32768;
+        u = edgeai_clamp_i32(u, 0, (int32_t)((EDGEAI_TERRAIN_W - 1u) << 16) - 1);
+        v = edgeai_clamp_i32(v, 0, (int32_t)((EDGEAI_TERRAIN_H - 1u) << 16) - 1);
+        uint32_t ix = (uint32_t)u >> 16;
+        uint32_t iy = (uint32_t)v >> 16;
+        int32_t fx = (u >> 8) & 0xFF;
+        int32_t fy = (v >> 8) & 0xFF;
+
+        const uint16_t *p = t->grad + iy * EDGEAI_TERRAIN_W + ix;
+        uint16_t g00 = p[0], g10 = p[1], g01 = p[EDGEAI_TERRAIN_W], g11 = p[EDGEAI_TERRAIN_W + 1u];
+        /* Weights in Q8 x Q8 sum to 1 << 16, so the blend lands in Q16. */
+        int32_t w00 = (256 - fx) * (256 - fy);
+        int32_t w10 = fx * (256 - fy);
+        int32_t w01 = (256 - fx) * fy;
+        int32_t w11 = fx * fy;
+        gx = w00 * (int8_t)g00 + w10 * (int8_t)g10 + w01 * (int8_t)g01 + w11 * (int8_t)g11;
+        gy = w00 * (int8_t)(g00 >> 8) + w10 * (int8_t)(g10 >> 8) + w01 * (int8_t)(g01 >> 8) +
+             w11 * (int8_t)(g11 >> 8);
+    }
+    if (gx_q16) *gx_q16 = gx;
+    if (gy_q16) *gy_q16 = gy;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edgeai_config.h"
+
+/* Terrain force for the ball: downhill gradient of the dune heightmap.
+ * The heightmap (half LCD resolution, one byte per texel) is differentiated once into a packed int8
+ * (gx, gy) table; sim_step samples it bilinearly in Q16 at the ball center and adds
+ * -gradient * EDGEAI_TERRAIN_A_PX_S2 to the tilt acceleration. A sample is four 16-bit loads and a
+ * handful of multiplies, so the step stays in the same cost class as the flat one.
+ */
+
+#ifndef EDGEAI_TERRAIN_ENABLE
+#define EDGEAI_TERRAIN_ENABLE 1
+#endif
+
+/* Acceleration (px/s^2) per unit of slope (height units per texel); typical dune slopes are 5..20. */
+#ifndef EDGEAI_TERRAIN_A_PX_S2
+#define EDGEAI_TERRAIN_A_PX_S2 24
+#endif
+
+/* Heightmap texel edge in LCD pixels. */
+#define EDGEAI_TERRAIN_TEXEL_SHIFT 1
+#define EDGEAI_TERRAIN_W (EDGEAI_LCD_W >> EDGEAI_TERRAIN_TEXEL_SHIFT)
+#define EDGEAI_TERRAIN_H (EDGEAI_LCD_H >> EDGEAI_TERRAIN_TEXEL_SHIFT)
+
+typedef struct
+{
+    const uint8_t *hmap;
+    /* Per texel: low byte gx, high byte gy (int8, half the central difference, saturated). */
+    uint16_t grad[EDGEAI_TERRAIN_W * EDGEAI_TERRAIN_H];
+} edgeai_terrain_t;
+
+/* `hmap` must be EDGEAI_TERRAIN_W x EDGEAI_TERRAIN_H (row-major) and outlive the terrain. */
+bool edgeai_terrain_init(edgeai_terrain_t *t, const uint8_t *hmap, uint32_t w, uint32_t h);
+
+/* Recomputes the gradient of texels [x0,x1) x [y0,y1) (clamped) after the heightmap changed there. */
+void edgeai_terrain_update_grad(edgeai_terrain_t *t, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+
+/* Bilinear gradient at an LCD-space point (Q16 px); results in height units per texel, Q16. */
+void edgeai_terrain_sample(const edgeai_terrain_t *t, int32_t x_q16, int32_t y_q16, int32_t *gx_q16,
+                           int32_t *gy_q16);
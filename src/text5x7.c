@@ -4,110 +4,233 @@
 
 #include "par_lcd_s035.h"
 
-/* Each glyph is 7 rows, 5 bits wide, MSB-first in the low 5 bits (bit 4..0). */
-static const uint8_t GLYPH_SPACE[7] = {0, 0, 0, 0, 0, 0, 0};
-static const uint8_t GLYPH_COLON[7] = {0x00, 0x04, 0x04, 0x00, 0x04, 0x04, 0x00};
-
-static const uint8_t GLYPH_0[7] = {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E};
-static const uint8_t GLYPH_1[7] = {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E};
-static const uint8_t GLYPH_2[7] = {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F};
-static const uint8_t GLYPH_3[7] = {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E};
-static const uint8_t GLYPH_4[7] = {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02};
-static const uint8_t GLYPH_5[7] = {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E};
-static const uint8_t GLYPH_6[7] = {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E};
-static const uint8_t GLYPH_7[7] = {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08};
-static const uint8_t GLYPH_8[7] = {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E};
-static const uint8_t GLYPH_9[7] = {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C};
-
-static const uint8_t GLYPH_A[7] = {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11};
-static const uint8_t GLYPH_B[7] = {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E};
-static const uint8_t GLYPH_C[7] = {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E};
-static const uint8_t GLYPH_D[7] = {0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E};
-static const uint8_t GLYPH_E[7] = {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F};
-static const uint8_t GLYPH_H[7] = {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11};
-static const uint8_t GLYPH_I[7] = {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E};
-static const uint8_t GLYPH_K[7] = {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11};
-static const uint8_t GLYPH_N[7] = {0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x11};
-static const uint8_t GLYPH_R[7] = {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11};
-static const uint8_t GLYPH_S[7] = {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E};
-static const uint8_t GLYPH_U[7] = {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E};
-static const uint8_t GLYPH_LPAREN[7] = {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02};
-static const uint8_t GLYPH_RPAREN[7] = {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08};
-
-static const uint8_t *edgeai_glyph5x7(char c)
+/* Packed atlas: one 7-byte glyph per printable ASCII code, indexed by (c - 0x20).
+ * Each row uses the low 5 bits, MSB-first (bit 4 = leftmost column).
+ */
+static const uint8_t s_font5x7[95][EDGEAI_TEXT5X7_GLYPH_H] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /* ' ' */
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}, /* '!' */
+    {0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00}, /* '"' */
+    {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}, /* '#' */
+    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, /* '$' */
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, /* '%' */
+    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, /* '&' */
+    {0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}, /* ''' */
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, /* '(' */
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, /* ')' */
+    {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}, /* '*' */
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, /* '+' */
+    {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}, /* ',' */
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, /* '-' */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, /* '.' */
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, /* '/' */
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, /* '0' */
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, /* '1' */
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, /* '2' */
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, /* '3' */
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, /* '4' */
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, /* '5' */
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, /* '6' */
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, /* '7' */
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, /* '8' */
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, /* '9' */
+    {0x00, 0x04, 0x04, 0x00, 0x04, 0x04, 0x00}, /* ':' */
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}, /* ';' */
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, /* '<' */
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, /* '=' */
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, /* '>' */
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, /* '?' */
+    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, /* '@' */
+    {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, /* 'A' */
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, /* 'B' */
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, /* 'C' */
+    {0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E}, /* 'D' */
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, /* 'E' */
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, /* 'F' */
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, /* 'G' */
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, /* 'H' */
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, /* 'I' */
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, /* 'J' */
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, /* 'K' */
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, /* 'L' */
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, /* 'M' */
+    {0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x11}, /* 'N' */
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, /* 'O' */
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, /* 'P' */
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, /* 'Q' */
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, /* 'R' */
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, /* 'S' */
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, /* 'T' */
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, /* 'U' */
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, /* 'V' */
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, /* 'W' */
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, /* 'X' */
+    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, /* 'Y' */
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, /* 'Z' */
+    {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}, /* '[' */
+    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, /* 0x5C */
+    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, /* ']' */
+    {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}, /* '^' */
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, /* '_' */
+    {0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00}, /* '`' */
+    {0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F}, /* 'a' */
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E}, /* 'b' */
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, /* 'c' (capital C shape, as the "(c)" signature always drew) */
+    {0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F}, /* 'd' */
+    {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E}, /* 'e' */
+    {0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08}, /* 'f' */
+    {0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E}, /* 'g' */
+    {0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11}, /* 'h' */
+    {0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E}, /* 'i' */
+    {0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C}, /* 'j' */
+    {0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12}, /* 'k' */
+    {0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, /* 'l' */
+    {0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11}, /* 'm' */
+    {0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11}, /* 'n' */
+    {0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E}, /* 'o' */
+    {0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10}, /* 'p' */
+    {0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01}, /* 'q' */
+    {0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10}, /* 'r' */
+    {0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E}, /* 's' */
+    {0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06}, /* 't' */
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D}, /* 'u' */
+    {0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04}, /* 'v' */
+    {0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A}, /* 'w' */
+    {0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11}, /* 'x' */
+    {0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E}, /* 'y' */
+    {0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F}, /* 'z' */
+    {0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02}, /* '{' */
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, /* '|' */
+    {0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08}, /* '}' */
+    {0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00}, /* '~' */
+};
+
+const uint8_t *edgeai_text5x7_glyph(char c)
 {
-    switch (c)
-    {
-        case '0': return GLYPH_0;
-        case '1': return GLYPH_1;
-        case '2': return GLYPH_2;
-        case '3': return GLYPH_3;
-        case '4': return GLYPH_4;
-        case '5': return GLYPH_5;
-        case '6': return GLYPH_6;
-        case '7': return GLYPH_7;
-        case '8': return GLYPH_8;
-        case '9': return GLYPH_9;
-
-        case 'A': return GLYPH_A;
-        case 'B': return GLYPH_B;
-        case 'C': return GLYPH_C;
-        case 'D': return GLYPH_D;
-        case 'E': return GLYPH_E;
-        case 'H': return GLYPH_H;
-        case 'I': return GLYPH_I;
-        case 'K': return GLYPH_K;
-        case 'N': return GLYPH_N;
-        case 'R': return GLYPH_R;
-        case 'S': return GLYPH_S;
-        case 'U': return GLYPH_U;
-        case 'c': return GLYPH_C;
-
-        case ':': return GLYPH_COLON;
-        case '(': return GLYPH_LPAREN;
-        case ')': return GLYPH_RPAREN;
-        case ' ': return GLYPH_SPACE;
-        default: return GLYPH_SPACE;
-    }
+    uint8_t u = (uint8_t)c;
+    if (u < 0x20u || u > 0x7Eu) u = 0x20u;
+    return s_font5x7[u - 0x20u];
 }
 
-static void edgeai_draw_char5x7_scaled(int32_t x, int32_t y, int32_t scale, char c, uint16_t color)
+int32_t edgeai_text5x7_width(int32_t scale, const char *s)
 {
-    const uint8_t *g = edgeai_glyph5x7(c);
+    if (!s) return 0;
     if (scale < 1) scale = 1;
+    int32_t n = 0;
+    while (s[n]) n++;
+    if (n == 0) return 0;
+    return n * EDGEAI_TEXT5X7_ADVANCE * scale - 1 * scale;
+}
 
-    for (int32_t row = 0; row < 7; row++)
+int32_t edgeai_text5x7_height(int32_t scale)
+{
+    if (scale < 1) scale = 1;
+    return EDGEAI_TEXT5X7_GLYPH_H * scale;
+}
+
+static void edgeai_text5x7_raster_color(uint16_t *dst, uint32_t w, uint32_t h,
+                                        int32_t lx, int32_t ly, int32_t scale,
+                                        const char *s, uint16_t rgb565)
+{
+    /* lx/ly are buffer-local. Each lit glyph bit becomes a scale x scale block; rows and
+     * columns are clipped once per block instead of per pixel.
+     */
+    for (; *s; s++, lx += EDGEAI_TEXT5X7_ADVANCE * scale)
     {
-        uint8_t bits = g[row];
-        for (int32_t col = 0; col < 5; col++)
+        if (lx >= (int32_t)w) break;
+        if (lx + EDGEAI_TEXT5X7_GLYPH_W * scale <= 0) continue;
+
+        const uint8_t *g = edgeai_text5x7_glyph(*s);
+        for (int32_t row = 0; row < EDGEAI_TEXT5X7_GLYPH_H; row++)
         {
-            if (bits & (1u << (4 - col)))
+            uint8_t bits = g[row];
+            if (bits == 0u) continue;
+
+            int32_t ya = ly + row * scale;
+            int32_t yb = ya + scale;
+            if (ya < 0) ya = 0;
+            if (yb > (int32_t)h) yb = (int32_t)h;
+            if (ya >= yb) continue;
+
+            for (int32_t col = 0; col < EDGEAI_TEXT5X7_GLYPH_W; col++)
             {
-                int32_t x0 = x + col * scale;
-                int32_t y0 = y + row * scale;
-                par_lcd_s035_fill_rect(x0, y0, x0 + scale - 1, y0 + scale - 1, color);
+                if (!(bits & (1u << (4 - col)))) continue;
+                int32_t xa = lx + col * scale;
+                int32_t xb = xa + scale;
+                if (xa < 0) xa = 0;
+                if (xb > (int32_t)w) xb = (int32_t)w;
+                for (int32_t yy = ya; yy < yb; yy++)
+                {
+                    uint16_t *p = &dst[(uint32_t)yy * w];
+                    for (int32_t xx = xa; xx < xb; xx++) p[xx] = rgb565;
+                }
             }
         }
     }
 }
 
-int32_t edgeai_text5x7_width(int32_t scale, const char *s)
+void edgeai_text5x7_raster(uint16_t *dst, uint32_t w, uint32_t h,
+                           int32_t x0, int32_t y0,
+                           int32_t x, int32_t y, const char *s,
+                           const edgeai_text5x7_style_t *style)
 {
-    if (!s) return 0;
-    int32_t n = 0;
-    while (s[n]) n++;
-    if (n == 0) return 0;
-    return n * (5 + 1) * scale - 1 * scale;
+    if (!dst || !s || !style || w == 0 || h == 0) return;
+    int32_t scale = (style->scale < 1) ? 1 : style->scale;
+
+    if (style->shadow)
+    {
+        edgeai_text5x7_raster_color(dst, w, h, x - x0 + style->shadow_dx, y - y0 + style->shadow_dy,
+                                    scale, s, style->shadow_rgb565);
+    }
+    edgeai_text5x7_raster_color(dst, w, h, x - x0, y - y0, scale, s, style->fg);
 }
 
-void edgeai_text5x7_draw_scaled(int32_t x, int32_t y, int32_t scale, const char *s, uint16_t rgb565)
+void edgeai_text5x7_draw_rect(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                              int32_t x, int32_t y, const char *s,
+                              const edgeai_text5x7_style_t *style,
+                              uint16_t *strip, uint32_t strip_px)
 {
-    if (!s) return;
-    int32_t cx = x;
-    while (*s)
+    if (!s || !style || !strip) return;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= EDGEAI_LCD_W) x1 = EDGEAI_LCD_W - 1;
+    if (y1 >= EDGEAI_LCD_H) y1 = EDGEAI_LCD_H - 1;
+    if (x1 < x0 || y1 < y0) return;
+
+    uint32_t w = (uint32_t)(x1 - x0 + 1);
+    uint32_t band_h = strip_px / w;
+    if (band_h == 0u) return;
+
+    /* One blit per band; a line that fits the strip is a single LCD transaction. */
+    for (int32_t by0 = y0; by0 <= y1; by0 += (int32_t)band_h)
+    {
+        int32_t by1 = by0 + (int32_t)band_h - 1;
+        if (by1 > y1) by1 = y1;
+        uint32_t h = (uint32_t)(by1 - by0 + 1);
+        uint32_t n = w * h;
+
+        for (uint32_t i = 0; i < n; i++) strip[i] = style->bg;
+        edgeai_text5x7_raster(strip, w, h, x0, by0, x, y, s, style);
+        par_lcd_s035_blit_rect(x0, by0, x1, by1, strip);
+    }
+}
+
+void edgeai_text5x7_draw(int32_t x, int32_t y, const char *s, const edgeai_text5x7_style_t *style,
+                         uint16_t *strip, uint32_t strip_px)
+{
+    if (!s || !style) return;
+    int32_t w = edgeai_text5x7_width(style->scale, s);
+    int32_t h = edgeai_text5x7_height(style->scale);
+    if (w <= 0) return;
+
+    int32_t x0 = x;
+    int32_t y0 = y;
+    int32_t x1 = x + w - 1;
+    int32_t y1 = y + h - 1;
+    if (style->shadow)
     {
-        edgeai_draw_char5x7_scaled(cx, y, scale, *s, rgb565);
-        cx += (5 + 1) * scale;
-        s++;
+        if (style->shadow_dx < 0) x0 += style->shadow_dx; else x1 += style->shadow_dx;
+        if (style->shadow_dy < 0) y0 += style->shadow_dy; else y1 += style->shadow_dy;
     }
+    edgeai_text5x7_draw_rect(x0, y0, x1, y1, x, y, s, style, strip, strip_px);
 }
@@ -1,11 +1,54 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
-/* Minimal 5x7 text renderer for direct-to-LCD drawing (via fill-rect).
- * This is used for boot titles and small status text in raster mode.
+#include "edgeai_config.h"
+
+/* 5x7 text renderer backed by one packed glyph atlas (printable ASCII 0x20..0x7E).
+ * - `edgeai_text5x7_raster` draws into a caller-provided RGB565 buffer (tile renderer, HUD).
+ * - `edgeai_text5x7_draw*` rasterize a whole string into a caller-provided RAM strip and blit it once
+ *   (boot title, raster-mode HUD). Text taller than the strip is split into row bands. There is no
+ *   static strip: callers lend an idle buffer such as the render tile (scratch_arena.h).
  */
 
+#define EDGEAI_TEXT5X7_GLYPH_W 5
+#define EDGEAI_TEXT5X7_GLYPH_H 7
+#define EDGEAI_TEXT5X7_ADVANCE 6
+
+typedef struct
+{
+    int32_t scale;
+    uint16_t fg;
+    uint16_t bg;
+    bool shadow;
+    int16_t shadow_dx;
+    int16_t shadow_dy;
+    uint16_t shadow_rgb565;
+} edgeai_text5x7_style_t;
+
+/* Glyph rows (7 bytes, bit 4 = leftmost column). Unknown characters map to space. */
+const uint8_t *edgeai_text5x7_glyph(char c);
+
 int32_t edgeai_text5x7_width(int32_t scale, const char *s);
-void edgeai_text5x7_draw_scaled(int32_t x, int32_t y, int32_t scale, const char *s, uint16_t rgb565);
+int32_t edgeai_text5x7_height(int32_t scale);
+
+/* Rasterize into a buffer whose top-left is (x0,y0) in LCD space (same convention as sw_render).
+ * Only lit pixels are written; the background is left untouched. `style->bg` is ignored.
+ */
+void edgeai_text5x7_raster(uint16_t *dst, uint32_t w, uint32_t h,
+                           int32_t x0, int32_t y0,
+                           int32_t x, int32_t y, const char *s,
+                           const edgeai_text5x7_style_t *style);
+
+/* Fill the inclusive LCD rect with `style->bg`, rasterize text at (x,y) and blit the rect, one band of
+ * `strip_px / width` rows at a time through `strip`. Nothing is drawn when a single row does not fit.
+ */
+void edgeai_text5x7_draw_rect(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                              int32_t x, int32_t y, const char *s,
+                              const edgeai_text5x7_style_t *style,
+                              uint16_t *strip, uint32_t strip_px);
 
+/* Same as `edgeai_text5x7_draw_rect` with the rect fitted to the text (and shadow). */
+void edgeai_text5x7_draw(int32_t x, int32_t y, const char *s, const edgeai_text5x7_style_t *style,
+                         uint16_t *strip, uint32_t strip_px);
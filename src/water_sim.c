@@ -1,2 +1,222 @@
-/* Placeholder for future grid-based water simulation module. */
+#include "water_sim.h"
 
+#include <string.h>
+
+#include "edgeai_util.h"
+
+/* Same direction ring as sand_sim.c (clockwise, +y down). */
+static const int8_t s_dir_x[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int8_t s_dir_y[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+#define WATER_LINE_MAX ((EDGEAI_SAND_W > EDGEAI_SAND_H) ? EDGEAI_SAND_W : EDGEAI_SAND_H)
+#define WATER_MASK_WORDS ((WATER_LINE_MAX + 31) / 32)
+
+typedef struct
+{
+    sand_grid_t *g;
+    edgeai_water_t *w;
+    int32_t gx;
+    int32_t gy;
+    int32_t dir;
+    bool rows;                         /* scan lines are rows: sideways is x */
+    uint32_t moved[WATER_MASK_WORDS]; /* cells of the current line that arrived by a move */
+} water_ctx_t;
+
+static int32_t water_dir_index(sand_gravity_t g)
+{
+    for (int32_t i = 0; i < 8; i++)
+    {
+        if (s_dir_x[i] == g.gx && s_dir_y[i] == g.gy) return i;
+    }
+    return -1;
+}
+
+static inline uint32_t water_xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+static inline bool water_is(const sand_grid_t *g, int32_t x, int32_t y, sand_material_t m)
+{
+    return x >= 0 && y >= 0 && x < EDGEAI_SAND_W && y < EDGEAI_SAND_H && g->cell[y][x] == (uint8_t)m;
+}
+
+static inline void water_move(water_ctx_t *c, int32_t x, int32_t y, int32_t nx, int32_t ny, uint8_t st)
+{
+    c->g->cell[ny][nx] = (uint8_t)kEdgeAiMatWater;
+    c->g->cell[y][x] = (uint8_t)kEdgeAiMatEmpty;
+    c->w->state[ny][nx] = st;
+    c->w->state[y][x] = 0u;
+    c->g->changed[sand_sim_patch_of(x, y)] = 1u;
+    c->g->changed[sand_sim_patch_of(nx, ny)] = 1u;
+    if (c->rows ? (ny == y) : (nx == x))
+    {
+        uint32_t a = (uint32_t)(c->rows ? nx : ny);
+        c->moved[a >> 5] |= 1u << (a & 31u);
+    }
+    c->w->moves++;
+}
+
+static void water_update_cell(water_ctx_t *c, int32_t x, int32_t y)
+{
+    sand_grid_t *g = c->g;
+    edgeai_water_t *w = c->w;
+    if (g->cell[y][x] != (uint8_t)kEdgeAiMatWater) return;
+    uint32_t a = (uint32_t)(c->rows ? x : y);
+    if (c->moved[a >> 5] & (1u << (a & 31u))) return;
+    w->water_cells++;
+
+    /* Pressure: one more than the water cell upstream, from its last update. */
+    uint8_t st = w->state[y][x];
+    uint32_t p = 0;
+    if (water_is(g, x - c->gx, y - c->gy, kEdgeAiMatWater))
+    {
+        p = (w->state[y - c->gy][x - c->gx] & EDGEAI_WATER_P_MASK) + 1u;
+        if (p > EDGEAI_WATER_P_MASK) p = EDGEAI_WATER_P_MASK;
+    }
+    uint32_t speed = (st & EDGEAI_WATER_SPEED_MASK) >> EDGEAI_WATER_SPEED_SHIFT;
+    bool pos = (st & EDGEAI_WATER_DIR_POS) != 0u;
+
+    if (water_is(g, x + c->gx, y + c->gy, kEdgeAiMatEmpty))
+    {
+        water_move(c, x, y, x + c->gx, y + c->gy, (uint8_t)(p | (st & EDGEAI_WATER_DIR_POS)));
+        return;
+    }
+
+    /* Diagonals of gravity, the one on the running side first (random when neither is). */
+    int32_t d1 = (c->dir + 1) & 7;
+    int32_t d2 = (c->dir + 7) & 7;
+    int32_t l1 = c->rows ? s_dir_x[d1] : s_dir_y[d1];
+    int32_t l2 = c->rows ? s_dir_x[d2] : s_dir_y[d2];
+    bool first_d1 = (l1 != l2) ? ((l1 > l2) == pos) : ((water_xorshift32(&w->rng) & 1u) != 0u);
+    if (!first_d1)
+    {
+        int32_t t = d1;
+        d1 = d2;
+        d2 = t;
+    }
+    if (water_is(g, x + s_dir_x[d1], y + s_dir_y[d1], kEdgeAiMatEmpty))
+    {
+        water_move(c, x, y, x + s_dir_x[d1], y + s_dir_y[d1], (uint8_t)(p | (st & EDGEAI_WATER_DIR_POS)));
+        return;
+    }
+    if (water_is(g, x + s_dir_x[d2], y + s_dir_y[d2], kEdgeAiMatEmpty))
+    {
+        water_move(c, x, y, x + s_dir_x[d2], y + s_dir_y[d2], (uint8_t)(p | (st & EDGEAI_WATER_DIR_POS)));
+        return;
+    }
+
+    /* Sideways along the line: deeper and already-running water reaches farther. A blocked side flips
+     * the direction; the run stops at the first cell with a drop under it.
+     */
+    uint32_t reach = 1u + (p >> 2) + speed;
+    if (reach > (uint32_t)EDGEAI_WATER_DISPERSE) reach = (uint32_t)EDGEAI_WATER_DISPERSE;
+    for (int32_t attempt = 0; attempt < 2; attempt++)
+    {
+        int32_t s = pos ? 1 : -1;
+        int32_t lx = c->rows ? s : 0;
+        int32_t ly = c->rows ? 0 : s;
+        int32_t last = 0;
+        for (int32_t k = 1; k <= (int32_t)reach; k++)
+        {
+            int32_t nx = x + lx * k;
+            int32_t ny = y + ly * k;
+            w->probes++;
+            if (!water_is(g, nx, ny, kEdgeAiMatEmpty)) break;
+            last = k;
+            if (water_is(g, nx + c->gx, ny + c->gy, kEdgeAiMatEmpty)) break;
+        }
+        if (last > 0)
+        {
+            uint32_t ns = (speed < EDGEAI_WATER_SPEED_MAX) ? speed + 1u : speed;
+            water_move(c, x, y, x + lx * last, y + ly * last,
+                       (uint8_t)(p | (ns << EDGEAI_WATER_SPEED_SHIFT) | (pos ? EDGEAI_WATER_DIR_POS : 0u)));
+            return;
+        }
+        pos = !pos;
+        speed = 0;
+    }
+    w->state[y][x] = (uint8_t)(p | (pos ? EDGEAI_WATER_DIR_POS : 0u));
+}
+
+void edgeai_water_init(edgeai_water_t *w, uint32_t seed)
+{
+    if (!w) return;
+    memset(w, 0, sizeof(*w));
+    w->rng = seed ? seed : 0x6C8E9CF5u;
+}
+
+void edgeai_water_fill_rect(edgeai_water_t *w, sand_grid_t *g, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    if (!w || !g) return;
+    sand_sim_fill_rect(g, x0, y0, x1, y1, kEdgeAiMatWater);
+    x0 = edgeai_clamp_i32(x0, 0, EDGEAI_SAND_W - 1);
+    x1 = edgeai_clamp_i32(x1, 0, EDGEAI_SAND_W - 1);
+    y0 = edgeai_clamp_i32(y0, 0, EDGEAI_SAND_H - 1);
+    y1 = edgeai_clamp_i32(y1, 0, EDGEAI_SAND_H - 1);
+    for (int32_t y = y0; y <= y1; y++) memset(&w->state[y][x0], 0, (size_t)(x1 - x0 + 1));
+}
+
+void edgeai_water_step(edgeai_water_t *w, sand_grid_t *g, sand_gravity_t grav)
+{
+    if (!w || !g) return;
+    (void)sand_sim_set_gravity(g, grav);
+    w->cells_scanned = 0;
+    w->water_cells = 0;
+    w->probes = 0;
+    w->moves = 0;
+
+    water_ctx_t c;
+    c.g = g;
+    c.w = w;
+    c.gx = grav.gx;
+    c.gy = grav.gy;
+    c.dir = water_dir_index(grav);
+    if (c.dir < 0) return;
+    c.rows = (grav.gy != 0);
+
+    /* The sand scan order (see sand_scan): downhill line first, toward -gx within a row for diagonal
+     * gravity, random line direction otherwise; only active patches.
+     */
+    const int32_t lines = c.rows ? EDGEAI_SAND_H : EDGEAI_SAND_W;
+    const int32_t len = c.rows ? EDGEAI_SAND_W : EDGEAI_SAND_H;
+    const int32_t down = c.rows ? grav.gy : grav.gx;
+    const int32_t lateral = c.rows ? grav.gx : 0;
+    const int32_t segs = (len + EDGEAI_SAND_PATCH - 1) / EDGEAI_SAND_PATCH;
+    for (int32_t li = 0; li < lines; li++)
+    {
+        int32_t line = (down > 0) ? (lines - 1 - li) : li;
+        bool reverse = (lateral > 0) || ((lateral == 0) && (water_xorshift32(&w->rng) & 1u));
+        memset(c.moved, 0, sizeof(c.moved));
+
+        for (int32_t si = 0; si < segs; si++)
+        {
+            int32_t seg = reverse ? (segs - 1 - si) : si;
+            int32_t a0 = seg * EDGEAI_SAND_PATCH;
+            int32_t a1 = a0 + EDGEAI_SAND_PATCH;
+            if (a1 > len) a1 = len;
+            int32_t px = c.rows ? seg : (line / EDGEAI_SAND_PATCH);
+            int32_t py = c.rows ? (line / EDGEAI_SAND_PATCH) : seg;
+            if (!g->active[py * EDGEAI_SAND_PATCH_COLS + px]) continue;
+            w->cells_scanned += (uint32_t)(a1 - a0);
+            for (int32_t k = 0; k < a1 - a0; k++)
+            {
+                int32_t a = reverse ? (a1 - 1 - k) : (a0 + k);
+                if (c.rows)
+                {
+                    water_update_cell(&c, a, line);
+                }
+                else
+                {
+                    water_update_cell(&c, line, a);
+                }
+            }
+        }
+    }
+    w->steps++;
+}
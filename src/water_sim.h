@@ -1,4 +1,56 @@
 #pragma once
 
-/* Placeholder for future grid-based water simulation module. */
+#include <stdbool.h>
+#include <stdint.h>
 
+#include "sand_sim.h"
+
+/* Grid water on the sand material grid (docs/SIM_ARCHITECTURE.md).
+ * Water cells are kEdgeAiMatWater in sand_grid_t; a parallel byte per cell carries their pressure (water
+ * cells stacked upstream, saturating) and lateral velocity (direction and speed). Rules per water cell:
+ * fall along gravity, else slide down a diagonal, else run sideways along the scan line up to
+ * 1 + pressure/4 + speed cells, capped at EDGEAI_WATER_DISPERSE, stopping early over a drop. A blocked run
+ * flips direction. Scan order is the sand order (downhill lines first), and a per-line moved mask keeps a
+ * cell that ran sideways from being moved again in the same step.
+ *
+ * Sharing: the water step scans the grid's active patches and flags what it changes in `changed`; call it
+ * before the sand step of the same frame, whose end-of-step folds both into the next active set. Sand
+ * sinking through water swaps the material only; the state byte of a displaced cell is rebuilt on its
+ * next update.
+ */
+
+#ifndef EDGEAI_WATER_ENABLE
+#define EDGEAI_WATER_ENABLE 0
+#endif
+
+/* Most cells a water cell runs sideways in one step. */
+#ifndef EDGEAI_WATER_DISPERSE
+#define EDGEAI_WATER_DISPERSE 4
+#endif
+
+/* State byte: pressure in the low nibble, then lateral speed and direction. */
+#define EDGEAI_WATER_P_MASK 0x0Fu
+#define EDGEAI_WATER_SPEED_SHIFT 4
+#define EDGEAI_WATER_SPEED_MASK 0x30u
+#define EDGEAI_WATER_SPEED_MAX 3u
+#define EDGEAI_WATER_DIR_POS 0x40u /* running toward +x (row scan) / +y (column scan) */
+
+typedef struct
+{
+    uint8_t state[EDGEAI_SAND_H][EDGEAI_SAND_W];
+    uint32_t rng;
+    uint32_t steps;
+    /* Last step. */
+    uint32_t cells_scanned; /* cells visited in active patches */
+    uint32_t water_cells;   /* water cells updated */
+    uint32_t probes;        /* sideways cells examined */
+    uint32_t moves;
+} edgeai_water_t;
+
+void edgeai_water_init(edgeai_water_t *w, uint32_t seed);
+
+/* Fills a rectangle of `g` with water (inclusive bounds, clipped) with fresh state. */
+void edgeai_water_fill_rect(edgeai_water_t *w, sand_grid_t *g, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+
+/* One water step on `g` under `grav` (a gravity change wakes every patch, as for sand). */
+void edgeai_water_step(edgeai_water_t *w, sand_grid_t *g, sand_gravity_t grav);
@@ -0,0 +1,135 @@
+/*
+ * Host check and cost of the ball-to-grid coupling (src/ball_grid.h).
+ *
+ * - Plow: a ball rolling from open ground into a packed sand bank at several speeds; grains must be
+ *   conserved (they flow around the ball into its wake) and the ball must slow down.
+ * - Wall: a ball driven into a metal column must bounce off it (normal velocity reversed, about 3/4).
+ * - Cost: ns per coupling step while plowing, and the worst case (a packed grid, where every footprint cell
+ *   searches both ways and stays), with the cells touched against the whole grid.
+ *
+ * Build and run:
+ *   cc -O2 -std=c11 -Isrc tools/ball_grid_bench.c src/ball_grid.c src/sand_sim.c src/edgeai_math.c \
+ *       -o /tmp/ball_grid_bench && /tmp/ball_grid_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "ball_grid.h"
+
+#define BENCH_FRAMES 120
+#define BENCH_COST_ITERS 20000
+
+static sand_grid_t s_grid;
+
+/* One 60 Hz frame of free motion plus the coupling impulse, as the demo applies it. */
+static double s_couple_s;
+
+static void frame(edgeai_ball_grid_t *c, ball_state_t *b)
+{
+    int32_t dvx = 0, dvy = 0;
+    double t0 = bench_now_s();
+    (void)edgeai_ball_grid_step(c, &s_grid, b, &dvx, &dvy);
+    s_couple_s += bench_now_s() - t0;
+    b->vx_q16 += dvx;
+    b->vy_q16 += dvy;
+    b->x_q16 += b->vx_q16 / 60;
+    b->y_q16 += b->vy_q16 / 60;
+    sand_sim_step(&s_grid, (sand_gravity_t){0, 1});
+}
+
+static int plow(int32_t speed_px_s)
+{
+    edgeai_ball_grid_t c;
+    edgeai_ball_grid_init(&c);
+    sand_sim_init(&s_grid, 0x5A17u);
+    sand_sim_fill_rect(&s_grid, EDGEAI_SAND_W / 4, EDGEAI_SAND_H / 2, EDGEAI_SAND_W - 1, EDGEAI_SAND_H - 1,
+                       kEdgeAiMatSand);
+    uint32_t n0 = sand_sim_count(&s_grid, kEdgeAiMatSand);
+
+    ball_state_t b;
+    memset(&b, 0, sizeof(b));
+    b.x_q16 = 40 << 16;
+    b.y_q16 = ((EDGEAI_LCD_H * 3) / 4) << 16;
+    b.vx_q16 = speed_px_s << 16;
+    uint64_t moved = 0, blocked = 0;
+    int32_t frames = 0;
+    s_couple_s = 0.0;
+    for (; frames < BENCH_FRAMES && b.vx_q16 > 0 && (b.x_q16 >> 16) < EDGEAI_LCD_W - 40; frames++)
+    {
+        frame(&c, &b);
+        moved += c.moved;
+        blocked += c.blocked;
+    }
+    uint32_t n1 = sand_sim_count(&s_grid, kEdgeAiMatSand);
+    double v1 = (double)b.vx_q16 / 65536.0;
+    printf("plow %3d px/s: %3d frames, %3d px into the bank, v %.0f px/s, %.1f moved / %.1f blocked per frame, "
+           "%.0f ns/step, grains %s\n",
+           speed_px_s, frames, (b.x_q16 >> 16) - (EDGEAI_SAND_W / 4) * EDGEAI_SAND_CELL_PX, v1,
+           (double)moved / frames, (double)blocked / frames, s_couple_s * 1e9 / frames, (n1 == n0) ? "kept" : "LOST");
+    return (n1 == n0 && v1 < speed_px_s) ? 0 : 1;
+}
+
+static int wall(void)
+{
+    edgeai_ball_grid_t c;
+    edgeai_ball_grid_init(&c);
+    sand_sim_init(&s_grid, 0x5A17u);
+    int32_t wx = (EDGEAI_SAND_W * 2) / 3;
+    sand_sim_fill_rect(&s_grid, wx, 0, wx + 2, EDGEAI_SAND_H - 1, kEdgeAiMatMetal);
+
+    ball_state_t b;
+    memset(&b, 0, sizeof(b));
+    b.x_q16 = ((wx * EDGEAI_SAND_CELL_PX) - 80) << 16;
+    b.y_q16 = (EDGEAI_LCD_H / 2) << 16;
+    int32_t v0 = 200;
+    b.vx_q16 = v0 << 16;
+    int32_t frames = 0;
+    for (; frames < BENCH_FRAMES && b.vx_q16 > 0; frames++) frame(&c, &b);
+    double v1 = (double)b.vx_q16 / 65536.0;
+    printf("metal wall %d px/s: bounced after %d frames at %.0f px/s (%.2f of the speed)\n", v0, frames, v1,
+           -v1 / v0);
+    return (b.vx_q16 < 0 && -v1 < v0) ? 0 : 1;
+}
+
+static void cost(void)
+{
+    edgeai_ball_grid_t c;
+    edgeai_ball_grid_init(&c);
+    sand_sim_init(&s_grid, 0x5A17u);
+    sand_sim_fill_rect(&s_grid, 0, 0, EDGEAI_SAND_W - 1, EDGEAI_SAND_H - 1, kEdgeAiMatSand);
+
+    /* The ball at the bottom (largest footprint) in a packed grid: nothing can move, every cell is read. */
+    ball_state_t b;
+    memset(&b, 0, sizeof(b));
+    b.x_q16 = (EDGEAI_LCD_W / 2) << 16;
+    b.y_q16 = (EDGEAI_LCD_H - 30) << 16;
+    b.vx_q16 = 150 << 16;
+    int32_t dvx = 0, dvy = 0;
+    int64_t sink = 0;
+    double t0 = bench_now_s();
+    for (int i = 0; i < BENCH_COST_ITERS; i++)
+    {
+        (void)edgeai_ball_grid_step(&c, &s_grid, &b, &dvx, &dvy);
+        sink += dvx;
+    }
+    double t = bench_now_s() - t0;
+    printf("worst case: %u cells touched of %d (r %d cells max), %.0f ns/step host%s\n", c.cells,
+           EDGEAI_SAND_W * EDGEAI_SAND_H, EDGEAI_BALL_GRID_R_MAX, t * 1e9 / BENCH_COST_ITERS, sink ? "" : " ");
+}
+
+int main(void)
+{
+    int rc = 0;
+    printf("grid %dx%d, %d px/cell\n", EDGEAI_SAND_W, EDGEAI_SAND_H, EDGEAI_SAND_CELL_PX);
+    rc |= plow(60);
+    rc |= plow(200);
+    rc |= plow(600);
+    rc |= wall();
+    cost();
+    return rc;
+}
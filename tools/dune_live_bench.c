@@ -0,0 +1,161 @@
+/*
+ * Host check and benchmark for the deformable dune (src/dune_live.h).
+ *
+ * - The fixed-point shading of the whole shipped heightmap must reproduce the shipped texture
+ *   (tools/gen_dune_bg.py) bit for bit.
+ * - A ball circles the board for a while, pressing and relaxing once per frame; reports the cost per
+ *   frame, texels relit per frame and dirty blocks per frame, against relighting the full map.
+ * - The ball is then lifted off: after relaxation the heightmap and the texture must be back to the
+ *   shipped ones exactly.
+ * - Dynamic lighting (as with EDGEAI_DUNE_LIGHT_DYNAMIC=1): the gradient-normal kernel under the baked light
+ *   against the shipped texture, the cost of one budgeted row band, and frames per full sweep while the
+ *   tilt keeps changing.
+ *
+ * Build and run:
+ *   cc -O2 -std=c11 -Isrc tools/dune_live_bench.c src/dune_live.c src/terrain.c src/sw_render.c src/edgeai_math.c \
+ *       -lm -o /tmp/dune_live_bench && /tmp/dune_live_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "dune_live.h"
+#include "edgeai_config.h"
+#include "sw_render.h"
+#include "terrain.h"
+
+#define BENCH_FRAMES 3600u /* 60 s at 60 fps */
+#define BENCH_FULL_ITERS 50
+
+static edgeai_dune_live_t s_dune;
+static edgeai_terrain_t s_terrain;
+static uint16_t s_full[EDGEAI_TERRAIN_W * EDGEAI_TERRAIN_H];
+
+static uint32_t count_dirty(void)
+{
+    uint32_t n = 0;
+    for (uint32_t b = 0; b < (uint32_t)EDGEAI_DUNE_BLOCK_COUNT; b++)
+    {
+        if (s_dune.block[b] & kEdgeAiDuneBlockDirty) n++;
+        s_dune.block[b] &= (uint8_t)~kEdgeAiDuneBlockDirty; /* the renderer's part */
+    }
+    return n;
+}
+
+int main(void)
+{
+    uint32_t w = 0, h = 0;
+    const uint8_t *hmap = sw_render_dune_hmap(&w, &h);
+    const uint16_t *tex = sw_render_dune_tex(&w, &h);
+
+    edgeai_dune_shade_rect(hmap, s_full, 0, 0, (int32_t)w, (int32_t)h);
+    uint32_t diff = 0;
+    for (uint32_t i = 0; i < w * h; i++) diff += (s_full[i] != tex[i]);
+    printf("shade vs shipped texture: %u/%u texels differ\n", diff, w * h);
+    if (diff) return 1;
+
+    double t0 = bench_now_s();
+    for (int i = 0; i < BENCH_FULL_ITERS; i++)
+    {
+        s_full[i] ^= 1u;
+        edgeai_dune_shade_rect(hmap, s_full, 0, 0, (int32_t)w, (int32_t)h);
+    }
+    double t_full = (bench_now_s() - t0) / BENCH_FULL_ITERS;
+
+    if (!edgeai_dune_live_init(&s_dune, hmap, tex, w, h, &s_terrain) ||
+        !edgeai_terrain_init(&s_terrain, s_dune.hmap, w, h))
+    {
+        printf("init failed\n");
+        return 1;
+    }
+
+    /* Lissajous path over most of the board, ~120 px/s. */
+    uint64_t dirty_total = 0;
+    uint32_t dirty_max = 0, displaced_max = 0;
+    uint32_t relit0 = s_dune.relit_texels;
+    t0 = bench_now_s();
+    int32_t x = 240 << 8, y = 160 << 8, vx = 512, vy = 300; /* Q8 px, px/frame */
+    for (uint32_t f = 0; f < BENCH_FRAMES; f++)
+    {
+        x += vx;
+        y += vy;
+        if (x < (60 << 8) || x > (420 << 8)) vx = -vx;
+        if (y < (60 << 8) || y > (260 << 8)) vy = -vy;
+        int32_t px = x >> 8, py = y >> 8;
+        edgeai_dune_live_press(&s_dune, px, py, edgeai_ball_r_for_y(py));
+        edgeai_dune_live_relax(&s_dune);
+        uint32_t d = count_dirty();
+        dirty_total += d;
+        if (d > dirty_max) dirty_max = d;
+        if (s_dune.displaced_blocks > displaced_max) displaced_max = s_dune.displaced_blocks;
+    }
+    double t_live = (bench_now_s() - t0) / BENCH_FRAMES;
+    uint32_t relit = s_dune.relit_texels - relit0;
+
+    printf("full-map relight: %.1f us (%u texels)\n", t_full * 1e6, w * h);
+    printf("live frame (press + relax + relight + gradient): %.2f us, %.0f texels relit/frame\n", t_live * 1e6,
+           (double)relit / BENCH_FRAMES);
+    printf("dirty blocks/frame: avg %.1f max %u (of %u); displaced blocks max %u\n",
+           (double)dirty_total / BENCH_FRAMES, dirty_max, (unsigned)EDGEAI_DUNE_BLOCK_COUNT, displaced_max);
+
+    /* Ball lifted: everything relaxes back to the shipped state. */
+    uint32_t frames = 0;
+    while (s_dune.displaced_blocks > 0u && frames < 100000u)
+    {
+        edgeai_dune_live_relax(&s_dune);
+        (void)count_dirty();
+        frames++;
+    }
+    uint32_t hdiff = 0, tdiff = 0;
+    for (uint32_t i = 0; i < w * h; i++)
+    {
+        hdiff += (s_dune.hmap[i] != hmap[i]);
+        tdiff += (s_dune.tex[i] != tex[i]);
+    }
+    printf("relaxed in %u frames (%.1f s at 60 fps): %u height / %u texture texels differ\n", frames,
+           frames / 60.0, hdiff, tdiff);
+    if (hdiff || tdiff) return 1;
+
+    /* Dynamic lighting; the kernel under the baked light differs only by the halved gradient. */
+    edgeai_dune_live_init(&s_dune, hmap, tex, w, h, &s_terrain);
+    edgeai_terrain_init(&s_terrain, s_dune.hmap, w, h);
+    s_dune.light_dynamic = true;
+    s_dune.light[0] = 0; /* force a full sweep under the baked light */
+    edgeai_dune_live_set_light(&s_dune, EDGEAI_DUNE_LIGHT_X, EDGEAI_DUNE_LIGHT_Y, EDGEAI_DUNE_LIGHT_Z);
+    while (edgeai_dune_live_relight_rows(&s_dune, h) > 0u) s_dune.band_y0 = s_dune.band_y1 = 0;
+    uint32_t ldiff = 0, lmax = 0;
+    for (uint32_t i = 0; i < w * h; i++)
+    {
+        uint16_t a = s_dune.tex[i], b = tex[i];
+        if (a == b) continue;
+        ldiff++;
+        int32_t dr = (int32_t)(a >> 11) - (int32_t)(b >> 11);
+        int32_t dg = (int32_t)((a >> 5) & 63u) - (int32_t)((b >> 5) & 63u);
+        int32_t db = (int32_t)(a & 31u) - (int32_t)(b & 31u);
+        uint32_t m = (uint32_t)(dr < 0 ? -dr : dr);
+        if ((uint32_t)(dg < 0 ? -dg : dg) > m) m = (uint32_t)(dg < 0 ? -dg : dg);
+        if ((uint32_t)(db < 0 ? -db : db) > m) m = (uint32_t)(db < 0 ? -db : db);
+        if (m > lmax) lmax = m;
+    }
+    printf("dynamic kernel, baked light: %u/%u texels differ from shipped, max %u LSB per channel\n", ldiff, w * h,
+           lmax);
+
+    uint32_t bands = 0;
+    t0 = bench_now_s();
+    for (uint32_t f = 0; f < BENCH_FRAMES; f++)
+    {
+        int32_t ax = (int32_t)((f * 37u) % 16384u) - 8192; /* tilt never settles */
+        edgeai_dune_live_light_from_tilt(&s_dune, ax, -ax / 2);
+        if (edgeai_dune_live_relight_rows(&s_dune, EDGEAI_DUNE_LIGHT_ROWS) > 0u) bands++;
+        s_dune.band_y0 = s_dune.band_y1 = 0; /* the renderer's part */
+    }
+    double t_band = (bench_now_s() - t0) / (bands ? bands : 1u);
+    printf("dynamic light: %.2f us per %u-row band (%u texels), %u frames per full sweep\n", t_band * 1e6,
+           (unsigned)EDGEAI_DUNE_LIGHT_ROWS, (unsigned)EDGEAI_DUNE_LIGHT_ROWS * w,
+           (unsigned)((h + EDGEAI_DUNE_LIGHT_ROWS - 1u) / EDGEAI_DUNE_LIGHT_ROWS));
+    return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * Host accuracy check and microbenchmark for the fixed-point math module (src/edgeai_math.h).
+ *
+ * - isqrt: every 32-bit argument (y^2 <= x < (y+1)^2, checked in 64 bits).
+ * - recip: every divisor 2..1024 against C division, over 64K numerators of each sign spread across
+ *   |n| * d < 2^32 plus the last 2d below that bound; and every Q14 normal the ball shaders divide by r
+ *   (radius 2..511).
+ * - pow5 / pow16 / pow: every Q14 input against double precision (max and mean error in Q14 LSB), next to
+ *   the truncating square chain the shaders used.
+ * - sincos: every angle against double precision.
+ * - Cost: ns per call against the old routines (bit-by-bit isqrt, divide, truncating square chain). The
+ *   host has a fast divider, so the reciprocal only pays off on target (SDIV is up to 12 cycles on the M33,
+ *   the multiply-high one).
+ * Exits non-zero on any mismatch or an error over its bound.
+ *
+ * Build and run (the exhaustive isqrt pass takes about a minute):
+ *   cc -O2 -std=c11 -Isrc tools/edgeai_math_check.c src/edgeai_math.c -lm -o /tmp/edgeai_math_check
+ *   /tmp/edgeai_math_check
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host/bench_clock.h"
+
+#include "edgeai_math.h"
+
+#define BENCH_N 4096u
+#define BENCH_ITERS 2000
+
+static uint32_t s_rng = 0x2545F491u;
+static int s_fail = 0;
+static uint32_t s_args[BENCH_N];
+static volatile uint32_t s_sink;
+
+static uint32_t rng_next(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+/* The bit-by-bit square root the module replaced. */
+static uint32_t isqrt_bitwise(uint32_t x)
+{
+    uint32_t op = x;
+    uint32_t res = 0;
+    uint32_t one = 1uL << 30;
+    while (one > op) one >>= 2;
+    while (one != 0)
+    {
+        if (op >= res + one)
+        {
+            op -= res + one;
+            res = res + 2u * one;
+        }
+        res >>= 1;
+        one >>= 2;
+    }
+    return res;
+}
+
+/* Floor sqrt check without trusting either routine: y^2 <= x < (y+1)^2. */
+static int isqrt_ok(uint32_t x, uint32_t y)
+{
+    uint64_t y2 = (uint64_t)y * y;
+    uint64_t y12 = (uint64_t)(y + 1u) * (y + 1u);
+    return y2 <= x && x < y12;
+}
+
+static void check_isqrt(void)
+{
+    uint32_t bad = 0;
+    uint32_t x = 0;
+    do
+    {
+        bad += !isqrt_ok(x, edgeai_isqrt_u32(x));
+    } while (++x != 0u);
+    printf("isqrt: all 2^32 arguments: %s\n", bad ? "MISMATCH" : "exact");
+    s_fail |= bad != 0u;
+}
+
+static void check_recip(void)
+{
+    uint32_t bad = 0;
+    uint64_t n = 0;
+    for (uint32_t d = 2; d <= 1024u; d++)
+    {
+        uint32_t m = edgeai_recip_u32(d);
+        uint32_t n_max = 0xFFFFFFFFu / d;
+        if (n_max > 0x7FFFFFFFu) n_max = 0x7FFFFFFFu;
+        uint32_t stride = n_max / 65536u + 1u;
+        for (uint32_t a = 0; a <= n_max - stride; a += stride, n += 2)
+        {
+            bad += edgeai_div_recip_i32((int32_t)a, m) != (int32_t)a / (int32_t)d;
+            bad += edgeai_div_recip_i32(-(int32_t)a, m) != -(int32_t)a / (int32_t)d;
+        }
+        for (uint32_t a = n_max - 2u * d; a <= n_max; a++, n++)
+        {
+            bad += edgeai_div_recip_i32((int32_t)a, m) != (int32_t)a / (int32_t)d;
+        }
+    }
+    for (int32_t r = 2; r <= 511; r++)
+    {
+        uint32_t m = edgeai_recip_u32((uint32_t)r);
+        for (int32_t v = -r; v <= r; v++, n++) bad += edgeai_div_recip_i32(v << 14, m) != (v << 14) / r;
+    }
+    printf("recip: %llu quotients (d 2..1024 over |n| * d < 2^32, Q14 normals for r 2..511): %s\n",
+           (unsigned long long)n, bad ? "MISMATCH" : "exact");
+    s_fail |= bad != 0u;
+}
+
+/* Truncating square chain the shaders used before (reported, no bound). */
+static int32_t pow16_trunc(int32_t s)
+{
+    int32_t s2 = (s * s) >> 14;
+    int32_t s4 = (s2 * s2) >> 14;
+    int32_t s8 = (s4 * s4) >> 14;
+    return (s8 * s8) >> 14;
+}
+
+static void check_pow(const char *name, uint32_t e, int32_t (*fn)(int32_t), int32_t bound)
+{
+    int32_t err_max = 0;
+    double err_sum = 0.0;
+    for (int32_t x = 0; x <= (1 << 14); x++)
+    {
+        int32_t got = fn ? fn(x) : edgeai_pow_q14(x, e);
+        int32_t want = (int32_t)lround(pow(x / 16384.0, (double)e) * 16384.0);
+        int32_t err = abs(got - want);
+        if (err > err_max) err_max = err;
+        err_sum += err;
+    }
+    printf("%-6s x^%-2u over all Q14 inputs: max err %2d LSB, mean %.3f LSB", name, e, err_max, err_sum / 16385.0);
+    if (bound < 0)
+    {
+        printf(" (old chain)\n");
+        return;
+    }
+    printf(" (bound %d)\n", bound);
+    s_fail |= err_max > bound;
+}
+
+static void check_sincos(void)
+{
+    int32_t err_max = 0;
+    for (uint32_t a = 0; a < 256u; a++)
+    {
+        int32_t s, c;
+        edgeai_sincos_q14((uint8_t)a, &s, &c);
+        double t = (double)a * (2.0 * 3.14159265358979323846 / 256.0);
+        int32_t es = abs(s - (int32_t)lround(sin(t) * 16384.0));
+        int32_t ec = abs(c - (int32_t)lround(cos(t) * 16384.0));
+        if (es > err_max) err_max = es;
+        if (ec > err_max) err_max = ec;
+    }
+    printf("sincos: all 256 angles, max err %d LSB (bound 1)\n", err_max);
+    s_fail |= err_max > 1;
+}
+
+static uint32_t b_isqrt_bitwise(uint32_t x) { return isqrt_bitwise(x); }
+static uint32_t b_isqrt(uint32_t x) { return edgeai_isqrt_u32(x); }
+/* x packs dx + 34 (low half) and r (high half), as in the shader's normal. */
+static uint32_t b_div(uint32_t x) { return (uint32_t)((((int32_t)(x & 0xFFFFu) - 34) << 14) / (int32_t)(x >> 16)); }
+static uint32_t b_recip(uint32_t x)
+{
+    return (uint32_t)edgeai_div_recip_i32(((int32_t)(x & 0xFFFFu) - 34) << 14, edgeai_recip_u32(x >> 16));
+}
+static uint32_t b_pow16_trunc(uint32_t x) { return (uint32_t)pow16_trunc((int32_t)x); }
+static uint32_t b_pow16(uint32_t x) { return (uint32_t)edgeai_pow16_q14((int32_t)x); }
+static uint32_t b_pow(uint32_t x) { return (uint32_t)edgeai_pow_q14((int32_t)x, 16u); }
+
+static void bench_one(const char *label, uint32_t (*fn)(uint32_t))
+{
+    uint32_t acc = 0;
+    double t0 = bench_now_s();
+    for (int it = 0; it < BENCH_ITERS; it++)
+    {
+        for (uint32_t i = 0; i < BENCH_N; i++) acc += fn(s_args[i]);
+    }
+    s_sink = acc;
+    printf("  %-34s %6.2f ns\n", label, (bench_now_s() - t0) * 1e9 / ((double)BENCH_ITERS * BENCH_N));
+}
+
+static void bench(void)
+{
+    printf("cost per call (host):\n");
+    /* Shader-sized arguments: r^2 - d^2 for radii up to the largest ball. */
+    for (uint32_t i = 0; i < BENCH_N; i++) s_args[i] = rng_next() % (34u * 34u + 1u);
+    bench_one("isqrt bitwise, x <= 34^2", b_isqrt_bitwise);
+    bench_one("isqrt seeded Newton, x <= 34^2", b_isqrt);
+    for (uint32_t i = 0; i < BENCH_N; i++) s_args[i] = rng_next();
+    bench_one("isqrt bitwise, full range", b_isqrt_bitwise);
+    bench_one("isqrt seeded Newton, full range", b_isqrt);
+
+    for (uint32_t i = 0; i < BENCH_N; i++) s_args[i] = (rng_next() % 69u) | ((12u + rng_next() % 23u) << 16);
+    bench_one("(dx << 14) / r", b_div);
+    bench_one("(dx << 14) * recip(r)", b_recip);
+
+    for (uint32_t i = 0; i < BENCH_N; i++) s_args[i] = rng_next() & 16383u;
+    bench_one("x^16 truncating chain", b_pow16_trunc);
+    bench_one("edgeai_pow16_q14", b_pow16);
+    bench_one("edgeai_pow_q14(x, 16)", b_pow);
+}
+
+int main(void)
+{
+    check_isqrt();
+    check_recip();
+    check_pow("pow5", 5u, edgeai_pow5_q14, 2);
+    check_pow("pow16", 16u, edgeai_pow16_q14, 5);
+    check_pow("pow", 16u, NULL, 5);
+    check_pow("pow", 3u, NULL, 2);
+    check_pow("trunc", 16u, pow16_trunc, -1);
+    check_sincos();
+    bench();
+    if (s_fail) printf("FAILED\n");
+    return s_fail;
+}
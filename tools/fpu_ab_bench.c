@@ -0,0 +1,59 @@
+/*
+ * Host run of the integer-vs-float A/B (src/fpu_ab.h): cost per call of each variant of accel_proc_update,
+ * sim_step and the ball shader, and the float output's error against the integer one.
+ *
+ * Host timings only rank the variants on this machine; the M33 numbers come from the firmware built with
+ * EDGEAI_FPU_AB_ENABLE=1, which prints the same table in DWT cycles at boot. The errors agree up to
+ * rounding (both are IEEE single precision; the target build may fuse multiply-adds).
+ *
+ * Build and run:
+ *   cc -O2 -std=c11 -Isrc tools/fpu_ab_bench.c src/fpu_ab.c src/accel_proc.c src/sim_world.c src/terrain.c \
+ *       src/sw_render.c src/edgeai_math.c -lm -o /tmp/fpu_ab_bench && /tmp/fpu_ab_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "host/bench_clock.h"
+
+#include "fpu_ab.h"
+
+#define BENCH_RUNS 5
+
+static uint32_t s_scratch[EDGEAI_FPU_AB_SCRATCH_BYTES / 4u];
+
+static uint32_t clock_ns(void)
+{
+    return (uint32_t)bench_now_ns();
+}
+
+int main(void)
+{
+    edgeai_fpu_ab_result_t best[kEdgeAiFpuAbCount];
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        edgeai_fpu_ab_result_t r[kEdgeAiFpuAbCount];
+        if (!edgeai_fpu_ab_run(clock_ns, s_scratch, sizeof(s_scratch), r)) return 1;
+        for (int i = 0; i < kEdgeAiFpuAbCount; i++)
+        {
+            if (run == 0) best[i] = r[i];
+            if (r[i].fixed_ticks < best[i].fixed_ticks) best[i].fixed_ticks = r[i].fixed_ticks;
+            if (r[i].float_ticks < best[i].float_ticks) best[i].float_ticks = r[i].float_ticks;
+        }
+    }
+
+    printf("%-6s %6s %12s %12s %7s %10s %10s %14s  %s\n", "fn", "calls", "fixed ns", "float ns", "ratio", "err max",
+           "err mean", "flips", "built");
+    for (int i = 0; i < kEdgeAiFpuAbCount; i++)
+    {
+        const edgeai_fpu_ab_result_t *r = &best[i];
+        double fx = (double)r->fixed_ticks / r->calls;
+        double fl = (double)r->float_ticks / r->calls;
+        printf("%-6s %6u %12.1f %12.1f %7.2f %6u %-3s %10.3f %7u/%-6u  %s\n", r->name, r->calls, fx, fl, fl / fx,
+               r->err_max, r->err_unit, r->err_mean_milli / 1000.0, r->flips, r->compared,
+               r->built_float ? "float" : "fixed");
+    }
+    return 0;
+}
@@ -87,8 +87,8 @@ def emit_c_array_u8(name: str, data: list[int], cols: int = 16) -> str:
     return "\n".join(lines)
 
 
-def emit_c_array_u16(name: str, data: list[int], cols: int = 12) -> str:
-    lines = [f"static const uint16_t {name}[{len(data)}] = {{"]
+def emit_c_array_u16(name: str, data: list[int], cols: int = 12, attr: str = "") -> str:
+    lines = [f"static const uint16_t {name}[{len(data)}]{' ' + attr if attr else ''} = {{"]
     for i in range(0, len(data), cols):
         chunk = data[i : i + cols]
         lines.append("    " + ", ".join(f"0x{v:04X}u" for v in chunk) + ",")
@@ -134,7 +134,12 @@ def main() -> int:
     header.append("")
     header.append(emit_c_array_u8("g_dune_hmap", hmap))
     header.append("")
-    header.append(emit_c_array_u16("g_dune_tex", tex))
+    header.append("/* Placement of the texture, set by the includer (sw_render.c, see ram_place.h). */")
+    header.append("#ifndef DUNE_TEX_ATTR")
+    header.append("#define DUNE_TEX_ATTR")
+    header.append("#endif")
+    header.append("")
+    header.append(emit_c_array_u16("g_dune_tex", tex, attr="DUNE_TEX_ATTR"))
     header.append("")
 
     outp.write_text("\n".join(header), encoding="utf-8")
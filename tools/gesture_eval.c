@@ -0,0 +1,252 @@
+/*
+ * Host evaluation for the gesture classifier (src/gesture.h).
+ *
+ * Replays an accelerometer trace through accel_proc_update + edgeai_gesture_update exactly as the
+ * main loop does, and reports per-class recall, false positives (detections outside any labelled
+ * gesture) per minute of unlabelled time, and the cost per gesture sample.
+ *
+ * Trace format (CSV, one main-loop sample per line, '#' comments):
+ *   t_us,x,y,z,label
+ * x/y/z are raw 12-bit sensor counts (before axis mapping); label is none|tap|shake|swirl (or 0..3)
+ * and marks every sample inside a performed gesture.
+ *
+ * Build and run:
+ *   cc -O2 -std=c11 -Isrc tools/gesture_eval.c src/gesture.c src/accel_proc.c src/tensor_util.c -lm -o /tmp/gesture_eval
+ *   /tmp/gesture_eval --synth /tmp/gesture_trace.csv   (writes a synthetic gameplay + gesture trace)
+ *   /tmp/gesture_eval /tmp/gesture_trace.csv [more traces...]
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "accel_proc.h"
+#include "edgeai_config.h"
+#include "gesture.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define EVAL_CYCLES() ((unsigned long long)__rdtsc())
+#define EVAL_UNIT "tsc cycles"
+#else
+#define EVAL_CYCLES() ((unsigned long long)bench_now_ns())
+#define EVAL_UNIT "ns"
+#endif
+
+/* A detection up to this long after a labelled segment still belongs to it. */
+#define EVAL_SLACK_US 300000u
+
+#define EVAL_PI 3.14159265358979323846
+
+typedef struct
+{
+    unsigned segments[kEdgeAiGestureCount];
+    unsigned hits[kEdgeAiGestureCount];
+    unsigned confused[kEdgeAiGestureCount][kEdgeAiGestureCount]; /* [label][detected] */
+    unsigned fp[kEdgeAiGestureCount];
+    double unlabelled_s;
+    unsigned long long gesture_cyc;
+    unsigned long long gesture_samples;
+} eval_totals_t;
+
+static int parse_label(const char *s)
+{
+    while (*s == ' ') s++;
+    if (*s >= '0' && *s <= '3') return *s - '0';
+    if (!strncmp(s, "tap", 3)) return kEdgeAiGestureTap;
+    if (!strncmp(s, "shake", 5)) return kEdgeAiGestureShake;
+    if (!strncmp(s, "swirl", 5)) return kEdgeAiGestureSwirl;
+    return kEdgeAiGestureNone;
+}
+
+static int eval_trace(const char *path, eval_totals_t *t)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+
+    accel_proc_t ap;
+    accel_proc_init(&ap);
+    static edgeai_gesture_t g;
+    edgeai_gesture_init(&g);
+
+    char line[256];
+    unsigned long long t_prev = 0, seg_end = 0;
+    int have_prev = 0;
+    int seg_label = kEdgeAiGestureNone; /* current or most recent segment */
+    int seg_hit = 0;                    /* segment already credited */
+    int prev_label = kEdgeAiGestureNone;
+    while (fgets(line, sizeof(line), f))
+    {
+        if (line[0] == '#' || line[0] == 't' || line[0] == '\n') continue;
+        unsigned long long t_us;
+        int x, y, z;
+        char lab[32] = "none";
+        if (sscanf(line, "%llu,%d,%d,%d,%31s", &t_us, &x, &y, &z, lab) < 4) continue;
+        int label = parse_label(lab);
+        uint32_t dt = have_prev ? (uint32_t)(t_us - t_prev) : 0u;
+        t_prev = t_us;
+        have_prev = 1;
+
+        if (label != kEdgeAiGestureNone && label != prev_label)
+        {
+            t->segments[label]++;
+            seg_label = label;
+            seg_hit = 0;
+        }
+        if (label != kEdgeAiGestureNone) seg_end = t_us;
+        else t->unlabelled_s += (double)dt * 1e-6;
+        prev_label = label;
+
+        accel_proc_out_t a;
+        accel_proc_update(&ap, x, y, z, &a);
+        uint32_t before = g.samples;
+        unsigned long long c0 = EVAL_CYCLES();
+        edgeai_gesture_kind_t k = edgeai_gesture_update(&g, &a, dt);
+        unsigned long long c1 = EVAL_CYCLES();
+        if (g.samples != before)
+        {
+            t->gesture_cyc += c1 - c0;
+            t->gesture_samples++;
+        }
+        if (k == kEdgeAiGestureNone) continue;
+
+        int in_seg = (seg_label != kEdgeAiGestureNone) && (label != kEdgeAiGestureNone || t_us <= seg_end + EVAL_SLACK_US);
+        if (!in_seg)
+        {
+            t->fp[k]++;
+        }
+        else if (!seg_hit)
+        {
+            t->confused[seg_label][k]++;
+            if ((int)k == seg_label) t->hits[seg_label]++;
+            seg_hit = 1;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+/* Deterministic synthetic trace: gameplay tilts with sensor noise and periodic gestures. */
+static unsigned s_rng = 12345u;
+static double rnd(void)
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return (double)(s_rng >> 8) / 16777216.0;
+}
+
+static int write_synth(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f) return 1;
+    const double dt = 0.005; /* 200 Hz main loop */
+    const double g1 = EDGEAI_ACCEL_MAP_DENOM;
+    const double dur_s = 600.0;
+    double tilt_x = 0, tilt_y = 0, tx_target = 0, ty_target = 0;
+    double next_gesture = 4.0, g_end = -1.0, g_start = 0.0;
+    int g_kind = kEdgeAiGestureNone, g_axis = 0, g_dir = 1;
+    fprintf(f, "# synthetic: 200 Hz, tilt gameplay + tap/shake/swirl every 4-8 s\n");
+    for (double t = 0.0; t < dur_s; t += dt)
+    {
+        /* Gameplay: tilt targets change every ~0.5 s (some brisk), first-order follow. */
+        if (rnd() < dt * 2.0)
+        {
+            tx_target = (rnd() - 0.5) * 1.2;
+            ty_target = (rnd() - 0.5) * 1.2;
+        }
+        double rate = (rnd() < 0.5) ? 6.0 : 15.0;
+        tilt_x += (tx_target - tilt_x) * rate * dt;
+        tilt_y += (ty_target - tilt_y) * rate * dt;
+        double ax = sin(tilt_x) * g1, ay = sin(tilt_y) * g1, az = cos(tilt_x) * cos(tilt_y) * g1;
+
+        if (g_kind == kEdgeAiGestureNone && t >= next_gesture)
+        {
+            g_kind = 1 + (int)(rnd() * 3.0);
+            g_axis = (rnd() < 0.5) ? 0 : 1;
+            g_dir = (rnd() < 0.5) ? 1 : -1;
+            g_start = t;
+            g_end = t + ((g_kind == kEdgeAiGestureTap) ? 0.03 : (g_kind == kEdgeAiGestureShake) ? 0.9 : 1.4);
+        }
+        int label = kEdgeAiGestureNone;
+        if (g_kind != kEdgeAiGestureNone)
+        {
+            double u = t - g_start;
+            label = g_kind;
+            if (g_kind == kEdgeAiGestureTap)
+            {
+                /* Knuckle tap: sharp z spike with a short damped ring. */
+                az += 700.0 * exp(-u / 0.006) * cos(2.0 * EVAL_PI * 60.0 * u);
+            }
+            else if (g_kind == kEdgeAiGestureShake)
+            {
+                double a = 0.7 * g1 * sin(2.0 * EVAL_PI * 4.0 * u);
+                if (g_axis == 0) ax += a;
+                else ay += a;
+            }
+            else
+            {
+                double w = 2.0 * EVAL_PI * 1.5 * u * g_dir;
+                ax += 0.45 * g1 * cos(w);
+                ay += 0.45 * g1 * sin(w);
+            }
+            if (t >= g_end)
+            {
+                g_kind = kEdgeAiGestureNone;
+                next_gesture = t + 4.0 + rnd() * 4.0;
+            }
+        }
+
+        /* Sensor noise; raw axes are pre-mapping, so undo EDGEAI_ACCEL_SWAP_XY. */
+        int x = (int)lround(ax + (rnd() - 0.5) * 10.0);
+        int y = (int)lround(ay + (rnd() - 0.5) * 10.0);
+        int z = (int)lround(az + (rnd() - 0.5) * 10.0);
+#if EDGEAI_ACCEL_SWAP_XY
+        int tmp = x; x = y; y = tmp;
+#endif
+        fprintf(f, "%llu,%d,%d,%d,%s\n", (unsigned long long)(t * 1e6 + 0.5), x, y, z,
+                edgeai_gesture_name((edgeai_gesture_kind_t)label));
+    }
+    fclose(f);
+    printf("wrote %s (%.0f s)\n", path, dur_s);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && !strcmp(argv[1], "--synth")) return write_synth(argv[2]);
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s trace.csv [...] | --synth out.csv\n", argv[0]);
+        return 2;
+    }
+
+    eval_totals_t t;
+    memset(&t, 0, sizeof(t));
+    for (int i = 1; i < argc; i++)
+    {
+        if (eval_trace(argv[i], &t)) return 1;
+    }
+
+    printf("class   segments  hit  recall   confused-as(tap/shake/swirl)\n");
+    for (int k = 1; k < kEdgeAiGestureCount; k++)
+    {
+        printf("%-7s %8u %4u  %5.1f%%   %u/%u/%u\n", edgeai_gesture_name((edgeai_gesture_kind_t)k), t.segments[k],
+               t.hits[k], t.segments[k] ? 100.0 * t.hits[k] / t.segments[k] : 0.0, t.confused[k][1], t.confused[k][2],
+               t.confused[k][3]);
+    }
+    unsigned fp = t.fp[1] + t.fp[2] + t.fp[3];
+    double minutes = t.unlabelled_s / 60.0;
+    printf("false positives: %u (tap %u shake %u swirl %u) over %.1f min unlabelled = %.2f/min\n", fp, t.fp[1], t.fp[2],
+           t.fp[3], minutes, minutes > 0.0 ? fp / minutes : 0.0);
+    printf("cost: %.1f %s per gesture sample (%llu samples)\n",
+           t.gesture_samples ? (double)t.gesture_cyc / (double)t.gesture_samples : 0.0, EVAL_UNIT, t.gesture_samples);
+    return 0;
+}
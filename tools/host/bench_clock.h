@@ -0,0 +1,24 @@
+/*
+ * Monotonic clock for the host benches and checks in tools/ (POSIX clock_gettime).
+ * Include as "host/bench_clock.h" (resolved next to the including tool, so build lines need no extra -I).
+ * The tool defines _POSIX_C_SOURCE (199309L or later) before its first system header.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline double bench_now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
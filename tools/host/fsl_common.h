@@ -0,0 +1,29 @@
+/*
+ * Host shim for the few MCUX SDK definitions used by src/npu/model.*.
+ * Only for tools/model_profile_host.cpp; target builds use the SDK header.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef int32_t status_t;
+
+enum
+{
+    kStatus_Success = 0,
+    kStatus_Fail = 1,
+};
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/* Profiler time source on the host: monotonic nanoseconds (truncated to 32 bits). */
+uint32_t edgeai_host_now(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#define EDGEAI_MODEL_PROFILE_NOW() edgeai_host_now()
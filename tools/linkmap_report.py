@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+"""
+SRAM report from a GNU ld map file (armgcc build of the firmware).
+
+Shows per-region usage from the "Memory Configuration" table, the largest RAM consumers
+(.bss/.data and quick-access input sections) and the scratch-related buffers (render tile, TFLM arenas,
+shared scratch region). With --baseline, prints the delta against another map, for example a build with
+EDGEAI_SCRATCH_SHARED=0, and what the difference buys for the sand grid or larger render tiles.
+With --placement, lists where the hot paths tagged in src/ram_place.h landed (RAM or flash) and what the
+CodeQuickAccess / DataQuickAccess sections copy to RAM at boot; the overlay runs it after every link.
+
+  python3 tools/linkmap_report.py --map mcuxsdk_ws/build/edgeai_sand_demo_cm33_core0.map
+  python3 tools/linkmap_report.py --map shared.map --baseline separate.map
+  python3 tools/linkmap_report.py --map mcuxsdk_ws/build/edgeai_sand_demo_cm33_core0.map --placement
+"""
+
+from __future__ import annotations
+
+import argparse
+import math
+import re
+import sys
+from pathlib import Path
+
+WATCH = ["s_scratch", "s_scratchTile", "s_tile", "s_persistentArena", "s_nonPersistentArena", "s_interpStorage"]
+
+# Tagged in src/ram_place.h (a build keeps one variant of each *_fixed / *_float pair).
+HOT_CODE = [
+    "accel_proc_update", "accel_proc_update_fixed", "accel_proc_update_float",
+    "sim_step", "sim_step_fixed", "sim_step_float",
+    "sw_render_dune_bg", "sw_render_silver_ball", "sw_render_silver_ball_fixed", "sw_render_silver_ball_float",
+]
+HOT_DATA = ["g_edgeai_isqrt_seed", "g_dune_tex"]
+QUICK = ("CodeQuickAccess", "DataQuickAccess")
+# File-scope statics have no map symbol; in RAM, their object's DataQuickAccess section stands in.
+STATIC_DATA = {"g_dune_tex": "sw_render.c"}
+
+RE_REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+\S+)?\s*$")
+RAM_INPUT = r"\.(?:bss|data|noinit|ram\w*)\S*|CodeQuickAccess|DataQuickAccess"
+RE_INPUT_FULL = re.compile(rf"^ ({RAM_INPUT})\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+RE_INPUT_NAME = re.compile(rf"^ ({RAM_INPUT})\s*$")
+RE_INPUT_ADDR = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+RE_ANY_FULL = re.compile(r"^ ([^\s*]\S*)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S+)")
+RE_ANY_NAME = re.compile(r"^ ([^\s*]\S*)\s*$")
+RE_SYMBOL = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_]\w*)\s*$")
+
+
+def parse_map(path: Path):
+    regions: list[tuple[str, int, int]] = []
+    sections: list[tuple[str, int, int, str]] = []
+    lines = path.read_text(encoding="utf-8", errors="replace").splitlines()
+    mode = None
+    pending = None
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            mode = "mem"
+            continue
+        if line.startswith("Linker script and memory map"):
+            mode = "map"
+            continue
+        if mode == "mem":
+            m = RE_REGION.match(line)
+            if m and m.group(1) not in ("Name", "*default*"):
+                regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+            continue
+        if mode != "map":
+            continue
+        if pending is not None:
+            m = RE_INPUT_ADDR.match(line)
+            if m:
+                sections.append((pending, int(m.group(1), 16), int(m.group(2), 16), m.group(3)))
+            pending = None
+            continue
+        m = RE_INPUT_FULL.match(line)
+        if m:
+            sections.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16), m.group(4)))
+            continue
+        m = RE_INPUT_NAME.match(line)
+        if m:
+            pending = m.group(1)
+    return regions, [s for s in sections if s[2] > 0]
+
+
+def symbol_of(section: str) -> str:
+    # .bss.s_tile -> s_tile; file-scope C++ statics (_ZL<len><name>) are unmangled.
+    parts = section.split(".", 2)
+    sym = parts[2] if len(parts) > 2 else section
+    m = re.match(r"_ZL(\d+)(\w+)", sym)
+    if m:
+        sym = m.group(2)[: int(m.group(1))]
+    return sym
+
+
+def summarize(path: Path):
+    regions, sections = parse_map(path)
+    used = {name: 0 for name, _, _ in regions}
+    for _, addr, size, _ in sections:
+        for name, origin, length in regions:
+            if origin <= addr < origin + length:
+                used[name] += size
+                break
+    watch: dict[str, int] = {}
+    for sec, _, size, _ in sections:
+        sym = symbol_of(sec)
+        for w in WATCH:
+            if sym == w:
+                watch[w] = watch.get(w, 0) + size
+    return regions, sections, used, watch
+
+
+def is_ram(origin: int) -> bool:
+    return 0x20000000 <= origin < 0x40000000 or 0x04000000 <= origin < 0x08000000 or 0x14000000 <= origin < 0x18000000
+
+
+def parse_placement(path: Path):
+    """Every input section of the link with the global symbols defined in it: (name, addr, size, obj, syms)."""
+    sections: list[tuple[str, int, int, str, list[tuple[str, int]]]] = []
+    in_map = False
+    pending = None
+    for line in path.read_text(encoding="utf-8", errors="replace").splitlines():
+        if line.startswith("Linker script and memory map"):
+            in_map = True
+            continue
+        if not in_map:
+            continue
+        if pending is not None:
+            m = RE_INPUT_ADDR.match(line)
+            if m:
+                sections.append((pending, int(m.group(1), 16), int(m.group(2), 16), m.group(3), []))
+            pending = None
+            continue
+        m = RE_ANY_FULL.match(line)
+        if m:
+            sections.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16), m.group(4), []))
+            continue
+        m = RE_ANY_NAME.match(line)
+        if m:
+            pending = m.group(1)
+            continue
+        m = RE_SYMBOL.match(line)
+        if m and sections:
+            sections[-1][4].append((m.group(2), int(m.group(1), 16)))
+    return sections
+
+
+def region_of(regions, addr: int) -> str:
+    for name, origin, length in regions:
+        if origin <= addr < origin + length:
+            return name
+    return "?"
+
+
+def find_hot(sections, name: str):
+    """(addr, size) of a hot function or table: its map symbol, its own -ffunction/-fdata-sections input
+    section, or for a file-scope static the DataQuickAccess section of its object."""
+    for sec, addr, size, obj, syms in sections:
+        for sym, sym_addr in syms:
+            if sym == name:
+                return sym_addr, size
+    for sec, addr, size, obj, _ in sections:
+        if sec.split(".")[-1] == name and sec.startswith((".text.", ".rodata.", ".data.")):
+            return addr, size
+    if name in STATIC_DATA:
+        for sec, addr, size, obj, _ in sections:
+            if sec == "DataQuickAccess" and Path(obj).name.startswith(STATIC_DATA[name]):
+                return addr, size
+    return None
+
+
+def print_placement(path: Path, regions) -> int:
+    sections = [s for s in parse_placement(path) if s[2] > 0]
+    print("quick-access sections (copied to RAM at boot, src/ram_place.h):")
+    warn = 0
+    total = {q: 0 for q in QUICK}
+    for sec, addr, size, obj, syms in sections:
+        if sec not in QUICK:
+            continue
+        total[sec] += size
+        where = region_of(regions, addr)
+        names = ", ".join(sym for sym, _ in syms) or "(statics)"
+        print(f"  {sec:<16} 0x{addr:08x} {size:>7} B  {where:<10} [{Path(obj).name}] {names}")
+        if not is_ram(addr):
+            warn += 1
+    for q in QUICK:
+        print(f"  {q:<16} total {fmt_kb(total[q])}")
+
+    print("hot paths:")
+    for name in HOT_CODE + HOT_DATA:
+        hit = find_hot(sections, name)
+        if hit is None:
+            print(f"  {name:<28} not linked (other variant, or inlined)")
+            continue
+        addr, _ = hit
+        kind = "RAM" if is_ram(addr) else "flash"
+        print(f"  {name:<28} 0x{addr:08x}  {kind:<5} {region_of(regions, addr)}")
+    if warn:
+        print(f"warning: {warn} quick-access section(s) outside RAM; the linker script does not place "
+              "CodeQuickAccess/DataQuickAccess in .data", file=sys.stderr)
+    return 0
+
+
+def fmt_kb(n: int) -> str:
+    return f"{n:>8} B ({n / 1024:7.1f} KiB)"
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--map", required=True, help="ld map file")
+    ap.add_argument("--baseline", help="second map to diff against (e.g. EDGEAI_SCRATCH_SHARED=0)")
+    ap.add_argument("--top", type=int, default=15, help="number of largest RAM sections to list")
+    ap.add_argument("--placement", action="store_true", help="only list where the RAM-placed hot paths landed")
+    args = ap.parse_args()
+
+    regions, sections, used, watch = summarize(Path(args.map))
+    if not regions:
+        print(f"{args.map}: no Memory Configuration table found", file=sys.stderr)
+        return 1
+
+    if args.placement:
+        print(f"map: {args.map}")
+        return print_placement(Path(args.map), regions)
+
+    ram_regions = {name for name, origin, _ in regions if is_ram(origin)}
+    print(f"map: {args.map}")
+    print("RAM data (.bss/.data and quick-access input sections) per region:")
+    for name, origin, length in regions:
+        if name in ram_regions:
+            print(f"  {name:<16} 0x{origin:08x} {fmt_kb(used[name])} of {fmt_kb(length)}")
+
+    print(f"largest RAM sections (top {args.top}):")
+    for sec, addr, size, obj in sorted(sections, key=lambda s: -s[2])[: args.top]:
+        print(f"  {fmt_kb(size)}  0x{addr:08x}  {symbol_of(sec)}  [{Path(obj).name}]")
+
+    print("scratch buffers:")
+    for w in WATCH:
+        if w in watch:
+            print(f"  {w:<18} {fmt_kb(watch[w])}")
+    total_watch = sum(watch.values())
+    print(f"  {'total':<18} {fmt_kb(total_watch)}")
+
+    if args.baseline:
+        b_regions, _, b_used, b_watch = summarize(Path(args.baseline))
+        print(f"baseline: {args.baseline}")
+        for name, _, _ in regions:
+            if name in ram_regions and name in b_used:
+                d = b_used[name] - used[name]
+                print(f"  {name:<16} freed {d:+} B")
+        freed = sum(b_watch.values()) - total_watch
+        print(f"  scratch buffers freed {freed:+} B")
+        if freed > 0:
+            side = int(math.isqrt(freed // 2))
+            print(f"  buys: {freed} sand cells at 1 B/cell (e.g. {freed // 240}x240),"
+                  f" or +{freed // 2} RGB565 tile pixels (a {side}x{side} tile on its own)")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
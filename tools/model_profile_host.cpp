@@ -0,0 +1,106 @@
+/*
+ * Host per-op profile of the embedded model (src/npu/model_data.h) with TFLM reference kernels.
+ *
+ * Runs the same interpreter wrapper and profiler as the firmware (src/npu/model.cpp,
+ * src/npu/model_profiler.cpp) and prints the same report, with host nanoseconds in place of DWT
+ * cycles. NEUTRON_GRAPH has no host implementation: a placeholder kernel zero-fills its outputs, so
+ * its row only reflects the placeholder while the CPU ops (Quantize/Pad/Softmax/Dequantize/...) run
+ * their reference kernels on real shapes.
+ *
+ * Build (TFLM checkout with downloaded third-party deps and a built microlite library):
+ *   make -C $TFLM -f tensorflow/lite/micro/tools/make/Makefile microlite
+ *   g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY -DEDGEAI_MODEL_PROFILE=1 \
+ *       -Itools/host -Isrc -I$TFLM \
+ *       -I$TFLM/tensorflow/lite/micro/tools/make/downloads/flatbuffers/include \
+ *       -I$TFLM/tensorflow/lite/micro/tools/make/downloads/gemmlowp \
+ *       tools/model_profile_host.cpp src/npu/model.cpp src/npu/model_profiler.cpp \
+ *       $TFLM/gen/linux_x86_64_default_gcc/lib/libtensorflow-microlite.a -o /tmp/model_profile_host
+ *   /tmp/model_profile_host 100
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "fsl_common.h"
+#include "npu/model.h"
+
+#include "tensorflow/lite/micro/kernels/kernel_util.h"
+#include "tensorflow/lite/micro/memory_helpers.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+
+extern "C" uint32_t edgeai_host_now(void)
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static TfLiteStatus neutron_placeholder_prepare(TfLiteContext *context, TfLiteNode *node)
+{
+    (void)context;
+    (void)node;
+    return kTfLiteOk;
+}
+
+static TfLiteStatus neutron_placeholder_eval(TfLiteContext *context, TfLiteNode *node)
+{
+    for (int i = 0; i < node->outputs->size; i++)
+    {
+        TfLiteEvalTensor *out = tflite::micro::GetEvalOutput(context, node, i);
+        size_t bytes = 0;
+        if (tflite::TfLiteEvalTensorByteLength(out, &bytes) != kTfLiteOk) return kTfLiteError;
+        memset(out->data.raw, 0, bytes);
+    }
+    return kTfLiteOk;
+}
+
+/* Host replacement for src/npu/model_ops_npu.cpp: same op list, NEUTRON_GRAPH as a placeholder. */
+tflite::MicroOpResolver &EDGEAI_MODEL_GetOpsResolver()
+{
+    static tflite::MicroMutableOpResolver<8> s_microOpResolver;
+    static TFLMRegistration s_neutron =
+        tflite::micro::RegisterOp(nullptr, neutron_placeholder_prepare, neutron_placeholder_eval);
+
+    s_microOpResolver.AddDepthwiseConv2D();
+    s_microOpResolver.AddDequantize();
+    s_microOpResolver.AddPad();
+    s_microOpResolver.AddQuantize();
+    s_microOpResolver.AddReshape();
+    s_microOpResolver.AddSlice();
+    s_microOpResolver.AddSoftmax();
+    s_microOpResolver.AddCustom("NEUTRON_GRAPH", &s_neutron);
+
+    return s_microOpResolver;
+}
+
+int main(int argc, char **argv)
+{
+    int runs = (argc > 1) ? atoi(argv[1]) : 100;
+    if (runs < 1) runs = 1;
+
+    if (EDGEAI_MODEL_Init() != kStatus_Success)
+    {
+        fprintf(stderr, "model init failed\n");
+        return 1;
+    }
+
+    edgeai_tensor_dims_t dims;
+    edgeai_tensor_type_t type;
+    uint8_t *in = EDGEAI_MODEL_GetInputTensorData(&dims, &type);
+    for (int r = 0; r < runs; r++)
+    {
+        uint32_t n = 1;
+        for (uint32_t i = 0; i < dims.size; i++) n *= dims.data[i];
+        for (uint32_t i = 0; i < n; i++) in[i] = (uint8_t)(i * 7u + (uint32_t)r);
+        if (EDGEAI_MODEL_RunInference() != kStatus_Success)
+        {
+            fprintf(stderr, "invoke %d failed\n", r);
+            return 1;
+        }
+    }
+
+    printf("host units: ns (firmware reports DWT cycles)\n");
+    EDGEAI_MODEL_PrintProfile(printf);
+    return 0;
+}
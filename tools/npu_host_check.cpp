@@ -0,0 +1,388 @@
+/*
+ * Host regression and profile of the NPU glue with the host backend (EDGEAI_NPU_BACKEND=2).
+ *
+ * Runs the firmware's own npu_api.c pipeline (submit -> poll -> on_result) and TFLM glue
+ * (src/npu_backend_neutron.cpp, src/npu/model.cpp) on TFLM reference kernels, with the CPU-equivalent
+ * graph of the embedded model (the .tflite fed to the Neutron converter):
+ *   - records: replays `EDGEAI: npu_rec` lines captured from the board UART (EDGEAI_NPU_RECORD=N build)
+ *     with their recorded input tensor, and compares the output tensor byte for byte (max |diff| within
+ *     --tol, same argmax, same glint). Exit status 1 on any mismatch.
+ *   - profile: --runs jobs with the speed-pattern packing path; reports the cost per job of Invoke alone
+ *     and of packing + output reduction + recording around it.
+ *   - --write-records: writes the host results in the same line format (a reference set to diff against).
+ *   - switch: loads a second registry slot ("aux", --model2 or the same graph) and runs the selection
+ *     sequence 0 -> 1 -> 0 -> 1 -> 0 with an inference on each visit; only the first visit of a model may
+ *     allocate, and model 0's output must be byte-identical after the round trip. Both slots share the
+ *     persistent arena, so this also shows that model 0 fits half of EDGEAI_MODEL_PERSISTENT_BYTES.
+ *
+ * Build (TFLM checkout with a built microlite library, as for tools/model_profile_host.cpp):
+ *   D="-DEDGEAI_NPU_BACKEND=2 -DEDGEAI_ENABLE_NPU_INFERENCE=1 -DEDGEAI_NPU_ASYNC_DEFER_IRQ=0 -DEDGEAI_NPU_RECORD=1"
+ *   for f in npu_api npu_backend_stub postfx scratch_arena tensor_util; do
+ *     cc -O2 -std=c11 $D -Itools/host -Isrc -c src/$f.c -o /tmp/$f.o; done
+ *   g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY $D -Itools/host -Isrc -I$TFLM \
+ *       -I$TFLM/tensorflow/lite/micro/tools/make/downloads/flatbuffers/include \
+ *       -I$TFLM/tensorflow/lite/micro/tools/make/downloads/gemmlowp \
+ *       tools/npu_host_check.cpp src/npu_backend_neutron.cpp src/npu/model.cpp src/npu/model_profiler.cpp \
+ *       src/npu/model_ops_host.cpp /tmp/npu_api.o /tmp/npu_backend_stub.o /tmp/postfx.o /tmp/scratch_arena.o \
+ *       /tmp/tensor_util.o \
+ *       $TFLM/gen/linux_x86_64_default_gcc/lib/libtensorflow-microlite.a -o /tmp/npu_host_check
+ * Run:
+ *   /tmp/npu_host_check --model ds_cnn_cpu.tflite --records uart.log [--model2 other.tflite] [--tol 1] [--runs 200]
+ */
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "fsl_common.h"
+#include "npu/model.h"
+#include "npu_api.h"
+
+#if !EDGEAI_NPU_RECORD || EDGEAI_NPU_ASYNC_DEFER_IRQ || (EDGEAI_NPU_BACKEND != 2)
+#error "build with -DEDGEAI_NPU_BACKEND=2 -DEDGEAI_NPU_ASYNC_DEFER_IRQ=0 -DEDGEAI_NPU_RECORD=1"
+#endif
+
+extern "C" uint32_t edgeai_host_now(void)
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/* Deferred-context hooks: jobs run from edgeai_npu_poll on the host. */
+extern "C" void edgeai_npu_defer_init(edgeai_npu_state_t *s)
+{
+    (void)s;
+}
+
+extern "C" void edgeai_npu_defer_kick(void)
+{
+}
+
+extern "C" uint32_t edgeai_npu_defer_now(void)
+{
+    return edgeai_host_now();
+}
+
+typedef struct
+{
+    unsigned seq;
+    unsigned glint;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> out;
+} check_record_t;
+
+static std::vector<uint8_t> s_last_out;
+static bool s_out_signed = false;
+
+static void check_on_result(edgeai_npu_state_t *s, void *user)
+{
+    (void)user;
+    edgeai_npu_tensor_view_t v;
+    if (!edgeai_npu_output_view(s, &v)) return;
+    s_last_out.assign(v.data, v.data + (size_t)v.w * v.h * v.c);
+    s_out_signed = v.is_signed;
+}
+
+static bool check_hex(const char *p, std::vector<uint8_t> *out)
+{
+    out->clear();
+    while (p[0] && p[1] && p[0] != ' ' && p[0] != '\r' && p[0] != '\n')
+    {
+        unsigned b = 0;
+        if (sscanf(p, "%2x", &b) != 1) return false;
+        out->push_back((uint8_t)b);
+        p += 2;
+    }
+    return !out->empty();
+}
+
+static bool check_load_records(const char *path, std::vector<check_record_t> *recs)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    std::string line;
+    char buf[4096];
+    while (fgets(buf, sizeof(buf), f))
+    {
+        line += buf;
+        if (line.empty() || line.back() != '\n') continue; /* long line: keep reading */
+        const char *p = strstr(line.c_str(), "npu_rec ");
+        const char *pi = strstr(line.c_str(), " in=");
+        const char *po = strstr(line.c_str(), " out=");
+        check_record_t r;
+        if (p && pi && po && sscanf(p, "npu_rec %u glint=%u", &r.seq, &r.glint) == 2 && check_hex(pi + 4, &r.in) &&
+            check_hex(po + 5, &r.out))
+        {
+            recs->push_back(r);
+        }
+        line.clear();
+    }
+    fclose(f);
+    return true;
+}
+
+static bool check_run(edgeai_npu_state_t *s, const edgeai_npu_input_t *in, edgeai_npu_output_t *out)
+{
+    if (!edgeai_npu_submit(s, in)) return false;
+    return edgeai_npu_poll(s, out);
+}
+
+static uint32_t check_input_bytes(void)
+{
+    edgeai_tensor_dims_t d;
+    edgeai_tensor_type_t t;
+    if (!EDGEAI_MODEL_GetInputTensorData(&d, &t)) return 0;
+    uint32_t n = (t == kEdgeAiTensorType_FLOAT32) ? 4u : 1u;
+    for (uint32_t i = 0; i < d.size; i++) n *= d.data[i];
+    return n;
+}
+
+/* Selection sequence 0 -> 1 -> 0 -> 1 -> 0; model 1 runs on each visit, so its plan overwrites the shared
+ * non-persistent arena in between model 0's runs.
+ */
+static bool check_switch(edgeai_npu_state_t *s)
+{
+    const edgeai_npu_input_t in = {23 << 16, 7 << 16, false};
+    edgeai_npu_output_t out;
+    if (!check_run(s, &in, &out))
+    {
+        printf("switch: model 0 run failed\n");
+        return false;
+    }
+    const std::vector<uint8_t> ref = s_last_out;
+    const edgeai_model_switch_stats_t *ms = EDGEAI_MODEL_GetSwitchStats();
+    const uint32_t loads0 = ms->loads, switches0 = ms->switches;
+    uint32_t arena_used[2] = {EDGEAI_MODEL_GetProfile()->arena_used_bytes, 0};
+    uint32_t arena_size[2] = {EDGEAI_MODEL_GetProfile()->arena_size_bytes, 0};
+
+    static const uint32_t seq[] = {1u, 0u, 1u, 0u};
+    for (uint32_t id : seq)
+    {
+        if (!edgeai_npu_select_model(s, id))
+        {
+            printf("switch: selecting %s failed\n", EDGEAI_MODEL_GetName(id));
+            return false;
+        }
+        if (id == 1u)
+        {
+            edgeai_tensor_dims_t d;
+            edgeai_tensor_type_t t;
+            memset(EDGEAI_MODEL_GetInputTensorData(&d, &t), 0x5A, check_input_bytes());
+            if (EDGEAI_MODEL_RunInference() != kStatus_Success)
+            {
+                printf("switch: %s run failed\n", EDGEAI_MODEL_GetName(id));
+                return false;
+            }
+            arena_used[1] = EDGEAI_MODEL_GetProfile()->arena_used_bytes;
+            arena_size[1] = EDGEAI_MODEL_GetProfile()->arena_size_bytes;
+        }
+    }
+    if (!check_run(s, &in, &out))
+    {
+        printf("switch: model 0 run failed after the round trip\n");
+        return false;
+    }
+
+    const uint32_t loads = ms->loads - loads0, switches = ms->switches - switches0;
+    const bool same = (s_last_out == ref);
+    printf("switch: %s arena %u/%u B, %s arena %u/%u B, loads %u (load %u / %u ns), switches %u "
+           "(last %u ns, max %u ns), model 0 output %s after the round trip\n",
+           EDGEAI_MODEL_GetName(0), arena_used[0], arena_size[0], EDGEAI_MODEL_GetName(1), arena_used[1],
+           arena_size[1], loads, ms->load_cyc[0], ms->load_cyc[1], switches, ms->last_switch_cyc, ms->max_switch_cyc,
+           same ? "identical" : "CHANGED");
+    return (loads == 1u) && (switches == 3u) && same;
+}
+
+static FILE *s_rec_file = nullptr;
+
+static int check_rec_print(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vfprintf(s_rec_file, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+static std::vector<uint8_t> check_read_file(const char *path)
+{
+    std::vector<uint8_t> data;
+    FILE *f = fopen(path, "rb");
+    if (!f) return data;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (sz > 0)
+    {
+        data.resize((size_t)sz);
+        if (fread(data.data(), 1, data.size(), f) != data.size()) data.clear();
+    }
+    fclose(f);
+    return data;
+}
+
+/* The flatbuffer must outlive the interpreter; 16-byte aligned like the embedded array. */
+static uint8_t *check_load_model(const char *path)
+{
+    std::vector<uint8_t> raw = check_read_file(path);
+    if (raw.empty())
+    {
+        fprintf(stderr, "cannot read %s\n", path);
+        return nullptr;
+    }
+    uint8_t *data = static_cast<uint8_t *>(aligned_alloc(16, (raw.size() + 15u) & ~(size_t)15u));
+    memcpy(data, raw.data(), raw.size());
+    return data;
+}
+
+int main(int argc, char **argv)
+{
+    const char *model = nullptr;
+    const char *model2 = nullptr;
+    const char *records = nullptr;
+    const char *write_records = nullptr;
+    int tol = 1;
+    int runs = 200;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--model")) model = argv[i + 1];
+        else if (!strcmp(argv[i], "--model2")) model2 = argv[i + 1];
+        else if (!strcmp(argv[i], "--records")) records = argv[i + 1];
+        else if (!strcmp(argv[i], "--write-records")) write_records = argv[i + 1];
+        else if (!strcmp(argv[i], "--tol")) tol = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--runs")) runs = atoi(argv[i + 1]);
+    }
+    if (!model)
+    {
+        fprintf(stderr, "usage: %s --model cpu.tflite [--model2 cpu2.tflite] [--records uart.log] [--tol N] "
+                        "[--runs N] [--write-records out.log]\n", argv[0]);
+        return 2;
+    }
+
+    uint8_t *model_data = check_load_model(model);
+    uint8_t *model2_data = model2 ? check_load_model(model2) : model_data;
+    if (!model_data || !model2_data) return 1;
+
+    /* Both slots are set before init, so the persistent arena is split between them. */
+    static edgeai_npu_state_t npu;
+    if (EDGEAI_MODEL_SetData(0u, model_data) != kStatus_Success ||
+        EDGEAI_MODEL_SetData(1u, model2_data) != kStatus_Success || !edgeai_npu_init(&npu))
+    {
+        fprintf(stderr, "host backend init failed (CPU-equivalent graph with ops from npu/model_ops_host.cpp? "
+                        "model 0 gets half of EDGEAI_MODEL_PERSISTENT_BYTES here)\n");
+        return 1;
+    }
+    npu.on_result = check_on_result;
+
+    int failures = 0;
+    if (!check_switch(&npu)) failures++;
+
+    edgeai_npu_tensor_view_t iv;
+    if (!edgeai_npu_input_view(&npu, &iv))
+    {
+        fprintf(stderr, "input tensor is not quantized\n");
+        return 1;
+    }
+    const size_t in_bytes = (size_t)iv.w * iv.h * iv.c;
+    printf("model %s: input %ux%ux%u %s scale=%g zp=%d\n", model, iv.w, iv.h, iv.c, iv.is_signed ? "int8" : "uint8",
+           (double)iv.scale, (int)iv.zero_point);
+
+    if (records)
+    {
+        std::vector<check_record_t> recs;
+        if (!check_load_records(records, &recs))
+        {
+            fprintf(stderr, "cannot open %s\n", records);
+            return 1;
+        }
+        unsigned exact = 0, argmax_ok = 0, glint_ok = 0;
+        int worst = 0;
+        for (const check_record_t &r : recs)
+        {
+            if (r.in.size() != in_bytes)
+            {
+                printf("rec %u: input %zu bytes, tensor has %zu\n", r.seq, r.in.size(), in_bytes);
+                failures++;
+                continue;
+            }
+            memcpy(iv.data, r.in.data(), in_bytes);
+            edgeai_npu_input_t in = {0, 0, true};
+            edgeai_npu_output_t out;
+            if (!check_run(&npu, &in, &out) || s_last_out.size() < r.out.size())
+            {
+                printf("rec %u: run failed\n", r.seq);
+                failures++;
+                continue;
+            }
+
+            int max_diff = 0;
+            size_t am_host = 0, am_rec = 0;
+            for (size_t i = 0; i < r.out.size(); i++)
+            {
+                int a = s_out_signed ? (int)(int8_t)s_last_out[i] : (int)s_last_out[i];
+                int b = s_out_signed ? (int)(int8_t)r.out[i] : (int)r.out[i];
+                int d = abs(a - b);
+                if (d > max_diff) max_diff = d;
+                int ah = s_out_signed ? (int)(int8_t)s_last_out[am_host] : (int)s_last_out[am_host];
+                int ar = s_out_signed ? (int)(int8_t)r.out[am_rec] : (int)r.out[am_rec];
+                if (a > ah) am_host = i;
+                if (b > ar) am_rec = i;
+            }
+            exact += (max_diff == 0) ? 1u : 0u;
+            argmax_ok += (am_host == am_rec) ? 1u : 0u;
+            glint_ok += (out.glint == r.glint) ? 1u : 0u;
+            if (max_diff > worst) worst = max_diff;
+            if (max_diff > tol || am_host != am_rec)
+            {
+                printf("rec %u: max |diff| %d, argmax host %zu target %zu, glint host %u target %u\n", r.seq, max_diff,
+                       am_host, am_rec, out.glint, r.glint);
+                failures++;
+            }
+        }
+        printf("records: %zu, exact %u, argmax match %u, glint match %u, worst |diff| %d (tol %d)\n", recs.size(),
+               exact, argmax_ok, glint_ok, worst, tol);
+    }
+
+    if (write_records)
+    {
+        s_rec_file = fopen(write_records, "w");
+        if (!s_rec_file)
+        {
+            fprintf(stderr, "cannot open %s\n", write_records);
+            return 1;
+        }
+    }
+
+    /* Profile: the full job (speed-pattern packing, Invoke, reduction, recording) against Invoke alone. */
+    uint64_t job_ns = 0, invoke_ns = 0;
+    for (int r = 0; r < runs; r++)
+    {
+        edgeai_npu_input_t in = {(int32_t)((r * 37) % 90) << 16, (int32_t)((r * 11) % 40) << 16, false};
+        edgeai_npu_output_t out;
+        uint32_t t0 = edgeai_host_now();
+        bool ok = check_run(&npu, &in, &out);
+        uint32_t t1 = edgeai_host_now();
+        bool ok2 = (EDGEAI_MODEL_RunInference() == kStatus_Success);
+        uint32_t t2 = edgeai_host_now();
+        if (!ok || !ok2)
+        {
+            fprintf(stderr, "job %d failed\n", r);
+            return 1;
+        }
+        job_ns += t1 - t0;
+        invoke_ns += t2 - t1;
+        if (s_rec_file) (void)edgeai_npu_record_print(&npu, check_rec_print);
+    }
+    if (s_rec_file) fclose(s_rec_file);
+    if (runs > 0)
+    {
+        double job = (double)job_ns / runs, inv = (double)invoke_ns / runs;
+        printf("profile: %d jobs, job %.0f ns, invoke %.0f ns, packing + reduction + pipeline %.0f ns (%.1f%%)\n", runs,
+               job, inv, job - inv, job > 0.0 ? 100.0 * (job - inv) / job : 0.0);
+    }
+    return failures ? 1 : 0;
+}
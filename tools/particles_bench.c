@@ -0,0 +1,139 @@
+/*
+ * Host check and cost of the pooled spray particles (src/particles.h).
+ *
+ * - Pool: bursts, steps and the cap churn the free list for many frames; every slot must stay either live
+ *   or free, exactly once. Also reports the largest redraw rectangle of a single burst.
+ * - Cap: a burst over `frame_max` is cut back to the cap on the next step, oldest first.
+ * - Cost: ns per particle for the batch step and the batch draw into a tile, at several live counts
+ *   (topped up every frame so the count holds).
+ *
+ * Build and run (a larger pool so the sweep can go past the default capacity):
+ *   cc -O2 -std=c11 -Isrc -DEDGEAI_PARTICLES_MAX=1024 tools/particles_bench.c src/particles.c -o /tmp/particles_bench && /tmp/particles_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "edgeai_config.h"
+#include "particles.h"
+
+#define BENCH_FRAMES 2000
+#define BENCH_DT_Q16 ((int32_t)((1u << 16) / 60u))
+
+static edgeai_particles_t s_p;
+static uint16_t s_tile[EDGEAI_TILE_MAX_W * EDGEAI_TILE_MAX_H];
+
+static int pool_consistent(const edgeai_particles_t *p)
+{
+    static uint8_t seen[EDGEAI_PARTICLES_MAX];
+    memset(seen, 0, sizeof(seen));
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < p->live_n; i++, n++)
+    {
+        if (p->live[i] >= EDGEAI_PARTICLES_MAX || seen[p->live[i]]++) return 0;
+    }
+    for (uint32_t s = p->free_head; s < EDGEAI_PARTICLES_MAX; s = p->next_free[s], n++)
+    {
+        if (seen[s]++) return 0;
+    }
+    return n == EDGEAI_PARTICLES_MAX;
+}
+
+static int pool_check(void)
+{
+    edgeai_particles_init(&s_p, 0x1234u);
+    s_p.frame_max = EDGEAI_PARTICLES_MAX / 2;
+    uint32_t rng = 0xACE1u;
+    int ok = 1;
+    for (int f = 0; f < BENCH_FRAMES && ok; f++)
+    {
+        rng = rng * 1664525u + 1013904223u;
+        if ((rng >> 28) < 3u)
+        {
+            int32_t x = (int32_t)((rng >> 8) % EDGEAI_LCD_W) << 16;
+            int32_t y = (int32_t)((rng >> 4) % EDGEAI_LCD_H) << 16;
+            (void)edgeai_particles_burst(&s_p, x, y, (int32_t)(rng & 0x3FFu) << 16, -(200 << 16), 96u);
+        }
+        edgeai_particles_step(&s_p, BENCH_DT_Q16, 0, 400 << 16);
+        edgeai_particles_mark_drawn(&s_p);
+        ok &= pool_consistent(&s_p);
+    }
+    printf("pool: %u spawned, %u dropped, %u retired early over %d frames: %s\n", s_p.spawned, s_p.dropped,
+           s_p.retired, BENCH_FRAMES, ok ? "consistent" : "BROKEN");
+    return ok ? 0 : 1;
+}
+
+/* Largest redraw rectangle of one full-gain burst over its life (renderer tiles beyond one tile). */
+static void burst_extent(void)
+{
+    edgeai_particles_init(&s_p, 0x1234u);
+    (void)edgeai_particles_burst(&s_p, 240 << 16, 160 << 16, EDGEAI_BANG_GAIN_Q16, 0, EDGEAI_PARTICLES_PER_BANG);
+    int32_t w_max = 0, h_max = 0;
+    while (s_p.live_n > 0u)
+    {
+        edgeai_particles_step(&s_p, BENCH_DT_Q16, 0, 0);
+        int32_t x0, y0, x1, y1;
+        if (edgeai_particles_dirty_rect(&s_p, &x0, &y0, &x1, &y1))
+        {
+            if (x1 - x0 + 1 > w_max) w_max = x1 - x0 + 1;
+            if (y1 - y0 + 1 > h_max) h_max = y1 - y0 + 1;
+        }
+        edgeai_particles_mark_drawn(&s_p);
+    }
+    printf("one burst (%d particles, full gain): redraw rect up to %dx%d (tile %dx%d)\n", EDGEAI_PARTICLES_PER_BANG,
+           w_max, h_max, EDGEAI_TILE_MAX_W, EDGEAI_TILE_MAX_H);
+}
+
+static int cap_check(void)
+{
+    edgeai_particles_init(&s_p, 0x1234u);
+    s_p.frame_max = 64;
+    uint32_t made = edgeai_particles_burst(&s_p, 240 << 16, 160 << 16, 150 << 16, 0, 100u);
+    made += edgeai_particles_burst(&s_p, 240 << 16, 160 << 16, -(150 << 16), 0, 100u);
+    edgeai_particles_step(&s_p, BENCH_DT_Q16, 0, 0);
+    printf("cap 64: %u spawned, %u live after one step, %u retired\n", made, s_p.live_n, s_p.retired);
+    return (s_p.live_n <= 64u && pool_consistent(&s_p)) ? 0 : 1;
+}
+
+static void cost(uint32_t count)
+{
+    edgeai_particles_init(&s_p, 0x1234u);
+    s_p.frame_max = (uint16_t)count;
+    double t_step = 0.0, t_draw = 0.0;
+    uint64_t stepped = 0;
+    const int32_t x0 = 140, y0 = 60;
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        if (s_p.live_n < count)
+        {
+            (void)edgeai_particles_burst(&s_p, 240 << 16, 160 << 16, 120 << 16, 80 << 16, count - s_p.live_n);
+        }
+        stepped += s_p.live_n;
+        double t0 = bench_now_s();
+        edgeai_particles_step(&s_p, BENCH_DT_Q16, 0, 200 << 16);
+        double t1 = bench_now_s();
+        edgeai_particles_draw(&s_p, s_tile, EDGEAI_TILE_MAX_W, EDGEAI_TILE_MAX_H, x0, y0);
+        double t2 = bench_now_s();
+        edgeai_particles_mark_drawn(&s_p);
+        t_step += t1 - t0;
+        t_draw += t2 - t1;
+    }
+    double per = (double)stepped;
+    printf("%5u live: step %.1f ns/particle (%.1f us/frame), draw %.1f ns/particle (%.1f us/frame)\n", count,
+           t_step * 1e9 / per, t_step * 1e6 / BENCH_FRAMES, t_draw * 1e9 / per, t_draw * 1e6 / BENCH_FRAMES);
+}
+
+int main(void)
+{
+    printf("pool %d slots, %u bytes, life %d frames\n", EDGEAI_PARTICLES_MAX, (unsigned)sizeof(edgeai_particles_t),
+           EDGEAI_PARTICLES_LIFE);
+    int rc = pool_check();
+    rc |= cap_check();
+    burst_extent();
+    for (uint32_t n = 64; n <= EDGEAI_PARTICLES_MAX; n *= 2) cost(n);
+    return rc;
+}
@@ -33,5 +33,5 @@ fi
 # before adding new files).
 if [[ -f "$EDGEAI_CMAKELISTS" ]]; then
   echo "[patch] fix: normalize edgeai_sand_demo CMakeLists sources"
-  perl -0777 -pi -e 's|(mcux_add_source\\(\\s+BASE_PATH \\$\\{EDGEAI_ROOT\\}\\s+SOURCES)(.*?)(\\)\\s+mcux_add_include)|$1\\n            src\\/edgeai_sand_demo\\.c\\n            src\\/text5x7\\.c\\n            src\\/accel_proc\\.c\\n            src\\/sim_world\\.c\\n            src\\/render_world\\.c\\n            src\\/npu_api\\.c\\n            src\\/npu_backend_stub\\.c\\n            src\\/npu_backend_neutron\\.cpp\\n            src\\/sand_sim\\.c\\n            src\\/water_sim\\.c\\n            src\\/fxls8974cf\\.c\\n            src\\/par_lcd_s035\\.c\\n            src\\/sw_render\\.c\\n            src\\/npu\\/model\\.cpp\\n            src\\/npu\\/model_ops_npu\\.cpp\\n)\\n\\nmcux_add_include|ms' "$EDGEAI_CMAKELISTS" || true
+  perl -0777 -pi -e 's|(mcux_add_source\\(\\s+BASE_PATH \\$\\{EDGEAI_ROOT\\}\\s+SOURCES)(.*?)(\\)\\s+mcux_add_include)|$1\\n            src\\/edgeai_sand_demo\\.c\\n            src\\/edgeai_math\\.c\\n            src\\/text5x7\\.c\\n            src\\/accel_proc\\.c\\n            src\\/gesture\\.c\\n            src\\/sim_world\\.c\\n            src\\/sim_record\\.c\\n            src\\/fpu_ab\\.c\\n            src\\/ram_place\\.c\\n            src\\/ball_grid\\.c\\n            src\\/terrain\\.c\\n            src\\/dune_live\\.c\\n            src\\/render_world\\.c\\n            src\\/particles\\.c\\n            src\\/scratch_arena\\.c\\n            src\\/scene_capture\\.c\\n            src\\/postfx\\.c\\n            src\\/npu_api\\.c\\n            src\\/npu_defer\\.c\\n            src\\/npu_backend_stub\\.c\\n            src\\/npu_backend_neutron\\.cpp\\n            src\\/sand_sim\\.c\\n            src\\/sand_surrogate\\.c\\n            src\\/tensor_util\\.c\\n            src\\/water_sim\\.c\\n            src\\/fxls8974cf\\.c\\n            src\\/par_lcd_s035\\.c\\n            src\\/sw_render\\.c\\n            src\\/latency_hist\\.c\\n            src\\/telemetry\\.c\\n            src\\/telemetry_uart\\.c\\n            src\\/npu\\/model\\.cpp\\n            src\\/npu\\/model_profiler\\.cpp\\n            src\\/npu\\/model_ops_npu\\.cpp\\n)\\n\\nmcux_add_include|ms' "$EDGEAI_CMAKELISTS" || true
 fi
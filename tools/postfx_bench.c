@@ -0,0 +1,119 @@
+/*
+ * Host benchmark for the post-process composite (src/postfx.h).
+ *
+ * Compares the two ways the effect map is produced each inference period:
+ *   cpu: stub backend path; CPU reference effect + load + composite
+ *   npu: Neutron path; load of a quantized int8 output tensor + composite (the effect runs on the NPU)
+ * Both are fed the same image; the npu path uses the reference quantized to int8, so the composited
+ * tiles must match bit for bit.
+ *
+ * Build and run:
+ *   cc -O2 -std=c11 -Isrc tools/postfx_bench.c src/postfx.c src/tensor_util.c -o /tmp/postfx_bench && /tmp/postfx_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "edgeai_config.h"
+#include "postfx.h"
+
+#define BENCH_MAP_W 80u
+#define BENCH_MAP_H 60u
+#define BENCH_ITERS 2000
+
+static uint8_t s_lum[BENCH_MAP_W * BENCH_MAP_H];
+static uint8_t s_ref[BENCH_MAP_W * BENCH_MAP_H];
+static uint8_t s_q8[BENCH_MAP_W * BENCH_MAP_H];
+static uint16_t s_tile_cpu[EDGEAI_TILE_MAX_W * EDGEAI_TILE_MAX_H];
+static uint16_t s_tile_npu[EDGEAI_TILE_MAX_W * EDGEAI_TILE_MAX_H];
+static edgeai_postfx_t s_fx;
+
+static void fill_scene(void)
+{
+    /* Dune-like gradient with a bright ball near the center. */
+    for (uint32_t y = 0; y < BENCH_MAP_H; y++)
+    {
+        for (uint32_t x = 0; x < BENCH_MAP_W; x++)
+        {
+            int32_t v = 90 + (int32_t)((x * 40u) / BENCH_MAP_W) + (int32_t)((y * 30u) / BENCH_MAP_H);
+            int32_t dx = (int32_t)x - 40, dy = (int32_t)y - 30;
+            if (dx * dx + dy * dy < 36) v = 240 - (dx * dx + dy * dy);
+            s_lum[y * BENCH_MAP_W + x] = (uint8_t)v;
+        }
+    }
+}
+
+static void fill_tile(uint16_t *t, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) t[i] = (uint16_t)(0x8410u + (i & 0x0F0Fu));
+}
+
+static uint32_t fnv1a(const uint16_t *p, uint32_t n)
+{
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        h = (h ^ (p[i] & 0xFFu)) * 16777619u;
+        h = (h ^ (p[i] >> 8)) * 16777619u;
+    }
+    return h;
+}
+
+int main(void)
+{
+    const uint32_t tw = EDGEAI_TILE_MAX_W, th = EDGEAI_TILE_MAX_H;
+    const int32_t x0 = (EDGEAI_LCD_W - (int32_t)tw) / 2, y0 = (EDGEAI_LCD_H - (int32_t)th) / 2;
+    const uint32_t n = tw * th;
+    fill_scene();
+
+    edgeai_npu_tensor_view_t vu8 = {s_ref, BENCH_MAP_W, BENCH_MAP_H, 1, false, 1.0f / 255.0f, 0};
+    edgeai_npu_tensor_view_t vi8 = {s_q8, BENCH_MAP_W, BENCH_MAP_H, 1, true, 1.0f / 255.0f, -128};
+
+    /* int8 output tensor carrying the reference effect, as the NPU would produce it. */
+    edgeai_postfx_reference(EDGEAI_POSTFX_MODE, s_lum, BENCH_MAP_W, BENCH_MAP_H, s_ref);
+    for (uint32_t i = 0; i < BENCH_MAP_W * BENCH_MAP_H; i++) s_q8[i] = (uint8_t)(int8_t)((int32_t)s_ref[i] - 128);
+
+    edgeai_postfx_init(&s_fx, EDGEAI_POSTFX_MODE, EDGEAI_POSTFX_GLOW_RGB565);
+
+    double t0 = bench_now_s();
+    for (int it = 0; it < BENCH_ITERS; it++)
+    {
+        fill_tile(s_tile_cpu, n);
+        edgeai_postfx_reference(EDGEAI_POSTFX_MODE, s_lum, BENCH_MAP_W, BENCH_MAP_H, s_ref);
+        (void)edgeai_postfx_load(&s_fx, &vu8);
+        edgeai_postfx_composite(&s_fx, s_tile_cpu, tw, th, x0, y0);
+    }
+    double t_cpu = (bench_now_s() - t0) / BENCH_ITERS;
+
+    t0 = bench_now_s();
+    for (int it = 0; it < BENCH_ITERS; it++)
+    {
+        fill_tile(s_tile_npu, n);
+        (void)edgeai_postfx_load(&s_fx, &vi8);
+        edgeai_postfx_composite(&s_fx, s_tile_npu, tw, th, x0, y0);
+    }
+    double t_npu = (bench_now_s() - t0) / BENCH_ITERS;
+
+    /* Split out the composite alone (common to both paths). */
+    t0 = bench_now_s();
+    for (int it = 0; it < BENCH_ITERS; it++)
+    {
+        fill_tile(s_tile_npu, n);
+        edgeai_postfx_composite(&s_fx, s_tile_npu, tw, th, x0, y0);
+    }
+    double t_comp = (bench_now_s() - t0) / BENCH_ITERS;
+
+    uint32_t h_cpu = fnv1a(s_tile_cpu, n);
+    uint32_t h_npu = fnv1a(s_tile_npu, n);
+    printf("postfx map=%ux%u tile=%ux%u mode=%d iters=%d\n", BENCH_MAP_W, BENCH_MAP_H, (unsigned)tw, (unsigned)th,
+           (int)EDGEAI_POSTFX_MODE, BENCH_ITERS);
+    printf("cpu path: %8.2f us/frame (reference + load + composite)\n", t_cpu * 1e6);
+    printf("npu path: %8.2f us/frame (load + composite)\n", t_npu * 1e6);
+    printf("composite only: %8.2f us/frame\n", t_comp * 1e6);
+    printf("tile hash cpu=%08x npu=%08x %s\n", (unsigned)h_cpu, (unsigned)h_npu, (h_cpu == h_npu) ? "match" : "MISMATCH");
+    return (h_cpu == h_npu) ? 0 : 1;
+}
@@ -0,0 +1,377 @@
+/*
+ * Host comparison of the surrogate sand step (src/sand_surrogate.h) against the CPU rule (src/sand_sim.h).
+ *
+ * Replays deterministic scenes (pile, walls, scattered fill) under a rotating gravity sequence and reports:
+ *   - error band: one-step cell mismatch (share of cells in active patches) and grain drift of the
+ *     surrogate step against the CPU step from the same grid, next to the CPU-vs-CPU band with a
+ *     different PRNG seed (the rule's own randomness, i.e. the floor any model can reach)
+ *   - fallback reasons (overflow: more patches than one batch; rejected: runner failure or drift)
+ *   - throughput in active cells per millisecond for both paths (surrogate: gather + run + scatter)
+ *
+ * Runners:
+ *   reference  the CPU rule applied inside each patch, borders as walls (edgeai_sand_surrogate_run_reference)
+ *   tflite     a .tflite model through TFLM reference kernels (needs -DEDGEAI_HOST_TFLM=1); input
+ *              [B,10,10,3] int8 and output [B,8,8,1] int8, requantized from the tensor scale/zero point;
+ *              a batch larger than B runs as several invokes
+ *
+ * Build and run (CPU reference only):
+ *   cc -O2 -std=c11 -Isrc -c src/sand_sim.c -o /tmp/sand_sim.o
+ *   cc -O2 -std=c11 -Isrc -c src/sand_surrogate.c -o /tmp/sand_surrogate.o
+ *   g++ -O2 -std=c++17 -Isrc tools/sand_surrogate_host.cpp /tmp/sand_sim.o /tmp/sand_surrogate.o \
+ *       -o /tmp/sand_surrogate_host
+ *   /tmp/sand_surrogate_host [steps]
+ * With a model (TFLM checkout and microlite library as in tools/model_profile_host.cpp):
+ *   g++ -O2 -std=c++17 -DTF_LITE_STATIC_MEMORY -DEDGEAI_HOST_TFLM=1 -Isrc -I$TFLM \
+ *       -I$TFLM/tensorflow/lite/micro/tools/make/downloads/flatbuffers/include \
+ *       -I$TFLM/tensorflow/lite/micro/tools/make/downloads/gemmlowp \
+ *       tools/sand_surrogate_host.cpp /tmp/sand_sim.o /tmp/sand_surrogate.o \
+ *       $TFLM/gen/linux_x86_64_default_gcc/lib/libtensorflow-microlite.a -o /tmp/sand_surrogate_host
+ *   /tmp/sand_surrogate_host [steps] --model sand_patch.tflite
+ * Training pairs (gathered input patch, reference-runner output) for offline training:
+ *   /tmp/sand_surrogate_host [steps] --dump pairs.bin
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "sand_sim.h"
+#include "sand_surrogate.h"
+}
+
+#if EDGEAI_HOST_TFLM
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#endif
+
+#define HOST_GRAVITY_PERIOD 40
+#define HOST_WINDOWS_MAX ((EDGEAI_SAND_PATCH_COLS + 1) * (EDGEAI_SAND_PATCH_ROWS + 1))
+
+static double now_ms(void)
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static const sand_gravity_t s_gravity_seq[] = {
+    {0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1},
+};
+
+static sand_gravity_t host_gravity(uint32_t step)
+{
+    return s_gravity_seq[(step / HOST_GRAVITY_PERIOD) % (sizeof(s_gravity_seq) / sizeof(s_gravity_seq[0]))];
+}
+
+static void host_scene(sand_grid_t *g, int scene)
+{
+    sand_sim_init(g, 0x1234u + (uint32_t)scene);
+    switch (scene)
+    {
+        case 0: /* one pile */
+            sand_sim_fill_rect(g, 30, 5, 90, 40, kEdgeAiMatSand);
+            break;
+        case 1: /* pile split by metal walls with a water pool */
+            sand_sim_fill_rect(g, 10, 2, 110, 30, kEdgeAiMatSand);
+            sand_sim_fill_rect(g, 40, 40, 41, 79, kEdgeAiMatMetal);
+            sand_sim_fill_rect(g, 80, 20, 81, 60, kEdgeAiMatMetal);
+            sand_sim_fill_rect(g, 0, 70, 39, 79, kEdgeAiMatWater);
+            break;
+        default: /* scattered 30% fill */
+        {
+            uint32_t r = 99u;
+            for (int32_t y = 0; y < EDGEAI_SAND_H; y++)
+            {
+                for (int32_t x = 0; x < EDGEAI_SAND_W; x++)
+                {
+                    r = r * 1664525u + 1013904223u;
+                    if ((r >> 24) < 77u) g->cell[y][x] = (uint8_t)kEdgeAiMatSand;
+                }
+            }
+            memset(g->active, 1, sizeof(g->active));
+            break;
+        }
+    }
+}
+
+/* Share of cells in the patches active before the step that differ between a and b. */
+static double host_mismatch(const sand_grid_t *a, const sand_grid_t *b, const uint8_t *active)
+{
+    uint32_t diff = 0, cells = 0;
+    for (uint32_t p = 0; p < (uint32_t)EDGEAI_SAND_PATCH_COUNT; p++)
+    {
+        if (!active[p]) continue;
+        int32_t x0 = (int32_t)(p % EDGEAI_SAND_PATCH_COLS) * EDGEAI_SAND_PATCH;
+        int32_t y0 = (int32_t)(p / EDGEAI_SAND_PATCH_COLS) * EDGEAI_SAND_PATCH;
+        for (int32_t y = y0; y < y0 + EDGEAI_SAND_PATCH && y < EDGEAI_SAND_H; y++)
+        {
+            for (int32_t x = x0; x < x0 + EDGEAI_SAND_PATCH && x < EDGEAI_SAND_W; x++)
+            {
+                diff += (a->cell[y][x] != b->cell[y][x]) ? 1u : 0u;
+                cells++;
+            }
+        }
+    }
+    return cells ? (double)diff / (double)cells : 0.0;
+}
+
+#if EDGEAI_HOST_TFLM
+typedef struct
+{
+    tflite::MicroInterpreter *interp;
+    uint32_t batch; /* model batch dimension */
+} host_tflm_t;
+
+static bool host_run_tflm(void *user, const int8_t *in, int8_t *out, uint32_t n)
+{
+    host_tflm_t *t = (host_tflm_t *)user;
+    TfLiteTensor *ti = t->interp->input(0);
+    TfLiteTensor *to = t->interp->output(0);
+    const float si = ti->params.scale, so = to->params.scale;
+    const int32_t zi = ti->params.zero_point, zo = to->params.zero_point;
+    for (uint32_t b0 = 0; b0 < n; b0 += t->batch)
+    {
+        uint32_t nb = std::min(t->batch, n - b0);
+        const int8_t *src = &in[b0 * EDGEAI_SAND_SURROGATE_IN_BYTES];
+        for (uint32_t i = 0; i < t->batch * EDGEAI_SAND_SURROGATE_IN_BYTES; i++)
+        {
+            /* Gathered values are real * 127; padding rows beyond nb are zero (static). */
+            float r = (i < nb * EDGEAI_SAND_SURROGATE_IN_BYTES) ? (float)src[i] / 127.0f : 0.0f;
+            int32_t q = (int32_t)lrintf(r / si) + zi;
+            ti->data.int8[i] = (int8_t)std::min(127, std::max(-128, q));
+        }
+        if (t->interp->Invoke() != kTfLiteOk) return false;
+        int8_t *dst = &out[b0 * EDGEAI_SAND_SURROGATE_OUT_BYTES];
+        for (uint32_t i = 0; i < nb * EDGEAI_SAND_SURROGATE_OUT_BYTES; i++)
+        {
+            dst[i] = (so * (float)(to->data.int8[i] - zo) > 0.0f) ? 127 : -127;
+        }
+    }
+    return true;
+}
+
+static std::vector<uint8_t> s_model_file;
+alignas(16) static uint8_t s_arena[512 * 1024];
+
+static bool host_tflm_open(const char *path, host_tflm_t *t)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    s_model_file.resize((size_t)sz);
+    bool ok = fread(s_model_file.data(), 1, (size_t)sz, f) == (size_t)sz;
+    fclose(f);
+    if (!ok) return false;
+
+    static tflite::MicroMutableOpResolver<16> s_resolver;
+    s_resolver.AddAdd();
+    s_resolver.AddConcatenation();
+    s_resolver.AddConv2D();
+    s_resolver.AddDepthwiseConv2D();
+    s_resolver.AddDequantize();
+    s_resolver.AddFullyConnected();
+    s_resolver.AddLogistic();
+    s_resolver.AddMul();
+    s_resolver.AddPad();
+    s_resolver.AddQuantize();
+    s_resolver.AddRelu();
+    s_resolver.AddReshape();
+    s_resolver.AddSlice();
+    s_resolver.AddStridedSlice();
+    s_resolver.AddTanh();
+
+    static tflite::MicroInterpreter s_interp(tflite::GetModel(s_model_file.data()), s_resolver, s_arena,
+                                             sizeof(s_arena));
+    if (s_interp.AllocateTensors() != kTfLiteOk) return false;
+    TfLiteTensor *ti = s_interp.input(0);
+    TfLiteTensor *to = s_interp.output(0);
+    if (ti->type != kTfLiteInt8 || to->type != kTfLiteInt8 || ti->dims->size != 4) return false;
+    if (ti->dims->data[1] != EDGEAI_SAND_SURROGATE_IN_EDGE || ti->dims->data[2] != EDGEAI_SAND_SURROGATE_IN_EDGE ||
+        ti->dims->data[3] != EDGEAI_SAND_SURROGATE_IN_C)
+    {
+        return false;
+    }
+    t->interp = &s_interp;
+    t->batch = (uint32_t)ti->dims->data[0];
+    return true;
+}
+#endif
+
+typedef struct
+{
+    std::vector<double> mismatch;
+    double drift_abs;
+    uint32_t steps;
+    uint32_t overflows;
+    uint32_t rejected; /* runner failures and drift rejects */
+} host_band_t;
+
+static double host_percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (double)(v.size() - 1) + 0.5);
+    return v[i];
+}
+
+static void host_print_band(const char *name, const host_band_t *b)
+{
+    double mean = 0.0;
+    for (double m : b->mismatch) mean += m;
+    mean = b->mismatch.empty() ? 0.0 : mean / (double)b->mismatch.size();
+    size_t used = b->mismatch.size();
+    printf("%-22s mismatch mean %5.2f%%  p95 %5.2f%%  max %5.2f%%  |drift| %.2f/step  (%zu/%u steps; overflow %u, rejected %u)\n",
+           name, 100.0 * mean, 100.0 * host_percentile(b->mismatch, 0.95), 100.0 * host_percentile(b->mismatch, 1.0),
+           used ? b->drift_abs / (double)used : 0.0, used, b->steps, b->overflows, b->rejected);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t steps = 400;
+    const char *model = NULL;
+    const char *dump = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--model") && i + 1 < argc) model = argv[++i];
+        else if (!strcmp(argv[i], "--dump") && i + 1 < argc) dump = argv[++i];
+        else steps = (uint32_t)atoi(argv[i]);
+    }
+    if (steps < 1u) steps = 1u;
+
+    static uint32_t s_ref_rng = 0x9E3779B9u;
+    edgeai_sand_surrogate_run_fn_t run = edgeai_sand_surrogate_run_reference;
+    void *user = &s_ref_rng;
+    const char *runner = "reference";
+#if EDGEAI_HOST_TFLM
+    static host_tflm_t s_tflm;
+    if (model)
+    {
+        if (!host_tflm_open(model, &s_tflm))
+        {
+            fprintf(stderr, "cannot load %s (expects int8 [B,%d,%d,%d] -> [B,%d,%d,1])\n", model,
+                    EDGEAI_SAND_SURROGATE_IN_EDGE, EDGEAI_SAND_SURROGATE_IN_EDGE, EDGEAI_SAND_SURROGATE_IN_C,
+                    EDGEAI_SAND_PATCH, EDGEAI_SAND_PATCH);
+            return 1;
+        }
+        run = host_run_tflm;
+        user = &s_tflm;
+        runner = model;
+    }
+#else
+    if (model)
+    {
+        fprintf(stderr, "--model needs a build with -DEDGEAI_HOST_TFLM=1\n");
+        return 2;
+    }
+#endif
+    FILE *dump_f = dump ? fopen(dump, "wb") : NULL;
+    if (dump && !dump_f)
+    {
+        fprintf(stderr, "cannot open %s\n", dump);
+        return 1;
+    }
+
+    static sand_grid_t s_cpu, s_alt, s_sur;
+    static edgeai_sand_surrogate_t s_s;
+    static int8_t s_pairs_in[HOST_WINDOWS_MAX * EDGEAI_SAND_SURROGATE_IN_BYTES];
+    static int8_t s_pairs_out[HOST_WINDOWS_MAX * EDGEAI_SAND_SURROGATE_OUT_BYTES];
+    static uint16_t s_pairs_window[HOST_WINDOWS_MAX];
+    static uint32_t s_pairs_rng = 0x51ED270Bu;
+    host_band_t band_sur = {}, band_cpu = {};
+    uint32_t pairs = 0;
+
+    /* Error band: both steps start from the CPU trajectory, so errors do not compound. */
+    for (int scene = 0; scene < 3; scene++)
+    {
+        host_scene(&s_cpu, scene);
+        for (uint32_t t = 0; t < steps; t++)
+        {
+            sand_gravity_t grav = host_gravity(t);
+            uint8_t active[EDGEAI_SAND_PATCH_COUNT];
+            s_sur = s_cpu;
+            s_alt = s_cpu;
+            s_alt.rng ^= 0xA5A5A5A5u;
+            (void)sand_sim_set_gravity(&s_sur, grav);
+            memcpy(active, s_sur.active, sizeof(active));
+            if (dump_f)
+            {
+                uint32_t n = edgeai_sand_surrogate_gather(&s_sur, t, s_pairs_in, s_pairs_window, HOST_WINDOWS_MAX);
+                (void)edgeai_sand_surrogate_run_reference(&s_pairs_rng, s_pairs_in, s_pairs_out, n);
+                for (uint32_t i = 0; i < n; i++)
+                {
+                    fwrite(&s_pairs_in[i * EDGEAI_SAND_SURROGATE_IN_BYTES], 1, EDGEAI_SAND_SURROGATE_IN_BYTES, dump_f);
+                    fwrite(&s_pairs_out[i * EDGEAI_SAND_SURROGATE_OUT_BYTES], 1, EDGEAI_SAND_SURROGATE_OUT_BYTES, dump_f);
+                }
+                pairs += n;
+            }
+
+            edgeai_sand_surrogate_init(&s_s, run, user);
+            s_s.phase = t & 1u;
+            bool used = edgeai_sand_surrogate_step(&s_s, &s_sur, grav);
+            sand_sim_step(&s_alt, grav);
+            sand_sim_step(&s_cpu, grav);
+
+            if (used)
+            {
+                band_sur.mismatch.push_back(host_mismatch(&s_cpu, &s_sur, active));
+                band_sur.drift_abs += std::fabs((double)s_s.last_drift);
+            }
+            band_sur.overflows += s_s.overflows;
+            band_sur.rejected += s_s.drift_rejects + s_s.run_failures;
+            band_sur.steps++;
+            band_cpu.mismatch.push_back(host_mismatch(&s_cpu, &s_alt, active));
+            band_cpu.steps++;
+        }
+    }
+
+    /* Throughput: each path runs its own trajectory from the same scenes. */
+    double cpu_ms = 0.0, sur_ms = 0.0;
+    uint64_t cpu_cells = 0, sur_cells = 0;
+    uint32_t sur_batches = 0, sur_fallbacks = 0, max_patches = 0;
+    for (int scene = 0; scene < 3; scene++)
+    {
+        host_scene(&s_cpu, scene);
+        host_scene(&s_sur, scene);
+        edgeai_sand_surrogate_init(&s_s, run, user);
+        for (uint32_t t = 0; t < steps; t++)
+        {
+            sand_gravity_t grav = host_gravity(t);
+            double t0 = now_ms();
+            sand_sim_step(&s_cpu, grav);
+            double t1 = now_ms();
+            (void)edgeai_sand_surrogate_step(&s_s, &s_sur, grav);
+            double t2 = now_ms();
+            cpu_ms += t1 - t0;
+            sur_ms += t2 - t1;
+            cpu_cells += s_cpu.cells_scanned;
+            sur_cells += s_sur.cells_scanned;
+            max_patches = std::max(max_patches, s_s.last_patches);
+        }
+        sur_batches += s_s.batches;
+        sur_fallbacks += s_s.fallback_steps;
+    }
+
+    printf("grid %dx%d, patch %d, batch %d, %u steps x 3 scenes, runner %s\n", EDGEAI_SAND_W, EDGEAI_SAND_H,
+           EDGEAI_SAND_PATCH, EDGEAI_SAND_SURROGATE_BATCH, steps, runner);
+    host_print_band("surrogate vs cpu", &band_sur);
+    host_print_band("cpu vs cpu (reseeded)", &band_cpu);
+    printf("cpu        %10.0f cells/ms  (%llu cells, %.2f ms)\n", cpu_ms > 0.0 ? (double)cpu_cells / cpu_ms : 0.0,
+           (unsigned long long)cpu_cells, cpu_ms);
+    printf("surrogate  %10.0f cells/ms  (%llu cells, %.2f ms; %u batched, %u fallback steps, max %u patches)\n",
+           sur_ms > 0.0 ? (double)sur_cells / sur_ms : 0.0, (unsigned long long)sur_cells, sur_ms, sur_batches,
+           sur_fallbacks, max_patches);
+    if (dump_f)
+    {
+        fclose(dump_f);
+        printf("dumped %u pairs (%d + %d bytes each) to %s\n", pairs, EDGEAI_SAND_SURROGATE_IN_BYTES,
+               EDGEAI_SAND_SURROGATE_OUT_BYTES, dump);
+    }
+    return 0;
+}
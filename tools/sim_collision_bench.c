@@ -0,0 +1,263 @@
+/*
+ * Host stress benchmark for the swept wall collision in sim_step (EDGEAI_SIM_SWEPT, src/sim_world.h).
+ *
+ * The ball is kicked with bang-sized impulses (up to EDGEAI_BANG_GAIN_Q16) in varying directions under a
+ * wandering tilt, and the same inputs are run through:
+ *   - swept: sim_step as built (adaptive substeps + time-of-impact reflection), 120 Hz;
+ *   - clamp: the old integrate-then-clamp step, 120 Hz;
+ *   - clamp x6: the old step at 720 Hz, the brute-force way to the same accuracy;
+ *   - reference: the same rules in double precision with 256 substeps per 120 Hz step.
+ * Kicks are one bang gain, then 4 and 8 stacked. For the steps where the reference hits a wall, each
+ * variant takes that one step from the reference state; reports the energy drift (signed), energy error and
+ * position error of the step against the reference, and the cost per 120 Hz step of each variant.
+ *
+ * Build and run (sim_world.c is built a second time as the clamp variant):
+ *   cc -O2 -std=c11 -Isrc -DEDGEAI_SIM_SWEPT=0 -Dsim_step=sim_step_clamp -Dsim_world_init=sim_world_init_clamp \
+ *       -Dsim_sample_terrain=sim_sample_terrain_clamp -Dsim_step_fixed=sim_step_fixed_clamp \
+ *       -Dsim_step_float=sim_step_float_clamp -c src/sim_world.c -o /tmp/sim_world_clamp.o && \
+ *   cc -O2 -std=c11 -Isrc tools/sim_collision_bench.c src/sim_world.c src/terrain.c /tmp/sim_world_clamp.o \
+ *       -lm -o /tmp/sim_collision_bench && /tmp/sim_collision_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "edgeai_config.h"
+#include "sim_world.h"
+
+void sim_world_init_clamp(sim_world_t *w, int32_t lcd_w, int32_t lcd_h);
+void sim_step_clamp(sim_world_t *w, const sim_input_t *in, const sim_params_t *p);
+
+#define BENCH_HZ 120
+#define BENCH_KICK_STEPS 60u /* a kick every 0.5 s */
+#define BENCH_KICKS 2000u
+#define BENCH_STEPS (BENCH_KICK_STEPS * BENCH_KICKS)
+#define BENCH_REF_SUB 256
+
+typedef struct
+{
+    double x, y, vx, vy;
+    uint32_t bounces;
+} ref_ball_t;
+
+static void params_init(sim_params_t *p, int32_t hz, int32_t damp_q16)
+{
+    memset(p, 0, sizeof(*p));
+    p->sim_step_q16 = (int32_t)((1u << 16) / (uint32_t)hz);
+    p->a_px_s2 = 3780;
+    p->damp_q16 = damp_q16;
+    p->minx = EDGEAI_BALL_R_MAX + 2;
+    p->miny = EDGEAI_BALL_R_MAX + 2;
+    p->maxx = (EDGEAI_LCD_W - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p->maxy = (EDGEAI_LCD_H - 1) - (EDGEAI_BALL_R_MAX + 2);
+}
+
+/* Input for step i: a wandering tilt plus a kick of 40..100% of `kick` bang gains every BENCH_KICK_STEPS
+ * (several bangs landing on one step stack).
+ */
+static void input_at(uint32_t i, double kick, sim_input_t *in)
+{
+    memset(in, 0, sizeof(*in));
+    double t = (double)i / BENCH_HZ;
+    in->ax_soft_q15 = (int32_t)(9000.0 * sin(t * 0.7));
+    in->ay_soft_q15 = (int32_t)(9000.0 * cos(t * 0.43));
+    if ((i % BENCH_KICK_STEPS) == 0u)
+    {
+        uint32_t k = i / BENCH_KICK_STEPS;
+        double ang = (double)((k * 2654435761u) >> 8) * (6.283185307179586 / 16777216.0);
+        double mag = (0.4 + 0.6 * (double)((k * 40503u) & 0xFFu) / 255.0) * kick * (double)EDGEAI_BANG_GAIN_Q16;
+        in->bang_dvx_q16 = (int32_t)(mag * cos(ang));
+        in->bang_dvy_q16 = (int32_t)(mag * sin(ang));
+    }
+}
+
+static void ref_axis(double *pos, double *vel, double d, double lo, double hi, uint32_t *bounces)
+{
+    double x = *pos + d;
+    if (x < lo)
+    {
+        if (*vel < 0.0 && *pos >= lo) { x = lo + (lo - x) * 0.75; *vel = -*vel * 0.75; (*bounces)++; }
+        else x = lo;
+    }
+    else if (x > hi)
+    {
+        if (*vel > 0.0 && *pos <= hi) { x = hi - (x - hi) * 0.75; *vel = -*vel * 0.75; (*bounces)++; }
+        else x = hi;
+    }
+    *pos = (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+static void ref_step(ref_ball_t *b, const sim_input_t *in, const sim_params_t *p)
+{
+    const double dt = 1.0 / BENCH_HZ;
+    b->vx += in->bang_dvx_q16 / 65536.0;
+    b->vy += in->bang_dvy_q16 / 65536.0;
+    b->vx += (double)in->ax_soft_q15 * p->a_px_s2 / 32768.0 * dt;
+    b->vy += (double)in->ay_soft_q15 * p->a_px_s2 / 32768.0 * dt;
+    b->vx *= p->damp_q16 / 65536.0;
+    b->vy *= p->damp_q16 / 65536.0;
+    for (int s = 0; s < BENCH_REF_SUB; s++)
+    {
+        int32_t shrink = EDGEAI_BALL_R_MAX - edgeai_ball_r_for_y((int32_t)floor(b->y));
+        ref_axis(&b->x, &b->vx, b->vx * dt / BENCH_REF_SUB, p->minx - shrink, p->maxx + shrink, &b->bounces);
+        ref_axis(&b->y, &b->vy, b->vy * dt / BENCH_REF_SUB, p->miny - shrink, p->maxy + shrink, &b->bounces);
+    }
+}
+
+static double ke(double vx, double vy)
+{
+    return 0.5 * (vx * vx + vy * vy);
+}
+
+static double ke_q16(const sim_world_t *w)
+{
+    return ke(w->ball.vx_q16 / 65536.0, w->ball.vy_q16 / 65536.0);
+}
+
+typedef struct
+{
+    const char *name;
+    void (*step)(sim_world_t *, const sim_input_t *, const sim_params_t *);
+    void (*init)(sim_world_t *, int32_t, int32_t);
+    const sim_params_t *p;
+    uint32_t sub; /* variant steps per 120 Hz step */
+    double drift; /* sum of (E - E_ref) / E_ref over the steps with a wall hit */
+    double err;   /* sum of |E - E_ref| / E_ref, same steps */
+    double pos;   /* sum of |p - p_ref| in px, same steps */
+} variant_t;
+
+/* One 120 Hz step of the variant from the reference state; the tilt is a rate, the kick is applied once. */
+static void local_step(variant_t *v, const ref_ball_t *b, const sim_input_t *in0, double *e, double *px,
+                       double *py)
+{
+    sim_world_t w;
+    v->init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    w.ball.x_q16 = (int32_t)lround(b->x * 65536.0);
+    w.ball.y_q16 = (int32_t)lround(b->y * 65536.0);
+    w.ball.vx_q16 = (int32_t)lround(b->vx * 65536.0);
+    w.ball.vy_q16 = (int32_t)lround(b->vy * 65536.0);
+    sim_input_t in = *in0;
+    for (uint32_t s = 0; s < v->sub; s++)
+    {
+        v->step(&w, &in, v->p);
+        in.bang_dvx_q16 = 0;
+        in.bang_dvy_q16 = 0;
+    }
+    *e = ke_q16(&w);
+    *px = w.ball.x_q16 / 65536.0;
+    *py = w.ball.y_q16 / 65536.0;
+}
+
+/* Follows the reference trajectory and, at every step that hits a wall, restarts each variant from the
+ * reference state: the error of that one step, so trajectories diverging chaotically do not swamp it.
+ */
+static bool accuracy(variant_t *v, uint32_t nv, double kick)
+{
+    sim_params_t ref_p;
+    params_init(&ref_p, BENCH_HZ, 65000);
+    ref_ball_t b = {EDGEAI_LCD_W / 2, EDGEAI_LCD_H / 2, 0.0, 0.0, 0u};
+    uint32_t hits = 0;
+    double vmax = 0.0, vsum = 0.0;
+    for (uint32_t i = 0; i < BENCH_STEPS; i++)
+    {
+        sim_input_t in;
+        input_at(i, kick, &in);
+        ref_ball_t b0 = b;
+        ref_step(&b, &in, &ref_p);
+        double sp = sqrt(b.vx * b.vx + b.vy * b.vy) / BENCH_HZ;
+        vsum += sp;
+        if (sp > vmax) vmax = sp;
+        if (b.bounces == b0.bounces) continue;
+        hits++;
+        double er = ke(b.vx, b.vy);
+        for (uint32_t k = 0; k < nv; k++)
+        {
+            double e, x, y;
+            local_step(&v[k], &b0, &in, &e, &x, &y);
+            if (er > 1.0)
+            {
+                v[k].drift += (e - er) / er;
+                v[k].err += fabs(e - er) / er;
+            }
+            v[k].pos += hypot(x - b.x, y - b.y);
+        }
+    }
+    printf("kicks up to %.0f px/s; reference: %u steps, %u with wall hits (%u hits), speed avg %.1f max %.1f px/step\n", kick * (EDGEAI_BANG_GAIN_Q16 >> 16), BENCH_STEPS,
+           hits, b.bounces, vsum / BENCH_STEPS, vmax);
+    for (uint32_t k = 0; k < nv; k++)
+    {
+        printf("  %-9s per wall-hit step: energy drift %+7.3f%%, |energy err| %6.3f%%, position err %5.2f px\n",
+               v[k].name, 100.0 * v[k].drift / hits, 100.0 * v[k].err / hits, v[k].pos / hits);
+    }
+    bool ok = (v[0].err <= v[1].err && v[0].pos <= v[1].pos);
+    for (uint32_t k = 0; k < nv; k++) v[k].drift = v[k].err = v[k].pos = 0.0;
+    return ok;
+}
+
+static double cost(void (*step)(sim_world_t *, const sim_input_t *, const sim_params_t *),
+                   void (*init)(sim_world_t *, int32_t, int32_t), const sim_params_t *p, uint32_t sub,
+                   const sim_input_t *ins, int32_t *hash)
+{
+    sim_world_t w;
+    init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    double t0 = bench_now_s();
+    for (uint32_t i = 0; i < BENCH_STEPS; i++)
+    {
+        sim_input_t in = ins[i];
+        for (uint32_t s = 0; s < sub; s++)
+        {
+            step(&w, &in, p);
+            in.bang_dvx_q16 = 0;
+            in.bang_dvy_q16 = 0;
+        }
+    }
+    double t = bench_now_s() - t0;
+    *hash = w.ball.x_q16 ^ w.ball.y_q16 ^ w.ball.vx_q16 ^ w.ball.vy_q16;
+    return t * 1e9 / BENCH_STEPS;
+}
+
+static sim_input_t s_inputs[BENCH_STEPS];
+
+int main(void)
+{
+    sim_params_t p120, p720;
+    params_init(&p120, BENCH_HZ, 65000);
+    /* Same damping per second at 6x the rate. */
+    params_init(&p720, BENCH_HZ * 6, (int32_t)lround(65536.0 * pow(65000.0 / 65536.0, 1.0 / 6.0)));
+
+    printf("%u kicks each 0.5 s, %u steps at %d Hz, reference %d substeps/step\n", BENCH_KICKS, BENCH_STEPS,
+           BENCH_HZ, BENCH_REF_SUB);
+    variant_t v[3] = {
+        {"swept", sim_step, sim_world_init, &p120, 1u, 0.0, 0.0, 0.0},
+        {"clamp", sim_step_clamp, sim_world_init_clamp, &p120, 1u, 0.0, 0.0, 0.0},
+        {"clamp x6", sim_step_clamp, sim_world_init_clamp, &p720, 6u, 0.0, 0.0, 0.0},
+    };
+
+    /* One bang, then stacked bangs well past what the clamp step can follow. */
+    static const double kicks[] = {1.0, 4.0, 8.0};
+    bool ok = true;
+    for (uint32_t k = 0; k < sizeof(kicks) / sizeof(kicks[0]); k++)
+    {
+        ok &= accuracy(v, 3u, kicks[k]);
+
+        for (uint32_t i = 0; i < BENCH_STEPS; i++) input_at(i, kicks[k], &s_inputs[i]);
+        int32_t h = 0;
+        sim_world_t probe;
+        sim_world_init(&probe, EDGEAI_LCD_W, EDGEAI_LCD_H);
+        for (uint32_t i = 0; i < BENCH_STEPS; i++) sim_step(&probe, &s_inputs[i], &p120);
+        double ns_s = cost(sim_step, sim_world_init, &p120, 1u, s_inputs, &h);
+        double ns_c = cost(sim_step_clamp, sim_world_init_clamp, &p120, 1u, s_inputs, &h);
+        double ns_6 = cost(sim_step_clamp, sim_world_init_clamp, &p720, 6u, s_inputs, &h);
+        printf("  cost per 120 Hz step: swept %.1f ns (%.2f substeps avg), clamp %.1f ns, clamp x6 %.1f ns\n", ns_s,
+               (double)probe.substeps / BENCH_STEPS, ns_c, ns_6);
+    }
+
+    /* The swept step should at least match the old one at the same rate. */
+    return ok ? 0 : 1;
+}
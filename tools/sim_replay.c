@@ -0,0 +1,313 @@
+/*
+ * Host replay for the sim recorder (src/sim_record.h).
+ *
+ *   sim_replay LOG [KEY]   replays the last `EDGEAI: sim_rec` line of a console log from keyframe KEY
+ *                          (default: every keyframe) and checks that each later keyframe is reproduced
+ *                          bit for bit; with KEY also prints the replayed steps as CSV.
+ *   sim_replay             self-test: records a synthetic run on the dune terrain with bangs, dumps it
+ *                          through the same print path, replays it and reports the recording cost and size.
+ *
+ * The firmware prints the line when 'd' is received on the debug console (EDGEAI_TELEMETRY_ENABLE=0).
+ * The replay build must match the firmware's EDGEAI_SIM_* collision and arithmetic settings (checked against
+ * the line).
+ *
+ * Build:
+ *   cc -O2 -std=c11 -Isrc tools/sim_replay.c src/sim_record.c src/sim_world.c src/terrain.c src/sw_render.c \
+ *       src/edgeai_math.c -lm -o /tmp/sim_replay
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "edgeai_config.h"
+#include "sim_record.h"
+#include "sim_world.h"
+#include "sw_render.h"
+#include "terrain.h"
+
+#define REPLAY_LINE_MAX (2u * EDGEAI_SIM_REC_BYTES + 512u)
+#define SELFTEST_STEPS 200000u
+
+static char s_line[REPLAY_LINE_MAX];
+static uint32_t s_line_len;
+static uint8_t s_data[EDGEAI_SIM_REC_BYTES];
+static edgeai_sim_rec_t s_rec;
+static edgeai_terrain_t s_terrain;
+
+/* Print function collecting the dump into s_line. */
+static int line_printf(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(s_line + s_line_len, sizeof(s_line) - s_line_len, fmt, ap);
+    va_end(ap);
+    if (n > 0) s_line_len += (uint32_t)n;
+    if (s_line_len >= sizeof(s_line)) s_line_len = sizeof(s_line) - 1u;
+    return n;
+}
+
+static int hex_val(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/* Parses a `sim_rec` line into params and s_data; returns the data length, 0 on error. */
+static uint32_t parse_line(const char *line, sim_params_t *p)
+{
+    const char *s = strstr(line, "EDGEAI: sim_rec ");
+    if (!s) return 0;
+    unsigned ver = 0;
+    int v[8], cfg[4], off = 0;
+    if (sscanf(s, "EDGEAI: sim_rec %u params=%d,%d,%d,%d,%d,%d,%d,%d swept=%d,%d,%d float=%d data=%n", &ver, &v[0],
+               &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &cfg[0], &cfg[1], &cfg[2], &cfg[3], &off) != 13 ||
+        off == 0)
+    {
+        fprintf(stderr, "malformed sim_rec line\n");
+        return 0;
+    }
+    if (ver != EDGEAI_SIM_REC_VERSION)
+    {
+        fprintf(stderr, "sim_rec version %u, this tool reads %u\n", ver, (unsigned)EDGEAI_SIM_REC_VERSION);
+        return 0;
+    }
+    if (cfg[0] != EDGEAI_SIM_SWEPT || cfg[1] != EDGEAI_SIM_SUBSTEP_PX || cfg[2] != EDGEAI_SIM_SUBSTEP_MAX ||
+        cfg[3] != EDGEAI_SIM_FLOAT)
+    {
+        fprintf(stderr, "recorded with EDGEAI_SIM_SWEPT=%d SUBSTEP_PX=%d SUBSTEP_MAX=%d FLOAT=%d; rebuild to match\n",
+                cfg[0], cfg[1], cfg[2], cfg[3]);
+        return 0;
+    }
+    memset(p, 0, sizeof(*p));
+    p->sim_step_q16 = v[0];
+    p->a_px_s2 = v[1];
+    p->damp_q16 = v[2];
+    p->minx = v[3];
+    p->miny = v[4];
+    p->maxx = v[5];
+    p->maxy = v[6];
+    p->terrain_a_px_s2 = v[7];
+
+    const char *h = s + off;
+    uint32_t n = 0;
+    while (n < sizeof(s_data) && hex_val(h[0]) >= 0 && hex_val(h[1]) >= 0)
+    {
+        s_data[n++] = (uint8_t)((hex_val(h[0]) << 4) | hex_val(h[1]));
+        h += 2;
+    }
+    return n;
+}
+
+static bool ball_equal(const ball_state_t *a, const ball_state_t *b)
+{
+    return a->x_q16 == b->x_q16 && a->y_q16 == b->y_q16 && a->vx_q16 == b->vx_q16 && a->vy_q16 == b->vy_q16 &&
+           a->lift_q16 == b->lift_q16 && a->glint == b->glint;
+}
+
+/* Replays from keyframe `start` (counted from the oldest) to the end of the data. Returns the number of
+ * later keyframes checked, or -1 on a mismatch or decode error.
+ */
+static int replay(const uint8_t *data, uint32_t len, const sim_params_t *p, uint32_t start, bool csv,
+                  uint32_t *steps_out)
+{
+    edgeai_sim_rec_reader_t rd;
+    edgeai_sim_rec_reader_init(&rd, data, len);
+    sim_world_t w;
+    uint32_t keys = 0, steps = 0;
+    int checked = 0;
+    bool running = false;
+    for (;;)
+    {
+        edgeai_sim_rec_item_t it = edgeai_sim_rec_read(&rd);
+        if (it == kEdgeAiSimRecEnd) break;
+        if (it == kEdgeAiSimRecError)
+        {
+            fprintf(stderr, "decode error at byte %u\n", rd.pos);
+            return -1;
+        }
+        if (it == kEdgeAiSimRecKey)
+        {
+            if (keys++ == start)
+            {
+                w = rd.key;
+                running = true;
+            }
+            else if (running)
+            {
+                if (!ball_equal(&w.ball, &rd.key.ball))
+                {
+                    fprintf(stderr, "step %u: replay (%d,%d v %d,%d) != keyframe (%d,%d v %d,%d)\n", rd.step,
+                            w.ball.x_q16, w.ball.y_q16, w.ball.vx_q16, w.ball.vy_q16, rd.key.ball.x_q16,
+                            rd.key.ball.y_q16, rd.key.ball.vx_q16, rd.key.ball.vy_q16);
+                    return -1;
+                }
+                checked++;
+            }
+            continue;
+        }
+        if (!running) continue;
+        sim_step(&w, &rd.in, p);
+        steps++;
+        if (csv)
+        {
+            printf("%u,%d,%d,%d,%d,%d,%u\n", rd.step - 1u, w.ball.x_q16, w.ball.y_q16, w.ball.vx_q16, w.ball.vy_q16,
+                   w.ball.lift_q16, (unsigned)w.ball.glint);
+        }
+    }
+    if (!running)
+    {
+        fprintf(stderr, "keyframe %u not in the recording (%u keyframes)\n", start, keys);
+        return -1;
+    }
+    if (steps_out) *steps_out = steps;
+    return checked;
+}
+
+static uint32_t count_keys(const uint8_t *data, uint32_t len)
+{
+    edgeai_sim_rec_reader_t rd;
+    edgeai_sim_rec_reader_init(&rd, data, len);
+    uint32_t keys = 0;
+    edgeai_sim_rec_item_t it;
+    while ((it = edgeai_sim_rec_read(&rd)) != kEdgeAiSimRecEnd && it != kEdgeAiSimRecError)
+    {
+        if (it == kEdgeAiSimRecKey) keys++;
+    }
+    return keys;
+}
+
+static int replay_all(const uint8_t *data, uint32_t len, const sim_params_t *p)
+{
+    uint32_t keys = count_keys(data, len);
+    int fails = 0;
+    for (uint32_t k = 0; k < keys; k++)
+    {
+        uint32_t steps = 0;
+        int checked = replay(data, len, p, k, false, &steps);
+        if (checked < 0) fails++;
+        if (k == 0u) printf("from keyframe 0: %u steps, %d keyframes reproduced\n", steps, checked);
+    }
+    printf("replayed from each of %u keyframes: %s\n", keys, fails ? "MISMATCH" : "bit-exact");
+    return fails ? 1 : 0;
+}
+
+/* Synthetic run: rotating tilt, periodic bangs and lift, on the dune gradient. */
+static void selftest_input(uint32_t i, int32_t *ax, int32_t *ay, sim_input_t *in)
+{
+    int32_t nax = *ax - (*ay >> 7);
+    *ay += *ax >> 7;
+    *ax = nax;
+    memset(in, 0, sizeof(*in));
+    in->ax_soft_q15 = *ax;
+    in->ay_soft_q15 = *ay;
+    if ((i % 97u) == 0u)
+    {
+        in->bang_dvx_q16 = (int32_t)((i * 2654435761u) >> 8) % EDGEAI_BANG_GAIN_Q16;
+        in->bang_dvy_q16 = (int32_t)((i * 40503u) << 9) % EDGEAI_BANG_GAIN_Q16;
+    }
+    in->lift_target_q16 = ((i / 240u) & 1u) ? (6 << 16) : 0;
+}
+
+static int selftest(void)
+{
+    uint32_t hw = 0, hh = 0;
+    const uint8_t *hmap = sw_render_dune_hmap(&hw, &hh);
+    if (!edgeai_terrain_init(&s_terrain, hmap, hw, hh)) return 1;
+    sim_params_t p;
+    memset(&p, 0, sizeof(p));
+    p.sim_step_q16 = (int32_t)((1u << 16) / 120u);
+    p.a_px_s2 = 3780;
+    p.damp_q16 = 65000;
+    p.minx = EDGEAI_BALL_R_MAX + 2;
+    p.miny = EDGEAI_BALL_R_MAX + 2;
+    p.maxx = (EDGEAI_LCD_W - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p.maxy = (EDGEAI_LCD_H - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p.terrain = &s_terrain;
+    p.terrain_a_px_s2 = EDGEAI_TERRAIN_A_PX_S2;
+
+    /* Cost: the same run with and without recording. */
+    double t[2];
+    for (int rec = 0; rec < 2; rec++)
+    {
+        sim_world_t w;
+        sim_world_init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+        edgeai_sim_rec_init(&s_rec);
+        int32_t ax = 9000, ay = 0;
+        double t0 = bench_now_s();
+        for (uint32_t i = 0; i < SELFTEST_STEPS; i++)
+        {
+            sim_input_t in;
+            selftest_input(i, &ax, &ay, &in);
+            sim_sample_terrain(&w, &p, &in);
+            if (rec) edgeai_sim_rec_step(&s_rec, &w, &in);
+            sim_step(&w, &in, &p);
+        }
+        t[rec] = bench_now_s() - t0;
+    }
+    printf("recorded %u steps: %.2f bytes/step, %u keyframes, ring holds %u bytes (%.1f s at 120 Hz)\n",
+           s_rec.steps, (double)s_rec.bytes / s_rec.steps, s_rec.keyframes, s_rec.head - s_rec.tail,
+           (double)(s_rec.head - s_rec.tail) * s_rec.steps / s_rec.bytes / 120.0);
+    printf("step %.1f ns, step + record %.1f ns: recording %.1f ns/step\n", t[0] * 1e9 / SELFTEST_STEPS,
+           t[1] * 1e9 / SELFTEST_STEPS, (t[1] - t[0]) * 1e9 / SELFTEST_STEPS);
+
+    /* Through the dump text and back. */
+    s_line_len = 0;
+    if (!edgeai_sim_rec_dump(&s_rec, &p, line_printf)) return 1;
+    sim_params_t rp;
+    uint32_t n = parse_line(s_line, &rp);
+    uint8_t direct[EDGEAI_SIM_REC_BYTES];
+    uint32_t nd = edgeai_sim_rec_copy(&s_rec, direct, sizeof(direct));
+    if (n == 0u || n != nd || memcmp(direct, s_data, n) != 0)
+    {
+        printf("dump round trip failed (%u vs %u bytes)\n", n, nd);
+        return 1;
+    }
+    printf("dump line: %u chars\n", s_line_len);
+    return replay_all(s_data, n, &rp);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) return selftest();
+
+    FILE *f = fopen(argv[1], "r");
+    if (!f)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    /* Keep the last sim_rec line. */
+    static char buf[REPLAY_LINE_MAX];
+    bool found = false;
+    while (fgets(buf, sizeof(buf), f))
+    {
+        if (strstr(buf, "EDGEAI: sim_rec "))
+        {
+            memcpy(s_line, buf, sizeof(s_line));
+            found = true;
+        }
+    }
+    fclose(f);
+    if (!found)
+    {
+        fprintf(stderr, "no sim_rec line in %s\n", argv[1]);
+        return 1;
+    }
+
+    sim_params_t p;
+    uint32_t n = parse_line(s_line, &p);
+    if (n == 0u) return 1;
+    if (argc < 3) return replay_all(s_data, n, &p);
+
+    printf("step,x_q16,y_q16,vx_q16,vy_q16,lift_q16,glint\n");
+    int checked = replay(s_data, n, &p, (uint32_t)strtoul(argv[2], NULL, 0), true, NULL);
+    fprintf(stderr, "%d later keyframes reproduced\n", checked);
+    return (checked < 0) ? 1 : 0;
+}
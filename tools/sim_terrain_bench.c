@@ -0,0 +1,128 @@
+/*
+ * Host benchmark for the terrain force in sim_step (src/terrain.h).
+ *
+ * Runs the same tilt sequence through sim_step on a flat board and on the dune gradient and reports
+ * the cost per step of each, the one-time gradient build, and a sanity check that a ball released at
+ * rest with no tilt ends up lower on the heightmap than where it started.
+ *
+ * Build and run:
+ *   cc -O2 -std=c11 -Isrc tools/sim_terrain_bench.c src/sim_world.c src/terrain.c src/sw_render.c src/edgeai_math.c \
+ *       -lm -o /tmp/sim_terrain_bench && /tmp/sim_terrain_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "edgeai_config.h"
+#include "sim_world.h"
+#include "sw_render.h"
+#include "terrain.h"
+
+#define BENCH_STEPS 2000000u
+#define BENCH_SETTLE_STEPS (120u * 20u) /* 20 s at 120 Hz */
+
+static edgeai_terrain_t s_terrain;
+
+static void params_init(sim_params_t *p, const edgeai_terrain_t *t)
+{
+    memset(p, 0, sizeof(*p));
+    p->sim_step_q16 = (int32_t)((1u << 16) / 120u);
+    p->a_px_s2 = 3780;
+    p->damp_q16 = 65000;
+    p->minx = EDGEAI_BALL_R_MAX + 2;
+    p->miny = EDGEAI_BALL_R_MAX + 2;
+    p->maxx = (EDGEAI_LCD_W - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p->maxy = (EDGEAI_LCD_H - 1) - (EDGEAI_BALL_R_MAX + 2);
+    p->terrain = t;
+    p->terrain_a_px_s2 = EDGEAI_TERRAIN_A_PX_S2;
+}
+
+/* Slowly rotating tilt so the ball sweeps the whole board. */
+static double run(const sim_params_t *p, uint32_t steps, int32_t *hash)
+{
+    sim_world_t w;
+    sim_world_init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+    sim_input_t in;
+    memset(&in, 0, sizeof(in));
+    int32_t ax = 12000, ay = 0;
+
+    double t0 = bench_now_s();
+    for (uint32_t i = 0; i < steps; i++)
+    {
+        /* x' = x - y/64, y' = y + x/64: a cheap rotation of the tilt vector. */
+        int32_t nax = ax - (ay >> 6);
+        ay += ax >> 6;
+        ax = nax;
+        in.ax_soft_q15 = ax;
+        in.ay_soft_q15 = ay;
+        sim_sample_terrain(&w, p, &in);
+        sim_step(&w, &in, p);
+    }
+    double t = bench_now_s() - t0;
+    *hash = w.ball.x_q16 ^ (w.ball.y_q16 * 31) ^ w.ball.vx_q16 ^ w.ball.vy_q16;
+    return t;
+}
+
+static uint32_t height_at(const uint8_t *hmap, const sim_world_t *w)
+{
+    uint32_t x = (uint32_t)(w->ball.x_q16 >> 16) >> EDGEAI_TERRAIN_TEXEL_SHIFT;
+    uint32_t y = (uint32_t)(w->ball.y_q16 >> 16) >> EDGEAI_TERRAIN_TEXEL_SHIFT;
+    return hmap[y * EDGEAI_TERRAIN_W + x];
+}
+
+int main(void)
+{
+    uint32_t hw = 0, hh = 0;
+    const uint8_t *hmap = sw_render_dune_hmap(&hw, &hh);
+
+    double t0 = bench_now_s();
+    if (!edgeai_terrain_init(&s_terrain, hmap, hw, hh))
+    {
+        printf("terrain init failed (%ux%u)\n", hw, hh);
+        return 1;
+    }
+    double t_init = bench_now_s() - t0;
+
+    sim_params_t flat, dune;
+    params_init(&flat, NULL);
+    params_init(&dune, &s_terrain);
+
+    int32_t h_flat = 0, h_dune = 0;
+    double t_flat = run(&flat, BENCH_STEPS, &h_flat);
+    double t_dune = run(&dune, BENCH_STEPS, &h_dune);
+
+    printf("gradient build: %.3f ms (%ux%u texels, %u bytes)\n", t_init * 1e3, hw, hh,
+           (unsigned)sizeof(s_terrain.grad));
+    printf("sim_step flat:  %.2f ns/step\n", t_flat * 1e9 / BENCH_STEPS);
+    printf("sim_step dune:  %.2f ns/step (x%.2f)\n", t_dune * 1e9 / BENCH_STEPS, t_dune / t_flat);
+
+    /* No tilt: the terrain alone should carry the ball downhill from a few starting points. */
+    static const int32_t starts[][2] = {{120, 80}, {240, 160}, {360, 240}, {100, 250}, {380, 90}};
+    uint32_t lower = 0;
+    for (uint32_t i = 0; i < sizeof(starts) / sizeof(starts[0]); i++)
+    {
+        sim_world_t w;
+        sim_world_init(&w, EDGEAI_LCD_W, EDGEAI_LCD_H);
+        w.ball.x_q16 = starts[i][0] << 16;
+        w.ball.y_q16 = starts[i][1] << 16;
+        uint32_t h0 = height_at(hmap, &w);
+        sim_input_t in;
+        memset(&in, 0, sizeof(in));
+        for (uint32_t s = 0; s < BENCH_SETTLE_STEPS; s++)
+        {
+            sim_sample_terrain(&w, &dune, &in);
+            sim_step(&w, &in, &dune);
+        }
+        uint32_t h1 = height_at(hmap, &w);
+        printf("release (%d,%d) h=%u -> (%d,%d) h=%u\n", starts[i][0], starts[i][1], h0,
+               (int)(w.ball.x_q16 >> 16), (int)(w.ball.y_q16 >> 16), h1);
+        if (h1 <= h0) lower++;
+    }
+    printf("downhill: %u/%u releases ended no higher than they started\n", lower,
+           (unsigned)(sizeof(starts) / sizeof(starts[0])));
+    return (lower == sizeof(starts) / sizeof(starts[0])) ? 0 : 1;
+}
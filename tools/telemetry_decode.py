@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+"""
+Decode the firmware binary telemetry stream (src/telemetry.h) into CSV, with optional plots.
+
+Input is either a capture file or a serial device (raw mode), for example:
+  stty -F /dev/ttyACM0 115200 raw -echo
+  timeout 30 cat /dev/ttyACM0 > tlm.bin
+  python3 tools/telemetry_decode.py --in tlm.bin --csv tlm.csv --latency-csv lat.csv --plot tlm.png
+
+Frame layout (little-endian):
+  0xA5 0x5A | type u8 | len u8 | seq u16 | payload[len] | crc16 u16
+CRC-16/CCITT-FALSE covers type, len, seq and payload. Text lines (boot banners) between frames
+are skipped; bytes are resynchronized on the sync pattern and validated by CRC.
+"""
+
+from __future__ import annotations
+
+import argparse
+import csv
+import struct
+import sys
+from pathlib import Path
+
+SYNC = b"\xA5\x5A"
+
+REC_STATS = 1
+REC_LATENCY = 2
+REC_STAGE_NAMES = 3
+REC_OP_PROFILE = 4
+REC_OP_NAMES = 5
+
+DEFAULT_STAGE_NAMES = ["input", "filter", "sim", "render", "blit", "npu", "npu_e2e", "gesture"]
+
+# Field layout must match edgeai_tlm_stats_t.
+STATS_FMT = "<BBHIII3h3h3hhhh2hh2hBBIIIIIIII"
+STATS_FIELDS = [
+    "version", "flags", "fps", "uptime_ms", "loops", "sim_steps",
+    "raw_x", "raw_y", "raw_z",
+    "lp_x", "lp_y", "lp_z",
+    "hp_x", "hp_y", "hp_z",
+    "g_mag", "g_hp", "bang_score",
+    "pos_x", "pos_y", "lift_px", "vel_x", "vel_y",
+    "glint", "reserved",
+    "tlm_cost_cyc", "tlm_dropped",
+    "npu_submitted", "npu_completed", "npu_dropped",
+    "npu_skipped", "npu_deferred", "npu_failed",
+]
+
+# edgeai_tlm_latency_t: header, then stage_count x (count, p50, p95, p99, max) in cycles.
+LATENCY_HDR_FMT = "<BBHI"
+LATENCY_STAGE_FMT = "<IIIII"
+
+# edgeai_tlm_op_profile_t: header, then op_count x (avg, max, last) in cycles.
+OP_HDR_FMT = "<BBHIII"
+OP_ENTRY_FMT = "<III"
+
+RECORDS = {
+    REC_STATS: ("stats", STATS_FMT, STATS_FIELDS),
+}
+
+
+def crc16_ccitt(data: bytes, crc: int = 0xFFFF) -> int:
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def iter_frames(buf: bytes, stats: dict[str, int]):
+    i = 0
+    n = len(buf)
+    while True:
+        j = buf.find(SYNC, i)
+        if j < 0 or j + 6 > n:
+            return
+        rtype, length, seq = buf[j + 2], buf[j + 3], struct.unpack_from("<H", buf, j + 4)[0]
+        end = j + 6 + length + 2
+        if end > n:
+            return
+        body = buf[j + 2 : j + 6 + length]
+        crc = struct.unpack_from("<H", buf, j + 6 + length)[0]
+        if crc16_ccitt(body) != crc:
+            stats["crc_errors"] += 1
+            i = j + 1
+            continue
+        yield rtype, seq, buf[j + 6 : j + 6 + length]
+        i = end
+
+
+def decode_stage_names(payload: bytes) -> list[str]:
+    names = []
+    i = 0
+    while i < len(payload):
+        n = payload[i]
+        names.append(payload[i + 1 : i + 1 + n].decode("ascii", "replace"))
+        i += 1 + n
+    return names
+
+
+def decode_latency(payload: bytes, names: list[str]) -> dict[str, float] | None:
+    hdr = struct.calcsize(LATENCY_HDR_FMT)
+    ent = struct.calcsize(LATENCY_STAGE_FMT)
+    if len(payload) < hdr:
+        return None
+    version, count, core_mhz, uptime_ms = struct.unpack_from(LATENCY_HDR_FMT, payload, 0)
+    if len(payload) != hdr + count * ent or core_mhz == 0:
+        return None
+    row: dict[str, float] = {"uptime_ms": uptime_ms, "core_mhz": core_mhz}
+    for i in range(count):
+        name = names[i] if i < len(names) else f"stage{i}"
+        n, p50, p95, p99, mx = struct.unpack_from(LATENCY_STAGE_FMT, payload, hdr + i * ent)
+        row[f"{name}_n"] = n
+        for k, v in (("p50", p50), ("p95", p95), ("p99", p99), ("max", mx)):
+            row[f"{name}_{k}_us"] = round(v / core_mhz, 1)
+    return row
+
+
+def decode_op_profile(payload: bytes, names: list[str]) -> list[dict[str, float]] | None:
+    hdr = struct.calcsize(OP_HDR_FMT)
+    ent = struct.calcsize(OP_ENTRY_FMT)
+    if len(payload) < hdr:
+        return None
+    version, count, core_mhz, invokes, used, size = struct.unpack_from(OP_HDR_FMT, payload, 0)
+    if len(payload) != hdr + count * ent or core_mhz == 0:
+        return None
+    out = []
+    for i in range(count):
+        avg, mx, last = struct.unpack_from(OP_ENTRY_FMT, payload, hdr + i * ent)
+        out.append({
+            "invokes": invokes, "arena_used": used, "arena_size": size,
+            "op": i, "name": names[i] if i < len(names) else f"op{i}",
+            "avg_us": round(avg / core_mhz, 1), "max_us": round(mx / core_mhz, 1), "last_us": round(last / core_mhz, 1),
+        })
+    return out
+
+
+def decode(buf: bytes):
+    stats = {"crc_errors": 0, "unknown": 0, "seq_gaps": 0}
+    rows: dict[str, list[dict[str, int]]] = {}
+    names = list(DEFAULT_STAGE_NAMES)
+    op_names: list[str] = []
+    last_seq = None
+    for rtype, seq, payload in iter_frames(buf, stats):
+        if last_seq is not None and seq != ((last_seq + 1) & 0xFFFF):
+            stats["seq_gaps"] += 1
+        last_seq = seq
+        if rtype == REC_STAGE_NAMES:
+            names = decode_stage_names(payload)
+            continue
+        if rtype == REC_OP_NAMES:
+            op_names = decode_stage_names(payload)
+            continue
+        if rtype == REC_OP_PROFILE:
+            ops = decode_op_profile(payload, op_names)
+            if ops is None:
+                stats["unknown"] += 1
+            else:
+                rows["ops"] = [{"seq": seq, **r} for r in ops]  # cumulative: keep the newest
+            continue
+        if rtype == REC_LATENCY:
+            row = decode_latency(payload, names)
+            if row is None:
+                stats["unknown"] += 1
+            else:
+                rows.setdefault("latency", []).append({"seq": seq, **row})
+            continue
+        spec = RECORDS.get(rtype)
+        if spec is None or len(payload) != struct.calcsize(spec[1]):
+            stats["unknown"] += 1
+            continue
+        name, fmt, fields = spec
+        row = {"seq": seq}
+        row.update(zip(fields, struct.unpack(fmt, payload)))
+        rows.setdefault(name, []).append(row)
+    return rows, stats
+
+
+def write_csv(path: Path, rows: list[dict[str, int]]) -> None:
+    with path.open("w", newline="", encoding="utf-8") as f:
+        w = csv.DictWriter(f, fieldnames=list(rows[0].keys()))
+        w.writeheader()
+        w.writerows(rows)
+
+
+def plot(path: Path, rows: list[dict[str, int]], lat_rows: list[dict[str, float]]) -> None:
+    import matplotlib
+
+    matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    t = [r["uptime_ms"] / 1000.0 for r in rows]
+    fig, axes = plt.subplots(3, 1, sharex=True, figsize=(10, 8))
+    axes[0].plot(t, [r["fps"] for r in rows], label="fps")
+    axes[0].legend(loc="upper right")
+    if lat_rows:
+        tl = [r["uptime_ms"] / 1000.0 for r in lat_rows]
+        for k in [k for k in lat_rows[0] if k.endswith("_p50_us")]:
+            stage = k[: -len("_p50_us")]
+            line = axes[1].plot(tl, [r[k] for r in lat_rows], label=f"{stage} p50")[0]
+            axes[1].plot(tl, [r[f"{stage}_p99_us"] for r in lat_rows], "--", color=line.get_color(),
+                         label=f"{stage} p99")
+    axes[1].set_ylabel("us")
+    axes[1].legend(loc="upper right", fontsize="small", ncol=2)
+    axes[2].plot(t, [r["pos_x"] for r in rows], label="pos_x")
+    axes[2].plot(t, [r["pos_y"] for r in rows], label="pos_y")
+    axes[2].plot(t, [r["bang_score"] for r in rows], label="bang_score")
+    axes[2].set_xlabel("uptime (s)")
+    axes[2].legend(loc="upper right", fontsize="small")
+    fig.tight_layout()
+    fig.savefig(path)
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--in", dest="inp", required=True, help="Capture file or raw serial device")
+    ap.add_argument("--csv", dest="csv_out", help="CSV output path (stats records)")
+    ap.add_argument("--latency-csv", dest="lat_csv_out", help="CSV output path (per-stage p50/p95/p99/max)")
+    ap.add_argument("--ops-csv", dest="ops_csv_out", help="CSV output path (model per-op profile, newest)")
+    ap.add_argument("--plot", dest="plot_out", help="PNG output path (requires matplotlib)")
+    args = ap.parse_args()
+
+    buf = Path(args.inp).read_bytes()
+    rows, stats = decode(buf)
+    stats_rows = rows.get("stats", [])
+    lat_rows = rows.get("latency", [])
+
+    print(f"records: stats={len(stats_rows)} latency={len(lat_rows)} crc_errors={stats['crc_errors']} "
+          f"unknown={stats['unknown']} seq_gaps={stats['seq_gaps']}", file=sys.stderr)
+    if stats_rows:
+        cost = [r["tlm_cost_cyc"] for r in stats_rows[1:]]
+        if cost:
+            print(f"firmware cost per record: avg={sum(cost) / len(cost):.0f} max={max(cost)} cycles",
+                  file=sys.stderr)
+
+    if args.csv_out and stats_rows:
+        write_csv(Path(args.csv_out), stats_rows)
+    elif stats_rows:
+        w = csv.DictWriter(sys.stdout, fieldnames=list(stats_rows[0].keys()))
+        w.writeheader()
+        w.writerows(stats_rows)
+
+    if args.lat_csv_out and lat_rows:
+        write_csv(Path(args.lat_csv_out), lat_rows)
+
+    op_rows = rows.get("ops", [])
+    if op_rows:
+        print(f"model: invokes={op_rows[0]['invokes']} arena={op_rows[0]['arena_used']}/{op_rows[0]['arena_size']} bytes",
+              file=sys.stderr)
+        for r in op_rows:
+            print(f"  op{r['op']:02d} {r['name']:<20} avg={r['avg_us']}us max={r['max_us']}us", file=sys.stderr)
+        if args.ops_csv_out:
+            write_csv(Path(args.ops_csv_out), op_rows)
+
+    if args.plot_out and stats_rows:
+        try:
+            plot(Path(args.plot_out), stats_rows, lat_rows)
+        except ImportError:
+            print("plot skipped: matplotlib is not installed (pip install matplotlib)", file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
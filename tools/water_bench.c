@@ -0,0 +1,169 @@
+/*
+ * Host check and throughput benchmark for grid water (src/water_sim.h) on the sand grid.
+ *
+ * - Dam break: a water column released on a flat floor must keep every cell and level out (column
+ *   heights within one cell of each other) in a bounded number of steps.
+ * - Mixed scene: a sand bank under a lake under a rotating 8-way gravity, water and sand steps
+ *   interleaved as in the demo; both materials must be conserved.
+ * - Throughput: cells/ms for the mixed scene (active patches only) and with every patch forced active
+ *   (worst case), plus an M33 cycle estimate from the step's operation counts (cells visited, water
+ *   cells updated, sideways probes, moves) with per-operation costs for a Cortex-M33 running from
+ *   zero-wait SRAM. The estimate gives the largest grid that fits a share of a 60 Hz frame.
+ *
+ * Build and run:
+ *   cc -O2 -std=c11 -Isrc tools/water_bench.c src/water_sim.c src/sand_sim.c -o /tmp/water_bench && /tmp/water_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host/bench_clock.h"
+
+#include "sand_sim.h"
+#include "water_sim.h"
+
+#define BENCH_DAM_STEPS_MAX 2000u
+#define BENCH_MIX_STEPS 4000u
+#define BENCH_GRAVITY_PERIOD 90u
+
+/* Cortex-M33 cost model (cycles), from the inner loops: a visited non-water cell is a load, compare and
+ * loop step; a water cell adds the moved-mask test, the upstream pressure read, the fall test and the two
+ * diagonal tests; a sideways probe is two bounded loads; a move is four stores plus patch flags.
+ */
+#define M33_CYC_VISIT 5.0
+#define M33_CYC_WATER 30.0
+#define M33_CYC_PROBE 8.0
+#define M33_CYC_MOVE 14.0
+#define M33_HZ 150e6
+#define FRAME_SHARE 0.25 /* of a 60 Hz frame for the water step */
+
+static sand_grid_t s_grid;
+static edgeai_water_t s_water;
+
+static void column_spread(const sand_grid_t *g, int32_t *hmin, int32_t *hmax)
+{
+    *hmin = EDGEAI_SAND_H;
+    *hmax = 0;
+    for (int32_t x = 0; x < EDGEAI_SAND_W; x++)
+    {
+        int32_t h = 0;
+        for (int32_t y = 0; y < EDGEAI_SAND_H; y++) h += (g->cell[y][x] == (uint8_t)kEdgeAiMatWater);
+        if (h < *hmin) *hmin = h;
+        if (h > *hmax) *hmax = h;
+    }
+}
+
+static int dam_break(void)
+{
+    sand_sim_init(&s_grid, 0x5A17u);
+    edgeai_water_init(&s_water, 0x1234u);
+    edgeai_water_fill_rect(&s_water, &s_grid, 0, EDGEAI_SAND_H / 3, EDGEAI_SAND_W / 4 - 1, EDGEAI_SAND_H - 1);
+    uint32_t n0 = sand_sim_count(&s_grid, kEdgeAiMatWater);
+    sand_gravity_t down = {0, 1};
+
+    uint32_t step = 0;
+    int32_t hmin = 0, hmax = 0;
+    for (; step < BENCH_DAM_STEPS_MAX; step++)
+    {
+        edgeai_water_step(&s_water, &s_grid, down);
+        sand_sim_end_step(&s_grid);
+        column_spread(&s_grid, &hmin, &hmax);
+        if (hmax - hmin <= 1) break;
+    }
+    uint32_t n1 = sand_sim_count(&s_grid, kEdgeAiMatWater);
+    printf("dam break: %u cells, level (column heights %d..%d) after %u steps, %u cells kept\n", n0, hmin, hmax,
+           step + 1u, n1);
+    return (n1 == n0 && hmax - hmin <= 1) ? 0 : 1;
+}
+
+typedef struct
+{
+    double t;
+    uint64_t scanned, water, probes, moves;
+} run_t;
+
+static sand_gravity_t gravity_at(uint32_t step)
+{
+    static const sand_gravity_t seq[] = {{0, 1}, {1, 1}, {1, 0}, {0, 1}, {-1, 1}, {-1, 0}, {0, 1}, {0, -1}};
+    return seq[(step / BENCH_GRAVITY_PERIOD) % (sizeof(seq) / sizeof(seq[0]))];
+}
+
+static void mixed_scene(void)
+{
+    sand_sim_init(&s_grid, 0x5A17u);
+    edgeai_water_init(&s_water, 0x1234u);
+    sand_sim_fill_rect(&s_grid, 0, (EDGEAI_SAND_H * 3) / 4, EDGEAI_SAND_W / 2, EDGEAI_SAND_H - 1, kEdgeAiMatSand);
+    edgeai_water_fill_rect(&s_water, &s_grid, EDGEAI_SAND_W / 3, EDGEAI_SAND_H / 4, EDGEAI_SAND_W - 1,
+                           EDGEAI_SAND_H / 2);
+}
+
+static run_t mixed_run(bool all_active, uint32_t *water_kept, uint32_t *sand_kept)
+{
+    mixed_scene();
+    uint32_t w0 = sand_sim_count(&s_grid, kEdgeAiMatWater);
+    uint32_t s0 = sand_sim_count(&s_grid, kEdgeAiMatSand);
+    run_t r;
+    memset(&r, 0, sizeof(r));
+    for (uint32_t i = 0; i < BENCH_MIX_STEPS; i++)
+    {
+        sand_gravity_t grav = gravity_at(i);
+        if (all_active) memset(s_grid.active, 1, sizeof(s_grid.active));
+        double t0 = bench_now_s();
+        edgeai_water_step(&s_water, &s_grid, grav);
+        r.t += bench_now_s() - t0;
+        r.scanned += s_water.cells_scanned;
+        r.water += s_water.water_cells;
+        r.probes += s_water.probes;
+        r.moves += s_water.moves;
+        sand_sim_step(&s_grid, grav);
+    }
+    *water_kept = (sand_sim_count(&s_grid, kEdgeAiMatWater) == w0);
+    *sand_kept = (sand_sim_count(&s_grid, kEdgeAiMatSand) == s0);
+    return r;
+}
+
+static void report(const char *name, const run_t *r)
+{
+    double cyc = M33_CYC_VISIT * (double)r->scanned + M33_CYC_WATER * (double)r->water +
+                 M33_CYC_PROBE * (double)r->probes + M33_CYC_MOVE * (double)r->moves;
+    double cells_per_step = (double)r->scanned / BENCH_MIX_STEPS;
+    double cyc_per_step = cyc / BENCH_MIX_STEPS;
+    double cyc_per_cell = cyc / (double)(r->scanned ? r->scanned : 1u);
+    double budget = M33_HZ / 60.0 * FRAME_SHARE;
+    printf("%s: %.0f cells/step (%.0f water, %.0f probes, %.0f moves), %.1f us/step host, %.0f cells/ms host\n",
+           name, cells_per_step, (double)r->water / BENCH_MIX_STEPS, (double)r->probes / BENCH_MIX_STEPS,
+           (double)r->moves / BENCH_MIX_STEPS, r->t * 1e6 / BENCH_MIX_STEPS, (double)r->scanned / (r->t * 1e3));
+    printf("  M33 estimate: %.1f cyc/cell, %.0f cyc/step = %.2f ms at %.0f MHz; %.0f cells fit %.0f%% of a frame\n",
+           cyc_per_cell, cyc_per_step, cyc_per_step / M33_HZ * 1e3, M33_HZ / 1e6, budget / cyc_per_cell,
+           FRAME_SHARE * 100.0);
+}
+
+int main(void)
+{
+    printf("grid %dx%d (%d cells, %d px/cell), dispersion %d\n", EDGEAI_SAND_W, EDGEAI_SAND_H,
+           EDGEAI_SAND_W * EDGEAI_SAND_H, EDGEAI_SAND_CELL_PX, EDGEAI_WATER_DISPERSE);
+    int rc = dam_break();
+
+    uint32_t wk = 0, sk = 0;
+    run_t act = mixed_run(false, &wk, &sk);
+    printf("mixed scene, %u steps: water %s, sand %s\n", BENCH_MIX_STEPS, wk ? "kept" : "LOST", sk ? "kept" : "LOST");
+    if (!wk || !sk) rc = 1;
+    report("active patches", &act);
+    run_t all = mixed_run(true, &wk, &sk);
+    report("all patches", &all);
+
+    /* Grid sizes by cell pitch at the all-active cost per cell (this scene's water share). */
+    double cyc_cell = (M33_CYC_VISIT * (double)all.scanned + M33_CYC_WATER * (double)all.water +
+                       M33_CYC_PROBE * (double)all.probes + M33_CYC_MOVE * (double)all.moves) /
+                      (double)all.scanned;
+    for (int px = 2; px <= 8; px *= 2)
+    {
+        int cells = (EDGEAI_LCD_W / px) * (EDGEAI_LCD_H / px);
+        double ms = cells * cyc_cell / M33_HZ * 1e3;
+        printf("  %d px/cell: %3dx%-3d %6d cells, ~%.2f ms/step (%s)\n", px, EDGEAI_LCD_W / px, EDGEAI_LCD_H / px,
+               cells, ms, (ms <= 1e3 / 60.0 * FRAME_SHARE) ? "fits" : "over budget");
+    }
+    return rc;
+}